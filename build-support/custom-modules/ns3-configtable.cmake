@@ -166,6 +166,9 @@ macro(write_configtable)
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
+  string(APPEND out "Multithreaded Simulation      : ")
+  check_on_or_off("NS3_MTP" "NS3_MTP")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "NS3_CLICK")
 
@@ -184,6 +187,9 @@ macro(write_configtable)
   string(APPEND out "SQLite support                : ")
   check_on_or_off("NS3_SQLITE" "ENABLE_SQLITE")
 
+  string(APPEND out "zlib support                  : ")
+  check_on_or_off("NS3_ZLIB" "ENABLE_ZLIB")
+
   string(APPEND out "Eigen3 support                : ")
   check_on_or_off("NS3_EIGEN" "ENABLE_EIGEN")
 
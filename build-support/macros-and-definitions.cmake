@@ -402,6 +402,18 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  # Compile the trace sources away if requested, e.g., for optimized builds
+  # which do not need tracing
+  if(NOT ${NS3_TRACE_SOURCES})
+    add_definitions(-DNS3_TRACE_SOURCES_DISABLE)
+  endif()
+
+  # Multithreaded simulation makes reference counts shared between partitions
+  # atomic, so the definition must be visible to every module
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -585,6 +597,19 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_ZLIB False)
+  if(${NS3_ZLIB})
+    find_package(ZLIB QUIET)
+
+    if(${ZLIB_FOUND})
+      set(ENABLE_ZLIB True)
+      add_definitions(-DHAVE_ZLIB)
+      if(NOT ${NS3_FORCE_LOCAL_DEPENDENCIES})
+        include_directories(SYSTEM ${ZLIB_INCLUDE_DIRS})
+      endif()
+    endif()
+  endif()
+
   set(ENABLE_EIGEN False)
   if(${NS3_EIGEN})
     disable_cmake_warnings()
@@ -1236,6 +1261,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
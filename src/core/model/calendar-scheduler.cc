@@ -14,6 +14,8 @@
 #include "log.h"
 #include "type-id.h"
 
+#include <algorithm>
+#include <iterator>
 #include <list>
 #include <string>
 
@@ -145,6 +147,49 @@ CalendarScheduler::Insert(const Event& ev)
     ResizeUp();
 }
 
+void
+CalendarScheduler::InsertBatch(std::span<const Event> events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+
+    // Resize once for the whole batch, before inserting the events
+    uint32_t nBuckets = m_nBuckets;
+    while (m_qSize + events.size() > nBuckets * 2 && nBuckets < 32768)
+    {
+        nBuckets *= 2;
+    }
+    if (nBuckets != m_nBuckets)
+    {
+        Resize(nBuckets);
+    }
+
+    // Sort the batch in bucket order, so that consecutive events falling
+    // into the same bucket are inserted with a single scan of the bucket
+    m_batch.assign(events.begin(), events.end());
+    std::sort(m_batch.begin(), m_batch.end(), [this](const Event& a, const Event& b) {
+        return Order(a.key, b.key);
+    });
+    uint32_t bucket = m_nBuckets;
+    Bucket::iterator pos;
+    for (const auto& ev : m_batch)
+    {
+        uint32_t evBucket = Hash(ev.key.m_ts);
+        if (evBucket != bucket)
+        {
+            bucket = evBucket;
+            pos = m_buckets[bucket].begin();
+        }
+        auto end = m_buckets[bucket].end();
+        while (pos != end && !Order(ev.key, pos->key))
+        {
+            ++pos;
+        }
+        pos = std::next(m_buckets[bucket].insert(pos, ev));
+    }
+    m_qSize += m_batch.size();
+    m_batch.clear();
+}
+
 bool
 CalendarScheduler::IsEmpty() const
 {
@@ -14,6 +14,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <vector>
 
 /**
  * @file
@@ -51,6 +52,7 @@ class EventImpl;
  * Operation    | Amortized %Time | Reason
  * :----------- | :-------------- | :-----
  * Insert()     | ~Constant       | Ordering within bucket; possible resize
+ * InsertBatch()| ~Linear         | Sorting; one scan per bucket; one resize
  * IsEmpty()    | Constant        | Explicit queue size
  * PeekNext()   | ~Constant       | Search buckets
  * Remove()     | ~Constant       | Search within bucket; possible resize
@@ -95,6 +97,7 @@ class CalendarScheduler : public Scheduler
 
     // Inherited
     void Insert(const Scheduler::Event& ev) override;
+    void InsertBatch(std::span<const Scheduler::Event> events) override;
     bool IsEmpty() const override;
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
@@ -171,6 +174,8 @@ class CalendarScheduler : public Scheduler
     uint64_t m_lastPrio;
     /** Number of events in queue. */
     uint32_t m_qSize;
+    /** Scratch space used to sort the batches of events. */
+    std::vector<Scheduler::Event> m_batch;
 
     /**
      * Set the insertion order.
@@ -15,6 +15,8 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 /**
@@ -189,441 +191,450 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 
 /**
  * @ingroup config-impl
- * Helper to test if an array entry matches a config path specification.
+ * Convert a string to an \c uint32_t.
+ *
+ * @param [in] str The string.
+ * @param [out] value The location to store the \c uint32_t.
+ * @returns \c true if the string could be converted.
  */
-class ArrayMatcher
-{
-  public:
-    /**
-     * Construct from a Config path specification.
-     *
-     * @param [in] element The Config path specification.
-     */
-    ArrayMatcher(std::string element);
-    /**
-     * Test if a specific index matches the Config Path.
-     *
-     * @param [in] i The index.
-     * @returns \c true if the index matches the Config Path.
-     */
-    bool Matches(std::size_t i) const;
-
-  private:
-    /**
-     * Convert a string to an \c uint32_t.
-     *
-     * @param [in] str The string.
-     * @param [in] value The location to store the \c uint32_t.
-     * @returns \c true if the string could be converted.
-     */
-    bool StringToUint32(std::string str, uint32_t* value) const;
-    /** The Config path element. */
-    std::string m_element;
-
-    // end of class ArrayMatcher
-};
-
-ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
-{
-    NS_LOG_FUNCTION(this << element);
-}
-
-bool
-ArrayMatcher::Matches(std::size_t i) const
-{
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
-    {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
-    }
-    std::string::size_type tmp;
-    tmp = m_element.find('|');
-    if (tmp != std::string::npos)
-    {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
-    }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
-        dash < rightBracket)
-    {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
-        uint32_t min;
-        uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
-        }
-    }
-    uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
-    {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-        return true;
-    }
-    NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-    return false;
-}
-
-bool
-ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
+static bool
+StringToUint32(std::string str, uint32_t* value)
 {
-    NS_LOG_FUNCTION(this << str << value);
+    NS_LOG_FUNCTION(str << value);
     std::istringstream iss;
     iss.str(str);
     iss >> (*value);
     return !iss.bad() && !iss.fail();
 }
 
-/**
- * @ingroup config-impl
- * Abstract class to parse Config paths into object references.
- */
-class Resolver
-{
-  public:
-    /**
-     * Construct from a base Config path.
-     *
-     * @param [in] path The Config path.
-     */
-    Resolver(std::string path);
-    /** Destructor. */
-    virtual ~Resolver();
-
-    /**
-     * Parse the stored Config path into an object reference,
-     * beginning at the indicated root object.
-     *
-     * @param [in] root The object corresponding to the current position in
-     *                  in the Config path.
-     */
-    void Resolve(Ptr<Object> root);
-
-  private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
-    /**
-     * Parse the next element in the Config path.
-     *
-     * @param [in] path The remaining portion of the Config path.
-     * @param [in] root The object corresponding to the current position
-     *                  in the Config path.
-     */
-    void DoResolve(std::string path, Ptr<Object> root);
-    /**
-     * Parse an index on the Config path.
-     *
-     * @param [in] path The remaining Config path.
-     * @param [in,out] vector The resulting list of matching objects.
-     */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
-    /**
-     * Handle one object found on the path.
-     *
-     * @param [in] object The current object on the Config path.
-     */
-    void DoResolveOne(Ptr<Object> object);
-    /**
-     * Get the current Config path.
-     *
-     * @returns The current Config path.
-     */
-    std::string GetResolvedPath() const;
-    /**
-     * Handle one found object.
-     *
-     * @param [in] object The found object.
-     * @param [in] path The matching Config path context.
-     */
-    virtual void DoOne(Ptr<Object> object, std::string path) = 0;
-
-    /** Current list of path tokens. */
-    std::vector<std::string> m_workStack;
-    /** The Config path. */
-    std::string m_path;
-
-    // end of class Resolver
-};
-
-Resolver::Resolver(std::string path)
+CompiledPath::CompiledPath(std::string path)
     : m_path(path)
 {
     NS_LOG_FUNCTION(this << path);
-    Canonicalize();
-}
-
-Resolver::~Resolver()
-{
-    NS_LOG_FUNCTION(this);
-}
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
+    std::string::size_type slash = path.find_last_of('/');
+    NS_ASSERT(slash != std::string::npos);
+    m_root = path.substr(0, slash);
+    m_leaf = path.substr(slash + 1, path.size() - (slash + 1));
 
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
+    // ensure that the root starts and ends with a '/', and split it
+    std::string root = m_root;
+    if (root.find('/') != 0)
+    {
+        root = "/" + root;
+    }
+    if (root.find_last_of('/') != root.size() - 1)
     {
-        // no slash at start
-        m_path = "/" + m_path;
+        root = root + "/";
     }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = root.find('/', start)) != std::string::npos)
     {
-        // no slash at end
-        m_path = m_path + "/";
+        Element element;
+        element.item = root.substr(start, next - start);
+        element.hasTid = element.item.find('$') == 0 &&
+                         TypeId::LookupByNameFailSafe(element.item.substr(1), &element.tid);
+        ParseArray(element.item, element.ranges);
+        m_elements.push_back(element);
+        start = next + 1;
     }
 }
 
-void
-Resolver::Resolve(Ptr<Object> root)
+std::string
+CompiledPath::GetPath() const
 {
-    NS_LOG_FUNCTION(this << root);
-
-    DoResolve(m_path, root);
+    NS_LOG_FUNCTION(this);
+    return m_path;
 }
 
 std::string
-Resolver::GetResolvedPath() const
+CompiledPath::GetLeaf() const
 {
     NS_LOG_FUNCTION(this);
+    return m_leaf;
+}
 
-    std::string fullPath = "/";
-    for (auto i = m_workStack.begin(); i != m_workStack.end(); i++)
+void
+CompiledPath::ParseArray(std::string item, std::vector<std::pair<std::size_t, std::size_t>>& ranges)
+{
+    NS_LOG_FUNCTION(item << &ranges);
+    if (item == "*")
     {
-        fullPath += *i + "/";
+        ranges.emplace_back(0, std::numeric_limits<std::size_t>::max());
+        return;
+    }
+    std::string::size_type tmp = item.find('|');
+    if (tmp != std::string::npos)
+    {
+        ParseArray(item.substr(0, tmp), ranges);
+        ParseArray(item.substr(tmp + 1, item.size() - (tmp + 1)), ranges);
+        return;
+    }
+    std::string::size_type leftBracket = item.find('[');
+    std::string::size_type rightBracket = item.find(']');
+    std::string::size_type dash = item.find('-');
+    uint32_t min;
+    uint32_t max;
+    if (leftBracket == 0 && rightBracket == item.size() - 1 && dash > leftBracket &&
+        dash < rightBracket)
+    {
+        std::string lowerBound = item.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = item.substr(dash + 1, rightBracket - (dash + 1));
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max))
+        {
+            ranges.emplace_back(min, max);
+        }
+        return;
+    }
+    if (StringToUint32(item, &min))
+    {
+        ranges.emplace_back(min, min);
     }
-    return fullPath;
 }
 
-void
-Resolver::DoResolveOne(Ptr<Object> object)
+const std::vector<CompiledPath::Link>&
+CompiledPath::GetLinks(const Element& element, TypeId tid)
 {
-    NS_LOG_FUNCTION(this << object);
+    NS_LOG_FUNCTION(element.item << tid);
+    auto it = element.links.find(tid.GetUid());
+    if (it != element.links.end())
+    {
+        return it->second;
+    }
 
-    NS_LOG_DEBUG("resolved=" << GetResolvedPath());
-    DoOne(object, GetResolvedPath());
+    std::vector<Link>& links = element.links[tid.GetUid()];
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (info.name != element.item && element.item != "*")
+            {
+                continue;
+            }
+            // keep the pointers and the object vectors, and ignore anything else
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                links.push_back({info.name, info.accessor, false});
+            }
+            if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                nullptr)
+            {
+                links.push_back({info.name, info.accessor, true});
+            }
+        }
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return links;
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+CompiledPath::DoResolve(std::size_t i,
+                        Ptr<Object> root,
+                        const std::size_t* index,
+                        std::string& context,
+                        Matches& matches) const
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << i << root << index << context << &matches);
 
-    if (next == std::string::npos)
+    if (i == m_elements.size())
     {
         //
-        // If root is zero, we're beginning to see if we can use the object name
-        // service to resolve this path.  It is impossible to have a object name
-        // associated with the root of the object name service since that root
-        // is not an object.  This path must be referring to something in another
-        // namespace and it will have been found already since the name service
-        // is always consulted last.
+        // If root is zero, this path refers to something in another namespace,
+        // which has been found already since the name service is consulted last.
+        // If an index is left, the path does not go through any array.
         //
-        if (root)
+        if (root && index == nullptr)
         {
-            DoResolveOne(root);
+            NS_LOG_DEBUG("resolved=" << context);
+            matches.objects.push_back(root);
+            matches.contexts.push_back(context);
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const Element& element = m_elements[i];
+    const std::string& item = element.item;
+    const std::size_t length = context.size();
 
     //
     // If root is zero, we're beginning to see if we can use the object name
-    // service to resolve this path.  In this case, we must see the name space
-    // "/Names" on the front of this path.  There is no object associated with
-    // the root of the "/Names" namespace, so we just ignore it and move on to
-    // the next segment.
+    // service to resolve this path, which must then start with "/Names".
+    // There is no object associated with the root of the "/Names" namespace.
     //
-    if (!root)
+    if (!root && item.rfind("Names", 0) == 0)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
-        {
-            m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
-            m_workStack.pop_back();
-            return;
-        }
+        context += item + "/";
+        DoResolve(i + 1, root, index, context, matches);
+        context.resize(length);
+        return;
     }
 
     //
-    // We have an item (possibly a segment of a namespace path.  Check to see if
-    // we can determine that this segment refers to a named object.  If root is
-    // zero, this means to look in the root of the "/Names" name space, otherwise
-    // it refers to a name space context (level).
+    // Check to see if this element refers to a named object, in the root of
+    // the "/Names" namespace if root is zero, or in the namespace of root.
     //
     Ptr<Object> namedObject = Names::Find<Object>(root, item);
     if (namedObject)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
-        m_workStack.pop_back();
+        context += item + "/";
+        DoResolve(i + 1, namedObject, index, context, matches);
+        context.resize(length);
         return;
     }
 
     //
-    // We're done with the object name service hooks, so proceed down the path
-    // of types and attributes; but only if root is nonzero.  If root is zero
-    // and we find ourselves here, we are trying to check in the namespace for
-    // a path that is not in the "/Names" namespace.  We will have previously
-    // found any matches, so we just bail out.
+    // Any match of a path outside of the "/Names" namespace has been found
+    // from the root namespace objects already.
     //
     if (!root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (item.find('$') == 0)
     {
-        // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        // This is a call to GetObject, whose TypeId is looked up here if it
+        // was not registered when the path was compiled
+        TypeId tid = element.hasTid ? element.tid : TypeId::LookupByName(item.substr(1));
+        NS_LOG_DEBUG("GetObject=" << tid.GetName() << " on path=" << context);
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << tid.GetName() << ") failed on path=" << context);
             return;
         }
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
-        m_workStack.pop_back();
+        context += item + "/";
+        DoResolve(i + 1, object, index, context, matches);
+        context.resize(length);
+        return;
     }
-    else
-    {
-        // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
-        bool foundMatch = false;
 
-        do
+    // this is a normal attribute.
+    const std::vector<Link>& links = GetLinks(element, root->GetInstanceTypeId());
+    if (links.empty())
+    {
+        NS_LOG_DEBUG("Requested item=" << item << " does not exist on path=" << context);
+        return;
+    }
+    for (const auto& link : links)
+    {
+        context += link.name + "/";
+        if (link.isContainer)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            NS_LOG_DEBUG("GetAttribute(vector)=" << link.name << " on path=" << context);
+            DoArrayResolve(i + 1, root, link, index, context, matches);
+        }
+        else
+        {
+            NS_LOG_DEBUG("GetAttribute(ptr)=" << link.name << " on path=" << context);
+            PointerValue value;
+            link.accessor->Get(PeekPointer(root), value);
+            Ptr<Object> object = value.Get<Object>();
+            if (object)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
-                {
-                    continue;
-                }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                DoResolve(i + 1, object, index, context, matches);
             }
+            else
+            {
+                NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                        << context.substr(0, length)
+                                                        << "\""
+                                                           " but is null.");
+            }
+        }
+        context.resize(length);
+    }
+}
 
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+void
+CompiledPath::DoArrayResolve(std::size_t i,
+                             Ptr<Object> root,
+                             const Link& link,
+                             const std::size_t* index,
+                             std::string& context,
+                             Matches& matches) const
+{
+    NS_LOG_FUNCTION(this << i << root << link.name << index << context << &matches);
 
-        if (!foundMatch)
+    if (i == m_elements.size())
+    {
+        return;
+    }
+    const auto& ranges = m_elements[i].ranges;
+    auto isMatch = [&ranges, index](std::size_t k) {
+        if (index != nullptr && k != *index)
+        {
+            return false;
+        }
+        return std::any_of(ranges.begin(), ranges.end(), [k](const auto& range) {
+            return k >= range.first && k <= range.second;
+        });
+    };
+    const std::size_t length = context.size();
+
+    //
+    // When a single index is requested, get the object at this index only,
+    // rather than all the objects of the container.
+    //
+    const auto accessor =
+        dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(link.accessor));
+    if (index != nullptr && accessor != nullptr)
+    {
+        std::size_t n;
+        if (!isMatch(*index) || !accessor->DoGetN(PeekPointer(root), &n))
         {
-            NS_LOG_DEBUG("Requested item=" << item
-                                           << " does not exist on path=" << GetResolvedPath());
             return;
         }
+        // the instance at position i has usually the index i
+        std::size_t found = n;
+        Ptr<Object> object;
+        if (*index < n)
+        {
+            object = accessor->DoGet(PeekPointer(root), *index, &found);
+        }
+        for (std::size_t j = 0; j < n && found != *index; j++)
+        {
+            object = accessor->DoGet(PeekPointer(root), j, &found);
+        }
+        if (found == *index)
+        {
+            context += std::to_string(*index) + "/";
+            DoResolve(i + 1, object, nullptr, context, matches);
+            context.resize(length);
+        }
+        return;
     }
+
+    ObjectPtrContainerValue container;
+    link.accessor->Get(PeekPointer(root), container);
+    for (auto it = container.Begin(); it != container.End(); ++it)
+    {
+        if (isMatch(it->first))
+        {
+            context += std::to_string(it->first) + "/";
+            DoResolve(i + 1, it->second, nullptr, context, matches);
+            context.resize(length);
+        }
+    }
+}
+
+MatchContainer
+CompiledPath::Resolve(const std::size_t* index) const
+{
+    NS_LOG_FUNCTION(this << index);
+
+    Matches matches;
+    std::string context = "/";
+    for (std::size_t i = 0; i < GetRootNamespaceObjectN(); i++)
+    {
+        DoResolve(0, GetRootNamespaceObject(i), index, context, matches);
+    }
+
+    //
+    // See if we can do something with the object name service.  Starting with
+    // the root pointer zeroed indicates that the resolution should start
+    // at the root of the "/Names" namespace.
+    //
+    DoResolve(0, nullptr, index, context, matches);
+
+    return MatchContainer(matches.objects, matches.contexts, m_root);
+}
+
+MatchContainer
+CompiledPath::LookupMatches() const
+{
+    NS_LOG_FUNCTION(this);
+    return Resolve(nullptr);
+}
+
+MatchContainer
+CompiledPath::LookupMatches(std::size_t index) const
+{
+    NS_LOG_FUNCTION(this << index);
+    return Resolve(&index);
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+CompiledPath::Set(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    LookupMatches().Set(m_leaf, value);
+}
+
+bool
+CompiledPath::SetFailSafe(const AttributeValue& value) const
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << &value);
+    return LookupMatches().SetFailSafe(m_leaf, value);
+}
+
+void
+CompiledPath::Connect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!ConnectFailSafe(cb))
     {
-        return;
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+}
+
+bool
+CompiledPath::ConnectFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return LookupMatches().ConnectFailSafe(m_leaf, cb);
+}
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
+void
+CompiledPath::ConnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!ConnectWithoutContextFailSafe(cb))
     {
-        if (matcher.Matches((*it).first))
-        {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
-        }
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
     }
 }
 
+bool
+CompiledPath::ConnectWithoutContextFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return LookupMatches().ConnectWithoutContextFailSafe(m_leaf, cb);
+}
+
+void
+CompiledPath::Disconnect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    MatchContainer container = LookupMatches();
+    if (container.GetN() == 0)
+    {
+        std::size_t lastFwdSlash = m_root.rfind('/');
+        NS_LOG_WARN("Failed to disconnect "
+                    << m_leaf << ", the Requested object name = " << m_root.substr(lastFwdSlash + 1)
+                    << " does not exits on path " << m_root.substr(0, lastFwdSlash));
+    }
+    container.Disconnect(m_leaf, cb);
+}
+
+void
+CompiledPath::DisconnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    MatchContainer container = LookupMatches();
+    if (container.GetN() == 0)
+    {
+        std::size_t lastFwdSlash = m_root.rfind('/');
+        NS_LOG_WARN("Failed to disconnect "
+                    << m_leaf << ", the Requested object name = " << m_root.substr(lastFwdSlash + 1)
+                    << " does not exits on path " << m_root.substr(0, lastFwdSlash));
+    }
+    container.DisconnectWithoutContext(m_leaf, cb);
+}
+
 /**
  * @ingroup config-impl
  * Config system implementation class.
@@ -659,15 +670,6 @@ class ConfigImpl : public Singleton<ConfigImpl>
     Ptr<Object> GetRootNamespaceObject(std::size_t i) const;
 
   private:
-    /**
-     * Break a Config path into the leading path and the last leaf token.
-     * @param [in] path The Config path.
-     * @param [in,out] root The leading part of the \pname{path},
-     *   up to the final slash.
-     * @param [in,out] leaf The trailing part of the \pname{path}.
-     */
-    void ParsePath(std::string path, std::string* root, std::string* leaf) const;
-
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
 
@@ -677,138 +679,54 @@ class ConfigImpl : public Singleton<ConfigImpl>
     // end of class ConfigImpl
 };
 
-void
-ConfigImpl::ParsePath(std::string path, std::string* root, std::string* leaf) const
-{
-    NS_LOG_FUNCTION(this << path << root << leaf);
-
-    std::string::size_type slash = path.find_last_of('/');
-    NS_ASSERT(slash != std::string::npos);
-    *root = path.substr(0, slash);
-    *leaf = path.substr(slash + 1, path.size() - (slash + 1));
-    NS_LOG_FUNCTION(path << *root << *leaf);
-}
-
 void
 ConfigImpl::Set(std::string path, const AttributeValue& value)
 {
     NS_LOG_FUNCTION(this << path << &value);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    container.Set(leaf, value);
+    CompiledPath(path).Set(value);
 }
 
 bool
 ConfigImpl::SetFailSafe(std::string path, const AttributeValue& value)
 {
     NS_LOG_FUNCTION(this << path << &value);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.SetFailSafe(leaf, value);
+    return CompiledPath(path).SetFailSafe(value);
 }
 
 bool
 ConfigImpl::ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << path << &cb);
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectWithoutContextFailSafe(leaf, cb);
+    return CompiledPath(path).ConnectWithoutContextFailSafe(cb);
 }
 
 void
 ConfigImpl::DisconnectWithoutContext(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << path << &cb);
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    if (container.GetN() == 0)
-    {
-        std::size_t lastFwdSlash = root.rfind('/');
-        NS_LOG_WARN("Failed to disconnect "
-                    << leaf << ", the Requested object name = " << root.substr(lastFwdSlash + 1)
-                    << " does not exits on path " << root.substr(0, lastFwdSlash));
-    }
-    container.DisconnectWithoutContext(leaf, cb);
+    CompiledPath(path).DisconnectWithoutContext(cb);
 }
 
 bool
 ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << path << &cb);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectFailSafe(leaf, cb);
+    return CompiledPath(path).ConnectFailSafe(cb);
 }
 
 void
 ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << path << &cb);
-
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    if (container.GetN() == 0)
-    {
-        std::size_t lastFwdSlash = root.rfind('/');
-        NS_LOG_WARN("Failed to disconnect "
-                    << leaf << ", the Requested object name = " << root.substr(lastFwdSlash + 1)
-                    << " does not exits on path " << root.substr(0, lastFwdSlash));
-    }
-    container.Disconnect(leaf, cb);
+    CompiledPath(path).Disconnect(cb);
 }
 
 MatchContainer
 ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
-
-    class LookupMatchesResolver : public Resolver
-    {
-      public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
-        {
-        }
-
-        void DoOne(Ptr<Object> object, std::string path) override
-        {
-            m_objects.push_back(object);
-            m_contexts.push_back(path);
-        }
-
-        std::vector<Ptr<Object>> m_objects;
-        std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
-
-    for (auto i = m_roots.begin(); i != m_roots.end(); i++)
-    {
-        resolver.Resolve(*i);
-    }
-
-    //
-    // See if we can do something with the object name service.  Starting with
-    // the root pointer zeroed indicates to the resolver that it should start
-    // looking at the root of the "/Names" namespace during this go.
-    //
-    resolver.Resolve(nullptr);
-
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+    // an empty leaf leaves the whole path to match objects
+    return CompiledPath(path + "/").LookupMatches();
 }
 
 void
@@ -9,7 +9,9 @@
 #define CONFIG_H
 
 #include "ptr.h"
+#include "type-id.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -356,6 +358,196 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+/**
+ * @ingroup config
+ * @brief A path parsed once, to be resolved repeatedly.
+ *
+ * The functions of the Config namespace parse their path, and look up
+ * the TypeIds and the attributes it names, on each call.  A CompiledPath
+ * splits its path into elements once, looks up the TypeId of its
+ * \c $TypeId elements once, and remembers the attributes matching each
+ * element by TypeId, so that resolving it again only walks the objects.
+ *
+ * The last element of the path names the attribute or the trace source
+ * which is set or connected, as with Config::Set and Config::Connect.
+ * LookupMatches(std::size_t) resolves the path under a single element of
+ * the first array of the path, e.g., under one node of \c /NodeList/,
+ * which connects the sinks of a node created after the others without
+ * visiting them again.
+ */
+class CompiledPath
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] path The path, whose last element is the name of
+     *                  an attribute or of a trace source.
+     */
+    CompiledPath(std::string path);
+
+    /**
+     * @returns The path.
+     */
+    std::string GetPath() const;
+    /**
+     * @returns The last element of the path, i.e., the name of the
+     *          attribute or of the trace source.
+     */
+    std::string GetLeaf() const;
+
+    /**
+     * @returns A container of the objects which match the path without
+     *          its last element.
+     */
+    MatchContainer LookupMatches() const;
+    /**
+     * @param [in] index The index of the element of the first array of the path.
+     * @returns A container of the objects which match the path without
+     *          its last element, and whose path goes through the element
+     *          \pname{index} of the first array of the path.
+     */
+    MatchContainer LookupMatches(std::size_t index) const;
+
+    /**
+     * @param [in] value The value to set in all matching attributes.
+     * \sa ns3::Config::Set
+     */
+    void Set(const AttributeValue& value) const;
+    /**
+     * @param [in] value The value to set in all matching attributes.
+     * @returns \c true if any matching attributes could be set.
+     * \sa ns3::Config::SetFailSafe
+     */
+    bool SetFailSafe(const AttributeValue& value) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * \sa ns3::Config::Connect
+     */
+    void Connect(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * @returns \c true if any trace sources could be connected.
+     * \sa ns3::Config::ConnectFailSafe
+     */
+    bool ConnectFailSafe(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * \sa ns3::Config::ConnectWithoutContext
+     */
+    void ConnectWithoutContext(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * @returns \c true if any trace sources could be connected.
+     * \sa ns3::Config::ConnectWithoutContextFailSafe
+     */
+    bool ConnectWithoutContextFailSafe(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to disconnect from the matching trace sources.
+     * \sa ns3::Config::Disconnect
+     */
+    void Disconnect(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to disconnect from the matching trace sources.
+     * \sa ns3::Config::DisconnectWithoutContext
+     */
+    void DisconnectWithoutContext(const CallbackBase& cb) const;
+
+  private:
+    /** An attribute of a TypeId leading to other objects. */
+    struct Link
+    {
+        std::string name;                      //!< The name of the attribute.
+        Ptr<const AttributeAccessor> accessor; //!< The accessor of the attribute.
+        bool isContainer; //!< Whether the attribute is a container rather than a pointer.
+    };
+
+    /** An element of the path. */
+    struct Element
+    {
+        std::string item;                                        //!< The element.
+        TypeId tid;                                              //!< The TypeId of \c $TypeId.
+        bool hasTid;                                             //!< Whether tid was found.
+        std::vector<std::pair<std::size_t, std::size_t>> ranges; //!< The matched indices.
+        /** The attributes matching the element, by TypeId uid. */
+        mutable std::map<uint16_t, std::vector<Link>> links;
+    };
+
+    /** The objects matching the path, and their context. */
+    struct Matches
+    {
+        std::vector<Ptr<Object>> objects;  //!< The objects.
+        std::vector<std::string> contexts; //!< The matched path of the objects.
+    };
+
+    /**
+     * Parse an array element of the path, i.e., \c *, an index,
+     * a range \c [x-y], or several of them separated by \c |.
+     *
+     * @param [in] item The array element.
+     * @param [out] ranges The ranges of indices matched.
+     */
+    static void ParseArray(std::string item,
+                           std::vector<std::pair<std::size_t, std::size_t>>& ranges);
+
+    /**
+     * Get the attributes of a TypeId, or of its parents, matching an
+     * element of the path, which lead to other objects.
+     *
+     * @param [in] element The element.
+     * @param [in] tid The TypeId.
+     * @returns The attributes.
+     */
+    static const std::vector<Link>& GetLinks(const Element& element, TypeId tid);
+
+    /**
+     * Resolve the path from an element.
+     *
+     * @param [in] i The index of the element.
+     * @param [in] root The object reached before the element, or null in
+     *                  the \c /Names namespace.
+     * @param [in] index The index to match in the first array of the path,
+     *                   or null to match the array element.
+     * @param [in,out] context The resolved path up to the element.
+     * @param [in,out] matches The objects matching the path.
+     */
+    void DoResolve(std::size_t i,
+                   Ptr<Object> root,
+                   const std::size_t* index,
+                   std::string& context,
+                   Matches& matches) const;
+    /**
+     * Resolve the path from an array element.
+     *
+     * @param [in] i The index of the array element.
+     * @param [in] root The object holding the array.
+     * @param [in] link The attribute of the array.
+     * @param [in] index The index to match, or null to match the array element.
+     * @param [in,out] context The resolved path up to the array element.
+     * @param [in,out] matches The objects matching the path.
+     */
+    void DoArrayResolve(std::size_t i,
+                        Ptr<Object> root,
+                        const Link& link,
+                        const std::size_t* index,
+                        std::string& context,
+                        Matches& matches) const;
+    /**
+     * Resolve the path from every root namespace object and from the
+     * \c /Names namespace.
+     *
+     * @param [in] index The index to match in the first array of the path,
+     *                   or null to match the array element.
+     * @returns A container of the objects matching the path.
+     */
+    MatchContainer Resolve(const std::size_t* index) const;
+
+    std::string m_path;              //!< The path.
+    std::string m_root;              //!< The path without its last element.
+    std::string m_leaf;              //!< The last element of the path.
+    std::vector<Element> m_elements; //!< The elements of the path without its last element.
+};
+
 /**
  * @ingroup config
  * @param [in] obj A new root object
@@ -259,6 +259,44 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
     }
 }
 
+void
+DefaultSimulatorImpl::ScheduleWithContextBatch(std::span<const Simulator::ContextEvent> events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+
+    if (m_mainThreadId == std::this_thread::get_id())
+    {
+        m_batch.clear();
+        for (const auto& event : events)
+        {
+            Time tAbsolute = event.delay + TimeStep(m_currentTs);
+            Scheduler::Event ev;
+            ev.impl = event.event;
+            ev.key.m_ts = static_cast<uint64_t>(tAbsolute.GetTimeStep());
+            ev.key.m_context = event.context;
+            ev.key.m_uid = m_uid;
+            m_uid++;
+            m_batch.push_back(ev);
+        }
+        m_unscheduledEvents += m_batch.size();
+        m_events->InsertBatch(m_batch);
+    }
+    else
+    {
+        std::unique_lock lock{m_eventsWithContextMutex};
+        for (const auto& event : events)
+        {
+            EventWithContext ev;
+            ev.context = event.context;
+            // Current time added in ProcessEventsWithContext()
+            ev.timestamp = event.delay.GetTimeStep();
+            ev.event = event.event;
+            m_eventsWithContext.push_back(ev);
+        }
+        m_eventsWithContextEmpty = m_eventsWithContext.empty();
+    }
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow(EventImpl* event)
 {
@@ -9,11 +9,13 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "scheduler.h"
 #include "simulator-impl.h"
 
 #include <list>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * @file
@@ -53,6 +55,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     EventId Stop(const Time& delay) override;
     EventId Schedule(const Time& delay, EventImpl* event) override;
     void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    void ScheduleWithContextBatch(std::span<const Simulator::ContextEvent> events) override;
     EventId ScheduleNow(EventImpl* event) override;
     EventId ScheduleDestroy(EventImpl* event) override;
     void Remove(const EventId& id) override;
@@ -106,6 +109,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
     bool m_stop;
     /** The event priority queue. */
     Ptr<Scheduler> m_events;
+    /** Scratch space used to insert the batches of events. */
+    std::vector<Scheduler::Event> m_batch;
 
     /** Next event unique id. */
     uint32_t m_uid;
@@ -10,6 +10,8 @@
 
 #include "log.h"
 
+#include <mutex>
+
 /**
  * @file
  * @ingroup events
@@ -21,6 +23,147 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+// Note:  Logging is avoided in the event memory pool, which can be used
+// while the logging components are not yet, or no longer, available.
+
+/**
+ * @ingroup events
+ * Unnamed namespace for the event memory pool.
+ */
+namespace
+{
+
+/** Size granularity of the memory blocks. */
+constexpr std::size_t BLOCK_GRANULARITY = 16;
+/** Number of block sizes; larger events use the system allocator. */
+constexpr std::size_t SIZE_CLASSES = 16;
+/** Number of blocks requested at once to the system allocator. */
+constexpr std::size_t BLOCKS_PER_SLAB = 64;
+/** Number of free blocks of a size above which a thread gives blocks back. */
+constexpr std::size_t MAX_FREE_BLOCKS = 4 * BLOCKS_PER_SLAB;
+
+/** A free memory block, linked in the free list of its size. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next free block.
+};
+
+/**
+ * Add statistics to a total.
+ *
+ * @param [in,out] total The total.
+ * @param [in] stats The statistics to add.
+ */
+void
+Accumulate(EventImpl::AllocationStats& total, const EventImpl::AllocationStats& stats)
+{
+    total.allocations += stats.allocations;
+    total.releases += stats.releases;
+    total.systemAllocations += stats.systemAllocations;
+}
+
+/**
+ * Free blocks and statistics shared by all the threads.
+ *
+ * It receives the blocks in excess of the threads and those of the
+ * exited threads.
+ */
+struct SharedPool
+{
+    std::mutex mutex;                 //!< Protects the members below.
+    FreeBlock* free[SIZE_CLASSES]{};  //!< Free blocks of each size.
+    EventImpl::AllocationStats stats; //!< Statistics of the exited threads.
+
+    /**
+     * Add a list of free blocks; the caller must hold the mutex.
+     *
+     * @param [in] index The block size index.
+     * @param [in] head The first block of the list.
+     * @param [in] tail The last block of the list.
+     */
+    void Push(std::size_t index, FreeBlock* head, FreeBlock* tail)
+    {
+        tail->next = free[index];
+        free[index] = head;
+    }
+
+    /**
+     * Get a free block, requesting more memory to the system allocator if
+     * needed; the caller must hold the mutex.
+     *
+     * @param [in] index The block size index.
+     * @param [in,out] stats The statistics to update.
+     * @returns The block.
+     */
+    FreeBlock* Pop(std::size_t index, EventImpl::AllocationStats& stats)
+    {
+        if (free[index] == nullptr)
+        {
+            std::size_t blockSize = (index + 1) * BLOCK_GRANULARITY;
+            auto slab = static_cast<char*>(::operator new(blockSize * BLOCKS_PER_SLAB));
+            stats.systemAllocations++;
+            for (std::size_t i = 0; i < BLOCKS_PER_SLAB; i++)
+            {
+                auto block = reinterpret_cast<FreeBlock*>(slab + i * blockSize);
+                Push(index, block, block);
+            }
+        }
+        FreeBlock* block = free[index];
+        free[index] = block->next;
+        return block;
+    }
+};
+
+/**
+ * Get the shared pool.
+ *
+ * The pool is never destroyed, since events can be released during the
+ * destruction of static objects.
+ *
+ * @returns The shared pool.
+ */
+SharedPool&
+GetSharedPool()
+{
+    static auto pool = new SharedPool;
+    return *pool;
+}
+
+/** Free blocks and statistics of a thread. */
+struct LocalPool
+{
+    FreeBlock* free[SIZE_CLASSES]{};   //!< Free blocks of each size.
+    std::size_t count[SIZE_CLASSES]{}; //!< Number of free blocks of each size.
+    EventImpl::AllocationStats stats;  //!< Statistics of the thread.
+
+    /** Destructor: hand the free blocks and the statistics over to the shared pool. */
+    ~LocalPool();
+};
+
+/** The pool of the calling thread. */
+thread_local LocalPool g_localPool;
+/** Flag set when the pool of the calling thread has been destroyed. */
+thread_local bool g_localPoolDestroyed = false;
+
+LocalPool::~LocalPool()
+{
+    SharedPool& shared = GetSharedPool();
+    std::lock_guard lock(shared.mutex);
+    for (std::size_t index = 0; index < SIZE_CLASSES; index++)
+    {
+        while (free[index] != nullptr)
+        {
+            FreeBlock* block = free[index];
+            free[index] = block->next;
+            shared.Push(index, block, block);
+        }
+    }
+    Accumulate(shared.stats, stats);
+    g_localPoolDestroyed = true;
+}
+
+} // unnamed namespace
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -56,4 +199,111 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+EventImpl::AllocationStats
+EventImpl::GetAllocationStats()
+{
+    SharedPool& shared = GetSharedPool();
+    std::lock_guard lock(shared.mutex);
+    AllocationStats stats = shared.stats;
+    if (!g_localPoolDestroyed)
+    {
+        Accumulate(stats, g_localPool.stats);
+    }
+    return stats;
+}
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t index = (size - 1) / BLOCK_GRANULARITY;
+    if (g_localPoolDestroyed)
+    {
+        SharedPool& shared = GetSharedPool();
+        std::lock_guard lock(shared.mutex);
+        shared.stats.allocations++;
+        if (index >= SIZE_CLASSES)
+        {
+            shared.stats.systemAllocations++;
+            return ::operator new(size);
+        }
+        return shared.Pop(index, shared.stats);
+    }
+
+    LocalPool& pool = g_localPool;
+    pool.stats.allocations++;
+    if (index >= SIZE_CLASSES)
+    {
+        pool.stats.systemAllocations++;
+        return ::operator new(size);
+    }
+    if (pool.free[index] == nullptr)
+    {
+        // Take a slab worth of blocks from the shared pool
+        SharedPool& shared = GetSharedPool();
+        std::lock_guard lock(shared.mutex);
+        for (std::size_t i = 0; i < BLOCKS_PER_SLAB; i++)
+        {
+            FreeBlock* block = shared.Pop(index, pool.stats);
+            block->next = pool.free[index];
+            pool.free[index] = block;
+        }
+        pool.count[index] += BLOCKS_PER_SLAB;
+    }
+    FreeBlock* block = pool.free[index];
+    pool.free[index] = block->next;
+    pool.count[index]--;
+    return block;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    std::size_t index = (size - 1) / BLOCK_GRANULARITY;
+    auto block = static_cast<FreeBlock*>(p);
+    if (g_localPoolDestroyed)
+    {
+        SharedPool& shared = GetSharedPool();
+        std::lock_guard lock(shared.mutex);
+        shared.stats.releases++;
+        if (index >= SIZE_CLASSES)
+        {
+            ::operator delete(p);
+            return;
+        }
+        shared.Push(index, block, block);
+        return;
+    }
+
+    LocalPool& pool = g_localPool;
+    pool.stats.releases++;
+    if (index >= SIZE_CLASSES)
+    {
+        ::operator delete(p);
+        return;
+    }
+    block->next = pool.free[index];
+    pool.free[index] = block;
+    pool.count[index]++;
+    if (pool.count[index] > MAX_FREE_BLOCKS)
+    {
+        // Events allocated by a thread and released by another one would
+        // otherwise accumulate in the pool of the latter
+        FreeBlock* tail = pool.free[index];
+        for (std::size_t i = 1; i < BLOCKS_PER_SLAB; i++)
+        {
+            tail = tail->next;
+        }
+        FreeBlock* excess = tail->next;
+        tail->next = nullptr;
+        for (tail = excess; tail->next != nullptr; tail = tail->next)
+        {
+        }
+        pool.count[index] = BLOCKS_PER_SLAB;
+
+        SharedPool& shared = GetSharedPool();
+        std::lock_guard lock(shared.mutex);
+        shared.Push(index, excess, tail);
+    }
+}
+
 } // namespace ns3
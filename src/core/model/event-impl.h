@@ -10,6 +10,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -30,6 +31,14 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The memory of the events is managed by a pool of fixed size blocks,
+ * so that scheduling and executing an event does not involve the
+ * system allocator in the steady state: the memory of an event is
+ * recycled for a new one once the last reference to it, including
+ * those held by EventId instances, is released.  Each thread has its
+ * own pool, so the blocks can be recycled without locking; the free
+ * blocks of a thread are handed over to the other threads when it exits.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -56,6 +65,39 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /** Statistics of the event memory pool. */
+    struct AllocationStats
+    {
+        uint64_t allocations{0};       //!< Number of events allocated.
+        uint64_t releases{0};          //!< Number of events released.
+        uint64_t systemAllocations{0}; //!< Memory requests to the system allocator.
+    };
+
+    /**
+     * Get the statistics of the event memory pool.
+     *
+     * The statistics include the events allocated by the calling thread
+     * and by the threads which have exited.
+     *
+     * @returns The event allocation statistics.
+     */
+    static AllocationStats GetAllocationStats();
+
+    /**
+     * Allocate the memory of an event from the pool.
+     *
+     * @param [in] size The size of the event.
+     * @returns The allocated memory.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return the memory of an event to the pool.
+     *
+     * @param [in] p The memory to release.
+     * @param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+
   protected:
     /**
      * Implementation for Invoke().
@@ -140,10 +140,10 @@ HeapScheduler::IsEmpty() const
 }
 
 void
-HeapScheduler::BottomUp()
+HeapScheduler::BottomUp(std::size_t start)
 {
-    NS_LOG_FUNCTION(this);
-    std::size_t index = Last();
+    NS_LOG_FUNCTION(this << start);
+    std::size_t index = start;
     while (!IsRoot(index) && IsLessStrictly(index, Parent(index)))
     {
         Exch(index, Parent(index));
@@ -191,7 +191,32 @@ HeapScheduler::Insert(const Event& ev)
 {
     NS_LOG_FUNCTION(this << &ev);
     m_heap.push_back(ev);
-    BottomUp();
+    BottomUp(Last());
+}
+
+void
+HeapScheduler::InsertBatch(std::span<const Event> events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    std::size_t first = m_heap.size();
+    m_heap.insert(m_heap.end(), events.begin(), events.end());
+    if (events.size() < first)
+    {
+        // Percolate the new items one by one, in insertion order
+        for (std::size_t index = first; index <= Last(); index++)
+        {
+            BottomUp(index);
+        }
+    }
+    else
+    {
+        // The batch is at least as large as the heap: rebuilding the
+        // whole heap bottom-up takes linear time
+        for (std::size_t index = Last() / 2; index >= Root(); index--)
+        {
+            TopDown(index);
+        }
+    }
 }
 
 Scheduler::Event
@@ -47,6 +47,7 @@ namespace ns3
  * Operation    | Amortized %Time | Reason
  * :----------- | :-------------- | :-----
  * Insert()     | Logarithmic     | Heapify
+ * InsertBatch()| Linear          | Heapify, or rebuild for large batches
  * IsEmpty()    | Constant        | Explicit queue size
  * PeekNext()   | Constant        | Heap kept sorted
  * Remove()     | Logarithmic     | Search, heapify
@@ -75,6 +76,7 @@ class HeapScheduler : public Scheduler
 
     // Inherited
     void Insert(const Scheduler::Event& ev) override;
+    void InsertBatch(std::span<const Scheduler::Event> events) override;
     bool IsEmpty() const override;
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
@@ -160,8 +162,12 @@ class HeapScheduler : public Scheduler
      * @param [in] b The second item.
      */
     inline void Exch(std::size_t a, std::size_t b);
-    /** Percolate a newly inserted Last item to its proper position. */
-    void BottomUp();
+    /**
+     * Percolate a newly inserted item up to its proper position.
+     *
+     * @param [in] start The entry of the new item.
+     */
+    void BottomUp(std::size_t start);
     /**
      * Percolate a deletion bubble down the heap.
      *
@@ -0,0 +1,272 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "log.h"
+#include "type-id.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_topStart(0),
+      m_rungs(MAX_RUNGS),
+      m_nRungs(0),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_size++;
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+    }
+    else
+    {
+        uint32_t i = 0;
+        for (; i < m_nRungs; i++)
+        {
+            Rung& rung = m_rungs[i];
+            if (ts >= rung.CurrentStart())
+            {
+                rung.buckets[(ts - rung.start) / rung.width].push_back(ev);
+                rung.size++;
+                break;
+            }
+        }
+        if (i == m_nRungs)
+        {
+            InsertInBottom(ev);
+        }
+    }
+    FillBottom();
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_size--;
+    FillBottom();
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    auto sameUid = [&ev](const Scheduler::Event& other) { return other.key == ev.key; };
+    uint64_t ts = ev.key.m_ts;
+
+    std::vector<Scheduler::Event>* container = nullptr;
+    if (ts >= m_topStart)
+    {
+        // m_topMin and m_topMax are left as they are, they only need to
+        // bound the events in the Top
+        container = &m_top;
+    }
+    else
+    {
+        for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+            Rung& rung = m_rungs[i];
+            if (ts >= rung.CurrentStart())
+            {
+                container = &rung.buckets[(ts - rung.start) / rung.width];
+                rung.size--;
+                break;
+            }
+        }
+    }
+
+    if (container != nullptr)
+    {
+        // Unsorted container: move the last event into the hole
+        auto it = std::find_if(container->begin(), container->end(), sameUid);
+        NS_ASSERT_MSG(it != container->end(), "Event not found");
+        *it = container->back();
+        container->pop_back();
+    }
+    else
+    {
+        auto it = std::lower_bound(m_bottom.begin(),
+                                   m_bottom.end(),
+                                   ev,
+                                   std::greater<Scheduler::Event>());
+        NS_ASSERT_MSG(it != m_bottom.end() && sameUid(*it), "Event not found");
+        m_bottom.erase(it);
+    }
+    m_size--;
+    FillBottom();
+}
+
+void
+LadderScheduler::SpawnRung(std::vector<Scheduler::Event>& events, uint64_t start, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << start << end);
+    NS_ASSERT(m_nRungs < MAX_RUNGS);
+    NS_ASSERT(!events.empty() && start < end);
+
+    // Size the buckets to hold one event each, on average
+    Rung& rung = m_rungs[m_nRungs];
+    m_nRungs++;
+    uint64_t span = end - start;
+    uint64_t n = events.size();
+    rung.start = start;
+    rung.width = std::max<uint64_t>(1, (span + n - 1) / n);
+    rung.current = 0;
+    rung.size = n;
+    rung.buckets.resize((span + rung.width - 1) / rung.width);
+    for (const auto& ev : events)
+    {
+        rung.buckets[(ev.key.m_ts - start) / rung.width].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::MoveToBottom(std::vector<Scheduler::Event>& events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    NS_ASSERT(m_bottom.empty());
+    std::sort(events.begin(), events.end(), std::greater<Scheduler::Event>());
+    // Swapping also hands the storage of the empty Bottom over to events
+    m_bottom.swap(events);
+}
+
+uint64_t
+LadderScheduler::GetBottomEnd() const
+{
+    if (m_nRungs == 0)
+    {
+        return m_topStart;
+    }
+    return m_rungs[m_nRungs - 1].CurrentStart();
+}
+
+void
+LadderScheduler::InsertInBottom(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.key.m_ts << ev.key.m_uid);
+    auto it =
+        std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<Scheduler::Event>());
+    m_bottom.insert(it, ev);
+
+    if (m_bottom.size() > THRESHOLD && m_nRungs < MAX_RUNGS &&
+        m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+    {
+        // The Bottom must stay small enough to make sorted insertion cheap
+        uint64_t end = GetBottomEnd();
+        SpawnRung(m_bottom, m_bottom.back().key.m_ts, end);
+    }
+}
+
+void
+LadderScheduler::FillBottom()
+{
+    while (m_bottom.empty() && m_size > 0)
+    {
+        if (m_nRungs == 0)
+        {
+            // Transfer the Top into the first rung
+            NS_ASSERT(!m_top.empty());
+            m_topStart = m_topMax + 1;
+            if (m_top.size() > THRESHOLD && m_topMin != m_topMax)
+            {
+                SpawnRung(m_top, m_topMin, m_topStart);
+            }
+            else
+            {
+                MoveToBottom(m_top);
+            }
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.size == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        uint64_t bucketStart = rung.CurrentStart();
+        rung.current++;
+        rung.size -= bucket.size();
+        if (bucket.size() > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+            SpawnRung(bucket, bucketStart, bucketStart + rung.width);
+        }
+        else
+        {
+            MoveToBottom(bucket);
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are stored in three tiers:
+ *
+ * - the \em Top, an unsorted vector receiving the events later than
+ *   any event already transferred to the lower tiers;
+ * - the \em Ladder, a stack of up to 8 rungs of buckets.  Each rung
+ *   splits the time span of a single bucket of the rung above it into
+ *   buckets small enough to hold a few events each.  Events inside a
+ *   bucket are not sorted;
+ * - the \em Bottom, a small sorted vector holding the earliest events,
+ *   from which the events are dequeued.
+ *
+ * When the Bottom becomes empty it is refilled with the first non-empty
+ * bucket of the lowest rung; a bucket with more than 50 events is split
+ * into a new rung instead.  When the Ladder is empty the whole Top is
+ * transferred into a new rung sized after the number of events and their
+ * time span.  Unlike the CalendarScheduler, the bucket width is thus
+ * derived from the actual events, and the structure never needs a full
+ * resize: this makes it robust to skewed or bimodal event distributions.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or to a bucket
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | `std::vector::back()` of the Bottom
+ * Remove()     | ~Constant       | Search within a bucket
+ * RemoveNext() | ~Constant       | Amortized sorting of the buckets
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                            | Reason
+ * :-------- | :-------------------------------- | :-----
+ * Overhead  | 8 rungs and 2 `std::vector`       | Preallocated rungs
+ * Per Event | `sizeof (Event)` + 1 bucket       | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Ladder bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;              //!< Start of the first bucket.
+        uint64_t width;              //!< Duration of a bucket.
+        uint32_t current;            //!< Index of the first bucket not yet dequeued.
+        uint32_t size;               //!< Number of events in the rung.
+        std::vector<Bucket> buckets; //!< The buckets.
+
+        /** @return The start of the current bucket. */
+        uint64_t CurrentStart() const
+        {
+            return start + current * width;
+        }
+    };
+
+    /** Maximum number of events sorted at once into the Bottom. */
+    static constexpr uint32_t THRESHOLD = 50;
+    /** Maximum number of rungs. */
+    static constexpr uint32_t MAX_RUNGS = 8;
+
+    /**
+     * Create a new rung below the existing ones and distribute events in it.
+     *
+     * @param [in,out] events The events to distribute; emptied on return.
+     * @param [in] start The earliest timestamp of the new rung.
+     * @param [in] end The end of the time span covered by the new rung.
+     */
+    void SpawnRung(std::vector<Scheduler::Event>& events, uint64_t start, uint64_t end);
+    /**
+     * Move events into the Bottom.
+     *
+     * @param [in,out] events The events to move; emptied on return.
+     */
+    void MoveToBottom(std::vector<Scheduler::Event>& events);
+    /**
+     * @return The end of the time span covered by the Bottom.
+     */
+    uint64_t GetBottomEnd() const;
+    /**
+     * Insert an event in the Bottom, splitting it into a new rung
+     * if it gets too large.
+     *
+     * @param [in] ev The event to insert.
+     */
+    void InsertInBottom(const Scheduler::Event& ev);
+    /** Refill the Bottom, if it is empty, from the Ladder or the Top. */
+    void FillBottom();
+
+    /** Unsorted events later than the Ladder. */
+    std::vector<Scheduler::Event> m_top;
+    /** Earliest timestamp in the Top. */
+    uint64_t m_topMin;
+    /** Latest timestamp in the Top. */
+    uint64_t m_topMax;
+    /** Events not earlier than this timestamp go into the Top. */
+    uint64_t m_topStart;
+    /** The rungs; only the first \c m_nRungs are in use. */
+    std::vector<Rung> m_rungs;
+    /** Number of rungs in use. */
+    uint32_t m_nRungs;
+    /** Earliest events, sorted in decreasing order. */
+    std::vector<Scheduler::Event> m_bottom;
+    /** Number of events in queue. */
+    uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
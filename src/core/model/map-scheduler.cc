@@ -12,6 +12,9 @@
 #include "assert.h"
 #include "log.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <string>
 
 /**
@@ -56,6 +59,29 @@ MapScheduler::Insert(const Event& ev)
     NS_ASSERT(result.second);
 }
 
+void
+MapScheduler::InsertBatch(std::span<const Event> events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    if (!std::is_sorted(events.begin(), events.end()))
+    {
+        Scheduler::InsertBatch(events);
+        return;
+    }
+    // The events of a sorted batch are usually adjacent in the map, e.g.
+    // when they share a timestamp: each one is then inserted in constant
+    // time right after the previous one
+    EventMapI hint = m_list.end();
+    for (const auto& ev : events)
+    {
+        if (hint != m_list.end() && !(ev.key < hint->first))
+        {
+            hint = m_list.upper_bound(ev.key);
+        }
+        hint = std::next(m_list.emplace_hint(hint, ev.key, ev.impl));
+    }
+}
+
 bool
 MapScheduler::IsEmpty() const
 {
@@ -36,6 +36,7 @@ namespace ns3
  * Operation    | Amortized %Time | Reason
  * :----------- | :-------------- | :-----
  * Insert()     | Logarithmic     | `std::map::insert()`
+ * InsertBatch()| ~Constant       | `std::map::emplace_hint()` for sorted batches
  * IsEmpty()    | Constant        | `std::map::empty()`
  * PeekNext()   | Constant        | `std::map::begin()`
  * Remove()     | Logarithmic     | `std::map::find()`
@@ -65,6 +66,7 @@ class MapScheduler : public Scheduler
 
     // Inherited
     void Insert(const Scheduler::Event& ev) override;
+    void InsertBatch(std::span<const Scheduler::Event> events) override;
     bool IsEmpty() const override;
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
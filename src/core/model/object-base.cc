@@ -12,6 +12,7 @@
 #include "environment-variable.h"
 #include "fatal-error.h"
 #include "log.h"
+#include "object.h"
 #include "string.h"
 #include "trace-source-accessor.h"
 
@@ -79,14 +80,12 @@ ObjectBase::NotifyConstructionCompleted()
 void
 ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
 {
-    // loop over the inheritance tree back to the Object base class.
     NS_LOG_FUNCTION(this << &attributes);
     TypeId tid = GetInstanceTypeId();
-    TypeId objectTid;
     // the TypeId of a class derived from Object is initialized to "ns3::Object"; for a class
     // deriving from Object, check that this function is called after that the correct TypeId is set
     // to ensure that the attributes of the class are initialized
-    NS_ABORT_MSG_IF(TypeId::LookupByNameFailSafe("ns3::Object", &objectTid) && tid == objectTid,
+    NS_ABORT_MSG_IF(tid == Object::GetTypeId(),
                     "ObjectBase::ConstructSelf() has been called on an object of a class derived "
                     "from the Object class, but the TypeId is still set to ns3::Object.\n"
                     "This is known to happen in two cases:\n"
@@ -95,100 +94,104 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
                     "initial values of the object attributes as soon as object construction is "
                     "completed (see issue #1249)\n"
                     "- the class deriving from Object does not define a static GetTypeId() method");
-    do // Do this tid and all parents
+    // loop over the attributes of this tid and of all its parents, which are listed once per tid
+    auto inheritedAttributes = tid.GetInheritedAttributes();
+    auto environment = EnvironmentVariable::GetDictionary("NS_ATTRIBUTE_DEFAULT");
+    NS_LOG_DEBUG("construct tid=" << tid.GetName() << ", params=" << inheritedAttributes->size());
+    for (const auto& attribute : *inheritedAttributes)
     {
-        // loop over all attributes in object type
-        NS_LOG_DEBUG("construct tid=" << tid.GetName() << ", params=" << tid.GetAttributeN());
-        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
-        {
-            TypeId::AttributeInformation info = tid.GetAttribute(i);
-            NS_LOG_DEBUG("try to construct \"" << tid.GetName() << "::" << info.name << "\"");
-            // is this attribute stored in this AttributeConstructionList instance ?
-            Ptr<const AttributeValue> value = attributes.Find(info.checker);
-            std::string where = "argument";
-
-            // See if this attribute should not be set here in the
-            // constructor.
-            if (!(info.flags & TypeId::ATTR_CONSTRUCT))
-            {
-                // Handle this attribute if it should not be
-                // set here.
-                if (!value)
-                {
-                    // Skip this attribute if it's not in the
-                    // AttributeConstructionList.
-                    NS_LOG_DEBUG("skipping, not settable at construction");
-                    continue;
-                }
-                else
-                {
-                    // This is an error because this attribute is not
-                    // settable in its constructor but is present in
-                    // the AttributeConstructionList.
-                    NS_FATAL_ERROR("Attribute name="
-                                   << info.name << " tid=" << tid.GetName()
-                                   << ": initial value cannot be set using attributes");
-                }
-            }
+        const TypeId::AttributeInformation& info = attribute.info;
+        NS_LOG_DEBUG("try to construct \"" << attribute.fullName << "\"");
+        // is this attribute stored in this AttributeConstructionList instance ?
+        Ptr<const AttributeValue> value = attributes.Find(info.checker);
+        std::string where = "argument";
 
+        // See if this attribute should not be set here in the
+        // constructor.
+        if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+        {
+            // Handle this attribute if it should not be
+            // set here.
             if (!value)
             {
-                NS_LOG_DEBUG("trying to set from environment variable NS_ATTRIBUTE_DEFAULT");
-                auto [found, val] =
-                    EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT", tid.GetAttributeFullName(i));
-                if (found)
-                {
-                    NS_LOG_DEBUG("found in environment: " << val);
-                    value = Create<StringValue>(val);
-                    where = "env var";
-                }
+                // Skip this attribute if it's not in the
+                // AttributeConstructionList.
+                NS_LOG_DEBUG("skipping, not settable at construction");
+                continue;
             }
-
-            bool initial{false};
-            if (!value)
+            else
             {
-                // This is guaranteed to exist
-                NS_LOG_DEBUG("falling back to initial value from tid");
-                value = info.initialValue;
-                where = "initial value";
-                initial = true;
+                // This is an error because this attribute is not
+                // settable in its constructor but is present in
+                // the AttributeConstructionList.
+                NS_FATAL_ERROR("Attribute " << attribute.fullName
+                                            << ": initial value cannot be set using attributes");
             }
+        }
 
-            // We have a matching attribute value, if only from the initialValue
-            if (DoSet(info.accessor, info.checker, *value) || initial)
+        if (!value)
+        {
+            NS_LOG_DEBUG("trying to set from environment variable NS_ATTRIBUTE_DEFAULT");
+            auto [found, val] = environment->Get(attribute.fullName);
+            if (found)
             {
-                // Setting from initial value may fail, e.g. setting
-                // ObjectVectorValue from ""
-                // That's ok, so we still report success since construction is complete
-                NS_LOG_DEBUG("construct \"" << tid.GetName() << "::" << info.name << "\" from "
-                                            << where);
+                NS_LOG_DEBUG("found in environment: " << val);
+                value = Create<StringValue>(val);
+                where = "env var";
             }
-            else
-            {
-                /*
-                  One would think this is an error...
+        }
 
-                  but there are cases where `attributes.Find(info.checker)`
-                  returns a non-null value which still fails the `DoSet()` call.
-                  For example, `value` is sometimes a real `PointerValue`
-                  containing 0 as the pointed-to address.  Since value
-                  is not null (it just contains null) the initial
-                  value is not used, the DoSet fails, and we end up
-                  here.
+        if (!value && attribute.isInitialValueValid)
+        {
+            // The checker accepts the initial value, which can be set
+            // without being copied into a valid value first
+            NS_LOG_DEBUG("construct \"" << attribute.fullName << "\" from initial value");
+            info.accessor->Set(this, *info.initialValue);
+            continue;
+        }
 
-                  If we were adventurous we might try to fix this deep
-                  below DoSet, but there be dragons.
-                */
-                /*
-                NS_ASSERT_MSG(false,
-                              "Failed to set attribute '" << info.name << "' from '"
-                                                          << value->SerializeToString(info.checker)
-                                                          << "'");
-                */
-            }
+        bool initial{false};
+        if (!value)
+        {
+            // This is guaranteed to exist
+            NS_LOG_DEBUG("falling back to initial value from tid");
+            value = info.initialValue;
+            where = "initial value";
+            initial = true;
+        }
+
+        // We have a matching attribute value, if only from the initialValue
+        if (DoSet(info.accessor, info.checker, *value) || initial)
+        {
+            // Setting from initial value may fail, e.g. setting
+            // ObjectVectorValue from ""
+            // That's ok, so we still report success since construction is complete
+            NS_LOG_DEBUG("construct \"" << attribute.fullName << "\" from " << where);
+        }
+        else
+        {
+            /*
+              One would think this is an error...
+
+              but there are cases where `attributes.Find(info.checker)`
+              returns a non-null value which still fails the `DoSet()` call.
+              For example, `value` is sometimes a real `PointerValue`
+              containing 0 as the pointed-to address.  Since value
+              is not null (it just contains null) the initial
+              value is not used, the DoSet fails, and we end up
+              here.
+
+              If we were adventurous we might try to fix this deep
+              below DoSet, but there be dragons.
+            */
+            /*
+            NS_ASSERT_MSG(false,
+                          "Failed to set attribute '" << info.name << "' from '"
+                                                      << value->SerializeToString(info.checker)
+                                                      << "'");
+            */
         }
-        tid = tid.GetParent();
-    } while (tid != ObjectBase::GetTypeId());
+    }
     NotifyConstructionCompleted();
 }
 
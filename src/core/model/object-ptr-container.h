@@ -28,6 +28,11 @@
 namespace ns3
 {
 
+namespace Config
+{
+class CompiledPath;
+} // namespace Config
+
 /**
  * @ingroup attribute_ObjectPtrContainer
  *
@@ -246,6 +251,9 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasSetter() const override;
 
   private:
+    /** Config::CompiledPath::DoArrayResolve() gets a single instance. */
+    friend class Config::CompiledPath;
+
     /**
      * Get the number of instances in the container.
      *
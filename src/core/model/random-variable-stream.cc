@@ -25,6 +25,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <mutex>
 #include <numbers>
 
 /**
@@ -65,17 +66,103 @@ RandomVariableStream::GetTypeId()
     return tid;
 }
 
+/**
+ * @ingroup randomvariable
+ * Unnamed namespace for the list of the random variable streams.
+ */
+namespace
+{
+
+/**
+ * The first of the existing random variable streams, which are linked
+ * through their m_nextStream and m_prevStream members.
+ */
+RandomVariableStream* g_streams = nullptr;
+
+#ifdef NS3_MTP
+/**
+ * Get the mutex protecting the list of the random variable streams,
+ * which may be created by several partitions at the same time.
+ *
+ * The mutex is never destroyed, since streams can be destroyed during
+ * the destruction of static objects.
+ *
+ * @returns The mutex.
+ */
+std::mutex&
+GetStreamsMutex()
+{
+    static auto mutex = new std::mutex;
+    return *mutex;
+}
+#endif
+
+} // unnamed namespace
+
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_streamIndex(0),
+      m_prevStream(nullptr)
 {
     NS_LOG_FUNCTION(this);
+#ifdef NS3_MTP
+    std::lock_guard lock(GetStreamsMutex());
+#endif
+    m_nextStream = g_streams;
+    if (m_nextStream != nullptr)
+    {
+        m_nextStream->m_prevStream = this;
+    }
+    g_streams = this;
 }
 
 RandomVariableStream::~RandomVariableStream()
 {
+    {
+#ifdef NS3_MTP
+        std::lock_guard lock(GetStreamsMutex());
+#endif
+        if (m_prevStream != nullptr)
+        {
+            m_prevStream->m_nextStream = m_nextStream;
+        }
+        else
+        {
+            g_streams = m_nextStream;
+        }
+        if (m_nextStream != nullptr)
+        {
+            m_nextStream->m_prevStream = m_prevStream;
+        }
+    }
     delete m_rng;
 }
 
+void
+RandomVariableStream::ResetAllStreams()
+{
+    NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_MTP
+    std::lock_guard lock(GetStreamsMutex());
+#endif
+    for (auto stream = g_streams; stream != nullptr; stream = stream->m_nextStream)
+    {
+        if (stream->m_rng != nullptr)
+        {
+            delete stream->m_rng;
+            stream->m_rng = new RngStream(RngSeedManager::GetSeed(),
+                                          stream->m_streamIndex,
+                                          RngSeedManager::GetRun());
+        }
+        stream->DoReset();
+    }
+}
+
+void
+RandomVariableStream::DoReset()
+{
+}
+
 void
 RandomVariableStream::SetAntithetic(bool isAntithetic)
 {
@@ -112,7 +199,7 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " automatic stream: " << nextStream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_streamIndex = nextStream;
     }
     else
     {
@@ -121,8 +208,9 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " configured stream: " << stream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_streamIndex = target;
     }
+    m_rng = new RngStream(RngSeedManager::GetSeed(), m_streamIndex, RngSeedManager::GetRun());
     m_stream = stream;
 }
 
@@ -686,6 +774,12 @@ NormalRandomVariable::NormalRandomVariable()
     NS_LOG_FUNCTION(this);
 }
 
+void
+NormalRandomVariable::DoReset()
+{
+    m_nextValid = false;
+}
+
 void
 NormalRandomVariable::SetStdDev(double stdDev)
 {
@@ -820,6 +914,12 @@ LogNormalRandomVariable::LogNormalRandomVariable()
     NS_LOG_FUNCTION(this);
 }
 
+void
+LogNormalRandomVariable::DoReset()
+{
+    m_nextValid = false;
+}
+
 double
 LogNormalRandomVariable::GetMu() const
 {
@@ -941,6 +1041,12 @@ GammaRandomVariable::GammaRandomVariable()
     NS_LOG_FUNCTION(this);
 }
 
+void
+GammaRandomVariable::DoReset()
+{
+    m_nextValid = false;
+}
+
 double
 GammaRandomVariable::GetAlpha() const
 {
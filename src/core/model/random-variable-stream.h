@@ -144,6 +144,19 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * @brief Restart the generators of all the existing streams.
+     *
+     * The generator of each stream is restarted from the current seed
+     * and run number, keeping its stream number, and the values cached by
+     * the stream are discarded, as if the stream had just been created.
+     * This gives different random values to the replications forked from
+     * the same simulation setup.
+     *
+     * @see ReplicationRunner
+     */
+    static void ResetAllStreams();
+
   protected:
     /**
      * @brief Get the pointer to the underlying RngStream.
@@ -151,6 +164,15 @@ class RandomVariableStream : public Object
      */
     RngStream* Peek() const;
 
+    /**
+     * @brief Discard the values drawn in advance from the RngStream.
+     *
+     * Called by ResetAllStreams() once the RngStream is restarted.  The
+     * distributions which draw several values at a time must override
+     * it to forget the values they keep for the next calls.
+     */
+    virtual void DoReset();
+
   private:
     /** Pointer to the underlying RngStream. */
     RngStream* m_rng;
@@ -161,6 +183,15 @@ class RandomVariableStream : public Object
     /** The stream number for the RngStream. */
     int64_t m_stream;
 
+    /** The index of the RngStream, derived from the stream number. */
+    uint64_t m_streamIndex;
+
+    /** The previous stream in the list of the existing streams. */
+    RandomVariableStream* m_prevStream;
+
+    /** The next stream in the list of the existing streams. */
+    RandomVariableStream* m_nextStream;
+
     // end of class RandomVariableStream
 };
 
@@ -1045,6 +1076,9 @@ class NormalRandomVariable : public RandomVariableStream
     using RandomVariableStream::GetInteger;
 
   private:
+    // Inherited
+    void DoReset() override;
+
     /** The mean value for the normal distribution returned by this RNG stream. */
     double m_mean;
 
@@ -1197,6 +1231,9 @@ class LogNormalRandomVariable : public RandomVariableStream
     using RandomVariableStream::GetInteger;
 
   private:
+    // Inherited
+    void DoReset() override;
+
     /** The mu value for the log-normal distribution returned by this RNG stream. */
     double m_mu;
 
@@ -1311,6 +1348,9 @@ class GammaRandomVariable : public RandomVariableStream
     using RandomVariableStream::GetInteger;
 
   private:
+    // Inherited
+    void DoReset() override;
+
     /**
      * @brief Returns a random double from a normal distribution with the specified mean, variance,
      * and bound.
@@ -0,0 +1,325 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "replication-runner.h"
+
+#include "fatal-error.h"
+#include "log.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+#ifndef __WIN32__
+#include <cerrno>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::ReplicationRunner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationRunner");
+
+#ifndef __WIN32__
+/**
+ * @ingroup core
+ * Unnamed namespace for the replication process helpers.
+ */
+namespace
+{
+
+/**
+ * Serialize the results of a replication.
+ *
+ * Each result is written as the size of its name, its name and its value.
+ *
+ * @param [in] results The results.
+ * @returns The serialized results.
+ */
+std::string
+SerializeResults(const ReplicationRunner::Results& results)
+{
+    std::string data;
+    for (const auto& [name, value] : results)
+    {
+        auto size = static_cast<uint32_t>(name.size());
+        data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        data.append(name);
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    return data;
+}
+
+/**
+ * Deserialize the results of a replication.
+ *
+ * @param [in] data The serialized results.
+ * @param [out] results The results.
+ * @returns True if \pname{data} holds complete results.
+ */
+bool
+DeserializeResults(const std::string& data, ReplicationRunner::Results& results)
+{
+    std::size_t offset = 0;
+    while (offset < data.size())
+    {
+        uint32_t size;
+        double value;
+        if (data.size() - offset < sizeof(size))
+        {
+            return false;
+        }
+        std::memcpy(&size, data.data() + offset, sizeof(size));
+        offset += sizeof(size);
+        if (data.size() - offset < size + sizeof(value))
+        {
+            return false;
+        }
+        std::string name = data.substr(offset, size);
+        offset += size;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        results[name] = value;
+    }
+    return true;
+}
+
+/**
+ * Run a replication in the forked process, and exit.
+ *
+ * @param [in] index The index of the replication.
+ * @param [in] run The run number of the replication.
+ * @param [in] prepare The callback preparing the replication.
+ * @param [in] collector The callback storing the results of the replication.
+ * @param [in] fd The file descriptor to write the results to.
+ */
+[[noreturn]] void
+RunReplication(uint32_t index,
+               uint64_t run,
+               const std::function<void(uint32_t)>& prepare,
+               const ReplicationRunner::Collector& collector,
+               int fd)
+{
+    int status = 1;
+    try
+    {
+        prepare(index);
+        Simulator::Run();
+        ReplicationRunner::Results results;
+        collector(run, results);
+        std::string data = SerializeResults(results);
+        std::size_t written = 0;
+        while (written < data.size())
+        {
+            ssize_t n = write(fd, data.data() + written, data.size() - written);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                break;
+            }
+            written += n;
+        }
+        status = written == data.size() ? 0 : 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Replication " << index << " (run " << run << ") failed: " << e.what()
+                  << std::endl;
+    }
+    close(fd);
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    // Skip the static destructors and exit handlers, which belong
+    // to the calling process
+    _exit(status);
+}
+
+} // unnamed namespace
+#endif /* __WIN32__ */
+
+ReplicationRunner::ReplicationRunner()
+    : m_maxProcesses(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ReplicationRunner::SetMaxProcesses(uint32_t processes)
+{
+    NS_LOG_FUNCTION(this << processes);
+    m_maxProcesses = processes;
+}
+
+uint32_t
+ReplicationRunner::GetMaxProcesses() const
+{
+    if (m_maxProcesses != 0)
+    {
+        return m_maxProcesses;
+    }
+    return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+std::vector<ReplicationRunner::Replication>
+ReplicationRunner::Run(uint64_t firstRun, uint32_t count, Collector collector) const
+{
+    NS_LOG_FUNCTION(this << firstRun << count);
+    std::vector<Replication> replications(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        replications[i].run = firstRun + i;
+        replications[i].completed = false;
+    }
+    Fork(
+        replications,
+        [&replications](uint32_t index) {
+            RngSeedManager::SetRun(replications[index].run);
+            RandomVariableStream::ResetAllStreams();
+        },
+        collector);
+    return replications;
+}
+
+std::vector<ReplicationRunner::Replication>
+ReplicationRunner::RunBranches(uint32_t count, Setup setup, Collector collector) const
+{
+    NS_LOG_FUNCTION(this << count);
+    std::vector<Replication> branches(count);
+    for (auto& branch : branches)
+    {
+        branch.run = RngSeedManager::GetRun();
+        branch.completed = false;
+    }
+    Fork(branches, setup, collector);
+    return branches;
+}
+
+void
+ReplicationRunner::Fork(std::vector<Replication>& replications,
+                        const std::function<void(uint32_t)>& prepare,
+                        const Collector& collector) const
+{
+    NS_LOG_FUNCTION(this << replications.size());
+    const auto count = static_cast<uint32_t>(replications.size());
+
+#ifdef __WIN32__
+    NS_FATAL_ERROR("ReplicationRunner is not available on Windows");
+#else
+    // Do not let the replications write the pending output of this process
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    /// A running replication
+    struct Child
+    {
+        pid_t pid;        //!< The replication process.
+        int fd;           //!< The file descriptor to read its results from.
+        uint32_t index;   //!< The index of the replication.
+        std::string data; //!< The serialized results read so far.
+    };
+
+    std::vector<Child> children;
+    const uint32_t maxProcesses = GetMaxProcesses();
+    uint32_t next = 0;
+    while (next < count || !children.empty())
+    {
+        while (next < count && children.size() < maxProcesses)
+        {
+            int fds[2];
+            if (pipe(fds) != 0)
+            {
+                NS_FATAL_ERROR("Cannot create a pipe: " << std::strerror(errno));
+            }
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                NS_FATAL_ERROR("Cannot fork a replication: " << std::strerror(errno));
+            }
+            if (pid == 0)
+            {
+                close(fds[0]);
+                RunReplication(next, replications[next].run, prepare, collector, fds[1]);
+            }
+            close(fds[1]);
+            NS_LOG_INFO("Replication " << next << " (run " << replications[next].run
+                                       << ") in process " << pid);
+            children.push_back({pid, fds[0], next, {}});
+            next++;
+        }
+
+        std::vector<pollfd> polled(children.size());
+        for (std::size_t i = 0; i < children.size(); i++)
+        {
+            polled[i].fd = children[i].fd;
+            polled[i].events = POLLIN;
+            polled[i].revents = 0;
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            NS_FATAL_ERROR("Cannot wait for the replications: " << std::strerror(errno));
+        }
+        for (std::size_t i = children.size(); i-- > 0;)
+        {
+            if (polled[i].revents == 0)
+            {
+                continue;
+            }
+            Child& child = children[i];
+            char buffer[4096];
+            ssize_t n = read(child.fd, buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                child.data.append(buffer, n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            // The replication closed its end of the pipe: it is over
+            close(child.fd);
+            int status = 0;
+            while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR)
+            {
+            }
+            Replication& replication = replications[child.index];
+            replication.completed = WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+                                    DeserializeResults(child.data, replication.results);
+            if (!replication.completed)
+            {
+                replication.results.clear();
+                NS_LOG_WARN("Replication " << child.index << " (run " << replication.run
+                                           << ") failed");
+            }
+            NS_LOG_INFO("Replication " << child.index << " done");
+            children.erase(children.begin() + i);
+        }
+    }
+#endif /* __WIN32__ */
+}
+
+} // namespace ns3
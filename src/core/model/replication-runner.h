@@ -0,0 +1,185 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <functional>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core
+ * ns3::ReplicationRunner declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup core
+ * @brief Run independent replications, or branches, of a simulation set
+ * up once.
+ *
+ * Running many replications of a scenario, each with its own
+ * RngSeedManager run number, usually means starting a new process per
+ * replication which parses its arguments and builds the scenario again.
+ * A ReplicationRunner instead forks the calling process once the
+ * scenario has been built, just before Simulator::Run(): each
+ * replication process starts from a copy of the objects, attributes and
+ * scheduled events of the setup, and only pays for its simulation.
+ *
+ * In each replication process, the runner
+ *   1. sets the run number of the replication with RngSeedManager::SetRun(),
+ *   2. restarts the generators of the existing random variables with
+ *      RandomVariableStream::ResetAllStreams(),
+ *   3. calls Simulator::Run(),
+ *   4. calls the collector callback, which stores the results of the
+ *      replication as named scalar values,
+ *   5. sends the results to the calling process and exits.
+ *
+ * Up to GetMaxProcesses() replications run at the same time.  The calling
+ * process does not run its simulation: it can start another set of
+ * replications, or call Simulator::Destroy().
+ *
+ * \code
+ *   // build the scenario, then
+ *   ReplicationRunner runner;
+ *   auto replications = runner.Run(1, 100, [&](uint64_t run, ReplicationRunner::Results& r) {
+ *       r["rxBytes"] = sink->GetTotalRx();
+ *   });
+ *   Simulator::Destroy();
+ * \endcode
+ *
+ * The random values drawn while building the scenario, for example random
+ * node positions, are shared by all the replications: only the values
+ * drawn during the simulation depend on the run number.  A scenario whose
+ * setup must vary between replications has to be built by each process.
+ *
+ * The same mechanism branches a simulation from a checkpoint: once the
+ * calling process has simulated a warm-up period, RunBranches() forks one
+ * process per parameter variant.  Each branch resumes the simulation from
+ * the state reached at the end of the warm-up, i.e., the pending events,
+ * the objects and the state of the random variables, after the setup
+ * callback has applied its parameters:
+ *
+ * \code
+ *   // build the scenario, then simulate the warm-up period once
+ *   Simulator::Stop(Seconds(60));
+ *   Simulator::Run();
+ *   // measure each variant over the next 30 s
+ *   Simulator::Stop(Seconds(30));
+ *   auto branches = runner.RunBranches(
+ *       rates.size(),
+ *       [&](uint32_t branch) { Config::Set("/NodeList/0/ApplicationList/0/DataRate",
+ *                                          DataRateValue(rates[branch])); },
+ *       [&](uint64_t run, ReplicationRunner::Results& r) { r["rxBytes"] = sink->GetTotalRx(); });
+ *   Simulator::Destroy();
+ * \endcode
+ *
+ * The branches keep the run number of the calling process and the state
+ * of its random variables, so that they compare their variants with common
+ * random numbers.  A setup callback can give its branch independent random
+ * values by changing the run number and calling
+ * RandomVariableStream::ResetAllStreams().
+ *
+ * Replications are processes, rather than threads, because the simulator
+ * and much of the model state are global.  This class is therefore not
+ * available on Windows.
+ */
+class ReplicationRunner
+{
+  public:
+    /** Results of a replication: scalar values by name. */
+    using Results = std::map<std::string, double>;
+
+    /**
+     * Callback storing the results of a replication, called in the
+     * replication process at the end of its simulation.
+     *
+     * @param [in] run The run number of the replication.
+     * @param [out] results The results of the replication.
+     */
+    using Collector = std::function<void(uint64_t run, Results& results)>;
+
+    /**
+     * Callback applying the parameters of a branch, called in the branch
+     * process before it resumes the simulation.
+     *
+     * @param [in] branch The index of the branch.
+     */
+    using Setup = std::function<void(uint32_t branch)>;
+
+    /** Outcome of a replication. */
+    struct Replication
+    {
+        uint64_t run;    //!< The run number of the replication.
+        bool completed;  //!< Whether the replication process exited normally.
+        Results results; //!< The results of the replication.
+    };
+
+    /** Constructor. */
+    ReplicationRunner();
+
+    /**
+     * Set the maximum number of replications running at the same time.
+     *
+     * @param [in] processes The number of replications, or zero for the
+     *             number of hardware threads.
+     */
+    void SetMaxProcesses(uint32_t processes);
+    /**
+     * Get the maximum number of replications running at the same time.
+     *
+     * @returns The number of replications.
+     */
+    uint32_t GetMaxProcesses() const;
+
+    /**
+     * Run replications of the simulation set up by the calling process.
+     *
+     * @param [in] firstRun The run number of the first replication.
+     * @param [in] count The number of replications, whose run numbers
+     *             follow \pname{firstRun}.
+     * @param [in] collector The callback storing the results of a replication.
+     * @returns The outcome of the replications, by increasing run number.
+     */
+    std::vector<Replication> Run(uint64_t firstRun, uint32_t count, Collector collector) const;
+
+    /**
+     * Run branches of the simulation from its current state.
+     *
+     * Each branch calls \pname{setup}, then Simulator::Run() to resume the
+     * simulation, and \pname{collector}.
+     *
+     * @param [in] count The number of branches.
+     * @param [in] setup The callback applying the parameters of a branch.
+     * @param [in] collector The callback storing the results of a branch.
+     * @returns The outcome of the branches, by increasing branch index.
+     *          Their run number is the one of the calling process.
+     */
+    std::vector<Replication> RunBranches(uint32_t count, Setup setup, Collector collector) const;
+
+  private:
+    /**
+     * Run the simulation in a forked process per replication.
+     *
+     * @param [in,out] replications The replications to run.
+     * @param [in] prepare The callback preparing a replication process
+     *             before its simulation, with the index of the replication.
+     * @param [in] collector The callback storing the results of a replication.
+     */
+    void Fork(std::vector<Replication>& replications,
+              const std::function<void(uint32_t)>& prepare,
+              const Collector& collector) const;
+
+    uint32_t m_maxProcesses; //!< Maximum number of replications running at the same time.
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
@@ -35,4 +35,14 @@ Scheduler::GetTypeId()
     return tid;
 }
 
+void
+Scheduler::InsertBatch(std::span<const Event> events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    for (const auto& ev : events)
+    {
+        Insert(ev);
+    }
+}
+
 } // namespace ns3
@@ -11,6 +11,7 @@
 
 #include "object.h"
 
+#include <span>
 #include <stdint.h>
 
 /**
@@ -100,6 +101,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderScheduler </td>
+ *      <td class="markdownTableBodyLeft"> Rungs of `std::vector` buckets </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> 8 rungs </td>
+ *      <td class="markdownTableBodyLeft"> 24 bytes </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
@@ -184,6 +193,16 @@ class Scheduler : public Object
      * @param [in] ev Event to store in the event list
      */
     virtual void Insert(const Event& ev) = 0;
+    /**
+     * Insert a batch of new Events in the schedule.
+     *
+     * The default implementation inserts the events one at a time;
+     * subclasses override it when they can share the insertion work
+     * among the events of the batch.
+     *
+     * @param [in] events Events to store in the event list
+     */
+    virtual void InsertBatch(std::span<const Event> events);
     /**
      * Test if the schedule is empty.
      *
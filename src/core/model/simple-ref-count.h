@@ -16,6 +16,10 @@
 #include <limits>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * @file
  * @ingroup ptr
@@ -120,8 +124,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -144,9 +147,15 @@ class SimpleRefCount : public PARENT
      *
      * @internal
      * Note we make this mutable so that the const methods can still
-     * change it.
+     * change it. When multithreaded simulation is enabled, objects
+     * may be shared between partitions running in different threads,
+     * so the count is made atomic.
      */
+#ifdef NS3_MTP
+    mutable std::atomic<uint32_t> m_count;
+#else
     mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
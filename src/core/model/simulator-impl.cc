@@ -29,4 +29,20 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+void
+SimulatorImpl::ScheduleWithContextBatch(std::span<const Simulator::ContextEvent> events)
+{
+    NS_LOG_FUNCTION(this << events.size());
+    for (const auto& ev : events)
+    {
+        ScheduleWithContext(ev.context, ev.delay, ev.event);
+    }
+}
+
+EventImpl::AllocationStats
+SimulatorImpl::GetEventAllocationStats() const
+{
+    return EventImpl::GetAllocationStats();
+}
+
 } // namespace ns3
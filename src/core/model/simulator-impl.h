@@ -15,6 +15,9 @@
 #include "object-factory.h"
 #include "object.h"
 #include "ptr.h"
+#include "simulator.h"
+
+#include <span>
 
 /**
  * @file
@@ -55,6 +58,12 @@ class SimulatorImpl : public Object
     virtual EventId Schedule(const Time& delay, EventImpl* event) = 0;
     /** @copydoc Simulator::ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
     virtual void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) = 0;
+    /**
+     * @copydoc Simulator::ScheduleWithContextBatch
+     *
+     * The default implementation calls ScheduleWithContext() on each event.
+     */
+    virtual void ScheduleWithContextBatch(std::span<const Simulator::ContextEvent> events);
     /** @copydoc Simulator::ScheduleNow(const Ptr<EventImpl>&) */
     virtual EventId ScheduleNow(EventImpl* event) = 0;
     /** @copydoc Simulator::ScheduleDestroy(const Ptr<EventImpl>&) */
@@ -89,6 +98,8 @@ class SimulatorImpl : public Object
     virtual uint32_t GetContext() const = 0;
     /** @copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
+    /** @copydoc Simulator::GetEventAllocationStats */
+    virtual EventImpl::AllocationStats GetEventAllocationStats() const;
 
     /**
      * Hook called before processing each event.
@@ -224,6 +224,18 @@ Simulator::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* i
     return GetImpl()->ScheduleWithContext(context, delay, impl);
 }
 
+void
+Simulator::ScheduleWithContextBatch(std::span<const ContextEvent> events)
+{
+#ifdef ENABLE_DES_METRICS
+    for (const auto& ev : events)
+    {
+        DesMetrics::Get()->TraceWithContext(ev.context, Now(), ev.delay);
+    }
+#endif
+    GetImpl()->ScheduleWithContextBatch(events);
+}
+
 EventId
 Simulator::ScheduleDestroy(const Ptr<EventImpl>& ev)
 {
@@ -309,6 +321,12 @@ Simulator::GetEventCount()
     return GetImpl()->GetEventCount();
 }
 
+EventImpl::AllocationStats
+Simulator::GetEventAllocationStats()
+{
+    return GetImpl()->GetEventAllocationStats();
+}
+
 uint32_t
 Simulator::GetSystemId()
 {
@@ -15,6 +15,7 @@
 #include "nstime.h"
 #include "object-factory.h"
 
+#include <span>
 #include <stdint.h>
 #include <string>
 
@@ -213,6 +214,18 @@ class Simulator
      */
     static uint64_t GetEventCount();
 
+    /**
+     * Get the statistics of the event memory pool.
+     *
+     * The events are allocated from a pool which recycles the memory of
+     * the executed and cancelled events: in the steady state, the number
+     * of memory requests to the system allocator should not grow with
+     * the number of events.
+     *
+     * @returns The event allocation statistics.
+     */
+    static EventImpl::AllocationStats GetEventAllocationStats();
+
     /**
      * @name Schedule events (in the same context) to run at a future time.
      */
@@ -487,6 +500,28 @@ class Simulator
      */
     static void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event);
 
+    /** An event to schedule with ScheduleWithContextBatch(). */
+    struct ContextEvent
+    {
+        uint32_t context; //!< Event context.
+        Time delay;       //!< Delay until the event expires.
+        EventImpl* event; //!< The event to schedule.
+    };
+
+    /**
+     * Schedule a batch of future events, each one in its own context.
+     *
+     * This is equivalent to calling ScheduleWithContext() on each event
+     * of the batch, in order, but lets the event scheduler share the
+     * insertion work among the events, e.g. when a channel delivers a
+     * transmission to many receivers.
+     * This method is thread-safe: it can be called from any thread.
+     *
+     * @param [in] events The events to schedule.
+     * @hidecaller
+     */
+    static void ScheduleWithContextBatch(std::span<const ContextEvent> events);
+
     /**
      * Schedule an event to run at the end of the simulation, after
      * the Stop() time or condition has been reached.
@@ -11,7 +11,9 @@
 
 #include "callback.h"
 
+#include <algorithm>
 #include <list>
+#include <vector>
 
 /**
  * @file
@@ -36,6 +38,14 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The chain is stored contiguously, and invoking a TracedCallback
+ * without any Callback connected costs a single test.  When ns-3 is
+ * configured with the trace sources disabled (\c NS3_TRACE_SOURCES
+ * set to \c OFF, which defines \c NS3_TRACE_SOURCES_DISABLE), the
+ * Callbacks connected are dropped, IsEmpty() is a constant true and
+ * invoking the chain returns at once, so that the trace sources are
+ * compiled away.
+ *
  * @tparam Ts \explicit Types of the functor arguments.
  *
  * Inheritance graph was not generated because of its size.
@@ -78,6 +88,11 @@ class TracedCallback
     void Disconnect(const CallbackBase& callback, std::string path);
     /**
      * @brief Functor which invokes the chain of Callbacks.
+     *
+     * The Callbacks connected while the chain is invoked are invoked too,
+     * the Callbacks disconnected while the chain is invoked are not invoked
+     * anymore.
+     *
      * @tparam Ts \deduced Types of the functor arguments.
      * @param [in] args The arguments to the functor
      */
@@ -86,7 +101,7 @@ class TracedCallback
      * @brief Checks if the Callbacks list is empty.
      * @return true if the Callbacks list is empty.
      */
-    bool IsEmpty() const;
+    constexpr bool IsEmpty() const;
 
     /**
      *  TracedCallback signature for POD.
@@ -100,14 +115,41 @@ class TracedCallback
     /**@}*/
 
   private:
+#ifdef NS3_TRACE_SOURCES_DISABLE
+    /** Whether the Callbacks connected are kept and invoked. */
+    static constexpr bool ENABLED{false};
+#else
+    /** Whether the Callbacks connected are kept and invoked. */
+    static constexpr bool ENABLED{true};
+#endif
+
+    /** A Callback of the chain. */
+    struct Sink
+    {
+        Callback<void, Ts...> callback; //!< The Callback.
+        bool connected;                 //!< Whether the Callback is still connected.
+    };
+
     /**
      * Container type for holding the chain of Callbacks.
      *
      * @tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Sink> CallbackList;
+
+    /** Remove the Callbacks disconnected from the chain. */
+    void Compact() const;
+
+    /**
+     * The chain of Callbacks.  The Callbacks disconnected while the chain
+     * is invoked are only marked, and removed once the invocation is over,
+     * so that the invocation does not skip the Callbacks following them.
+     */
+    mutable CallbackList m_callbackList;
+    /** Number of invocations of the chain in progress. */
+    mutable uint32_t m_invoking;
+    /** Whether some Callbacks were disconnected during an invocation. */
+    mutable bool m_disconnected;
 };
 
 } // namespace ns3
@@ -121,7 +163,9 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_callbackList(),
+      m_invoking(0),
+      m_disconnected(false)
 {
 }
 
@@ -134,7 +178,10 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    if constexpr (ENABLED)
+    {
+        m_callbackList.push_back({cb, true});
+    }
 }
 
 template <typename... Ts>
@@ -146,25 +193,28 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
     {
         NS_FATAL_ERROR("when connecting to " << path);
     }
-    Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    if constexpr (ENABLED)
+    {
+        m_callbackList.push_back({cb.Bind(path), true});
+    }
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
+    for (auto& sink : m_callbackList)
     {
-        if ((*i).IsEqual(callback))
-        {
-            i = m_callbackList.erase(i);
-        }
-        else
+        if (sink.connected && sink.callback.IsEqual(callback))
         {
-            i++;
+            sink.connected = false;
+            m_disconnected = true;
         }
     }
+    if (m_invoking == 0)
+    {
+        Compact();
+    }
 }
 
 template <typename... Ts>
@@ -184,16 +234,48 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if constexpr (!ENABLED)
     {
-        (*i)(args...);
+        return;
     }
+    if (m_callbackList.empty()) [[likely]]
+    {
+        return;
+    }
+    // Index the chain, which the Callbacks may extend while invoked
+    m_invoking++;
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
+    {
+        if (m_callbackList[i].connected)
+        {
+            m_callbackList[i].callback(args...);
+        }
+    }
+    if (--m_invoking == 0 && m_disconnected)
+    {
+        Compact();
+    }
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Compact() const
+{
+    m_callbackList.erase(std::remove_if(m_callbackList.begin(),
+                                        m_callbackList.end(),
+                                        [](const Sink& sink) { return !sink.connected; }),
+                         m_callbackList.end());
+    m_disconnected = false;
 }
 
 template <typename... Ts>
-bool
+constexpr bool
 TracedCallback<Ts...>::IsEmpty() const
 {
+    if constexpr (!ENABLED)
+    {
+        return true;
+    }
     return m_callbackList.empty();
 }
 
@@ -12,7 +12,10 @@
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -112,7 +115,7 @@ class IidManager : public Singleton<IidManager>
      * @param [in] name The type id to find.
      * @returns The type id.  A type id of 0 means \pname{name} wasn't found.
      */
-    uint16_t GetUid(std::string name) const;
+    uint16_t GetUid(const std::string& name) const;
     /**
      * Get a type id by hash value.
      * @param [in] hash The type id to find.
@@ -229,6 +232,25 @@ class IidManager : public Singleton<IidManager>
      * @returns The information associated to attribute whose index is \pname{i}.
      */
     TypeId::AttributeInformation GetAttribute(uint16_t uid, std::size_t i) const;
+    /**
+     * Find an Attribute of a type id or of its parents by name.
+     * @param [in] uid The id.
+     * @param [in] name The Attribute name.
+     * @param [out] declaringUid The id declaring the Attribute.
+     * @param [out] i The index of the Attribute in \pname{declaringUid}.
+     * @returns \c true if the Attribute was found.
+     */
+    bool FindAttribute(uint16_t uid,
+                       const std::string& name,
+                       uint16_t* declaringUid,
+                       std::size_t* i) const;
+    /**
+     * Get the Attributes of a type id and of its parents.
+     * @param [in] uid The id.
+     * @returns The Attributes, from \pname{uid} to the top of its inheritance tree.
+     */
+    std::shared_ptr<const std::vector<TypeId::InheritedAttributeInformation>>
+    GetInheritedAttributes(uint16_t uid);
     /**
      * Record a new TraceSource.
      * @param [in] uid The id.
@@ -315,6 +337,13 @@ class IidManager : public Singleton<IidManager>
         bool mustHideFromDocumentation;
         /** The container of Attributes. */
         std::vector<TypeId::AttributeInformation> attributes;
+        /** The index of the Attributes by name. */
+        std::unordered_map<std::string, std::size_t> attributeIndex;
+        /** The Attributes of this type id and of its parents, if built. */
+        std::shared_ptr<const std::vector<TypeId::InheritedAttributeInformation>>
+            inheritedAttributes;
+        /** The generation of the type ids when inheritedAttributes was built. */
+        uint64_t inheritedGeneration;
         /** The container of TraceSources. */
         std::vector<TypeId::TraceSourceInformation> traceSources;
         /** Support level/deprecation. */
@@ -336,16 +365,30 @@ class IidManager : public Singleton<IidManager>
     /** The container of all type id records. */
     std::vector<IidInformation> m_information;
 
+    /**
+     * Record a change of the Attributes or of the parent of a type id,
+     * which invalidates the lists of inherited Attributes.
+     */
+    void NotifyAttributesChanged();
+
     /** Type of the by-name index. */
-    typedef std::map<std::string, uint16_t> namemap_t;
+    typedef std::unordered_map<std::string, uint16_t> namemap_t;
     /** The by-name index. */
     namemap_t m_namemap;
 
     /** Type of the by-hash index. */
-    typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
+    typedef std::unordered_map<TypeId::hash_t, uint16_t> hashmap_t;
     /** The by-hash index. */
     hashmap_t m_hashmap;
 
+    /**
+     * The number of changes of Attributes or parents, which threads read
+     * without the lock to check the lists of inherited Attributes they keep.
+     */
+    std::atomic<uint64_t> m_generation{0};
+    /** Protects the lists of inherited Attributes, built on first use. */
+    std::mutex m_inheritedMutex;
+
     /** IidManager constants. */
     enum
     {
@@ -446,6 +489,7 @@ IidManager::AllocateUid(std::string name)
     information.hasConstructor = false;
     information.mustHideFromDocumentation = false;
     information.supportLevel = TypeId::SupportLevel::SUPPORTED;
+    information.inheritedGeneration = 0;
     m_information.push_back(information);
     std::size_t tuid = m_information.size();
     NS_ASSERT(tuid <= 0xffff);
@@ -488,6 +532,7 @@ IidManager::SetParent(uint16_t uid, uint16_t parent)
     NS_ASSERT(parent <= m_information.size());
     IidInformation* information = LookupInformation(uid);
     information->parent = parent;
+    NotifyAttributesChanged();
 }
 
 void
@@ -529,7 +574,7 @@ IidManager::AddConstructor(uint16_t uid, Callback<ObjectBase*> callback)
 }
 
 uint16_t
-IidManager::GetUid(std::string name) const
+IidManager::GetUid(const std::string& name) const
 {
     NS_LOG_FUNCTION(IID << name);
     uint16_t uid = 0;
@@ -654,29 +699,11 @@ bool
 IidManager::HasAttribute(uint16_t uid, std::string name)
 {
     NS_LOG_FUNCTION(IID << uid << name);
-    IidInformation* information = LookupInformation(uid);
-    while (true)
-    {
-        for (auto i = information->attributes.begin(); i != information->attributes.end(); ++i)
-        {
-            if (i->name == name)
-            {
-                NS_LOG_LOGIC(IIDL << true);
-                return true;
-            }
-        }
-        IidInformation* parent = LookupInformation(information->parent);
-        if (parent == information)
-        {
-            // top of inheritance tree
-            NS_LOG_LOGIC(IIDL << false);
-            return false;
-        }
-        // check parent
-        information = parent;
-    }
-    NS_LOG_LOGIC(IIDL << false);
-    return false;
+    uint16_t declaringUid;
+    std::size_t i;
+    bool found = FindAttribute(uid, name, &declaringUid, &i);
+    NS_LOG_LOGIC(IIDL << found);
+    return found;
 }
 
 void
@@ -714,7 +741,9 @@ IidManager::AddAttribute(uint16_t uid,
     info.checker = checker;
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
+    information->attributeIndex[name] = information->attributes.size();
     information->attributes.push_back(info);
+    NotifyAttributesChanged();
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
 
@@ -727,6 +756,7 @@ IidManager::SetAttributeInitialValue(uint16_t uid,
     IidInformation* information = LookupInformation(uid);
     NS_ASSERT(i < information->attributes.size());
     information->attributes[i].initialValue = initialValue;
+    NotifyAttributesChanged();
 }
 
 std::size_t
@@ -749,6 +779,97 @@ IidManager::GetAttribute(uint16_t uid, std::size_t i) const
     return information->attributes[i];
 }
 
+bool
+IidManager::FindAttribute(uint16_t uid,
+                          const std::string& name,
+                          uint16_t* declaringUid,
+                          std::size_t* i) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    while (true)
+    {
+        IidInformation* information = LookupInformation(uid);
+        auto it = information->attributeIndex.find(name);
+        if (it != information->attributeIndex.end())
+        {
+            *declaringUid = uid;
+            *i = it->second;
+            return true;
+        }
+        if (information->parent == uid)
+        {
+            // top of inheritance tree
+            return false;
+        }
+        // check parent
+        uid = information->parent;
+    }
+}
+
+std::shared_ptr<const std::vector<TypeId::InheritedAttributeInformation>>
+IidManager::GetInheritedAttributes(uint16_t uid)
+{
+    NS_LOG_FUNCTION(IID << uid);
+    // Each thread keeps the lists it got, so that constructing an object
+    // takes the lock only after the Attributes changed
+    thread_local std::vector<
+        std::pair<uint64_t,
+                  std::shared_ptr<const std::vector<TypeId::InheritedAttributeInformation>>>>
+        cache;
+    uint64_t generation = m_generation.load(std::memory_order_acquire);
+    if (uid < cache.size() && cache[uid].second && cache[uid].first == generation)
+    {
+        return cache[uid].second;
+    }
+    if (uid >= cache.size())
+    {
+        cache.resize(uid + 1);
+    }
+
+    std::lock_guard lock(m_inheritedMutex);
+    IidInformation* information = LookupInformation(uid);
+    generation = m_generation.load(std::memory_order_relaxed);
+    if (information->inheritedAttributes && information->inheritedGeneration == generation)
+    {
+        cache[uid] = {generation, information->inheritedAttributes};
+        return information->inheritedAttributes;
+    }
+
+    auto attributes = std::make_shared<std::vector<TypeId::InheritedAttributeInformation>>();
+    uint16_t current = uid;
+    while (true)
+    {
+        IidInformation* currentInformation = LookupInformation(current);
+        for (const auto& attribute : currentInformation->attributes)
+        {
+            // an initial value accepted by the checker is set without a copy
+            bool isValid =
+                attribute.initialValue && attribute.checker->Check(*attribute.initialValue);
+            attributes->push_back(
+                {currentInformation->name + "::" + attribute.name, attribute, isValid});
+        }
+        if (currentInformation->parent == current)
+        {
+            // top of inheritance tree
+            break;
+        }
+        current = currentInformation->parent;
+    }
+    NS_LOG_LOGIC(IIDL << attributes->size());
+    information->inheritedAttributes = attributes;
+    information->inheritedGeneration = generation;
+    cache[uid] = {generation, attributes};
+    return attributes;
+}
+
+void
+IidManager::NotifyAttributesChanged()
+{
+    NS_LOG_FUNCTION(IID);
+    std::lock_guard lock(m_inheritedMutex);
+    m_generation.fetch_add(1, std::memory_order_release);
+}
+
 bool
 IidManager::HasTraceSource(uint16_t uid, std::string name)
 {
@@ -941,27 +1062,11 @@ TypeId::GetRegistered(uint16_t i)
 std::tuple<bool, TypeId, TypeId::AttributeInformation>
 TypeId::FindAttribute(const TypeId& tid, const std::string& name)
 {
-    TypeId currentTid = tid;
-    TypeId parentTid;
-    while (true)
+    uint16_t uid;
+    std::size_t i;
+    if (IidManager::Get()->FindAttribute(tid.m_tid, name, &uid, &i))
     {
-        for (std::size_t i = 0; i < currentTid.GetAttributeN(); ++i)
-        {
-            const AttributeInformation& attributeInfo = currentTid.GetAttribute(i);
-            if (attributeInfo.name == name)
-            {
-                return {true, currentTid, attributeInfo};
-            }
-        }
-
-        parentTid = currentTid.GetParent();
-
-        if (parentTid == currentTid)
-        {
-            break;
-        }
-
-        currentTid = parentTid;
+        return {true, TypeId(uid), IidManager::Get()->GetAttribute(uid, i)};
     }
     return {false, TypeId(), AttributeInformation()};
 }
@@ -1159,19 +1264,13 @@ TypeId::SetAttributeInitialValue(std::string name, Ptr<const AttributeValue> ini
     // Walk the inheritance chain to the TypeId that declares the attribute; the
     // initial value must be recorded there so ObjectBase::ConstructSelf reads it
     // back for a derived instance (issue #147).
-    auto [found, declaringTid, info] = FindAttribute(*this, name);
-    if (!found)
+    uint16_t uid;
+    std::size_t i;
+    if (!IidManager::Get()->FindAttribute(m_tid, name, &uid, &i))
     {
         return false;
     }
-    for (std::size_t i = 0; i < declaringTid.GetAttributeN(); ++i)
-    {
-        if (declaringTid.GetAttribute(i).name == name)
-        {
-            return declaringTid.SetAttributeInitialValue(i, initialValue);
-        }
-    }
-    return false;
+    return TypeId(uid).SetAttributeInitialValue(i, initialValue);
 }
 
 Callback<ObjectBase*>
@@ -1213,6 +1312,13 @@ TypeId::GetAttributeFullName(std::size_t i) const
     return GetName() + "::" + info.name;
 }
 
+std::shared_ptr<const std::vector<TypeId::InheritedAttributeInformation>>
+TypeId::GetInheritedAttributes() const
+{
+    NS_LOG_FUNCTION(this);
+    return IidManager::Get()->GetInheritedAttributes(m_tid);
+}
+
 std::size_t
 TypeId::GetTraceSourceN() const
 {
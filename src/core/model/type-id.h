@@ -17,8 +17,10 @@
 #include "hash.h"
 #include "trace-source-accessor.h"
 
+#include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 /**
  * @file
@@ -122,6 +124,17 @@ class TypeId
         std::string supportMsg;
     };
 
+    /** Attribute of a TypeId or of one of its parents. */
+    struct InheritedAttributeInformation
+    {
+        /** Attribute full name, i.e., the name of its TypeId, "::" and its name. */
+        std::string fullName;
+        /** Attribute information. */
+        AttributeInformation info;
+        /** \c true if the checker accepts the initial value as is. */
+        bool isInitialValueValid;
+    };
+
     /** Type of hash values. */
     typedef uint32_t hash_t;
 
@@ -293,6 +306,20 @@ class TypeId
      */
     std::string GetAttributeFullName(std::size_t i) const;
 
+    /**
+     * Get the attributes of this TypeId and of its parents.
+     *
+     * The attributes are listed from this TypeId to the root of its
+     * parents, in the order of ObjectBase::ConstructSelf().  The list is
+     * built at the first call, and built again once an attribute, a parent
+     * or an initial value of any TypeId changed; a list already returned
+     * is not modified.
+     *
+     * @returns The attributes of this TypeId and of its parents.
+     */
+    std::shared_ptr<const std::vector<InheritedAttributeInformation>> GetInheritedAttributes()
+        const;
+
     /**
      * Get the constructor callback.
      *
@@ -851,6 +851,157 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * @ingroup config-tests
+ * Test for the ability to resolve a compiled path repeatedly, and under
+ * a single element of its first array.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CompiledPathConfigTestCase();
+
+    /** Destructor. */
+    ~CompiledPathConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback with context path.
+     * @param path The context path.
+     * @param old The old value.
+     * @param newValue The new value.
+     */
+    void TraceWithPath(std::string path,
+                       int16_t old [[maybe_unused]],
+                       int16_t newValue [[maybe_unused]])
+    {
+        m_paths.push_back(path);
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the matched paths of a container.
+     * @param container The container.
+     * @param expected The expected matched paths.
+     */
+    void CheckMatchedPaths(const Config::MatchContainer& container,
+                           const std::vector<std::string>& expected);
+
+    std::vector<std::string> m_paths; //!< The context paths of the traces.
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase()
+    : TestCase("Check ability to resolve a compiled path repeatedly")
+{
+}
+
+void
+CompiledPathConfigTestCase::CheckMatchedPaths(const Config::MatchContainer& container,
+                                              const std::vector<std::string>& expected)
+{
+    NS_TEST_ASSERT_MSG_EQ(container.GetN(), expected.size(), "Unexpected number of matches");
+    for (uint32_t i = 0; i < container.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(container.GetMatchedPath(i), expected[i], "Unexpected match");
+    }
+}
+
+void
+CompiledPathConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    //
+    // Create a root namespace object, holding four objects in its NodesA
+    // vector, each one pointing to another object with an aggregated object.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    Names::Add("CompiledRoot", root);
+    std::vector<Ptr<ConfigTestObject>> nodes;
+    auto addNode = [&root, &nodes]() {
+        Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+        Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+        b->AggregateObject(CreateObject<DerivedConfigObject>());
+        a->SetNodeB(b);
+        root->AddNodeA(a);
+        nodes.push_back(b);
+    };
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        addNode();
+    }
+
+    //
+    // Resolve paths with array expressions, attribute wildcards, GetObject
+    // and names.
+    //
+    Config::CompiledPath source("/NodesA/*/NodeB/Source");
+    NS_TEST_EXPECT_MSG_EQ(source.GetLeaf(), "Source", "Unexpected leaf");
+    CheckMatchedPaths(source.LookupMatches(),
+                      {"/NodesA/0/NodeB/",
+                       "/NodesA/1/NodeB/",
+                       "/NodesA/2/NodeB/",
+                       "/NodesA/3/NodeB/"});
+    CheckMatchedPaths(Config::CompiledPath("/NodesA/|0|[2-3]/*/$DerivedConfigObject/X")
+                          .LookupMatches(),
+                      {"/NodesA/0/NodeB/$DerivedConfigObject/",
+                       "/NodesA/2/NodeB/$DerivedConfigObject/",
+                       "/NodesA/3/NodeB/$DerivedConfigObject/"});
+    CheckMatchedPaths(Config::CompiledPath("/Names/CompiledRoot/NodesA/1/NodeB/A").LookupMatches(),
+                      {"/Names/CompiledRoot/NodesA/1/NodeB/"});
+    CheckMatchedPaths(Config::LookupMatches("/NodesA/3|4/NodeB"), {"/NodesA/3/NodeB/"});
+
+    //
+    // Resolve a path under a single element of its first array.
+    //
+    CheckMatchedPaths(source.LookupMatches(2), {"/NodesA/2/NodeB/"});
+    CheckMatchedPaths(source.LookupMatches(4), {});
+    CheckMatchedPaths(Config::CompiledPath("/NodesA/0|1/NodeB/A").LookupMatches(2), {});
+    CheckMatchedPaths(Config::CompiledPath("/NodeA/NodeB/A").LookupMatches(0), {});
+
+    //
+    // Set an attribute through the compiled path, and check that only the
+    // matching objects changed.
+    //
+    Config::CompiledPath a("/NodesA/[1-2]/NodeB/A");
+    a.Set(IntegerValue(3));
+    for (uint32_t i = 0; i < nodes.size(); i++)
+    {
+        nodes[i]->GetAttribute("A", iv);
+        NS_TEST_EXPECT_MSG_EQ(iv.Get(), (i == 1 || i == 2 ? 3 : 10), "Unexpected attribute A");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Config::CompiledPath("/NodesA/*/NodeB/Z").SetFailSafe(IntegerValue(3)),
+                          false,
+                          "Unknown attribute Z unexpectedly set");
+
+    //
+    // Connect to the objects, then to the object of a new element of the array.
+    //
+    source.Connect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    nodes[0]->SetAttribute("Source", IntegerValue(-2));
+    addNode();
+    nodes[4]->SetAttribute("Source", IntegerValue(-3));
+    source.LookupMatches(4).Connect(
+        source.GetLeaf(),
+        MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    nodes[4]->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_ASSERT_MSG_EQ(m_paths.size(), 2, "Unexpected number of traces");
+    NS_TEST_EXPECT_MSG_EQ(m_paths[0], "/NodesA/0/NodeB/Source", "Unexpected trace context");
+    NS_TEST_EXPECT_MSG_EQ(m_paths[1], "/NodesA/4/NodeB/Source", "Unexpected trace context");
+
+    source.Disconnect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    nodes[4]->SetAttribute("Source", IntegerValue(-5));
+    NS_TEST_EXPECT_MSG_EQ(m_paths.size(), 2, "Trace fired after disconnection");
+
+    Config::UnregisterRootNamespaceObject(root);
+    Names::Clear();
+}
+
 /**
  * @ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -869,6 +1020,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new CompiledPathConfigTestCase);
 }
 
 /**
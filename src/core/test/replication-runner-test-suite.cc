@@ -0,0 +1,305 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/replication-runner.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <stdexcept>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup replication-runner-tests
+ * ReplicationRunner test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup replication-runner-tests ReplicationRunner tests
+ */
+
+/**
+ * @ingroup replication-runner-tests
+ *
+ * @brief Check that the replications share the setup and draw their own random values.
+ */
+class ReplicationRunnerTestCase : public TestCase
+{
+  public:
+    ReplicationRunnerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase()
+    : TestCase("Check the replications of a simulation set up once")
+{
+}
+
+void
+ReplicationRunnerTestCase::DoRun()
+{
+    const uint64_t originalRun = RngSeedManager::GetRun();
+    const uint64_t firstRun = 3;
+    const uint32_t count = 5;
+
+    // Set up the simulation: the replications draw a value in an event
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(7);
+    double value = -1;
+    Time drawn;
+    Simulator::Schedule(Seconds(2), [&]() {
+        value = uniform->GetValue();
+        drawn = Simulator::Now();
+    });
+
+    ReplicationRunner runner;
+    runner.SetMaxProcesses(2);
+    NS_TEST_EXPECT_MSG_EQ(runner.GetMaxProcesses(), 2, "Bad number of processes");
+    auto replications =
+        runner.Run(firstRun, count, [&](uint64_t run, ReplicationRunner::Results& results) {
+            results["run"] = run;
+            results["value"] = value;
+            results["time"] = drawn.GetSeconds();
+        });
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(value, -1, "The calling process should not run the simulation");
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), originalRun, "The run number changed");
+    NS_TEST_ASSERT_MSG_EQ(replications.size(), count, "Bad number of replications");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto& replication = replications[i];
+        NS_TEST_EXPECT_MSG_EQ(replication.run, firstRun + i, "Bad run number");
+        NS_TEST_ASSERT_MSG_EQ(replication.completed, true, "Replication failed");
+        NS_TEST_EXPECT_MSG_EQ(replication.results.size(), 3, "Bad number of results");
+        NS_TEST_EXPECT_MSG_EQ(replication.results.at("run"), firstRun + i, "Bad run result");
+        NS_TEST_EXPECT_MSG_EQ(replication.results.at("time"), 2, "Bad event time");
+
+        // The value drawn by the replication is the one a new process
+        // would draw with the run number of the replication
+        RngSeedManager::SetRun(replication.run);
+        Ptr<UniformRandomVariable> expected = CreateObject<UniformRandomVariable>();
+        expected->SetStream(7);
+        NS_TEST_EXPECT_MSG_EQ(replication.results.at("value"),
+                              expected->GetValue(),
+                              "Bad random value for run " << replication.run);
+    }
+    NS_TEST_EXPECT_MSG_NE(replications[0].results.at("value"),
+                          replications[1].results.at("value"),
+                          "The replications should draw different values");
+    RngSeedManager::SetRun(originalRun);
+}
+
+/**
+ * @ingroup replication-runner-tests
+ *
+ * @brief Check that a replication draws the sequence of a new random
+ * variable, even if the variable cached a value in the calling process.
+ */
+class ReplicationRunnerCachedValueTestCase : public TestCase
+{
+  public:
+    ReplicationRunnerCachedValueTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ReplicationRunnerCachedValueTestCase::ReplicationRunnerCachedValueTestCase()
+    : TestCase("Check the values cached by the random variables of the replications")
+{
+}
+
+void
+ReplicationRunnerCachedValueTestCase::DoRun()
+{
+    const uint64_t originalRun = RngSeedManager::GetRun();
+    const uint64_t run = 5;
+    const uint32_t draws = 3;
+
+    // The normal variable draws its values in pairs, and keeps the second
+    // value of the pair drawn by the setup for its next call
+    Ptr<NormalRandomVariable> normal = CreateObject<NormalRandomVariable>();
+    normal->SetStream(11);
+    normal->GetValue();
+
+    ReplicationRunner runner;
+    auto replications = runner.Run(run, 1, [&](uint64_t, ReplicationRunner::Results& results) {
+        for (uint32_t i = 0; i < draws; i++)
+        {
+            results[std::to_string(i)] = normal->GetValue();
+        }
+    });
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(replications.size(), 1, "Bad number of replications");
+    NS_TEST_ASSERT_MSG_EQ(replications[0].completed, true, "Replication failed");
+    NS_TEST_ASSERT_MSG_EQ(replications[0].results.size(), draws, "Bad number of results");
+    RngSeedManager::SetRun(run);
+    Ptr<NormalRandomVariable> expected = CreateObject<NormalRandomVariable>();
+    expected->SetStream(11);
+    for (uint32_t i = 0; i < draws; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(replications[0].results.at(std::to_string(i)),
+                              expected->GetValue(),
+                              "Bad random value " << i);
+    }
+    RngSeedManager::SetRun(originalRun);
+}
+
+/**
+ * @ingroup replication-runner-tests
+ *
+ * @brief Check that the failed replications are reported.
+ */
+class ReplicationRunnerFailureTestCase : public TestCase
+{
+  public:
+    ReplicationRunnerFailureTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ReplicationRunnerFailureTestCase::ReplicationRunnerFailureTestCase()
+    : TestCase("Check the failed replications")
+{
+}
+
+void
+ReplicationRunnerFailureTestCase::DoRun()
+{
+    ReplicationRunner runner;
+    auto replications = runner.Run(1, 3, [](uint64_t run, ReplicationRunner::Results& results) {
+        results["run"] = run;
+        if (run == 2)
+        {
+            throw std::runtime_error("expected failure");
+        }
+    });
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(replications.size(), 3, "Bad number of replications");
+    NS_TEST_EXPECT_MSG_EQ(replications[0].completed, true, "Replication 1 should succeed");
+    NS_TEST_EXPECT_MSG_EQ(replications[1].completed, false, "Replication 2 should fail");
+    NS_TEST_EXPECT_MSG_EQ(replications[1].results.empty(), true, "Failed replication results");
+    NS_TEST_EXPECT_MSG_EQ(replications[2].completed, true, "Replication 3 should succeed");
+}
+
+/**
+ * @ingroup replication-runner-tests
+ *
+ * @brief Check that the branches resume the simulation from the state of the calling process.
+ */
+class ReplicationRunnerBranchTestCase : public TestCase
+{
+  public:
+    ReplicationRunnerBranchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ReplicationRunnerBranchTestCase::ReplicationRunnerBranchTestCase()
+    : TestCase("Check the branches of a simulation from a checkpoint")
+{
+}
+
+void
+ReplicationRunnerBranchTestCase::DoRun()
+{
+    const uint32_t count = 3;
+
+    // An event every second adds the increment of the branch, and draws a value
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(11);
+    uint32_t events = 0;
+    double increment = 1;
+    double total = 0;
+    double value = -1;
+    for (int i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(Seconds(i + 0.5), [&]() {
+            events++;
+            total += increment;
+            value = uniform->GetValue();
+        });
+    }
+
+    // Warm up during 5 s, then branch for 5 s
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(events, 5, "Bad number of warm-up events");
+    Simulator::Stop(Seconds(5));
+
+    ReplicationRunner runner;
+    runner.SetMaxProcesses(2);
+    auto branches = runner.RunBranches(
+        count,
+        [&](uint32_t branch) { increment = branch + 2; },
+        [&](uint64_t, ReplicationRunner::Results& results) {
+            results["events"] = events;
+            results["total"] = total;
+            results["value"] = value;
+            results["time"] = Simulator::Now().GetSeconds();
+        });
+
+    NS_TEST_EXPECT_MSG_EQ(events, 5, "The calling process should not resume the simulation");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(5), "The calling process time changed");
+    Simulator::Destroy();
+
+    // The value drawn by the last event is the tenth value of the stream
+    Ptr<UniformRandomVariable> expected = CreateObject<UniformRandomVariable>();
+    expected->SetStream(11);
+    double expectedValue = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        expectedValue = expected->GetValue();
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(branches.size(), count, "Bad number of branches");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto& branch = branches[i];
+        NS_TEST_EXPECT_MSG_EQ(branch.run, RngSeedManager::GetRun(), "Bad run number");
+        NS_TEST_ASSERT_MSG_EQ(branch.completed, true, "Branch failed");
+        NS_TEST_EXPECT_MSG_EQ(branch.results.at("events"), 10, "Bad number of events");
+        NS_TEST_EXPECT_MSG_EQ(branch.results.at("total"), 5 + 5 * (i + 2), "Bad total");
+        NS_TEST_EXPECT_MSG_EQ(branch.results.at("time"), 10, "Bad end time");
+        NS_TEST_EXPECT_MSG_EQ(branch.results.at("value"),
+                              expectedValue,
+                              "The branches should keep the random variable state");
+    }
+}
+
+/**
+ * @ingroup replication-runner-tests
+ *
+ * @brief ReplicationRunner test suite.
+ */
+class ReplicationRunnerTestSuite : public TestSuite
+{
+  public:
+    ReplicationRunnerTestSuite()
+        : TestSuite("replication-runner", Type::UNIT)
+    {
+#ifndef __WIN32__
+        AddTestCase(new ReplicationRunnerTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new ReplicationRunnerCachedValueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new ReplicationRunnerFailureTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new ReplicationRunnerBranchTestCase(), TestCase::Duration::QUICK);
+#endif
+    }
+};
+
+static ReplicationRunnerTestSuite
+    g_replicationRunnerTestSuite; //!< Static variable for test initialization
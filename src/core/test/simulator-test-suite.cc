@@ -7,12 +7,19 @@
  */
 #include "ns3/calendar-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -647,6 +654,280 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that a scheduler returns the events in the same order
+ * as the MapScheduler, under a random mix of insertions and removals.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param schedulerFactory Factory of the scheduler to check.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the event order of " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    Ptr<Scheduler> reference = CreateObject<MapScheduler>();
+    std::mt19937 rng(1);
+    // Pending events, and their index in pending by uid
+    std::vector<Scheduler::Event> pending;
+    std::unordered_map<uint32_t, std::size_t> pendingIndex;
+    uint64_t now = 0;
+    uint32_t uid = 0;
+
+    auto newEvent = [&](uint64_t ts) {
+        Scheduler::Event ev;
+        ev.impl = nullptr;
+        ev.key.m_ts = ts;
+        ev.key.m_uid = uid++;
+        ev.key.m_context = 0;
+        reference->Insert(ev);
+        pendingIndex[ev.key.m_uid] = pending.size();
+        pending.push_back(ev);
+        return ev;
+    };
+    auto removePending = [&](uint32_t evUid) {
+        std::size_t index = pendingIndex[evUid];
+        pending[index] = pending.back();
+        pendingIndex[pending[index].key.m_uid] = index;
+        pending.pop_back();
+        pendingIndex.erase(evUid);
+    };
+
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        uint32_t op = rng() % 32;
+        if (op == 0)
+        {
+            // A batch of simultaneous events, and a few later ones
+            std::vector<Scheduler::Event> batch;
+            uint64_t ts = now + rng() % 100;
+            for (uint32_t size = 1 + rng() % 40; size > 0; size--)
+            {
+                batch.push_back(newEvent((rng() % 10 == 0) ? ts + rng() % 1000 : ts));
+            }
+            scheduler->InsertBatch(batch);
+        }
+        else if (op < 12 || pending.empty())
+        {
+            // Bimodal delays, with many simultaneous events
+            scheduler->Insert(newEvent(now + ((rng() % 10 == 0) ? rng() % 1000000 : rng() % 100)));
+        }
+        else if (op < 28)
+        {
+            Scheduler::Event ev = reference->RemoveNext();
+            Scheduler::Event next = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, ev.key.m_uid, "Wrong event at step " << i);
+            now = ev.key.m_ts;
+            removePending(ev.key.m_uid);
+        }
+        else
+        {
+            Scheduler::Event ev = pending[rng() % pending.size()];
+            scheduler->Remove(ev);
+            reference->Remove(ev);
+            removePending(ev.key.m_uid);
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), reference->IsEmpty(), "Wrong queue size");
+    }
+    while (!reference->IsEmpty())
+    {
+        NS_TEST_ASSERT_MSG_EQ(scheduler->RemoveNext().key.m_uid,
+                              reference->RemoveNext().key.m_uid,
+                              "Wrong event order");
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Events left in the scheduler");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the scheduling of batches of events.
+ */
+class ScheduleWithContextBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param schedulerFactory Scheduler factory.
+     */
+    ScheduleWithContextBatchTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the execution of an event.
+     *
+     * @param [in] index The index of the event in its batch.
+     */
+    void Record(uint32_t index);
+
+    ObjectFactory m_schedulerFactory;                 //!< Scheduler factory.
+    std::vector<std::pair<Time, uint32_t>> m_records; //!< Time and index of the executed events.
+};
+
+ScheduleWithContextBatchTestCase::ScheduleWithContextBatchTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check batches of events with " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+ScheduleWithContextBatchTestCase::Record(uint32_t index)
+{
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetContext(), index, "Wrong context");
+    m_records.emplace_back(Simulator::Now(), index);
+}
+
+void
+ScheduleWithContextBatchTestCase::DoRun()
+{
+    const uint32_t nEvents = 500;
+    Simulator::SetScheduler(m_schedulerFactory);
+
+    // A few events first, so that both the small and the large batch
+    // paths of the schedulers are used
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       NanoSeconds(3),
+                                       &ScheduleWithContextBatchTestCase::Record,
+                                       this,
+                                       i);
+    }
+    Simulator::Schedule(NanoSeconds(1), [this, nEvents]() {
+        for (uint32_t size : {5U, nEvents})
+        {
+            std::vector<Simulator::ContextEvent> events;
+            for (uint32_t i = 0; i < size; i++)
+            {
+                events.push_back(
+                    {i,
+                     NanoSeconds(i % 7),
+                     MakeEvent(&ScheduleWithContextBatchTestCase::Record, this, i)});
+            }
+            Simulator::ScheduleWithContextBatch(events);
+        }
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // Events sorted by time, then in scheduling order
+    std::vector<std::pair<Time, uint32_t>> expected;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        expected.emplace_back(NanoSeconds(3), i);
+    }
+    for (uint32_t size : {5U, nEvents})
+    {
+        for (uint32_t i = 0; i < size; i++)
+        {
+            expected.emplace_back(NanoSeconds(1 + i % 7), i);
+        }
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    NS_TEST_ASSERT_MSG_EQ(m_records.size(), expected.size(), "Wrong number of events");
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_records[i].first, expected[i].first, "Wrong time of event " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_records[i].second,
+                              expected[i].second,
+                              "Wrong order of event " << i);
+    }
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the event memory is recycled.
+ */
+class EventAllocationTestCase : public TestCase
+{
+  public:
+    EventAllocationTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Schedule the next event of a chain, cancelling every other event.
+     *
+     * @param [in] remaining The number of events left in the chain.
+     */
+    void Chain(uint32_t remaining);
+
+    EventId m_first; //!< The first event of the chain.
+};
+
+EventAllocationTestCase::EventAllocationTestCase()
+    : TestCase("Check the recycling of the event memory")
+{
+}
+
+void
+EventAllocationTestCase::Chain(uint32_t remaining)
+{
+    if (remaining > 0)
+    {
+        Simulator::Schedule(NanoSeconds(1), &EventAllocationTestCase::Chain, this, remaining - 1);
+        EventId cancelled = Simulator::Schedule(NanoSeconds(1), [this]() {
+            NS_TEST_EXPECT_MSG_EQ(true, false, "Cancelled event executed");
+        });
+        cancelled.Cancel();
+        NS_TEST_EXPECT_MSG_EQ(cancelled.IsPending(), false, "Cancelled event is pending");
+    }
+}
+
+void
+EventAllocationTestCase::DoRun()
+{
+    const uint32_t nEvents = 10000;
+    m_first = Simulator::Schedule(NanoSeconds(1), &EventAllocationTestCase::Chain, this, nEvents);
+    EventImpl::AllocationStats before = Simulator::GetEventAllocationStats();
+    Simulator::Run();
+    EventImpl::AllocationStats after = Simulator::GetEventAllocationStats();
+
+    // The first event is held by m_first, its memory must not be recycled
+    NS_TEST_EXPECT_MSG_EQ(m_first.IsExpired(), true, "First event not expired");
+    NS_TEST_EXPECT_MSG_EQ(m_first.PeekEventImpl()->IsCancelled(), false, "Wrong event state");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.allocations - before.allocations,
+                                2 * nEvents,
+                                "Wrong number of allocations");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.releases - before.releases,
+                                2 * nEvents,
+                                "Wrong number of releases");
+    // Only a few events are alive at any time
+    NS_TEST_EXPECT_MSG_LT(after.systemAllocations - before.systemAllocations,
+                          10,
+                          "Event memory not recycled");
+
+    m_first = EventId();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -670,6 +951,20 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(CalendarScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new EventAllocationTestCase(), TestCase::Duration::QUICK);
+        for (auto scheduler : {MapScheduler::GetTypeId(),
+                               HeapScheduler::GetTypeId(),
+                               CalendarScheduler::GetTypeId(),
+                               LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(scheduler);
+            AddTestCase(new ScheduleWithContextBatchTestCase(factory), TestCase::Duration::QUICK);
+        }
     }
 };
 
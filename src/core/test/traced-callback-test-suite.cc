@@ -7,6 +7,8 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -122,6 +124,138 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the order of the Callbacks of a chain,
+ * including Callbacks connected and disconnected while the chain is invoked.
+ */
+class ChainTracedCallbackTestCase : public TestCase
+{
+  public:
+    ChainTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the invocation of a Callback.
+     * @param id The identifier of the Callback.
+     */
+    void Record(int id);
+
+    /**
+     * Record the invocation of a Callback, and connect another one to the
+     * traced callback invoked.
+     * @param id The identifier of the Callback.
+     */
+    void RecordAndConnect(int id);
+
+    /**
+     * Record the invocation of a Callback, and disconnect both itself and
+     * the Callback connected before it from the traced callback invoked.
+     * @param id The identifier of the Callback.
+     */
+    void RecordAndDisconnect(int id);
+
+    /**
+     * Record the invocation of a Callback, with a negated identifier.
+     * @param id The identifier of the Callback.
+     */
+    void RecordNegated(int id);
+
+    TracedCallback<int> m_trace; //!< The traced callback tested.
+    std::vector<int> m_invoked;  //!< The identifiers of the Callbacks invoked.
+};
+
+ChainTracedCallbackTestCase::ChainTracedCallbackTestCase()
+    : TestCase("Check the chain of a TracedCallback")
+{
+}
+
+void
+ChainTracedCallbackTestCase::Record(int id)
+{
+    m_invoked.push_back(id);
+}
+
+void
+ChainTracedCallbackTestCase::RecordAndConnect(int id)
+{
+    m_invoked.push_back(id);
+    m_trace.ConnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Record, this));
+}
+
+void
+ChainTracedCallbackTestCase::RecordAndDisconnect(int id)
+{
+    m_invoked.push_back(id);
+    m_trace.DisconnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Record, this));
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::RecordAndDisconnect, this));
+}
+
+void
+ChainTracedCallbackTestCase::RecordNegated(int id)
+{
+    m_invoked.push_back(-id);
+}
+
+void
+ChainTracedCallbackTestCase::DoRun()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "No Callback should be connected");
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_invoked.empty(), true, "No Callback should be invoked");
+
+    // The Callbacks are invoked in their order of connection, including the
+    // Callback connected by the first one
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::RecordAndConnect, this));
+    m_trace.ConnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Record, this));
+    m_trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), false, "Callbacks should be connected");
+    NS_TEST_ASSERT_MSG_EQ((m_invoked == std::vector<int>{1, 1, 1}),
+                          true,
+                          "The chain and the Callback it connected should be invoked");
+
+    // Disconnecting a Callback removes all its connections
+    m_trace.DisconnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Record, this));
+    m_invoked.clear();
+    m_trace(2);
+    NS_TEST_ASSERT_MSG_EQ((m_invoked == std::vector<int>{2, 2}),
+                          true,
+                          "The first Callback and the one it connected should be invoked");
+
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::RecordAndConnect, this));
+    m_trace.DisconnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Record, this));
+    m_invoked.clear();
+    m_trace(3);
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "All the Callbacks should be disconnected");
+    NS_TEST_ASSERT_MSG_EQ(m_invoked.empty(), true, "No Callback should be invoked");
+
+    // A Callback disconnecting itself and an earlier Callback while the
+    // chain is invoked does not skip the Callback following it
+    m_trace.ConnectWithoutContext(MakeCallback(&ChainTracedCallbackTestCase::Record, this));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::RecordAndDisconnect, this));
+    m_trace.ConnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::RecordNegated, this));
+    m_trace(4);
+    NS_TEST_ASSERT_MSG_EQ((m_invoked == std::vector<int>{4, 4, -4}),
+                          true,
+                          "All the Callbacks should be invoked once");
+    m_invoked.clear();
+    m_trace(5);
+    NS_TEST_ASSERT_MSG_EQ((m_invoked == std::vector<int>{-5}),
+                          true,
+                          "Only the last Callback should still be connected");
+    m_trace.DisconnectWithoutContext(
+        MakeCallback(&ChainTracedCallbackTestCase::RecordNegated, this));
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "All the Callbacks should be disconnected");
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +271,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ChainTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
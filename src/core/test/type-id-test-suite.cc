@@ -6,10 +6,13 @@
  * Author: Peter D. Barnes, Jr. <pdbarnes@llnl.gov>
  */
 
+#include "ns3/config.h"
 #include "ns3/double.h"
 #include "ns3/integer.h"
 #include "ns3/log.h"
+#include "ns3/object-factory.h"
 #include "ns3/object.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/traced-value.h"
 #include "ns3/type-id.h"
@@ -336,6 +339,151 @@ DeprecatedAttributeTestCase::DoRun()
               << std::endl;
 }
 
+/**
+ * @ingroup typeid-tests
+ *
+ * Base class used to test the inherited Attributes.
+ */
+class InheritedAttributeBase : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("InheritedAttributeBase")
+                                .SetParent<Object>()
+                                .AddConstructor<InheritedAttributeBase>()
+                                .AddAttribute("Base",
+                                              "an attribute of the base class",
+                                              IntegerValue(1),
+                                              MakeIntegerAccessor(&InheritedAttributeBase::m_base),
+                                              MakeIntegerChecker<int>());
+        return tid;
+    }
+
+    int m_base{0}; //!< The Base attribute.
+};
+
+/**
+ * @ingroup typeid-tests
+ *
+ * Derived class used to test the inherited Attributes.
+ */
+class InheritedAttributeDerived : public InheritedAttributeBase
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("InheritedAttributeDerived")
+                .SetParent<InheritedAttributeBase>()
+                .AddConstructor<InheritedAttributeDerived>()
+                .AddAttribute("Derived",
+                              "an attribute of the derived class",
+                              IntegerValue(2),
+                              MakeIntegerAccessor(&InheritedAttributeDerived::m_derived),
+                              MakeIntegerChecker<int>())
+                .AddAttribute("FromString",
+                              "an attribute whose initial value is a string",
+                              StringValue("3"),
+                              MakeIntegerAccessor(&InheritedAttributeDerived::m_fromString),
+                              MakeIntegerChecker<int>());
+        return tid;
+    }
+
+    int m_derived{0};    //!< The Derived attribute.
+    int m_fromString{0}; //!< The FromString attribute.
+};
+
+/**
+ * @ingroup typeid-tests
+ *
+ * Check the Attributes inherited by a TypeId, and the construction of
+ * the objects from them.
+ */
+class InheritedAttributesTestCase : public TestCase
+{
+  public:
+    InheritedAttributesTestCase();
+    ~InheritedAttributesTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+InheritedAttributesTestCase::InheritedAttributesTestCase()
+    : TestCase("Check inherited Attributes")
+{
+}
+
+InheritedAttributesTestCase::~InheritedAttributesTestCase()
+{
+}
+
+void
+InheritedAttributesTestCase::DoRun()
+{
+    TypeId tid = InheritedAttributeDerived::GetTypeId();
+    auto attributes = tid.GetInheritedAttributes();
+    NS_TEST_ASSERT_MSG_EQ(attributes->size(), 3, "Unexpected number of attributes");
+    NS_TEST_EXPECT_MSG_EQ((*attributes)[0].fullName,
+                          "InheritedAttributeDerived::Derived",
+                          "The attributes of the derived class should come first");
+    NS_TEST_EXPECT_MSG_EQ((*attributes)[1].fullName,
+                          "InheritedAttributeDerived::FromString",
+                          "The attributes should keep their order");
+    NS_TEST_EXPECT_MSG_EQ((*attributes)[2].fullName,
+                          "InheritedAttributeBase::Base",
+                          "The attributes of the base class should come last");
+    NS_TEST_EXPECT_MSG_EQ((*attributes)[0].isInitialValueValid,
+                          true,
+                          "An integer should be a valid initial value");
+    NS_TEST_EXPECT_MSG_EQ((*attributes)[1].isInitialValueValid,
+                          false,
+                          "A string should need a conversion");
+    NS_TEST_EXPECT_MSG_EQ(tid.GetInheritedAttributes(),
+                          attributes,
+                          "The attributes should be built once");
+
+    TypeId::AttributeInformation info;
+    NS_TEST_EXPECT_MSG_EQ(tid.LookupAttributeByName("Base", &info),
+                          true,
+                          "The attribute of the base class should be found");
+    NS_TEST_EXPECT_MSG_EQ(tid.LookupAttributeByName("Other", &info),
+                          false,
+                          "An unknown attribute should not be found");
+
+    Ptr<InheritedAttributeDerived> object = CreateObject<InheritedAttributeDerived>();
+    NS_TEST_EXPECT_MSG_EQ(object->m_base, 1, "Base not constructed from its initial value");
+    NS_TEST_EXPECT_MSG_EQ(object->m_derived, 2, "Derived not constructed from its initial value");
+    NS_TEST_EXPECT_MSG_EQ(object->m_fromString, 3, "FromString not converted from a string");
+
+    // A new initial value builds the attributes again, leaving the previous ones
+    Config::SetDefault("InheritedAttributeDerived::Base", IntegerValue(4));
+    auto newAttributes = tid.GetInheritedAttributes();
+    NS_TEST_EXPECT_MSG_NE(newAttributes, attributes, "The attributes should be built again");
+    NS_TEST_EXPECT_MSG_EQ((*attributes)[2].info.initialValue->SerializeToString(
+                              (*attributes)[2].info.checker),
+                          "1",
+                          "The previous attributes should be unchanged");
+
+    ObjectFactory factory("InheritedAttributeDerived");
+    factory.Set("Derived", IntegerValue(5));
+    Ptr<InheritedAttributeDerived> created = factory.Create<InheritedAttributeDerived>();
+    NS_TEST_EXPECT_MSG_EQ(created->m_base, 4, "Base not constructed from its new initial value");
+    NS_TEST_EXPECT_MSG_EQ(created->m_derived, 5, "Derived not constructed from the factory");
+    NS_TEST_EXPECT_MSG_EQ(created->m_fromString, 3, "FromString not converted from a string");
+
+    Config::SetDefault("InheritedAttributeDerived::Base", IntegerValue(1));
+}
+
 /**
  * @ingroup typeid-tests
  *
@@ -424,6 +572,83 @@ LookupTimeTestCase::Report(const std::string how, const uint32_t delta) const
               << "ticks: " << delta << "\tper: " << per << " microsec/lookup" << std::endl;
 }
 
+/**
+ * @ingroup typeid-tests
+ *
+ * Performance test: measure average object construction time.
+ */
+class ConstructionTimeTestCase : public TestCase
+{
+  public:
+    ConstructionTimeTestCase();
+    ~ConstructionTimeTestCase() override;
+
+  private:
+    void DoRun() override;
+    /**
+     * Report the performance test results.
+     * @param how How the objects are created.
+     * @param delta The time required for the creations.
+     */
+    void Report(const std::string how, const uint32_t delta) const;
+
+    /// Number of repetitions
+    static constexpr uint32_t REPETITIONS{1000000};
+};
+
+ConstructionTimeTestCase::ConstructionTimeTestCase()
+    : TestCase("Measure average construction time")
+{
+}
+
+ConstructionTimeTestCase::~ConstructionTimeTestCase()
+{
+}
+
+void
+ConstructionTimeTestCase::DoRun()
+{
+    std::cout << suite << std::endl;
+    std::cout << suite << GetName() << std::endl;
+
+    int start = clock();
+    for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+        Ptr<InheritedAttributeDerived> object = CreateObject<InheritedAttributeDerived>();
+    }
+    int stop = clock();
+    Report("CreateObject", stop - start);
+
+    ObjectFactory factory("InheritedAttributeDerived");
+    factory.Set("Derived", IntegerValue(5));
+    start = clock();
+    for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+        Ptr<Object> object = factory.Create();
+    }
+    stop = clock();
+    Report("ObjectFactory", stop - start);
+
+    TypeId tid = InheritedAttributeDerived::GetTypeId();
+    TypeId::AttributeInformation info;
+    start = clock();
+    for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+        tid.LookupAttributeByName("Base", &info);
+    }
+    stop = clock();
+    Report("LookupAttributeByName", stop - start);
+}
+
+void
+ConstructionTimeTestCase::Report(const std::string how, const uint32_t delta) const
+{
+    double per = 1E6 * double(delta) / (REPETITIONS * double(CLOCKS_PER_SEC));
+
+    std::cout << suite << "Construction time: by " << how << ": "
+              << "ticks: " << delta << "\tper: " << per << " microsec/object" << std::endl;
+}
+
 /**
  * @ingroup typeid-tests
  *
@@ -448,6 +673,7 @@ TypeIdTestSuite::TypeIdTestSuite()
     AddTestCase(new UniqueTypeIdTestCase, Duration::QUICK);
     AddTestCase(new CollisionTestCase, Duration::QUICK);
     AddTestCase(new DeprecatedAttributeTestCase, Duration::QUICK);
+    AddTestCase(new InheritedAttributesTestCase, Duration::QUICK);
 }
 
 /// Static variable for test initialization.
@@ -468,6 +694,7 @@ TypeIdPerformanceSuite::TypeIdPerformanceSuite()
     : TestSuite("type-id-perf", Type::PERFORMANCE)
 {
     AddTestCase(new LookupTimeTestCase, Duration::QUICK);
+    AddTestCase(new ConstructionTimeTestCase, Duration::QUICK);
 }
 
 /// Static variable for test initialization.
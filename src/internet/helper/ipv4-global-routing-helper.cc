@@ -171,4 +171,10 @@ Ipv4GlobalRoutingHelper::RecomputeRoutingTables()
     Ipv4GlobalRouteManager::InitializeRoutes();
 }
 
+void
+Ipv4GlobalRoutingHelper::UpdateRoutingTables()
+{
+    Ipv4GlobalRouteManager::UpdateRoutes();
+}
+
 } // namespace ns3
@@ -63,4 +63,10 @@ Ipv6GlobalRoutingHelper::RecomputeRoutingTables()
     GlobalRouteManager<Ipv6Manager>::InitializeRoutes();
 }
 
+void
+Ipv6GlobalRoutingHelper::UpdateRoutingTables()
+{
+    GlobalRouteManager<Ipv6Manager>::UpdateRoutes();
+}
+
 } // namespace ns3
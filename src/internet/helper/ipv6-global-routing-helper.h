@@ -80,6 +80,19 @@ class Ipv6GlobalRoutingHelper : public Ipv6RoutingHelper
      */
     static void RecomputeRoutingTables();
 
+    /**
+     * @brief Update the routes that were previously installed in a prior call
+     * to PopulateRoutingTables(), RecomputeRoutingTables() or
+     * UpdateRoutingTables(), after a change of the topology.
+     *
+     * The routing tables are the same as with RecomputeRoutingTables(), but
+     * only the routers whose shortest paths may have changed, e.g., after a
+     * point-to-point link failed, compute their routes again.  The other
+     * routers only add or remove the routes to the destinations which
+     * appeared or disappeared.  The order of equal cost routes may differ.
+     */
+    static void UpdateRoutingTables();
+
     /**
      * @brief initialize all nodes as routers. this method queries all the nodes in the simulation
      * and enables ipv6 forwarding on all of them.
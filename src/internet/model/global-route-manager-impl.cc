@@ -24,14 +24,20 @@
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <queue>
+#include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -40,6 +46,20 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * @ingroup globalrouting
+ * @anchor GlobalValueGlobalRoutingThreads
+ * The number of threads computing the global routes.
+ *
+ * Each thread runs the SPF computations of a share of the routers.
+ */
+static GlobalValue g_globalRoutingThreads =
+    GlobalValue("GlobalRoutingThreads",
+                "The number of threads computing the global routes, "
+                "or 0 for one per hardware thread",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
 /**
  * @brief Stream insertion operator.
  *
@@ -105,7 +125,6 @@ SPFVertex<T>::SPFVertex(GlobalRoutingLSA<IpManager>* lsa)
     {
         NS_LOG_LOGIC("Setting m_vertexType to VertexRouter");
         m_vertexType = SPFVertex<T>::VertexRouter;
-        m_node = lsa->GetNode();
     }
     else if (lsa->GetLSType() == GlobalRoutingLSA<IpManager>::NetworkLSA)
     {
@@ -439,6 +458,13 @@ SPFVertex<T>::GetNode() const
     return m_node;
 }
 
+template <typename T>
+void
+SPFVertex<T>::SetNode(Ptr<Node> node)
+{
+    m_node = node;
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerLSDB Implementation
@@ -495,7 +521,28 @@ GlobalRouteManagerLSDB<T>::Insert(IpAddress addr, GlobalRoutingLSA<IpManager>* l
     }
     else
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        auto [inserted, isNew] = m_database.insert(LSDBPair_t(addr, lsa));
+        if (!isNew)
+        {
+            return;
+        }
+        //
+        // Index the transit network link records, keeping the LSA which comes
+        // first in the database for each link data.
+        //
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord<IpManager>* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord<IpManager>::TransitNetwork)
+            {
+                continue;
+            }
+            auto [indexed, isNewData] = m_linkDataIndex.emplace(lr->GetLinkData(), inserted);
+            if (!isNewData && inserted->first < indexed->second->first)
+            {
+                indexed->second = inserted;
+            }
+        }
     }
 }
 
@@ -523,12 +570,10 @@ GlobalRouteManagerLSDB<T>::GetLSA(IpAddress addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -539,21 +584,12 @@ GlobalRouteManagerLSDB<T>::GetLSAByLinkData(IpAddress addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the link data of its transit network link records.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkDataIndex.find(addr);
+    if (i != m_linkDataIndex.end())
     {
-        GlobalRoutingLSA<IpManager>* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
-        {
-            GlobalRoutingLinkRecord<IpManager>* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
-        }
+        return i->second->second;
     }
     return nullptr;
 }
@@ -566,17 +602,27 @@ GlobalRouteManagerLSDB<T>::GetLSAByLinkData(IpAddress addr) const
 
 template <typename T>
 GlobalRouteManagerImpl<T>::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_ownLsdb(true)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB<IpManager>();
 }
 
+template <typename T>
+GlobalRouteManagerImpl<T>::GlobalRouteManagerImpl(GlobalRouteManagerLSDB<IpManager>* lsdb)
+    : m_spfroot(nullptr),
+      m_lsdb(lsdb),
+      m_ownLsdb(false)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+}
+
 template <typename T>
 GlobalRouteManagerImpl<T>::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    if (m_lsdb && m_ownLsdb)
     {
         delete m_lsdb;
     }
@@ -601,25 +647,7 @@ GlobalRouteManagerImpl<T>::DeleteGlobalRoutes()
     NS_LOG_FUNCTION(this);
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
-        Ptr<Node> node = *i;
-        Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
-        if (!router)
-        {
-            continue;
-        }
-        Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        DeleteRoutes(*i);
     }
     if (m_lsdb)
     {
@@ -629,6 +657,31 @@ GlobalRouteManagerImpl<T>::DeleteGlobalRoutes()
     }
 }
 
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::DeleteRoutes(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node);
+    Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+    uint32_t j = 0;
+    uint32_t nRoutes = gr->GetNRoutes();
+    NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
+        gr->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+}
+
 //
 // In order to build the routing database, we need to walk the list of nodes
 // in the system and look for those that support the GlobalRouter interface.
@@ -728,10 +781,20 @@ void
 GlobalRouteManagerImpl<T>::InitializeRoutes()
 {
     NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("About to start SPF calculation");
+    ComputeRoutes(GetRoots());
+    NS_LOG_INFO("Finished SPF calculation");
+}
+
+template <typename T>
+std::vector<typename GlobalRouteManagerImpl<T>::Root>
+GlobalRouteManagerImpl<T>::GetRoots() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Root> roots;
     //
     // Walk the list of nodes in the system.
     //
-    NS_LOG_INFO("About to start SPF calculation");
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -754,10 +817,652 @@ GlobalRouteManagerImpl<T>::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.emplace_back(rtr->GetRouterId(), node);
         }
     }
-    NS_LOG_INFO("Finished SPF calculation");
+    return roots;
+}
+
+template <typename T>
+typename GlobalRouteManagerImpl<T>::RootObjects
+GlobalRouteManagerImpl<T>::GetRootObjects(Ptr<Node> node)
+{
+    RootObjects objects;
+    if (!node)
+    {
+        return objects;
+    }
+    objects.node = PeekPointer(node);
+    objects.ip = PeekPointer(node->GetObject<Ip>());
+    Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
+    if (router)
+    {
+        objects.router = PeekPointer(router);
+        objects.routing = PeekPointer(router->GetRoutingProtocol());
+    }
+    return objects;
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::ComputeRoutes(const std::vector<Root>& roots)
+{
+    NS_LOG_FUNCTION(this << roots.size());
+    UintegerValue threadsValue;
+    g_globalRoutingThreads.GetValue(threadsValue);
+    std::size_t threads = threadsValue.Get();
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    threads = std::min(threads, roots.size());
+    if (threads <= 1)
+    {
+        for (const auto& [routerId, node] : roots)
+        {
+            SPFCalculate(routerId, GetRootObjects(node));
+        }
+        return;
+    }
+
+    //
+    // The SPF computations only read the database, and each one only fills
+    // the forwarding table of its root node: the threads share the database,
+    // and pick the next root to compute until there is none left.  The
+    // objects of the root nodes are looked up here, as GetObject () and the
+    // smart pointers are not thread safe.
+    //
+    NS_LOG_INFO("Running the SPF calculation of " << roots.size() << " routers on " << threads
+                                                  << " threads");
+    std::vector<RootObjects> objects;
+    objects.reserve(roots.size());
+    for (const auto& root : roots)
+    {
+        objects.push_back(GetRootObjects(root.second));
+    }
+    std::atomic<std::size_t> next{0};
+    auto worker = [this, &roots, &objects, &next]() {
+        GlobalRouteManagerImpl<T> impl(m_lsdb);
+        for (std::size_t i = next++; i < roots.size(); i = next++)
+        {
+            impl.SPFCalculate(roots[i].first, objects[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+}
+
+//
+// After a change of topology, most shortest path trees are usually the same:
+// when a point-to-point link fails, only the trees which used the link change.
+// The routes of the routers whose tree does not change differ only by the
+// destinations which the change made appear or disappear, i.e., the addresses
+// and networks of the link.  Their routes toward a destination use the same
+// exits as toward the routers advertising it, which the host routes to the
+// other addresses of these routers give.
+//
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::UpdateRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    GlobalRouteManagerLSDB<IpManager>* oldLsdb = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB<IpManager>();
+    BuildGlobalRoutingDatabase();
+
+    std::vector<Root> roots = GetRoots();
+    DatabaseChanges changes;
+    if (!DiffDatabases(*oldLsdb, changes))
+    {
+        NS_LOG_INFO("The routing database changed too much, computing all the routes again");
+        delete oldLsdb;
+        for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+        {
+            DeleteRoutes(*i);
+        }
+        ComputeRoutes(roots);
+        return;
+    }
+    NS_LOG_INFO(changes.routers.size() << " router LSAs changed");
+
+    //
+    // The routers whose LSA changed, their neighbors, and the routers at the
+    // other end of the links which changed compute their tree again.
+    //
+    std::set<IpAddress> rerun(changes.routers);
+    for (const auto& routerId : changes.routers)
+    {
+        for (const GlobalRouteManagerLSDB<IpManager>* lsdb : {oldLsdb, m_lsdb})
+        {
+            GlobalRoutingLSA<IpManager>* lsa = lsdb->GetLSA(routerId);
+            for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+            {
+                GlobalRoutingLinkRecord<IpManager>* l = lsa->GetLinkRecord(j);
+                if (l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::PointToPoint)
+                {
+                    rerun.insert(l->GetLinkId());
+                }
+            }
+        }
+    }
+    std::set<IpAddress> targets;
+    for (const auto links : {&changes.removedLinks, &changes.addedLinks})
+    {
+        for (const auto& link : *links)
+        {
+            rerun.insert(link.to);
+            targets.insert(link.from);
+            targets.insert(link.to);
+        }
+    }
+
+    //
+    // The tree of another router changes if a link which disappeared was on
+    // a shortest path, or if a link which appeared is on a path no longer
+    // than the shortest one.
+    //
+    auto distances = GetDistancesTo(*oldLsdb, targets);
+    const uint64_t infinity = std::numeric_limits<uint64_t>::max();
+    auto getDistance = [&distances, infinity](IpAddress from, IpAddress to) {
+        const auto& toTarget = distances[to];
+        auto distance = toTarget.find(from);
+        return distance == toTarget.end() ? infinity : distance->second;
+    };
+    std::vector<Root> rerunRoots;
+    for (const auto& root : roots)
+    {
+        bool changed = rerun.count(root.first);
+        //
+        // The stub routers only get a default route, which CheckForStubNode()
+        // computes cheaply.
+        //
+        GlobalRoutingLSA<IpManager>* lsa = m_lsdb->GetLSA(root.first);
+        uint32_t transits = 0;
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            if (lsa->GetLinkRecord(j)->GetLinkType() !=
+                GlobalRoutingLinkRecord<IpManager>::StubNetwork)
+            {
+                transits++;
+            }
+        }
+        changed = changed || transits <= 1;
+        for (const auto& link : changes.removedLinks)
+        {
+            uint64_t distance = getDistance(root.first, link.from);
+            changed = changed || (distance != infinity &&
+                                  distance + link.metric == getDistance(root.first, link.to));
+        }
+        for (const auto& link : changes.addedLinks)
+        {
+            uint64_t distance = getDistance(root.first, link.from);
+            changed = changed || (distance != infinity &&
+                                  distance + link.metric <= getDistance(root.first, link.to));
+        }
+        if (changed || !PatchRoutes(root, changes))
+        {
+            rerunRoots.push_back(root);
+        }
+    }
+    delete oldLsdb;
+
+    NS_LOG_INFO("Computing the routes of " << rerunRoots.size() << " of " << roots.size()
+                                           << " routers again");
+    for (const auto& root : rerunRoots)
+    {
+        DeleteRoutes(root.second);
+    }
+    ComputeRoutes(rerunRoots);
+}
+
+template <typename T>
+bool
+GlobalRouteManagerImpl<T>::DiffDatabases(const GlobalRouteManagerLSDB<IpManager>& oldLsdb,
+                                         DatabaseChanges& changes) const
+{
+    NS_LOG_FUNCTION(this << &oldLsdb);
+    if (oldLsdb.GetNumExtLSAs() > 0 || m_lsdb->GetNumExtLSAs() > 0 ||
+        oldLsdb.m_database.size() != m_lsdb->m_database.size())
+    {
+        return false;
+    }
+
+    auto isSame = [](GlobalRoutingLinkRecord<IpManager>* a, GlobalRoutingLinkRecord<IpManager>* b) {
+        return a->GetLinkType() == b->GetLinkType() && a->GetLinkId() == b->GetLinkId() &&
+               a->GetLinkData() == b->GetLinkData() && a->GetMetric() == b->GetMetric() &&
+               a->GetLinkLocData() == b->GetLinkLocData();
+    };
+    //
+    // Removes the records found in both lists, leaving the records which
+    // disappeared in the first one and returning the records which appeared.
+    //
+    auto diff = [&isSame](std::vector<GlobalRoutingLinkRecord<IpManager>*>& oldRecords,
+                          const std::vector<GlobalRoutingLinkRecord<IpManager>*>& newRecords) {
+        std::vector<GlobalRoutingLinkRecord<IpManager>*> added;
+        for (auto record : newRecords)
+        {
+            auto found = std::find_if(oldRecords.begin(), oldRecords.end(), [&](auto oldRecord) {
+                return isSame(oldRecord, record);
+            });
+            if (found == oldRecords.end())
+            {
+                added.push_back(record);
+            }
+            else
+            {
+                oldRecords.erase(found);
+            }
+        }
+        return added;
+    };
+    auto addStub = [&changes](GlobalRoutingLinkRecord<IpManager>* l) {
+        auto network = GetStubNetwork(l);
+        auto found = std::find_if(changes.stubs.begin(), changes.stubs.end(), [&](auto& stub) {
+            return stub.first == network;
+        });
+        if (found == changes.stubs.end())
+        {
+            changes.stubs.emplace_back(network, std::vector<Advertiser>());
+        }
+    };
+
+    std::map<IpAddress, uint32_t> linkDataCount;
+    for (auto i = oldLsdb.m_database.begin(), j = m_lsdb->m_database.begin();
+         i != oldLsdb.m_database.end();
+         i++, j++)
+    {
+        GlobalRoutingLSA<IpManager>* oldLsa = i->second;
+        GlobalRoutingLSA<IpManager>* newLsa = j->second;
+        if (i->first != j->first || oldLsa->GetLSType() != newLsa->GetLSType())
+        {
+            return false;
+        }
+        if (newLsa->GetLSType() == GlobalRoutingLSA<IpManager>::NetworkLSA)
+        {
+            if (oldLsa->GetNetworkLSANetworkMask() != newLsa->GetNetworkLSANetworkMask() ||
+                oldLsa->GetNAttachedRouters() != newLsa->GetNAttachedRouters())
+            {
+                return false;
+            }
+            for (uint32_t k = 0; k < newLsa->GetNAttachedRouters(); k++)
+            {
+                if (oldLsa->GetAttachedRouter(k) != newLsa->GetAttachedRouter(k))
+                {
+                    return false;
+                }
+            }
+            continue;
+        }
+        if (newLsa->GetLSType() != GlobalRoutingLSA<IpManager>::RouterLSA)
+        {
+            return false;
+        }
+
+        // Sort the link records of the router by type
+        std::map<typename GlobalRoutingLinkRecord<IpManager>::LinkType,
+                 std::vector<GlobalRoutingLinkRecord<IpManager>*>>
+            oldRecords;
+        std::map<typename GlobalRoutingLinkRecord<IpManager>::LinkType,
+                 std::vector<GlobalRoutingLinkRecord<IpManager>*>>
+            newRecords;
+        for (uint32_t k = 0; k < oldLsa->GetNLinkRecords(); k++)
+        {
+            GlobalRoutingLinkRecord<IpManager>* l = oldLsa->GetLinkRecord(k);
+            oldRecords[l->GetLinkType()].push_back(l);
+        }
+        for (uint32_t k = 0; k < newLsa->GetNLinkRecords(); k++)
+        {
+            GlobalRoutingLinkRecord<IpManager>* l = newLsa->GetLinkRecord(k);
+            newRecords[l->GetLinkType()].push_back(l);
+            if (l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::PointToPoint)
+            {
+                linkDataCount[l->GetLinkData()]++;
+            }
+        }
+        for (const auto& [type, records] : newRecords)
+        {
+            if (type != GlobalRoutingLinkRecord<IpManager>::PointToPoint &&
+                type != GlobalRoutingLinkRecord<IpManager>::StubNetwork)
+            {
+                auto& previous = oldRecords[type];
+                if (!std::equal(records.begin(),
+                                records.end(),
+                                previous.begin(),
+                                previous.end(),
+                                isSame))
+                {
+                    return false;
+                }
+            }
+        }
+        for (const auto& [type, records] : oldRecords)
+        {
+            if (type != GlobalRoutingLinkRecord<IpManager>::PointToPoint &&
+                type != GlobalRoutingLinkRecord<IpManager>::StubNetwork && !records.empty() &&
+                newRecords[type].empty())
+            {
+                return false;
+            }
+        }
+
+        auto& removedLinks = oldRecords[GlobalRoutingLinkRecord<IpManager>::PointToPoint];
+        auto addedLinks =
+            diff(removedLinks, newRecords[GlobalRoutingLinkRecord<IpManager>::PointToPoint]);
+        auto& removedStubs = oldRecords[GlobalRoutingLinkRecord<IpManager>::StubNetwork];
+        auto addedStubs =
+            diff(removedStubs, newRecords[GlobalRoutingLinkRecord<IpManager>::StubNetwork]);
+        if (removedLinks.empty() && addedLinks.empty() && removedStubs.empty() &&
+            addedStubs.empty())
+        {
+            continue;
+        }
+        NS_LOG_LOGIC("Router LSA " << i->first << " changed");
+        changes.routers.insert(i->first);
+        for (const auto& [records, links] : {std::pair(&removedLinks, &changes.removedLinks),
+                                             std::pair(&addedLinks, &changes.addedLinks)})
+        {
+            for (auto l : *records)
+            {
+                links->push_back({i->first, l->GetLinkId(), l->GetMetric()});
+                if (l->GetLinkData() != IpAddress::GetZero())
+                {
+                    changes.hosts[l->GetLinkData()];
+                }
+            }
+        }
+        for (auto l : removedStubs)
+        {
+            addStub(l);
+        }
+        for (auto l : addedStubs)
+        {
+            addStub(l);
+        }
+    }
+
+    //
+    // Find the routers advertising the destinations which changed.  The
+    // stub networks must not be transit networks too, whose routes would
+    // be mixed.
+    //
+    std::map<IpAddress, IpAddress> anchors;
+    auto getAnchor = [&](GlobalRoutingLSA<IpManager>* lsa) {
+        auto [anchor, isNew] = anchors.emplace(lsa->GetLinkStateId(), IpAddress::GetZero());
+        for (uint32_t k = 0; isNew && k < lsa->GetNLinkRecords(); k++)
+        {
+            GlobalRoutingLinkRecord<IpManager>* l = lsa->GetLinkRecord(k);
+            if (l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::PointToPoint &&
+                l->GetLinkData() != IpAddress::GetZero() && linkDataCount[l->GetLinkData()] == 1 &&
+                !changes.hosts.count(l->GetLinkData()))
+            {
+                anchor->second = l->GetLinkData();
+                break;
+            }
+        }
+        return Advertiser(lsa->GetLinkStateId(), anchor->second);
+    };
+    for (const auto& [id, lsa] : m_lsdb->m_database)
+    {
+        if (lsa->GetLSType() == GlobalRoutingLSA<IpManager>::NetworkLSA)
+        {
+            IpMaskOrPrefix mask = lsa->GetNetworkLSANetworkMask();
+            IpAddress network;
+            if constexpr (IsIpv4)
+            {
+                network = lsa->GetLinkStateId().CombineMask(mask);
+            }
+            else
+            {
+                network = lsa->GetLinkStateId().CombinePrefix(mask);
+            }
+            for (const auto& stub : changes.stubs)
+            {
+                if (stub.first == std::pair(network, mask))
+                {
+                    return false;
+                }
+            }
+            continue;
+        }
+        for (uint32_t k = 0; k < lsa->GetNLinkRecords(); k++)
+        {
+            GlobalRoutingLinkRecord<IpManager>* l = lsa->GetLinkRecord(k);
+            if (l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::PointToPoint)
+            {
+                auto host = changes.hosts.find(l->GetLinkData());
+                if (host != changes.hosts.end())
+                {
+                    host->second.push_back(getAnchor(lsa));
+                }
+            }
+            else if (l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::StubNetwork)
+            {
+                auto network = GetStubNetwork(l);
+                for (auto& stub : changes.stubs)
+                {
+                    if (stub.first == network)
+                    {
+                        stub.second.push_back(getAnchor(lsa));
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::map<typename GlobalRouteManagerImpl<T>::IpAddress,
+         std::map<typename GlobalRouteManagerImpl<T>::IpAddress, uint64_t>>
+GlobalRouteManagerImpl<T>::GetDistancesTo(const GlobalRouteManagerLSDB<IpManager>& lsdb,
+                                          const std::set<IpAddress>& targets) const
+{
+    NS_LOG_FUNCTION(this << &lsdb << targets.size());
+    //
+    // List the edges of the graph of SPFNext() entering each vertex.
+    //
+    using Edge = std::pair<const GlobalRoutingLSA<IpManager>*, uint32_t>;
+    std::unordered_map<const GlobalRoutingLSA<IpManager>*, std::vector<Edge>> incoming;
+    for (const auto& [id, lsa] : lsdb.m_database)
+    {
+        if (lsa->GetLSType() == GlobalRoutingLSA<IpManager>::RouterLSA)
+        {
+            for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+            {
+                GlobalRoutingLinkRecord<IpManager>* l = lsa->GetLinkRecord(j);
+                GlobalRoutingLSA<IpManager>* w_lsa = nullptr;
+                if (l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::PointToPoint ||
+                    l->GetLinkType() == GlobalRoutingLinkRecord<IpManager>::TransitNetwork)
+                {
+                    w_lsa = lsdb.GetLSA(l->GetLinkId());
+                }
+                if (w_lsa)
+                {
+                    incoming[w_lsa].emplace_back(lsa, l->GetMetric());
+                }
+            }
+        }
+        else if (lsa->GetLSType() == GlobalRoutingLSA<IpManager>::NetworkLSA)
+        {
+            for (uint32_t j = 0; j < lsa->GetNAttachedRouters(); j++)
+            {
+                GlobalRoutingLSA<IpManager>* w_lsa =
+                    lsdb.GetLSAByLinkData(lsa->GetAttachedRouter(j));
+                if (w_lsa)
+                {
+                    incoming[w_lsa].emplace_back(lsa, 0);
+                }
+            }
+        }
+    }
+
+    //
+    // Run Dijkstra backward from each target.
+    //
+    std::map<IpAddress, std::map<IpAddress, uint64_t>> distances;
+    for (const auto& target : targets)
+    {
+        auto& toTarget = distances[target];
+        GlobalRoutingLSA<IpManager>* targetLsa = lsdb.GetLSA(target);
+        if (!targetLsa)
+        {
+            continue;
+        }
+        using Candidate = std::pair<uint64_t, const GlobalRoutingLSA<IpManager>*>;
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+        std::unordered_map<const GlobalRoutingLSA<IpManager>*, uint64_t> settled;
+        candidates.emplace(0, targetLsa);
+        while (!candidates.empty())
+        {
+            auto [distance, v] = candidates.top();
+            candidates.pop();
+            if (!settled.emplace(v, distance).second)
+            {
+                continue;
+            }
+            if (v->GetLSType() == GlobalRoutingLSA<IpManager>::RouterLSA)
+            {
+                toTarget[v->GetLinkStateId()] = distance;
+            }
+            auto edges = incoming.find(v);
+            if (edges == incoming.end())
+            {
+                continue;
+            }
+            for (const auto& [w, metric] : edges->second)
+            {
+                if (!settled.count(w))
+                {
+                    candidates.emplace(distance + metric, w);
+                }
+            }
+        }
+    }
+    return distances;
+}
+
+template <typename T>
+bool
+GlobalRouteManagerImpl<T>::PatchRoutes(const Root& root, const DatabaseChanges& changes)
+{
+    NS_LOG_FUNCTION(this << root.first);
+    Ptr<GlobalRouter<IpManager>> router =
+        root.second->template GetObject<GlobalRouter<IpManager>>();
+    NS_ASSERT(router);
+    Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+    NS_ASSERT(gr);
+
+    //
+    // Find the exits toward the routers advertising each destination before
+    // changing the routes.
+    //
+    using Exits = std::vector<typename SPFVertex<T>::NodeExit_t>;
+    auto getExits = [&root, &gr](const std::vector<Advertiser>& advertisers, Exits& exits) {
+        for (const auto& [routerId, anchor] : advertisers)
+        {
+            if (routerId == root.first)
+            {
+                // There are no routes to the local destinations
+                continue;
+            }
+            if (anchor == IpAddress::GetZero())
+            {
+                return false;
+            }
+            if (auto routes = gr->m_hostIndex.Find(anchor, gr->m_hostIndex.ADDRESS_BITS))
+            {
+                for (auto route : *routes)
+                {
+                    exits.emplace_back((*route)->GetGateway(), (*route)->GetInterface());
+                }
+            }
+        }
+        return true;
+    };
+    std::vector<Exits> hostExits(changes.hosts.size());
+    auto hostExit = hostExits.begin();
+    for (const auto& [host, advertisers] : changes.hosts)
+    {
+        if (!getExits(advertisers, *hostExit++))
+        {
+            return false;
+        }
+    }
+    std::vector<Exits> stubExits(changes.stubs.size());
+    auto stubExit = stubExits.begin();
+    for (const auto& [network, advertisers] : changes.stubs)
+    {
+        if (!getExits(advertisers, *stubExit++))
+        {
+            return false;
+        }
+    }
+
+    hostExit = hostExits.begin();
+    for (const auto& [host, advertisers] : changes.hosts)
+    {
+        gr->RemoveHostRoutesTo(host);
+        for (const auto& [nextHop, outIf] : *hostExit++)
+        {
+            gr->AddHostRouteTo(host, nextHop, outIf);
+        }
+    }
+    stubExit = stubExits.begin();
+    for (const auto& [network, advertisers] : changes.stubs)
+    {
+        gr->RemoveNetworkRoutesTo(network.first, network.second);
+        for (const auto& [nextHop, outIf] : *stubExit++)
+        {
+            gr->AddNetworkRouteTo(network.first, network.second, nextHop, outIf);
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::pair<typename GlobalRouteManagerImpl<T>::IpAddress,
+          typename GlobalRouteManagerImpl<T>::IpMaskOrPrefix>
+GlobalRouteManagerImpl<T>::GetStubNetwork(GlobalRoutingLinkRecord<IpManager>* l)
+{
+    IpMaskOrPrefix mask;
+    if constexpr (IsIpv4)
+    {
+        mask = Ipv4Mask(l->GetLinkData().Get());
+        return {l->GetLinkId().CombineMask(mask), mask};
+    }
+    else
+    {
+        // to get the Prefix from the Ipv6Address
+        uint8_t buf[16];
+        l->GetLinkData().GetBytes(buf);
+        mask = Ipv6Prefix(buf);
+        return {l->GetLinkId().CombinePrefix(mask), mask};
+    }
+}
+
+template <typename T>
+typename GlobalRouteManagerImpl<T>::SPFStatus
+GlobalRouteManagerImpl<T>::GetStatus(const GlobalRoutingLSA<IpManager>* lsa) const
+{
+    auto status = m_status.find(lsa);
+    return status == m_status.end() ? GlobalRoutingLSA<IpManager>::LSA_SPF_NOT_EXPLORED
+                                    : status->second;
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::SetStatus(const GlobalRoutingLSA<IpManager>* lsa, SPFStatus status)
+{
+    m_status[lsa] = status;
 }
 
 //
@@ -866,7 +1571,7 @@ GlobalRouteManagerImpl<T>::SPFNext(SPFVertex<T>* v, CandidateQueue<T>& candidate
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE)
+        if (GetStatus(w_lsa) == GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -890,7 +1595,7 @@ GlobalRouteManagerImpl<T>::SPFNext(SPFVertex<T>* v, CandidateQueue<T>& candidate
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA<IpManager>::LSA_SPF_NOT_EXPLORED)
+        if (GetStatus(w_lsa) == GlobalRoutingLSA<IpManager>::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -902,7 +1607,7 @@ GlobalRouteManagerImpl<T>::SPFNext(SPFVertex<T>* v, CandidateQueue<T>& candidate
             w = new SPFVertex<T>(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA<IpManager>::LSA_SPF_CANDIDATE);
+                SetStatus(w_lsa, GlobalRoutingLSA<IpManager>::LSA_SPF_CANDIDATE);
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -917,7 +1622,7 @@ GlobalRouteManagerImpl<T>::SPFNext(SPFVertex<T>* v, CandidateQueue<T>& candidate
                 NS_ASSERT_MSG(0, "SPFNexthopCalculation never return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA<IpManager>::LSA_SPF_CANDIDATE)
+        else if (GetStatus(w_lsa) == GlobalRoutingLSA<IpManager>::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -1373,10 +2078,7 @@ GlobalRouteManagerImpl<T>::CheckForStubNode(IpAddress root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter<IpManager>> router =
-                        rlsa->GetNode()->template GetObject<GlobalRouter<IpManager>>();
-                    NS_ASSERT(router);
-                    Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+                    IpGlobalRouting* gr = m_rootObjects.routing;
                     NS_ASSERT(gr);
                     if constexpr (IsIpv4)
                     {
@@ -1416,12 +2118,23 @@ void
 GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
 {
     NS_LOG_FUNCTION(this << root);
+    SPFCalculate(root,
+                 GetRootObjects(NodeList::GetNNodes() > 0 ? m_lsdb->GetLSA(root)->GetNode()
+                                                          : nullptr));
+}
+
+template <typename T>
+void
+GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root, const RootObjects& objects)
+{
+    NS_LOG_FUNCTION(this << root << objects.node);
 
     SPFVertex<T>* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the status of the Link State Advertisements, which is kept
+    // apart from the shared Link State Database.
     //
-    m_lsdb->Initialize();
+    m_status.clear();
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1440,8 +2153,9 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
     // We also mark this vertex as being in the SPF tree.
     //
     m_spfroot = v;
+    m_rootObjects = objects;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE);
+    SetStatus(v->GetLSA(), GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE);
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
 
     //
@@ -1451,7 +2165,7 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (objects.node && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
@@ -1502,7 +2216,7 @@ GlobalRouteManagerImpl<T>::SPFCalculate(IpAddress root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE);
+        SetStatus(v->GetLSA(), GlobalRoutingLSA<IpManager>::LSA_SPF_IN_SPFTREE);
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
@@ -1636,7 +2350,7 @@ GlobalRouteManagerImpl<T>::SPFAddASExternal(GlobalRoutingLSA<IpManager>* extlsa,
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Node* node = m_rootObjects.node;
 
     if (!node)
     {
@@ -1648,7 +2362,7 @@ GlobalRouteManagerImpl<T>::SPFAddASExternal(GlobalRoutingLSA<IpManager>* extlsa,
     // to QI for that interface.  If there's no GlobalRouter interface, the node
     // in question cannot be the router we want, so we continue.
     //
-    Ptr<GlobalRouter<T>> router = node->GetObject<GlobalRouter<T>>();
+    GlobalRouter<IpManager>* router = m_rootObjects.router;
     NS_ASSERT_MSG(router, "No GlobalRouter interface on SPF root node " << node->GetId());
     //
     // If the router ID of the current node is equal to the router ID of the
@@ -1663,7 +2377,7 @@ GlobalRouteManagerImpl<T>::SPFAddASExternal(GlobalRoutingLSA<IpManager>* extlsa,
         // for that interface.  If the node is acting as an IP version 4 router, it
         // should absolutely have an Ipv4 interface.
         //
-        Ptr<Ip> ipv4 = node->GetObject<Ip>();
+        Ip* ipv4 = m_rootObjects.ip;
         NS_ASSERT_MSG(ipv4,
                       "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
                       "QI for <Ipv4> interface failed");
@@ -1701,11 +2415,7 @@ GlobalRouteManagerImpl<T>::SPFAddASExternal(GlobalRoutingLSA<IpManager>* extlsa,
         // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
         // which the packets should be send for forwarding.
         //
-        Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
-
-        NS_ASSERT_MSG(router, "No GlobalRouter interface on node " << node->GetId());
-
-        Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+        IpGlobalRouting* gr = m_rootObjects.routing;
         NS_ASSERT(gr);
         // walk through all next-hop-IPs and out-going-interfaces for reaching
         // the stub network gateway 'v' from the root node
@@ -1808,7 +2518,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddStub(GlobalRoutingLinkRecord<IpManager>* l
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Node* node = m_rootObjects.node;
     if (!node)
     {
         NS_LOG_ERROR("SPFIntraAddStub():Can't find root node " << routerId);
@@ -1819,7 +2529,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddStub(GlobalRoutingLinkRecord<IpManager>* l
     // to QI for that interface.  If there's no GlobalRouter interface, the node
     // in question cannot be the router we want, so we continue.
     //
-    Ptr<GlobalRouter<T>> router = node->GetObject<GlobalRouter<T>>();
+    GlobalRouter<IpManager>* router = m_rootObjects.router;
     NS_ASSERT_MSG(router, "No GlobalRouter interface on node " << node->GetId());
     //
     // If the router ID of the current node is equal to the router ID of the
@@ -1834,7 +2544,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddStub(GlobalRoutingLinkRecord<IpManager>* l
         // for that interface.  If the node is acting as an IP version 4 router, it
         // should absolutely have an Ipv4 interface.
         //
-        Ptr<Ip> ip = node->GetObject<Ip>();
+        Ip* ip = m_rootObjects.ip;
         NS_ASSERT_MSG(ip,
                       "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
                       "QI for <Ipv4> interface failed");
@@ -1882,10 +2592,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddStub(GlobalRoutingLinkRecord<IpManager>* l
         // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
         // which the packets should be send for forwarding.
         //
-
-        Ptr<GlobalRouter<T>> router = node->GetObject<GlobalRouter<T>>();
-
-        Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+        IpGlobalRouting* gr = m_rootObjects.routing;
         NS_ASSERT(gr);
         // walk through all next-hop-IPs and out-going-interfaces for reaching
         // the stub network gateway 'v' from the root node
@@ -1941,7 +2648,7 @@ GlobalRouteManagerImpl<T>::FindOutgoingInterfaceId(IpAddress a, IpMaskOrPrefix a
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Node* node = m_rootObjects.node;
     if (!node)
     {
         //
@@ -1951,7 +2658,7 @@ GlobalRouteManagerImpl<T>::FindOutgoingInterfaceId(IpAddress a, IpMaskOrPrefix a
         return -1;
     }
 
-    Ptr<GlobalRouter<IpManager>> rtr = node->GetObject<GlobalRouter<IpManager>>();
+    GlobalRouter<IpManager>* rtr = m_rootObjects.router;
     NS_ASSERT_MSG(rtr, "No GlobalRouter interface on node " << node->GetId());
     //
     // If the node doesn't have a GlobalRouter interface it can't be the one
@@ -1966,7 +2673,7 @@ GlobalRouteManagerImpl<T>::FindOutgoingInterfaceId(IpAddress a, IpMaskOrPrefix a
         // is participating in routing IP version 4 packets, it certainly must have
         // an Ipv4 interface.
         //
-        Ptr<Ip> ip = node->GetObject<Ip>();
+        Ip* ip = m_rootObjects.ip;
         NS_ASSERT_MSG(ip,
                       "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
                       "GetObject for <Ipv4> interface failed");
@@ -2029,7 +2736,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddRouter(SPFVertex<T>* v)
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Node* node = m_rootObjects.node;
     if (!node)
     {
         NS_LOG_ERROR("SPFIntraAddRouter():Can't find root node " << routerId);
@@ -2041,7 +2748,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddRouter(SPFVertex<T>* v)
     // to GetObject for that interface.  If there's no GlobalRouter interface,
     // the node in question cannot be the router we want, so we continue.
     //
-    Ptr<GlobalRouter<T>> rtr = node->GetObject<GlobalRouter<T>>();
+    GlobalRouter<IpManager>* rtr = m_rootObjects.router;
     NS_ASSERT_MSG(rtr, "No GlobalRouter interface on node " << node->GetId());
     //
     // If the router ID of the current node is equal to the router ID of the
@@ -2057,7 +2764,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddRouter(SPFVertex<T>* v)
         // GetObject for that interface.  If the node is acting as an IP version 4
         // router, it should absolutely have an Ipv4 interface.
         //
-        Ptr<Ip> ip = node->GetObject<Ip>();
+        Ip* ip = m_rootObjects.ip;
         NS_ASSERT_MSG(ip,
                       "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
                       "GetObject for <Ipv4> interface failed");
@@ -2107,12 +2814,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddRouter(SPFVertex<T>* v)
             // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
             // which the packets should be send for forwarding.
             //
-            Ptr<GlobalRouter<IpManager>> router = node->GetObject<GlobalRouter<IpManager>>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+            IpGlobalRouting* gr = m_rootObjects.routing;
             NS_ASSERT(gr);
             // walk through all available exit directions due to ECMP,
             // and add host route for each of the exit direction toward
@@ -2179,7 +2881,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddTransit(SPFVertex<T>* v)
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Node* node = m_rootObjects.node;
     if (!node)
     {
         NS_LOG_ERROR("SPFIntraAddTransit():Can't find root node " << routerId);
@@ -2191,7 +2893,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddTransit(SPFVertex<T>* v)
     // to GetObject for that interface.  If there's no GlobalRouter interface,
     // the node in question cannot be the router we want, so we continue.
     //
-    Ptr<GlobalRouter<T>> rtr = node->GetObject<GlobalRouter<T>>();
+    GlobalRouter<IpManager>* rtr = m_rootObjects.router;
     NS_ASSERT_MSG(rtr, "No GlobalRouter interface on node " << node->GetId());
     //
     // If the router ID of the current node is equal to the router ID of the
@@ -2207,7 +2909,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddTransit(SPFVertex<T>* v)
         // GetObject for that interface.  If the node is acting as an IP version 4
         // router, it should absolutely have an Ipv4 interface.
         //
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        Ip* ipv4 = m_rootObjects.ip;
         NS_ASSERT_MSG(ipv4,
                       "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
                       "GetObject for <Ipv4> interface failed");
@@ -2231,8 +2933,7 @@ GlobalRouteManagerImpl<T>::SPFIntraAddTransit(SPFVertex<T>* v)
         {
             tempip = tempip.CombinePrefix(tempmask);
         }
-        Ptr<GlobalRouter<T>> router = node->GetObject<GlobalRouter<T>>();
-        Ptr<GlobalRouting<IpRoutingProtocol>> gr = router->GetRoutingProtocol();
+        IpGlobalRouting* gr = m_rootObjects.routing;
         NS_ASSERT(gr);
         // walk through all available exit directions due to ECMP,
         // and add host route for each of the exit direction toward
@@ -27,7 +27,9 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -568,10 +570,19 @@ class SPFVertex
 
     /**
      * @brief Get the node pointer corresponding to this Vertex
+     *
+     * Only the root of a shortest path tree is given its node.
+     *
      * @returns the node pointer corresponding to this Vertex
      */
     Ptr<Node> GetNode() const;
 
+    /**
+     * @brief Set the node pointer corresponding to this Vertex
+     * @param node the node pointer corresponding to this Vertex
+     */
+    void SetNode(Ptr<Node> node);
+
   private:
     VertexType m_vertexType;                        //!< Vertex type
     IpAddress m_vertexId;                           //!< Vertex ID
@@ -662,6 +673,9 @@ class GlobalRouteManagerLSDB
     /// Alias for Ipv4Mask And Ipv6Prefix
     using IpMaskOrPrefix = typename std::conditional_t<IsIpv4, Ipv4Mask, Ipv6Prefix>;
 
+    template <typename>
+    friend class GlobalRouteManagerImpl;
+
   public:
     /**
      * @brief Construct an empty Global Router Manager Link State Database.
@@ -768,6 +782,8 @@ class GlobalRouteManagerLSDB
         LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
 
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+    /// Link State Advertisements by the link data of their transit network link records
+    std::map<IpAddress, typename LSDBMap_t::const_iterator> m_linkDataIndex;
     std::vector<GlobalRoutingLSA<IpManager>*>
         m_extdatabase; //!< database of External Link State Advertisements
 };
@@ -857,9 +873,31 @@ class GlobalRouteManagerImpl
     /**
      * @brief Compute routes using a Dijkstra SPF computation and populate
      * per-node forwarding tables
+     *
+     * The SPF computations of the routers are spread over the number of
+     * threads set by the "GlobalRoutingThreads" global value.
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Build the routing database again, and update the routes
+     * computed from the previous database.
+     *
+     * When the databases differ by point-to-point and stub link records of
+     * router LSAs only, e.g., after a point-to-point link failed or recovered,
+     * and there are no AS external LSAs, the SPF computation is run again for
+     * the routers whose shortest path tree may have changed, and for the
+     * routers next to the changes.  The routes of the other routers are
+     * patched: the routes to the addresses and networks which appeared or
+     * disappeared are added or removed.  Otherwise, all the routes are
+     * computed again.
+     *
+     * The routes are the same as after a full computation, but the patched
+     * routes to a destination may be in a different order, which matters
+     * only among equal cost routes when random ECMP routing is disabled.
+     */
+    virtual void UpdateRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -909,9 +947,160 @@ class GlobalRouteManagerImpl
     void InitializeRouters();
 
   private:
+    /// A router ID, and the node whose routes the SPF computation rooted at the router fills
+    using Root = std::pair<IpAddress, Ptr<Node>>;
+
+    /**
+     * The objects of the node whose routes an SPF computation fills.  They are
+     * looked up before the computation, which then neither calls GetObject ()
+     * (which reorders the aggregates of the node) nor copies smart pointers
+     * (whose reference counts are not atomic), and can run on a worker thread.
+     */
+    struct RootObjects
+    {
+        Node* node{nullptr};                      //!< the node, or null if there is none
+        GlobalRouter<IpManager>* router{nullptr}; //!< the GlobalRouter of the node
+        IpGlobalRouting* routing{nullptr};        //!< the global routing protocol of the node
+        Ip* ip{nullptr};                          //!< the IP stack of the node
+    };
+
+    /// The status of the Link State Advertisements during an SPF computation
+    using SPFStatus = typename GlobalRoutingLSA<IpManager>::SPFStatus;
+
+    /// A point-to-point link between two routers, from the router advertising it
+    struct Link
+    {
+        IpAddress from;  //!< the router ID of the router advertising the link
+        IpAddress to;    //!< the router ID of the router at the other end
+        uint16_t metric; //!< the metric of the link
+    };
+
+    /**
+     * A router advertising a destination: its router ID, and the address of
+     * one of its point-to-point links which no other router advertises, or
+     * zero if there is none.  The host routes to this address give the exits
+     * toward the router.
+     */
+    using Advertiser = std::pair<IpAddress, IpAddress>;
+
+    /// The changes between two routing databases, see UpdateRoutes()
+    struct DatabaseChanges
+    {
+        std::set<IpAddress> routers;    //!< the routers whose LSA changed
+        std::vector<Link> removedLinks; //!< the point-to-point links which disappeared
+        std::vector<Link> addedLinks;   //!< the point-to-point links which appeared
+        /// The addresses of the point-to-point links which appeared or
+        /// disappeared, and the routers advertising them now
+        std::map<IpAddress, std::vector<Advertiser>> hosts;
+        /// The stub networks which appeared or disappeared, and the routers
+        /// advertising them now
+        std::vector<std::pair<std::pair<IpAddress, IpMaskOrPrefix>, std::vector<Advertiser>>>
+            stubs;
+    };
+
+    /**
+     * @brief Create a route manager computing routes from the database of another.
+     *
+     * This lets threads run SPF computations on a shared, read-only database.
+     *
+     * @param lsdb the database, which stays owned by the other route manager
+     */
+    GlobalRouteManagerImpl(GlobalRouteManagerLSDB<IpManager>* lsdb);
+
+    /**
+     * @brief Get the routers of this system on which to root SPF computations
+     * @returns the routers, by increasing node ID
+     */
+    std::vector<Root> GetRoots() const;
+
+    /**
+     * @brief Look up the objects of the node at the root of an SPF computation
+     * @param node the node, or null
+     * @returns the objects of the node
+     */
+    static RootObjects GetRootObjects(Ptr<Node> node);
+
+    /**
+     * @brief Run the SPF computations rooted at some routers, and fill their
+     * forwarding tables.
+     *
+     * The computations are spread over the number of threads set by the
+     * "GlobalRoutingThreads" global value.
+     *
+     * @param roots the routers
+     */
+    void ComputeRoutes(const std::vector<Root>& roots);
+
+    /**
+     * @brief Delete the global routes of a node
+     * @param node the node
+     */
+    void DeleteRoutes(Ptr<Node> node);
+
+    /**
+     * @brief Compare a previous routing database with the current one.
+     *
+     * @param oldLsdb the previous database
+     * @param changes the changes between the databases
+     * @returns true if the databases only differ by point-to-point and stub
+     * link records of router LSAs
+     */
+    bool DiffDatabases(const GlobalRouteManagerLSDB<IpManager>& oldLsdb,
+                       DatabaseChanges& changes) const;
+
+    /**
+     * @brief Compute the distances from the routers to some routers.
+     *
+     * @param lsdb the database describing the graph
+     * @param targets the router IDs of the destinations
+     * @returns for each destination, the distance from each router reaching
+     * it, by router ID
+     */
+    std::map<IpAddress, std::map<IpAddress, uint64_t>> GetDistancesTo(
+        const GlobalRouteManagerLSDB<IpManager>& lsdb,
+        const std::set<IpAddress>& targets) const;
+
+    /**
+     * @brief Patch the routes of a router whose shortest path tree did not
+     * change, to the destinations which appeared or disappeared.
+     *
+     * @param root the router
+     * @param changes the changes between the databases
+     * @returns false if the routes could not be patched, in which case they
+     * are left unchanged
+     */
+    bool PatchRoutes(const Root& root, const DatabaseChanges& changes);
+
+    /**
+     * @brief Get the network and mask of a stub link record
+     * @param l the stub link record
+     * @returns the network and mask
+     */
+    static std::pair<IpAddress, IpMaskOrPrefix> GetStubNetwork(
+        GlobalRoutingLinkRecord<IpManager>* l);
+
+    /**
+     * @brief Get the SPF status of a Link State Advertisement
+     * @param lsa the Link State Advertisement
+     * @returns the status of the Link State Advertisement in the current SPF computation
+     */
+    SPFStatus GetStatus(const GlobalRoutingLSA<IpManager>* lsa) const;
+
+    /**
+     * @brief Set the SPF status of a Link State Advertisement
+     * @param lsa the Link State Advertisement
+     * @param status the status of the Link State Advertisement in the current SPF computation
+     */
+    void SetStatus(const GlobalRoutingLSA<IpManager>* lsa, SPFStatus status);
+
     SPFVertex<T>* m_spfroot; //!< the root node
+    RootObjects m_rootObjects; //!< the objects of the root node of the current SPF computation
     GlobalRouteManagerLSDB<IpManager>*
         m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_ownLsdb; //!< whether the LSDB is deleted with the Global Route Manager
+    /// The status of the Link State Advertisements in the current SPF computation, kept apart
+    /// from the LSDB so that several computations can share it
+    std::unordered_map<const GlobalRoutingLSA<IpManager>*, SPFStatus> m_status;
 
     /**
      * @brief Test if a node is a stub, from an OSPF sense.
@@ -933,6 +1122,17 @@ class GlobalRouteManagerImpl
      */
     void SPFCalculate(IpAddress root);
 
+    /**
+     * @brief Calculate the shortest path first (SPF) tree
+     *
+     * Only the given objects are accessed, through raw pointers, so that
+     * computations rooted at different nodes can run concurrently.
+     *
+     * @param root the root node
+     * @param objects the objects of the root router, whose forwarding table is filled
+     */
+    void SPFCalculate(IpAddress root, const RootObjects& objects);
+
     /**
      * @brief Process Stub nodes
      *
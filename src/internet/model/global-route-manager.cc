@@ -57,6 +57,15 @@ GlobalRouteManager<T>::InitializeRoutes()
         ->InitializeRoutes();
 }
 
+template <typename T>
+void
+GlobalRouteManager<T>::UpdateRoutes()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    SimulationSingleton<GlobalRouteManagerImpl<typename GlobalRouteManager<T>::IpManager>>::Get()
+        ->UpdateRoutes();
+}
+
 template <typename T>
 uint32_t
 GlobalRouteManager<T>::AllocateRouterId()
@@ -95,6 +95,15 @@ class GlobalRouteManager
      */
     static void InitializeRoutes();
 
+    /**
+     * @brief Build the routing database again, and update the routes computed
+     * from the previous database, running the SPF computation again only for
+     * the routers whose routes may have changed.
+     *
+     * @see GlobalRouteManagerImpl::UpdateRoutes
+     */
+    static void UpdateRoutes();
+
     /**
      * @brief Reset the router ID counter to zero. This should only be called by tests to reset the
      * router ID counter between simulations within the same program. This function should not be
@@ -103,16 +103,7 @@ GlobalRouting<T>::AddHostRouteTo(IpAddress dest, IpAddress nextHop, uint32_t int
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    InsertHostRoute(route);
 }
 
 template <typename T>
@@ -122,16 +113,7 @@ GlobalRouting<T>::AddHostRouteTo(IpAddress dest, uint32_t interface)
     NS_LOG_FUNCTION(this << dest << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateHostRouteTo(dest, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    InsertHostRoute(route);
 }
 
 template <typename T>
@@ -144,16 +126,7 @@ GlobalRouting<T>::AddNetworkRouteTo(IpAddress network,
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    for (auto routePointer : m_networkRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_networkRoutes.push_back(route);
+    InsertNetworkRoute(route);
 }
 
 template <typename T>
@@ -165,16 +138,7 @@ GlobalRouting<T>::AddNetworkRouteTo(IpAddress network,
     NS_LOG_FUNCTION(this << network << networkMask << interface);
     auto route = new IpRoutingTableEntry();
     *route = IpRoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
-    for (auto routePointer : m_networkRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_networkRoutes.push_back(route);
+    InsertNetworkRoute(route);
 }
 
 template <typename T>
@@ -211,11 +175,11 @@ GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
     RouteVec_t allRoutes;
 
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    if (auto routes = m_hostIndex.Find(dest, m_hostIndex.ADDRESS_BITS))
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        for (auto i : *routes)
         {
+            NS_ASSERT((*i)->IsHost());
             if (oif)
             {
                 if (oif != m_ip->GetNetDevice((*i)->GetInterface()))
@@ -231,23 +195,10 @@ GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        // store the length of the longest mask.
-        uint16_t longest_mask = 0;
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-        {
-            IpMaskOrPrefix mask;
-            if constexpr (IsIpv4)
-            {
-                mask = (*j)->GetDestNetworkMask();
-            }
-            else
-            {
-                mask = (*j)->GetDestNetworkPrefix();
-            }
-            uint16_t masklen = mask.GetPrefixLength();
-
-            IpAddress entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+        // keep the routes of the longest matching prefix with routes on the
+        // requested interface
+        m_networkIndex.VisitMatches(dest, [&](const std::vector<NetworkRoutesI>& routes, uint8_t) {
+            for (auto j : routes)
             {
                 if (oif)
                 {
@@ -257,25 +208,11 @@ GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
                         continue;
                     }
                 }
+                allRoutes.push_back(*j);
                 NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-                if (masklen < longest_mask) // Not interested if got shorter mask
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-                else if (masklen == longest_mask)
-                {
-                    NS_LOG_LOGIC("Equal mask length, adding this to the list");
-                    allRoutes.push_back(*j);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("Longer mask length found, clearing the list and adding");
-                    allRoutes.clear();
-                    allRoutes.push_back(*j);
-                }
             }
-        }
+            return !allRoutes.empty();
+        });
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
@@ -346,6 +283,129 @@ GlobalRouting<T>::LookupGlobal(IpAddress dest, Ptr<NetDevice> oif)
     }
 }
 
+template <typename T>
+typename GlobalRouting<T>::IpMaskOrPrefix
+GlobalRouting<T>::GetDestMask(const IpRoutingTableEntry* route)
+{
+    if constexpr (IsIpv4)
+    {
+        return route->GetDestNetworkMask();
+    }
+    else
+    {
+        return route->GetDestNetworkPrefix();
+    }
+}
+
+template <typename T>
+uint8_t
+GlobalRouting<T>::GetIndexLength(const IpMaskOrPrefix& mask)
+{
+    if constexpr (IsIpv4)
+    {
+        return mask.GetPrefixLength();
+    }
+    else
+    {
+        // the declared length of a prefix may exceed the bits it matches
+        return mask.GetMinimumPrefixLength();
+    }
+}
+
+template <typename T>
+void
+GlobalRouting<T>::InsertHostRoute(IpRoutingTableEntry* route)
+{
+    if (auto routes = m_hostIndex.Find(route->GetDest(), m_hostIndex.ADDRESS_BITS))
+    {
+        for (auto i : *routes)
+        {
+            if (**i == *route)
+            {
+                NS_LOG_LOGIC("Route already exists");
+                delete route;
+                return;
+            }
+        }
+    }
+    auto it = m_hostRoutes.insert(m_hostRoutes.end(), route);
+    m_hostIndex.Insert(route->GetDest(), m_hostIndex.ADDRESS_BITS, it);
+}
+
+template <typename T>
+void
+GlobalRouting<T>::InsertNetworkRoute(IpRoutingTableEntry* route)
+{
+    const uint8_t length = GetIndexLength(GetDestMask(route));
+    if (auto routes = m_networkIndex.Find(route->GetDestNetwork(), length))
+    {
+        for (auto j : *routes)
+        {
+            if (**j == *route)
+            {
+                NS_LOG_LOGIC("Route already exists");
+                delete route;
+                return;
+            }
+        }
+    }
+    auto it = m_networkRoutes.insert(m_networkRoutes.end(), route);
+    m_networkIndex.Insert(route->GetDestNetwork(), length, it);
+}
+
+template <typename T>
+typename GlobalRouting<T>::HostRoutesI
+GlobalRouting<T>::EraseHostRoute(HostRoutesI it)
+{
+    IpRoutingTableEntry* route = *it;
+    m_hostIndex.Remove(route->GetDest(), m_hostIndex.ADDRESS_BITS, it);
+    delete route;
+    return m_hostRoutes.erase(it);
+}
+
+template <typename T>
+typename GlobalRouting<T>::NetworkRoutesI
+GlobalRouting<T>::EraseNetworkRoute(NetworkRoutesI it)
+{
+    IpRoutingTableEntry* route = *it;
+    m_networkIndex.Remove(route->GetDestNetwork(), GetIndexLength(GetDestMask(route)), it);
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
+template <typename T>
+void
+GlobalRouting<T>::RemoveHostRoutesTo(IpAddress dest)
+{
+    NS_LOG_FUNCTION(this << dest);
+    while (auto routes = m_hostIndex.Find(dest, m_hostIndex.ADDRESS_BITS))
+    {
+        EraseHostRoute(routes->front());
+    }
+}
+
+template <typename T>
+void
+GlobalRouting<T>::RemoveNetworkRoutesTo(IpAddress network, IpMaskOrPrefix networkMask)
+{
+    NS_LOG_FUNCTION(this << network << networkMask);
+    std::vector<NetworkRoutesI> removed;
+    if (auto routes = m_networkIndex.Find(network, GetIndexLength(networkMask)))
+    {
+        for (auto j : *routes)
+        {
+            if ((*j)->GetDestNetwork() == network && GetDestMask(*j) == networkMask)
+            {
+                removed.push_back(j);
+            }
+        }
+    }
+    for (auto j : removed)
+    {
+        EraseNetworkRoute(j);
+    }
+}
+
 template <typename T>
 uint32_t
 GlobalRouting<T>::GetNRoutes() const
@@ -416,8 +476,7 @@ GlobalRouting<T>::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
-                delete *i;
-                m_hostRoutes.erase(i);
+                EraseHostRoute(i);
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
                 return;
@@ -432,8 +491,7 @@ GlobalRouting<T>::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
-            delete *j;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -480,6 +538,8 @@ GlobalRouting<T>::DoDispose()
     {
         delete (*j);
     }
+    m_hostIndex.Clear();
+    m_networkIndex.Clear();
     for (auto l = m_ASexternalRoutes.begin(); l != m_ASexternalRoutes.end();
          l = m_ASexternalRoutes.erase(l))
     {
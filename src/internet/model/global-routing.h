@@ -79,6 +79,7 @@
 #define GLOBAL_ROUTING_H
 
 #include "global-route-manager.h"
+#include "ip-prefix-trie.h"
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
@@ -132,6 +133,10 @@ class GlobalRouteManagerImpl;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * The routes to hosts and networks are indexed by destination prefix, so
+ * that the lookup of a route does not depend on the size of the routing
+ * table.
+ *
  * @see Ipv4RoutingProtocol
  * @see GlobalRouteManager
  */
@@ -552,10 +557,66 @@ class GlobalRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProtocol
      */
     Ptr<IpRoute> LookupGlobal(IpAddress dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * @brief Get the mask or prefix of the destination of a network route.
+     * @param route the route
+     * @return the mask or prefix of the destination network
+     */
+    static IpMaskOrPrefix GetDestMask(const IpRoutingTableEntry* route);
+
+    /**
+     * @brief Get the length of the prefix under which a network route is indexed.
+     * @param mask the mask or prefix of the destination network of the route
+     * @return the length of the bits matched by the mask or prefix
+     */
+    static uint8_t GetIndexLength(const IpMaskOrPrefix& mask);
+
+    /**
+     * @brief Add a route at the end of the host routes, unless it is already present.
+     * @param route the route, owned by the routing table
+     */
+    void InsertHostRoute(IpRoutingTableEntry* route);
+
+    /**
+     * @brief Add a route at the end of the network routes, unless it is already present.
+     * @param route the route, owned by the routing table
+     */
+    void InsertNetworkRoute(IpRoutingTableEntry* route);
+
+    /**
+     * @brief Remove a host route, and delete it.
+     * @param it the route
+     * @return the route following the removed one
+     */
+    HostRoutesI EraseHostRoute(HostRoutesI it);
+
+    /**
+     * @brief Remove a network route, and delete it.
+     * @param it the route
+     * @return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
+    /**
+     * @brief Remove the host routes to a destination.
+     * @param dest the destination
+     */
+    void RemoveHostRoutesTo(IpAddress dest);
+
+    /**
+     * @brief Remove the network routes to a network.
+     * @param network the network
+     * @param networkMask the mask or prefix of the network
+     */
+    void RemoveNetworkRoutesTo(IpAddress network, IpMaskOrPrefix networkMask);
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    IpPrefixTrie<IpAddress, HostRoutesI> m_hostIndex;       //!< Routes to hosts, by destination
+    IpPrefixTrie<IpAddress, NetworkRoutesI> m_networkIndex; //!< Routes to networks, by prefix
+
     Ptr<Ip> m_ip; //!< associated IPv4 instance
 };
 
@@ -0,0 +1,327 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IP_PREFIX_TRIE_H
+#define IP_PREFIX_TRIE_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <stdint.h>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ *
+ * @brief Index of values, typically routes, by IP prefix, which finds the
+ * prefixes matching an address without visiting the others.
+ *
+ * The prefixes are stored in a path-compressed binary trie: a lookup
+ * visits at most one node per bit of the address, and usually much fewer,
+ * whatever the number of prefixes.  The values of a prefix are kept in the
+ * order they were inserted, so that a routing table can keep the order of
+ * its equal cost routes.
+ *
+ * @tparam Address The address type, Ipv4Address or Ipv6Address.
+ * @tparam Value The type of the values, which must be equality comparable.
+ */
+template <typename Address, typename Value>
+class IpPrefixTrie
+{
+    static_assert(std::is_same_v<Address, Ipv4Address> || std::is_same_v<Address, Ipv6Address>,
+                  "IpPrefixTrie only supports Ipv4Address and Ipv6Address");
+
+  public:
+    /// The number of bits of an address
+    static constexpr uint8_t ADDRESS_BITS = std::is_same_v<Address, Ipv4Address> ? 32 : 128;
+
+    IpPrefixTrie()
+        : m_n(0)
+    {
+    }
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    IpPrefixTrie(const IpPrefixTrie&) = delete;
+    IpPrefixTrie& operator=(const IpPrefixTrie&) = delete;
+
+    /**
+     * Add a value to a prefix, after the values it already holds.
+     *
+     * @param [in] prefix The prefix address; the bits beyond its length are ignored.
+     * @param [in] length The length of the prefix (bits).
+     * @param [in] value The value.
+     */
+    void Insert(Address prefix, uint8_t length, Value value)
+    {
+        const Key key = GetKey(prefix, length);
+        Node* node = &m_root;
+        while (node->length < length)
+        {
+            auto& child = node->children[GetBit(key, node->length)];
+            if (!child)
+            {
+                child = std::make_unique<Node>(key, length);
+                node = child.get();
+                break;
+            }
+            const uint8_t common =
+                GetCommonLength(key, child->key, std::min(length, child->length));
+            if (common < child->length)
+            {
+                // Split the edge to the child at the last common bit
+                auto parent = std::make_unique<Node>(Mask(key, common), common);
+                parent->children[GetBit(child->key, common)] = std::move(child);
+                child = std::move(parent);
+            }
+            node = child.get();
+        }
+        node->values.push_back(value);
+        m_n++;
+    }
+
+    /**
+     * Remove a value from a prefix.
+     *
+     * @param [in] prefix The prefix address; the bits beyond its length are ignored.
+     * @param [in] length The length of the prefix (bits).
+     * @param [in] value The value.
+     * @returns Whether the prefix held the value.
+     */
+    bool Remove(Address prefix, uint8_t length, const Value& value)
+    {
+        if (!Remove(m_root, GetKey(prefix, length), length, value))
+        {
+            return false;
+        }
+        m_n--;
+        return true;
+    }
+
+    /**
+     * Get the values of a prefix.
+     *
+     * @param [in] prefix The prefix address; the bits beyond its length are ignored.
+     * @param [in] length The length of the prefix (bits).
+     * @returns The values of the prefix, in insertion order, or null if it has none.
+     */
+    const std::vector<Value>* Find(Address prefix, uint8_t length) const
+    {
+        const Key key = GetKey(prefix, length);
+        const Node* node = &m_root;
+        while (node->length < length)
+        {
+            node = node->children[GetBit(key, node->length)].get();
+            if (!node || node->length > length ||
+                GetCommonLength(key, node->key, node->length) < node->length)
+            {
+                return nullptr;
+            }
+        }
+        return node->values.empty() ? nullptr : &node->values;
+    }
+
+    /**
+     * Visit the prefixes matching an address, from the longest to the
+     * shortest, until the visitor returns true.
+     *
+     * @tparam Visitor The type of the visitor, called as
+     *         <tt>bool (const std::vector<Value>& values, uint8_t length)</tt>.
+     * @param [in] address The address.
+     * @param [in] visitor The visitor, called with the values of each matching prefix.
+     * @returns Whether the visitor returned true.
+     */
+    template <typename Visitor>
+    bool VisitMatches(Address address, Visitor visitor) const
+    {
+        const Key key = GetKey(address, ADDRESS_BITS);
+        std::array<const Node*, ADDRESS_BITS + 1> matches;
+        std::size_t n = 0;
+        const Node* node = &m_root;
+        while (node && GetCommonLength(key, node->key, node->length) == node->length)
+        {
+            if (!node->values.empty())
+            {
+                matches[n++] = node;
+            }
+            if (node->length == ADDRESS_BITS)
+            {
+                break;
+            }
+            node = node->children[GetBit(key, node->length)].get();
+        }
+        while (n > 0)
+        {
+            n--;
+            if (visitor(matches[n]->values, matches[n]->length))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Remove all the values.
+     */
+    void Clear()
+    {
+        m_root.values.clear();
+        m_root.children[0].reset();
+        m_root.children[1].reset();
+        m_n = 0;
+    }
+
+    /**
+     * @returns The number of values.
+     */
+    std::size_t GetN() const
+    {
+        return m_n;
+    }
+
+  private:
+    /// The bits of an address, most significant first
+    using Key = std::array<uint8_t, ADDRESS_BITS / 8>;
+
+    /** A node of the trie, holding the values of a prefix, if any. */
+    struct Node
+    {
+        /**
+         * Create a node.
+         *
+         * @param [in] k The prefix of the node.
+         * @param [in] l The length of the prefix.
+         */
+        Node(const Key& k, uint8_t l)
+            : key(k),
+              length(l)
+        {
+        }
+
+        /// The prefix, with the bits beyond its length unset.
+        Key key;
+        uint8_t length;                    //!< The length of the prefix.
+        std::vector<Value> values;         //!< The values of the prefix.
+        std::unique_ptr<Node> children[2]; //!< The longer prefixes, by their next bit.
+    };
+
+    /**
+     * Get the key of a prefix.
+     *
+     * @param [in] prefix The prefix address.
+     * @param [in] length The length of the prefix.
+     * @returns The key, with the bits beyond the length unset.
+     */
+    static Key GetKey(Address prefix, uint8_t length)
+    {
+        Key key;
+        prefix.Serialize(key.data());
+        return Mask(key, length);
+    }
+
+    /**
+     * Unset the bits of a key beyond a length.
+     *
+     * @param [in] key The key.
+     * @param [in] length The length.
+     * @returns The masked key.
+     */
+    static Key Mask(Key key, uint8_t length)
+    {
+        for (std::size_t i = length / 8; i < key.size(); i++)
+        {
+            key[i] &= (i == length / 8u) ? static_cast<uint8_t>(0xff00 >> (length % 8)) : 0;
+        }
+        return key;
+    }
+
+    /**
+     * @param [in] key The key.
+     * @param [in] i The index of the bit, from the most significant one.
+     * @returns The bit of the key.
+     */
+    static uint8_t GetBit(const Key& key, uint8_t i)
+    {
+        return (key[i / 8] >> (7 - i % 8)) & 1;
+    }
+
+    /**
+     * Get the length of the common prefix of two keys.
+     *
+     * @param [in] a The first key.
+     * @param [in] b The second key.
+     * @param [in] max The length at which to stop comparing the keys.
+     * @returns The number of leading bits the keys have in common, up to max.
+     */
+    static uint8_t GetCommonLength(const Key& a, const Key& b, uint8_t max)
+    {
+        for (std::size_t i = 0; i * 8 < max; i++)
+        {
+            if (a[i] != b[i])
+            {
+                const auto common = i * 8 + std::countl_zero(static_cast<uint8_t>(a[i] ^ b[i]));
+                return static_cast<uint8_t>(std::min<std::size_t>(common, max));
+            }
+        }
+        return max;
+    }
+
+    /**
+     * Remove a value from a prefix under a node, and the nodes left
+     * without values nor branches.
+     *
+     * @param [in] node The node.
+     * @param [in] key The key of the prefix.
+     * @param [in] length The length of the prefix.
+     * @param [in] value The value.
+     * @returns Whether the prefix held the value.
+     */
+    static bool Remove(Node& node, const Key& key, uint8_t length, const Value& value)
+    {
+        if (node.length == length)
+        {
+            auto it = std::find(node.values.begin(), node.values.end(), value);
+            if (it == node.values.end())
+            {
+                return false;
+            }
+            node.values.erase(it);
+            return true;
+        }
+        auto& child = node.children[GetBit(key, node.length)];
+        if (!child || child->length > length ||
+            GetCommonLength(key, child->key, child->length) < child->length ||
+            !Remove(*child, key, length, value))
+        {
+            return false;
+        }
+        if (child->values.empty())
+        {
+            if (!child->children[0])
+            {
+                child = std::move(child->children[1]);
+            }
+            else if (!child->children[1])
+            {
+                child = std::move(child->children[0]);
+            }
+        }
+        return true;
+    }
+
+    Node m_root{Key{}, 0}; //!< The node of the empty prefix.
+    std::size_t m_n;       //!< The number of values.
+};
+
+} // namespace ns3
+
+#endif /* IP_PREFIX_TRIE_H */
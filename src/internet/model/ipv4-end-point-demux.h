@@ -15,6 +15,9 @@
 
 #include <list>
 #include <stdint.h>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -31,6 +34,11 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed by local port, and by local port and peer
+ * address and port, so that a lookup only visits the endpoints which can
+ * match the packet, e.g., the listening endpoint and the connection of a
+ * server with many connections on the same port.
  */
 
 class Ipv4EndPointDemux
@@ -160,6 +168,55 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * @brief Key of the index of the endpoints: local port, peer address and peer port.
+     *
+     * The peer address and port of an endpoint can be wildcards.
+     */
+    using Key = std::tuple<uint16_t, Ipv4Address, uint16_t>;
+
+    /**
+     * @brief Hash function of the keys of the index.
+     */
+    struct KeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash of the key
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * @brief Position of an endpoint in the lists.
+     */
+    struct Position
+    {
+        EndPointsI all;  //!< Position in the list of all the endpoints.
+        EndPointsI port; //!< Position in the list of the endpoints of its local port.
+    };
+
+    /**
+     * @brief Add an allocated endpoint to the lists and the index.
+     * @param endPoint the endpoint
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Add an endpoint to the index, under its current peer.
+     * @param endPoint the endpoint
+     */
+    void AddToIndex(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Remove an endpoint from the index, before its peer changes.
+     * @param endPoint the endpoint
+     */
+    void RemoveFromIndex(Ipv4EndPoint* endPoint);
+
     /**
      * @brief Allocate an ephemeral port.
      * @returns the ephemeral port
@@ -185,6 +242,21 @@ class Ipv4EndPointDemux
      * @brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The IPv4 end points of each local port, in allocation order.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_ports;
+
+    /**
+     * @brief The IPv4 end points by local port and peer.
+     */
+    std::unordered_map<Key, std::vector<Ipv4EndPoint*>, KeyHash> m_index;
+
+    /**
+     * @brief The position of each IPv4 end point in the lists.
+     */
+    std::unordered_map<Ipv4EndPoint*, Position> m_positions;
 };
 
 } // namespace ns3
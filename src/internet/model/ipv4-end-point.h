@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv4EndPointDemux;
 class Packet;
 
 /**
@@ -224,6 +225,13 @@ class Ipv4EndPoint
      * @brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    /**
+     * @brief The demux indexing the endpoint by peer (if any).
+     */
+    Ipv4EndPointDemux* m_demux;
+
+    friend class Ipv4EndPointDemux;
 };
 
 } // namespace ns3
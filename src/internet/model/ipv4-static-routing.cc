@@ -67,8 +67,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -84,9 +83,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -141,7 +138,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -213,7 +210,13 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    auto routes = m_networkIndex.Find(route.GetDestNetwork(),
+                                      route.GetDestNetworkMask().GetPrefixLength());
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& j : *routes)
     {
         Ipv4RoutingTableEntry* rtentry = j->first;
 
@@ -228,13 +231,31 @@ Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv4StaticRouting::InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    auto it = m_networkRoutes.emplace(m_networkRoutes.end(), route, metric);
+    m_networkIndex.Insert(route->GetDestNetwork(),
+                          route->GetDestNetworkMask().GetPrefixLength(),
+                          it);
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    Ipv4RoutingTableEntry* route = it->first;
+    m_networkIndex.Remove(route->GetDestNetwork(),
+                          route->GetDestNetworkMask().GetPrefixLength(),
+                          it);
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << " " << oif);
     Ptr<Ipv4Route> rtentry = nullptr;
-    uint16_t longest_mask = 0;
-    uint32_t shortest_metric = 0xffffffff;
     /* when sending on local multicast, there have to be interface specified */
     if (dest.IsLocalMulticast())
     {
@@ -250,56 +271,53 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+    // Visit the prefixes matching the destination from the longest one: the
+    // route is the one with the lowest metric of the first prefix with a
+    // route on the requested interface
+    m_networkIndex.VisitMatches(
+        dest,
+        [&](const std::vector<NetworkRoutesI>& routes, uint8_t masklen) {
+            Ipv4RoutingTableEntry* route = nullptr;
+            uint32_t shortest_metric = 0xffffffff;
+            for (const auto& i : routes)
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                Ipv4RoutingTableEntry* j = i->first;
+                uint32_t metric = i->second;
+                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << +masklen
+                                                           << ", metric " << metric);
+                if (oif)
+                {
+                    if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                    {
+                        NS_LOG_LOGIC("Not on requested interface, skipping");
+                        continue;
+                    }
+                }
+                if (metric > shortest_metric)
                 {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
                     continue;
                 }
+                shortest_metric = metric;
+                route = j;
+                if (masklen == 32)
+                {
+                    break;
+                }
             }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-                shortest_metric = 0xffffffff;
-            }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
+            if (!route)
             {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
+                return false;
             }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
             uint32_t interfaceIdx = route->GetInterface();
             rtentry = Create<Ipv4Route>();
             rtentry->SetDestination(route->GetDest());
             rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
             rtentry->SetGateway(route->GetGateway());
             rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
-            }
-        }
-    }
+            return true;
+        });
+
     if (rtentry)
     {
         NS_LOG_LOGIC("Matching route via " << rtentry->GetGateway() << " at the end");
@@ -446,8 +464,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             return;
         }
         tmp++;
@@ -581,6 +598,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkIndex.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -620,8 +638,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -665,8 +682,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -10,6 +10,7 @@
 #ifndef IPV4_STATIC_ROUTING_H
 #define IPV4_STATIC_ROUTING_H
 
+#include "ip-prefix-trie.h"
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
@@ -49,6 +50,9 @@ class Node;
  * Ipv4RoutingProtocol that defines the interface methods that a routing
  * protocol must support.
  *
+ * The network routes are indexed by destination prefix, so that the
+ * lookup of a route does not depend on the size of the routing table.
+ *
  * @see Ipv4RoutingProtocol
  * @see Ipv4ListRouting
  * @see Ipv4ListRouting::AddRoutingProtocol
@@ -378,6 +382,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * @brief Add a route at the end of the network routes.
+     * @param route the route, owned by the routing table
+     * @param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a network route, and delete it.
+     * @param it the route
+     * @return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -400,6 +418,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the network routes, by destination prefix.
+     */
+    IpPrefixTrie<Ipv4Address, NetworkRoutesI> m_networkIndex;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -12,6 +12,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace ns3
 {
 
@@ -34,29 +37,38 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_index.clear();
+    m_positions.clear();
+}
+
+std::size_t
+Ipv6EndPointDemux::KeyHash::operator()(const Key& key) const
+{
+    std::size_t hash = std::hash<Ipv6Address>()(std::get<1>(key));
+    std::size_t ports = (static_cast<std::size_t>(std::get<0>(key)) << 16) | std::get<2>(key);
+    return hash ^ (ports + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoints = m_ports.find(port);
+    if (endPoints == m_ports.end())
+    {
+        return false;
+    }
+    for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
+        if ((*i)->GetLocalAddress() == addr &&
             (*i)->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
@@ -76,7 +88,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -92,7 +104,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -115,7 +127,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -128,19 +140,22 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoints = m_index.find({localPort, peerAddress, peerPort});
+    if (endPoints != m_index.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetLocalAddress() == localAddress &&
+                ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -151,14 +166,55 @@ void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
+    }
+    RemoveFromIndex(endPoint);
+    auto endPoints = m_ports.find(endPoint->GetLocalPort());
+    endPoints->second.erase(position->second.port);
+    if (endPoints->second.empty())
+    {
+        m_ports.erase(endPoints);
+    }
+    m_endPoints.erase(position->second.all);
+    m_positions.erase(position);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
+}
+
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Position position;
+    position.all = m_endPoints.insert(m_endPoints.end(), endPoint);
+    auto& endPoints = m_ports[endPoint->GetLocalPort()];
+    position.port = endPoints.insert(endPoints.end(), endPoint);
+    m_positions[endPoint] = position;
+    endPoint->m_demux = this;
+    AddToIndex(endPoint);
+}
+
+void
+Ipv6EndPointDemux::AddToIndex(Ipv6EndPoint* endPoint)
+{
+    m_index[{endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()}]
+        .push_back(endPoint);
+}
+
+void
+Ipv6EndPointDemux::RemoveFromIndex(Ipv6EndPoint* endPoint)
+{
+    auto endPoints = m_index.find(
+        {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()});
+    NS_ASSERT(endPoints != m_index.end());
+    auto& bucket = endPoints->second;
+    bucket.erase(std::find(bucket.begin(), bucket.end(), endPoint));
+    if (bucket.empty())
+    {
+        m_index.erase(endPoints);
     }
 }
 
@@ -182,92 +238,103 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
 
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
+    // The endpoints which may match have the exact or the wildcard peer address
+    // and port: only the index entries of these four keys are visited
+    const Key keys[] = {{dport, saddr, sport},
+                        {dport, saddr, 0},
+                        {dport, Ipv6Address::GetAny(), sport},
+                        {dport, Ipv6Address::GetAny(), 0}};
+    for (std::size_t k = 0; k < 4; k++)
+    {
+        // Skip the duplicate keys if the packet has a wildcard source address or port
+        if ((k % 2 == 1 && sport == 0) || (k >= 2 && saddr == Ipv6Address::GetAny()))
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
             continue;
         }
-
-        if (endP->GetLocalPort() != dport)
+        auto endPoints = m_index.find(keys[k]);
+        if (endPoints == m_index.end())
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
             continue;
         }
-
-        if (endP->GetBoundNetDevice())
+        for (auto endP : endPoints->second)
         {
-            if (!incomingInterface)
+            NS_LOG_DEBUG("Looking at endpoint dport="
+                         << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                         << " sport=" << endP->GetPeerPort()
+                         << " saddr=" << endP->GetPeerAddress());
+
+            if (!endP->IsRxEnabled())
             {
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+
+            if (endP->GetBoundNetDevice())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                if (!incomingInterface)
+                {
+                    continue;
+                }
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
             }
-        }
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
+            /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+            NS_LOG_DEBUG("dest addr " << daddr);
 
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+            bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+            bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
+            bool localAddressMatchesAllRouters =
+                endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
 
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
+            /* if no match here, keep looking */
+            if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+                continue;
+            }
+            bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
+
+            /* If remote does not match either with exact or wildcard,i
+               skip this one */
+            if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+                continue;
+            }
 
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
+            /* Now figure out which return list to add this one to */
+            if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
+                remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+                retval1.push_back(endP);
+            }
+            if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
+                remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All but local address */
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All 4 match */
+                retval4.push_back(endP);
+            }
         }
     }
 
@@ -299,18 +366,30 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    auto endPoints = m_ports.find(dport);
+    if (endPoints == m_ports.end())
+    {
+        return nullptr;
+    }
+    // An exact match is in the index entry of the peer: if there is none,
+    // the first endpoint with specific local and peer addresses is returned
+    bool exact = false;
+    auto peerEndPoints = m_index.find({dport, src, sport});
+    if (peerEndPoints != m_index.end())
+    {
+        for (auto endPoint : peerEndPoints->second)
+        {
+            exact = exact || endPoint->GetLocalAddress() == dst;
+        }
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i = endPoints->second.begin(); i != endPoints->second.end(); i++)
     {
         uint32_t tmp = 0;
 
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-
         if ((*i)->GetLocalAddress() == dst && (*i)->GetPeerPort() == sport &&
             (*i)->GetPeerAddress() == src)
         {
@@ -333,6 +412,10 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
             generic = (*i);
             genericity = tmp;
         }
+        if (genericity == 0 && !exact)
+        {
+            break;
+        }
     }
     return generic;
 }
@@ -15,6 +15,9 @@
 
 #include <list>
 #include <stdint.h>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +28,10 @@ class Ipv6EndPoint;
  * @ingroup ipv6
  *
  * @brief Demultiplexer for end points.
+ *
+ * The endpoints are indexed by local port, and by local port and peer
+ * address and port, so that a lookup only visits the endpoints which can
+ * match the packet.
  */
 class Ipv6EndPointDemux
 {
@@ -150,6 +157,55 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * @brief Key of the index of the endpoints: local port, peer address and peer port.
+     *
+     * The peer address and port of an endpoint can be wildcards.
+     */
+    using Key = std::tuple<uint16_t, Ipv6Address, uint16_t>;
+
+    /**
+     * @brief Hash function of the keys of the index.
+     */
+    struct KeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash of the key
+         */
+        std::size_t operator()(const Key& key) const;
+    };
+
+    /**
+     * @brief Position of an endpoint in the lists.
+     */
+    struct Position
+    {
+        EndPointsI all;  //!< Position in the list of all the endpoints.
+        EndPointsI port; //!< Position in the list of the endpoints of its local port.
+    };
+
+    /**
+     * @brief Add an allocated endpoint to the lists and the index.
+     * @param endPoint the endpoint
+     */
+    void Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Add an endpoint to the index, under its current peer.
+     * @param endPoint the endpoint
+     */
+    void AddToIndex(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Remove an endpoint from the index, before its peer changes.
+     * @param endPoint the endpoint
+     */
+    void RemoveFromIndex(Ipv6EndPoint* endPoint);
+
     /**
      * @brief Allocate a ephemeral port.
      * @return a port
@@ -175,6 +231,21 @@ class Ipv6EndPointDemux
      * @brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The IPv6 end points of each local port, in allocation order.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_ports;
+
+    /**
+     * @brief The IPv6 end points by local port and peer.
+     */
+    std::unordered_map<Key, std::vector<Ipv6EndPoint*>, KeyHash> m_index;
+
+    /**
+     * @brief The position of each IPv6 end point in the lists.
+     */
+    std::unordered_map<Ipv6EndPoint*, Position> m_positions;
 };
 
 } /* namespace ns3 */
@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -228,6 +229,13 @@ class Ipv6EndPoint
      * @brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    /**
+     * @brief The demux indexing the endpoint by peer (if any).
+     */
+    Ipv6EndPointDemux* m_demux;
+
+    friend class Ipv6EndPointDemux;
 };
 
 } /* namespace ns3 */
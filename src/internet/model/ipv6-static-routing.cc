@@ -27,6 +27,18 @@ NS_LOG_COMPONENT_DEFINE("Ipv6StaticRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6StaticRouting);
 
+/**
+ * @brief Get the length under which a route is indexed, i.e., the length of
+ * the bits its prefix matches, which may be shorter than its declared length.
+ * @param prefix the prefix of the route
+ * @return the length of the prefix in the index
+ */
+static uint8_t
+GetIndexLength(const Ipv6Prefix& prefix)
+{
+    return prefix.GetMinimumPrefixLength();
+}
+
 TypeId
 Ipv6StaticRouting::GetTypeId()
 {
@@ -170,8 +182,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -197,8 +208,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -214,8 +224,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -257,7 +266,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     auto network = Ipv6Address("ff00::"); /* RFC 3513 */
     auto networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -352,7 +361,13 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    auto routes =
+        m_networkIndex.Find(route.GetDestNetwork(), GetIndexLength(route.GetDestNetworkPrefix()));
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& j : *routes)
     {
         Ipv6RoutingTableEntry* rtentry = j->first;
 
@@ -368,13 +383,31 @@ Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv6StaticRouting::InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    auto it = m_networkRoutes.emplace(m_networkRoutes.end(), route, metric);
+    m_networkIndex.Insert(route->GetDestNetwork(),
+                          GetIndexLength(route->GetDestNetworkPrefix()),
+                          it);
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    Ipv6RoutingTableEntry* route = it->first;
+    m_networkIndex.Remove(route->GetDestNetwork(),
+                          GetIndexLength(route->GetDestNetworkPrefix()),
+                          it);
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
     NS_LOG_FUNCTION(this << dst << interface);
     Ptr<Ipv6Route> rtentry = nullptr;
-    uint16_t longestMask = 0;
-    uint32_t shortestMetric = 0xffffffff;
 
     /* when sending on link-local multicast, there have to be interface specified */
     if (dst.IsLinkLocalMulticast())
@@ -391,71 +424,62 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
-                                                       << ", metric " << metric);
-
-            /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
+    // Visit the prefixes matching the destination from the longest one: the
+    // route is the one with the lowest metric of the first prefix with a
+    // route on the requested interface
+    m_networkIndex.VisitMatches(
+        dst,
+        [&](const std::vector<NetworkRoutesI>& routes, uint8_t maskLen) {
+            Ipv6RoutingTableEntry* route = nullptr;
+            uint32_t shortestMetric = 0xffffffff;
+            for (const auto& it : routes)
             {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
+                Ipv6RoutingTableEntry* j = it->first;
+                uint32_t metric = it->second;
+                NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << +maskLen
+                                                           << ", metric " << metric);
 
-                if (maskLen > longestMask)
+                /* if interface is given, check the route will output on this interface */
+                if (interface && interface != m_ipv6->GetNetDevice(j->GetInterface()))
                 {
-                    shortestMetric = 0xffffffff;
+                    continue;
                 }
-
-                longestMask = maskLen;
                 if (metric > shortestMetric)
                 {
                     NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
                     continue;
                 }
-
                 shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
-
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
-
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
+                route = j;
                 if (maskLen == 128)
                 {
                     break;
                 }
             }
-        }
-    }
+            if (!route)
+            {
+                return false;
+            }
+            uint32_t interfaceIdx = route->GetInterface();
+            rtentry = Create<Ipv6Route>();
+
+            if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
+            {
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
+            }
+            else
+            {
+                // Default route
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                    interfaceIdx,
+                    route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
+            }
+
+            rtentry->SetDestination(route->GetDest());
+            rtentry->SetGateway(route->GetGateway());
+            rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
+            return true;
+        });
 
     if (rtentry)
     {
@@ -475,6 +499,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkIndex.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -631,8 +656,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
         tmp++;
@@ -654,8 +678,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
     }
@@ -796,8 +819,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -834,8 +856,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -892,8 +913,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseNetworkRoute(j);
             }
             else
             {
@@ -9,6 +9,7 @@
 #ifndef IPV6_STATIC_ROUTING_H
 #define IPV6_STATIC_ROUTING_H
 
+#include "ip-prefix-trie.h"
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
@@ -45,6 +46,9 @@ class Ipv6MulticastRoutingTableEntry;
  * Ipv6RoutingProtocol that defines the interface methods that a routing
  * protocol must support.
  *
+ * The network routes are indexed by destination prefix, so that the
+ * lookup of a route does not depend on the size of the routing table.
+ *
  * @see Ipv6RoutingProtocol
  * @see Ipv6ListRouting
  * @see Ipv6ListRouting::AddRoutingProtocol
@@ -303,6 +307,20 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * @brief Add a route at the end of the network routes.
+     * @param route the route, owned by the routing table
+     * @param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a network route, and delete it.
+     * @param it the route
+     * @return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -325,6 +343,11 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the network routes, by destination prefix.
+     */
+    IpPrefixTrie<Ipv6Address, NetworkRoutesI> m_networkIndex;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -0,0 +1,300 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 end point demultiplexer Test
+ *
+ * A server listens on a port and accepts many connections, whose endpoints
+ * are allocated with their peer (passive open), while a client endpoint is
+ * given its peer after its allocation (active open).
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Look up the endpoint receiving a packet.
+     *
+     * @param daddr the destination address
+     * @param dport the destination port
+     * @param saddr the source address
+     * @param sport the source port
+     * @returns the endpoint, or null if there is none
+     */
+    Ipv4EndPoint* Lookup(Ipv4Address daddr, uint16_t dport, Ipv4Address saddr, uint16_t sport);
+
+    Ipv4EndPointDemux m_demux;      //!< The demultiplexer.
+    Ptr<Ipv4Interface> m_interface; //!< The interface receiving the packets.
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Check the IPv4 end point lookups with many connections")
+{
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemuxTestCase::Lookup(Ipv4Address daddr,
+                                  uint16_t dport,
+                                  Ipv4Address saddr,
+                                  uint16_t sport)
+{
+    auto endPoints = m_demux.Lookup(daddr, dport, saddr, sport, m_interface);
+    return endPoints.empty() ? nullptr : endPoints.front();
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    m_interface = CreateObject<Ipv4Interface>();
+    const Ipv4Address local("10.0.1.1");
+    m_interface->AddAddress(Ipv4InterfaceAddress(local, Ipv4Mask("255.255.255.0")));
+
+    Ipv4EndPoint* listener = m_demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listener not allocated");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.Allocate(nullptr, 80), nullptr, "Duplicated listener");
+
+    std::vector<Ipv4EndPoint*> connections;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        Ipv4Address peer(Ipv4Address("10.0.2.0").Get() + i / 4);
+        auto connection = m_demux.Allocate(nullptr, local, 80, peer, 1000 + i % 4);
+        NS_TEST_ASSERT_MSG_NE(connection, nullptr, "Connection " << i << " not allocated");
+        connections.push_back(connection);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_demux.Allocate(nullptr, local, 80, Ipv4Address("10.0.2.3"), 1002),
+                          nullptr,
+                          "Duplicated connection");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.GetAllEndPoints().size(), 2001, "Bad number of endpoints");
+
+    for (uint32_t i = 0; i < connections.size(); i += 7)
+    {
+        Ipv4Address peer(Ipv4Address("10.0.2.0").Get() + i / 4);
+        NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, peer, 1000 + i % 4),
+                              connections[i],
+                              "Bad endpoint of connection " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_demux.SimpleLookup(local, 80, peer, 1000 + i % 4),
+                              connections[i],
+                              "Bad endpoint of connection " << i);
+    }
+    // A new peer, or a packet to the subnet-directed broadcast address, reaches the listener
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, Ipv4Address("10.0.5.1"), 1000),
+                          listener,
+                          "Bad endpoint of a new connection");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(Ipv4Address("10.0.1.255"), 80, Ipv4Address("10.0.2.0"), 1000),
+                          listener,
+                          "Bad endpoint of a broadcast packet");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 81, Ipv4Address("10.0.2.0"), 1000),
+                          nullptr,
+                          "Endpoint found on a closed port");
+    // The least generic endpoint is the first connection
+    NS_TEST_EXPECT_MSG_EQ(m_demux.SimpleLookup(local, 80, Ipv4Address("10.0.5.1"), 1000),
+                          connections[0],
+                          "Bad generic endpoint");
+
+    // An endpoint bound to the subnet matches the packets of the subnet only
+    Ipv4EndPoint* subnet = m_demux.Allocate(nullptr, Ipv4Address("10.0.1.0"), 53);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(Ipv4Address("10.0.1.255"), 53, Ipv4Address("10.0.1.2"), 1000),
+                          subnet,
+                          "Bad endpoint of a subnet-directed broadcast packet");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(Ipv4Address("10.0.4.255"), 53, Ipv4Address("10.0.1.2"), 1000),
+                          nullptr,
+                          "Endpoint found for another subnet");
+
+    // Active open: the peer is set once the endpoint is allocated
+    Ipv4EndPoint* client = m_demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Client not allocated");
+    uint16_t clientPort = client->GetLocalPort();
+    NS_TEST_EXPECT_MSG_EQ(m_demux.LookupPortLocal(clientPort), true, "Client port not found");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, clientPort, Ipv4Address("10.0.5.1"), 8080),
+                          client,
+                          "Bad endpoint of the unconnected client");
+    client->SetPeer(Ipv4Address("10.0.5.1"), 8080);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, clientPort, Ipv4Address("10.0.5.1"), 8080),
+                          client,
+                          "Bad endpoint of the connected client");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, clientPort, Ipv4Address("10.0.5.2"), 8080),
+                          nullptr,
+                          "The connected client received a packet of another peer");
+    NS_TEST_EXPECT_MSG_EQ(
+        m_demux.Allocate(nullptr, local, clientPort, Ipv4Address("10.0.5.1"), 8080),
+        nullptr,
+        "Duplicated client connection");
+
+    // An endpoint which cannot receive is skipped
+    connections[1]->SetRxEnabled(false);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, Ipv4Address("10.0.2.0"), 1001),
+                          listener,
+                          "Bad endpoint of a connection which cannot receive");
+
+    // Closing the connections
+    for (uint32_t i = 0; i < connections.size(); i += 2)
+    {
+        m_demux.DeAllocate(connections[i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, Ipv4Address("10.0.2.0"), 1000),
+                          listener,
+                          "Bad endpoint of a closed connection");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, Ipv4Address("10.0.2.0"), 1003),
+                          connections[3],
+                          "Bad endpoint of an open connection");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.GetAllEndPoints().size(),
+                          1003,
+                          "Bad number of endpoints after closing connections");
+    m_demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(m_demux.LookupPortLocal(clientPort), false, "Closed port found");
+    m_interface = nullptr;
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv6 end point demultiplexer Test
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Look up the endpoint receiving a packet.
+     *
+     * @param daddr the destination address
+     * @param dport the destination port
+     * @param saddr the source address
+     * @param sport the source port
+     * @returns the endpoint, or null if there is none
+     */
+    Ipv6EndPoint* Lookup(Ipv6Address daddr, uint16_t dport, Ipv6Address saddr, uint16_t sport);
+
+    Ipv6EndPointDemux m_demux; //!< The demultiplexer.
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Check the IPv6 end point lookups with many connections")
+{
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemuxTestCase::Lookup(Ipv6Address daddr,
+                                  uint16_t dport,
+                                  Ipv6Address saddr,
+                                  uint16_t sport)
+{
+    auto endPoints = m_demux.Lookup(daddr, dport, saddr, sport, nullptr);
+    return endPoints.empty() ? nullptr : endPoints.front();
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    const Ipv6Address local("2001:1::1");
+    auto peer = [](uint32_t i) {
+        uint8_t bytes[16] = {0x20, 0x01, 0, 2};
+        bytes[14] = (i >> 8) & 0xff;
+        bytes[15] = i & 0xff;
+        return Ipv6Address(bytes);
+    };
+
+    Ipv6EndPoint* listener = m_demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listener not allocated");
+    // An endpoint bound to a device does not receive the packets without interface
+    Ptr<NetDevice> device = CreateObject<SimpleNetDevice>();
+    Ipv6EndPoint* bound = m_demux.Allocate(device, local, 80);
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Bound endpoint not allocated");
+    bound->BindToNetDevice(device);
+
+    std::vector<Ipv6EndPoint*> connections;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        auto connection = m_demux.Allocate(nullptr, local, 80, peer(i / 4), 1000 + i % 4);
+        NS_TEST_ASSERT_MSG_NE(connection, nullptr, "Connection " << i << " not allocated");
+        connections.push_back(connection);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_demux.Allocate(nullptr, local, 80, peer(3), 1002),
+                          nullptr,
+                          "Duplicated connection");
+
+    for (uint32_t i = 0; i < connections.size(); i += 7)
+    {
+        NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, peer(i / 4), 1000 + i % 4),
+                              connections[i],
+                              "Bad endpoint of connection " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_demux.SimpleLookup(local, 80, peer(i / 4), 1000 + i % 4),
+                              connections[i],
+                              "Bad endpoint of connection " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, peer(1000), 1000),
+                          listener,
+                          "Bad endpoint of a new connection");
+
+    // Active open
+    Ipv6EndPoint* client = m_demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Client not allocated");
+    uint16_t clientPort = client->GetLocalPort();
+    client->SetPeer(peer(2000), 8080);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, clientPort, peer(2000), 8080),
+                          client,
+                          "Bad endpoint of the connected client");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, clientPort, peer(2001), 8080),
+                          nullptr,
+                          "The connected client received a packet of another peer");
+
+    for (uint32_t i = 0; i < connections.size(); i += 2)
+    {
+        m_demux.DeAllocate(connections[i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, peer(0), 1000),
+                          listener,
+                          "Bad endpoint of a closed connection");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(local, 80, peer(0), 1003),
+                          connections[3],
+                          "Bad endpoint of an open connection");
+    NS_TEST_EXPECT_MSG_EQ(m_demux.GetEndPoints().size(),
+                          1003,
+                          "Bad number of endpoints after closing connections");
+    m_demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(m_demux.LookupPortLocal(clientPort), false, "Closed port found");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief End point demultiplexer TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite();
+};
+
+EndPointDemuxTestSuite::EndPointDemuxTestSuite()
+    : TestSuite("end-point-demux", Type::UNIT)
+{
+    AddTestCase(new Ipv4EndPointDemuxTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv6EndPointDemuxTestCase, TestCase::Duration::QUICK);
+}
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -7,6 +7,7 @@
 #include "ns3/config.h"
 #include "ns3/global-route-manager.h"
 #include "ns3/global-routing.h"
+#include "ns3/global-value.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -37,6 +38,9 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <sstream>
+#include <string>
 #include <vector>
 using namespace ns3;
 
@@ -2942,6 +2946,248 @@ GlobalRoutingv6ProtocolTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief This TestCase checks that the routes computed on several threads, and
+ * the routes updated after a change of topology, are the same as the routes
+ * computed by a single thread from scratch.
+ */
+class GlobalRoutingUpdateTestCase : public TestCase
+{
+  public:
+    GlobalRoutingUpdateTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+  private:
+    /**
+     * Get the IPv4 and IPv6 global routes of the nodes.
+     * @param sorted whether to sort the routes of each node
+     * @param ipv6 whether to include the IPv6 routes
+     * @returns the routes of each node
+     */
+    std::vector<std::string> GetRoutes(bool sorted, bool ipv6 = true) const;
+
+    /**
+     * Set the interfaces of a link up or down.
+     * @param link the index of the link
+     * @param ends the number of interfaces to set, from the first one
+     * @param up whether to set the interfaces up
+     */
+    void SetLink(uint32_t link, uint32_t ends, bool up);
+
+    NodeContainer m_nodes;                   //!< Nodes used in the test.
+    std::vector<NetDeviceContainer> m_links; //!< The devices of each link.
+};
+
+GlobalRoutingUpdateTestCase::GlobalRoutingUpdateTestCase()
+    : TestCase("Parallel and incremental global route computations")
+{
+}
+
+void
+GlobalRoutingUpdateTestCase::DoSetup()
+{
+    /*
+        //         Network Topology
+        //
+        //    n0----n1----n2----n3
+        //    |     |     |     |
+        //    n4----n5----n6----n7
+        //    |     |     |     |
+        //    n8----n9----n10---n11----n12
+        //
+        //    Link k: 10.1.k.0/30, 2001:k::/64
+        //
+        //     Note: All the links are P2P links, n12 is a stub router.
+    */
+    m_nodes.Create(13);
+
+    Ipv4GlobalRoutingHelper globalhelperv4;
+    Ipv6GlobalRoutingHelper globalhelperv6;
+
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelperv4);
+    stack.SetRoutingHelper(globalhelperv6);
+    stack.Install(m_nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+
+    std::vector<std::pair<uint32_t, uint32_t>> links;
+    for (uint32_t row = 0; row < 3; row++)
+    {
+        for (uint32_t column = 0; column < 4; column++)
+        {
+            uint32_t node = 4 * row + column;
+            if (column < 3)
+            {
+                links.emplace_back(node, node + 1);
+            }
+            if (row < 2)
+            {
+                links.emplace_back(node, node + 4);
+            }
+        }
+    }
+    links.emplace_back(11, 12);
+
+    Ipv4AddressHelper address;
+    Ipv6AddressHelper ipv6;
+    for (const auto& [from, to] : links)
+    {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer devices = devHelper.Install(m_nodes.Get(from), channel);
+        devices.Add(devHelper.Install(m_nodes.Get(to), channel));
+        m_links.push_back(devices);
+
+        std::ostringstream network;
+        network << "10.1." << m_links.size() << ".0";
+        address.SetBase(network.str().c_str(), "255.255.255.252");
+        address.Assign(devices);
+        std::ostringstream network6;
+        network6 << "2001:" << m_links.size() << "::";
+        ipv6.SetBase(network6.str().c_str(), Ipv6Prefix(64));
+        ipv6.Assign(devices);
+    }
+}
+
+void
+GlobalRoutingUpdateTestCase::DoTeardown()
+{
+    GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(1));
+    Simulator::Destroy();
+}
+
+std::vector<std::string>
+GlobalRoutingUpdateTestCase::GetRoutes(bool sorted, bool ipv6) const
+{
+    std::vector<std::string> routes;
+    for (auto node = m_nodes.Begin(); node != m_nodes.End(); node++)
+    {
+        std::vector<std::string> nodeRoutes;
+        Ptr<Ipv4GlobalRouting> routingv4 =
+            (*node)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+        for (uint32_t i = 0; i < routingv4->GetNRoutes(); i++)
+        {
+            std::ostringstream route;
+            route << *routingv4->GetRoute(i);
+            nodeRoutes.push_back(route.str());
+        }
+        Ptr<Ipv6GlobalRouting> routingv6 =
+            (*node)->GetObject<Ipv6>()->GetRoutingProtocol()->GetObject<Ipv6GlobalRouting>();
+        for (uint32_t i = 0; ipv6 && i < routingv6->GetNRoutes(); i++)
+        {
+            std::ostringstream route;
+            route << *routingv6->GetRoute(i);
+            nodeRoutes.push_back(route.str());
+        }
+        if (sorted)
+        {
+            std::sort(nodeRoutes.begin(), nodeRoutes.end());
+        }
+        std::ostringstream oss;
+        for (const auto& route : nodeRoutes)
+        {
+            oss << route << std::endl;
+        }
+        routes.push_back(oss.str());
+    }
+    return routes;
+}
+
+void
+GlobalRoutingUpdateTestCase::SetLink(uint32_t link, uint32_t ends, bool up)
+{
+    for (uint32_t i = 0; i < ends; i++)
+    {
+        Ptr<NetDevice> device = m_links[link].Get(i);
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        Ptr<Ipv6> ipv6 = device->GetNode()->GetObject<Ipv6>();
+        if (up)
+        {
+            ipv4->SetUp(ipv4->GetInterfaceForDevice(device));
+            ipv6->SetUp(ipv6->GetInterfaceForDevice(device));
+        }
+        else
+        {
+            ipv4->SetDown(ipv4->GetInterfaceForDevice(device));
+            ipv6->SetDown(ipv6->GetInterfaceForDevice(device));
+        }
+    }
+}
+
+void
+GlobalRoutingUpdateTestCase::DoRun()
+{
+    GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(1));
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Ipv6GlobalRoutingHelper::PopulateRoutingTables();
+    std::vector<std::string> serialRoutes = GetRoutes(false);
+    // An IPv6 interface set down loses its global addresses
+    std::vector<std::string> initialRoutes = GetRoutes(true, false);
+
+    // The threads compute the same routes, in the same order
+    GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(4));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    Ipv6GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::string> parallelRoutes = GetRoutes(false);
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(parallelRoutes[i],
+                              serialRoutes[i],
+                              "Different routes computed in parallel for node " << i);
+    }
+
+    // Links going down and up, within and at the border of the grid, between
+    // the stub router and the grid, and on one side only
+    for (const auto& [link, ends] : {std::pair(9, 2), std::pair(0, 2), std::pair(17, 2),
+                                     std::pair(13, 1)})
+    {
+        for (bool up : {false, true})
+        {
+            SetLink(link, ends, up);
+            Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+            Ipv6GlobalRoutingHelper::UpdateRoutingTables();
+            std::vector<std::string> updatedRoutes = GetRoutes(true);
+            Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+            Ipv6GlobalRoutingHelper::RecomputeRoutingTables();
+            std::vector<std::string> recomputedRoutes = GetRoutes(true);
+            for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+            {
+                NS_TEST_EXPECT_MSG_EQ(updatedRoutes[i],
+                                      recomputedRoutes[i],
+                                      "Different routes updated for node "
+                                          << i << " after setting link " << link
+                                          << (up ? " up" : " down"));
+            }
+        }
+    }
+    std::vector<std::string> finalRoutes = GetRoutes(true, false);
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(finalRoutes[i],
+                              initialRoutes[i],
+                              "Different routes for node " << i << " once all the links are up");
+    }
+
+    // A change of metric moves the shortest paths
+    Ptr<Ipv4> ipv4 = m_nodes.Get(5)->GetObject<Ipv4>();
+    ipv4->SetMetric(ipv4->GetInterfaceForDevice(m_links[9].Get(0)), 5);
+    Ipv4GlobalRoutingHelper::UpdateRoutingTables();
+    std::vector<std::string> updatedRoutes = GetRoutes(true);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::string> recomputedRoutes = GetRoutes(true);
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(updatedRoutes[i],
+                              recomputedRoutes[i],
+                              "Different routes updated for node " << i
+                                                                   << " after a change of metric");
+    }
+}
+
 /**
  * @ingroup internet-test
  *
@@ -2968,6 +3214,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new EcmpRouteCalculationTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingv4ProtocolTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingv6ProtocolTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new GlobalRoutingUpdateTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ip-prefix-trie.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IpPrefixTrie Test
+ *
+ * Random prefixes, many of them nested or equal, are added to and removed
+ * from a trie, whose matches are checked against all the prefixes.
+ *
+ * @tparam Address The address type, Ipv4Address or Ipv6Address.
+ */
+template <typename Address>
+class IpPrefixTrieTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] name The name of the test case.
+     */
+    IpPrefixTrieTestCase(const std::string& name);
+
+  private:
+    void DoRun() override;
+
+    /// The trie tested, holding the index of the prefixes
+    using Trie = IpPrefixTrie<Address, uint32_t>;
+    /// The bytes of an address
+    using Bytes = std::array<uint8_t, Trie::ADDRESS_BITS / 8>;
+
+    /** A prefix added to the trie. */
+    struct Prefix
+    {
+        Bytes bytes;    //!< The prefix, with random bits beyond its length.
+        uint8_t length; //!< The length of the prefix.
+        bool removed;   //!< Whether the prefix was removed from the trie.
+    };
+
+    /**
+     * Get random bytes continuing a prefix.
+     *
+     * @param [in] prefix The prefix.
+     * @param [in] length The length of the prefix.
+     * @returns The bytes, whose bits beyond the length of the prefix are random.
+     */
+    Bytes GetRandomBytes(const Bytes& prefix, uint8_t length);
+
+    /**
+     * @param [in] bytes The bytes of an address.
+     * @param [in] prefix The prefix.
+     * @returns Whether the address matches the prefix.
+     */
+    static bool IsMatch(const Bytes& bytes, const Prefix& prefix);
+
+    /**
+     * Check the prefixes of the trie matching an address against all the
+     * prefixes.
+     *
+     * @param [in] bytes The bytes of the address.
+     */
+    void CheckMatches(const Bytes& bytes);
+
+    Trie m_trie;                         //!< The trie.
+    std::vector<Prefix> m_prefixes;      //!< The prefixes, by index.
+    Ptr<UniformRandomVariable> m_random; //!< Random prefixes.
+};
+
+template <typename Address>
+IpPrefixTrieTestCase<Address>::IpPrefixTrieTestCase(const std::string& name)
+    : TestCase(name)
+{
+}
+
+template <typename Address>
+typename IpPrefixTrieTestCase<Address>::Bytes
+IpPrefixTrieTestCase<Address>::GetRandomBytes(const Bytes& prefix, uint8_t length)
+{
+    Bytes bytes;
+    for (std::size_t i = 0; i < bytes.size(); i++)
+    {
+        const uint8_t mask = i < length / 8u ? 0xff : i == length / 8u ? 0xff00 >> (length % 8) : 0;
+        bytes[i] = (prefix[i] & mask) | (m_random->GetInteger(0, 255) & ~mask);
+    }
+    return bytes;
+}
+
+template <typename Address>
+bool
+IpPrefixTrieTestCase<Address>::IsMatch(const Bytes& bytes, const Prefix& prefix)
+{
+    for (uint8_t i = 0; i < prefix.length; i++)
+    {
+        const uint8_t bit = 0x80 >> (i % 8);
+        if ((bytes[i / 8] & bit) != (prefix.bytes[i / 8] & bit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Address>
+void
+IpPrefixTrieTestCase<Address>::CheckMatches(const Bytes& bytes)
+{
+    std::map<uint8_t, std::vector<uint32_t>, std::greater<>> expected;
+    for (uint32_t i = 0; i < m_prefixes.size(); i++)
+    {
+        if (!m_prefixes[i].removed && IsMatch(bytes, m_prefixes[i]))
+        {
+            expected[m_prefixes[i].length].push_back(i);
+        }
+    }
+
+    std::map<uint8_t, std::vector<uint32_t>, std::greater<>> found;
+    std::vector<uint8_t> lengths;
+    const Address address = Address::Deserialize(bytes.data());
+    bool stopped = m_trie.VisitMatches(address, [&](const auto& values, uint8_t length) {
+        found[length] = values;
+        lengths.push_back(length);
+        return false;
+    });
+    NS_TEST_EXPECT_MSG_EQ(stopped, false, "The visit should not stop");
+    NS_TEST_EXPECT_MSG_EQ((found == expected), true, "Bad matches for " << address);
+    NS_TEST_EXPECT_MSG_EQ(std::is_sorted(lengths.begin(), lengths.end(), std::greater<>()),
+                          true,
+                          "The matches should be visited from the longest");
+
+    uint32_t visited = 0;
+    stopped = m_trie.VisitMatches(address, [&](const auto&, uint8_t) {
+        visited++;
+        return true;
+    });
+    NS_TEST_EXPECT_MSG_EQ(stopped, !expected.empty(), "The visit should stop at the first match");
+    NS_TEST_EXPECT_MSG_EQ(visited, (expected.empty() ? 0 : 1), "Bad number of visited prefixes");
+}
+
+template <typename Address>
+void
+IpPrefixTrieTestCase<Address>::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(1);
+    const uint32_t bits = Trie::ADDRESS_BITS;
+
+    // Add prefixes, which are new, nested in a previous prefix, or equal to one
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        Prefix prefix;
+        const double draw = m_random->GetValue();
+        if (i == 0 || draw < 0.3)
+        {
+            prefix.length = m_random->GetInteger(0, bits);
+            prefix.bytes = GetRandomBytes(Bytes(), 0);
+        }
+        else
+        {
+            const Prefix& parent = m_prefixes[m_random->GetInteger(0, i - 1)];
+            prefix.length =
+                draw < 0.4 ? parent.length : m_random->GetInteger(parent.length, bits);
+            prefix.bytes = GetRandomBytes(parent.bytes, parent.length);
+        }
+        prefix.removed = false;
+        m_prefixes.push_back(prefix);
+        m_trie.Insert(Address::Deserialize(prefix.bytes.data()), prefix.length, i);
+
+        if (i % 100 == 99)
+        {
+            for (uint32_t j = 0; j < 20; j++)
+            {
+                const Prefix& matched = m_prefixes[m_random->GetInteger(0, i)];
+                CheckMatches(GetRandomBytes(matched.bytes, matched.length));
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_trie.GetN(), m_prefixes.size(), "Bad number of values");
+
+    // Remove a third of the prefixes
+    uint32_t remaining = m_prefixes.size();
+    for (uint32_t i = 0; i < m_prefixes.size(); i++)
+    {
+        if (m_random->GetValue() < 1.0 / 3)
+        {
+            Prefix& prefix = m_prefixes[i];
+            const Address address = Address::Deserialize(prefix.bytes.data());
+            NS_TEST_EXPECT_MSG_EQ(m_trie.Remove(address, prefix.length, i),
+                                  true,
+                                  "The prefix should be removed");
+            NS_TEST_EXPECT_MSG_EQ(m_trie.Remove(address, prefix.length, i),
+                                  false,
+                                  "The prefix should already be removed");
+            prefix.removed = true;
+            remaining--;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_trie.GetN(), remaining, "Bad number of values");
+    for (uint32_t j = 0; j < 500; j++)
+    {
+        const Prefix& matched = m_prefixes[m_random->GetInteger(0, m_prefixes.size() - 1)];
+        CheckMatches(GetRandomBytes(matched.bytes, matched.length));
+    }
+
+    // Find the values of each prefix
+    for (uint32_t i = 0; i < m_prefixes.size(); i++)
+    {
+        const Prefix& prefix = m_prefixes[i];
+        std::vector<uint32_t> expected;
+        for (uint32_t j = 0; j < m_prefixes.size(); j++)
+        {
+            if (!m_prefixes[j].removed && m_prefixes[j].length == prefix.length &&
+                IsMatch(prefix.bytes, m_prefixes[j]))
+            {
+                expected.push_back(j);
+            }
+        }
+        auto values = m_trie.Find(Address::Deserialize(prefix.bytes.data()), prefix.length);
+        NS_TEST_EXPECT_MSG_EQ((values ? *values : std::vector<uint32_t>()) == expected,
+                              true,
+                              "Bad values of prefix " << i);
+    }
+
+    m_trie.Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_trie.GetN(), 0, "The trie should be empty");
+    NS_TEST_EXPECT_MSG_EQ(m_trie.Find(Address::Deserialize(m_prefixes[0].bytes.data()), 0),
+                          nullptr,
+                          "The trie should be empty");
+    m_prefixes.clear();
+    CheckMatches(GetRandomBytes(Bytes(), 0));
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IpPrefixTrie TestSuite
+ */
+class IpPrefixTrieTestSuite : public TestSuite
+{
+  public:
+    IpPrefixTrieTestSuite();
+};
+
+IpPrefixTrieTestSuite::IpPrefixTrieTestSuite()
+    : TestSuite("ip-prefix-trie", Type::UNIT)
+{
+    AddTestCase(new IpPrefixTrieTestCase<Ipv4Address>("IPv4 prefixes"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new IpPrefixTrieTestCase<Ipv6Address>("IPv6 prefixes"),
+                TestCase::Duration::QUICK);
+}
+
+static IpPrefixTrieTestSuite g_ipPrefixTrieTestSuite; //!< Static variable for test initialization
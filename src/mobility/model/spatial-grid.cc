@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#include "spatial-grid.h"
+
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef NS3_MTP
+/// Lock the mutex of the grid until the end of the scope
+#define SPATIAL_GRID_LOCK() std::lock_guard lock(m_mutex)
+#else
+/// Nothing to lock without threads
+#define SPATIAL_GRID_LOCK()
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialGrid");
+
+namespace
+{
+
+/// The distance a moving item may cover before being sorted again, in cells
+constexpr double MARGIN = 0.25;
+
+/// The slot of an item which is in no cell
+constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+} // unnamed namespace
+
+SpatialGrid::SpatialGrid(double cellSize)
+    : m_cellSize(cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The cells must have a positive size");
+}
+
+SpatialGrid::~SpatialGrid()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+SpatialGrid::SetCellSize(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The cells must have a positive size");
+    SPATIAL_GRID_LOCK();
+    m_cellSize = cellSize;
+    m_cells.clear();
+    m_expiries = {};
+    m_changed.clear();
+    for (uint32_t i = 0; i < m_entries.size(); i++)
+    {
+        Entry& entry = m_entries[i];
+        if (entry.mobility)
+        {
+            entry.slot = NO_SLOT;
+            entry.changed = true;
+            m_changed.push_back(i);
+        }
+    }
+}
+
+double
+SpatialGrid::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+void
+SpatialGrid::Add(uint32_t item, Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << item << mobility);
+    SPATIAL_GRID_LOCK();
+    auto index = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back({item, nullptr, {}, 0, NO_SLOT, Time::Max(), false});
+    SetMobility(index, mobility);
+}
+
+void
+SpatialGrid::Add(uint32_t item, Callback<Ptr<MobilityModel>> getMobility)
+{
+    NS_LOG_FUNCTION(this << item);
+    SPATIAL_GRID_LOCK();
+    auto index = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back({item, nullptr, getMobility, 0, NO_SLOT, Time::Max(), false});
+    m_unresolved.push_back(index);
+}
+
+void
+SpatialGrid::SetMobility(uint32_t index, Ptr<MobilityModel> mobility)
+{
+    if (!mobility)
+    {
+        m_unlocated.push_back(index);
+        return;
+    }
+    m_entries[index].mobility = mobility;
+    auto& items = m_models[PeekPointer(mobility)];
+    if (items.empty())
+    {
+        mobility->TraceConnectWithoutContext("CourseChange",
+                                             MakeCallback(&SpatialGrid::CourseChanged, this));
+    }
+    items.push_back(index);
+    // The mobility model may not be positioned yet: sort the item at the next query
+    m_entries[index].changed = true;
+    m_changed.push_back(index);
+}
+
+void
+SpatialGrid::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    SPATIAL_GRID_LOCK();
+    for (const auto& [mobility, items] : m_models)
+    {
+        m_entries[items.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&SpatialGrid::CourseChanged, this));
+    }
+    m_models.clear();
+    m_entries.clear();
+    m_unlocated.clear();
+    m_cells.clear();
+    m_unresolved.clear();
+    m_changed.clear();
+    m_expiries = {};
+}
+
+uint32_t
+SpatialGrid::GetN() const
+{
+    return static_cast<uint32_t>(m_entries.size());
+}
+
+std::vector<uint32_t>
+SpatialGrid::GetWithin(const Vector& position, double range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    SPATIAL_GRID_LOCK();
+    Update();
+
+    std::vector<uint32_t> found(m_unlocated);
+    auto visit = [&](const std::vector<uint32_t>& items) {
+        for (auto index : items)
+        {
+            if (CalculateDistance(m_entries[index].mobility->GetPosition(), position) <= range)
+            {
+                found.push_back(index);
+            }
+        }
+    };
+
+    // The moving items may be up to a margin away from their cell
+    const double reach = range + MARGIN * m_cellSize;
+    const int32_t xMin = GetCellIndex(position.x - reach);
+    const int32_t xMax = GetCellIndex(position.x + reach);
+    const int32_t yMin = GetCellIndex(position.y - reach);
+    const int32_t yMax = GetCellIndex(position.y + reach);
+    if ((static_cast<double>(xMax) - xMin + 1) * (static_cast<double>(yMax) - yMin + 1) >
+        m_cells.size())
+    {
+        // The range covers more cells than there are occupied ones
+        for (const auto& [cell, items] : m_cells)
+        {
+            visit(items);
+        }
+    }
+    else
+    {
+        for (int64_t x = xMin; x <= xMax; x++)
+        {
+            for (int64_t y = yMin; y <= yMax; y++)
+            {
+                auto cell = m_cells.find(GetCell(x, y));
+                if (cell != m_cells.end())
+                {
+                    visit(cell->second);
+                }
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    for (auto& index : found)
+    {
+        index = m_entries[index].item;
+    }
+    NS_LOG_LOGIC(found.size() << " of " << m_entries.size() << " items within " << range);
+    return found;
+}
+
+int32_t
+SpatialGrid::GetCellIndex(double coordinate) const
+{
+    const double index = std::floor(coordinate / m_cellSize);
+    return static_cast<int32_t>(std::clamp<double>(index,
+                                                   std::numeric_limits<int32_t>::min(),
+                                                   std::numeric_limits<int32_t>::max()));
+}
+
+uint64_t
+SpatialGrid::GetCell(int32_t x, int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void
+SpatialGrid::Sort(uint32_t index)
+{
+    Entry& entry = m_entries[index];
+    // A course change notified while the position is computed sorts the item again
+    entry.changed = false;
+    const Vector position = entry.mobility->GetPosition();
+    const uint64_t cell = GetCell(GetCellIndex(position.x), GetCellIndex(position.y));
+    if (entry.slot == NO_SLOT || entry.cell != cell)
+    {
+        RemoveFromCell(index);
+        auto& items = m_cells[cell];
+        entry.cell = cell;
+        entry.slot = items.size();
+        items.push_back(index);
+    }
+
+    const double speed = entry.mobility->GetVelocity().GetLength();
+    const double delay = MARGIN * m_cellSize / speed;
+    if (speed > 0 && delay < Time::Max().GetSeconds() / 2)
+    {
+        entry.expiry = Simulator::Now() + std::max(Seconds(delay), TimeStep(1));
+        m_expiries.emplace(entry.expiry, index);
+    }
+    else
+    {
+        entry.expiry = Time::Max();
+    }
+}
+
+void
+SpatialGrid::RemoveFromCell(uint32_t index)
+{
+    Entry& entry = m_entries[index];
+    if (entry.slot == NO_SLOT)
+    {
+        return;
+    }
+    auto cell = m_cells.find(entry.cell);
+    NS_ASSERT(cell != m_cells.end());
+    auto& items = cell->second;
+    items[entry.slot] = items.back();
+    m_entries[items[entry.slot]].slot = entry.slot;
+    items.pop_back();
+    if (items.empty())
+    {
+        m_cells.erase(cell);
+    }
+    entry.slot = NO_SLOT;
+}
+
+void
+SpatialGrid::Update()
+{
+    for (auto index : m_unresolved)
+    {
+        SetMobility(index, m_entries[index].getMobility());
+        m_entries[index].getMobility = Callback<Ptr<MobilityModel>>();
+    }
+    m_unresolved.clear();
+
+    const Time now = Simulator::Now();
+    // Computing a position may notify a course change, e.g., when a waypoint is reached
+    do
+    {
+        std::vector<uint32_t> changed;
+        changed.swap(m_changed);
+        for (auto index : changed)
+        {
+            Sort(index);
+        }
+        while (!m_expiries.empty() && m_expiries.top().first <= now)
+        {
+            auto [expiry, index] = m_expiries.top();
+            m_expiries.pop();
+            // Skip the expiries replaced by a later sort of the item
+            if (m_entries[index].expiry == expiry)
+            {
+                Sort(index);
+            }
+        }
+    } while (!m_changed.empty());
+}
+
+void
+SpatialGrid::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    SPATIAL_GRID_LOCK();
+    auto items = m_models.find(PeekPointer(mobility));
+    if (items == m_models.end())
+    {
+        return;
+    }
+    for (auto index : items->second)
+    {
+        if (!m_entries[index].changed)
+        {
+            m_entries[index].changed = true;
+            m_changed.push_back(index);
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,199 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "mobility-model.h"
+
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#ifdef NS3_MTP
+#include <mutex>
+#endif
+
+namespace ns3
+{
+
+/**
+ * @ingroup mobility
+ *
+ * @brief Index of the positions of a set of mobility models, which finds
+ * the models within a range of a position without visiting the others.
+ *
+ * The models are sorted in the square cells of a grid of the horizontal
+ * plane, whose size is typically the range of the queries: a query then
+ * visits a few cells around its position, and checks the distance of the
+ * models they hold.  A channel can use it to find the receivers in range
+ * of a transmitter.
+ *
+ * The grid is updated lazily, when it is queried:
+ *   - the models whose course changed since the last query, as notified
+ *     by their \c CourseChange trace source, are moved to their cell;
+ *   - a moving model stays in the cell of a past position until it may
+ *     have moved by a quarter of a cell, according to its speed when it
+ *     was sorted; the queries visit the cells within this margin of their
+ *     range.
+ *
+ * The distance to the models visited is computed with their current
+ * position, so that the result of a query is exact provided that the
+ * speed of a model does not increase without a course change
+ * notification.  This holds for all the mobility models of ns-3 but the
+ * ConstantAccelerationMobilityModel.
+ */
+class SpatialGrid : public SimpleRefCount<SpatialGrid>
+{
+  public:
+    /**
+     * Create an empty grid.
+     *
+     * @param [in] cellSize The size of the cells (m).
+     */
+    SpatialGrid(double cellSize);
+    ~SpatialGrid();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+    /**
+     * Set the size of the cells, and sort the models again.
+     *
+     * @param [in] cellSize The size of the cells (m).
+     */
+    void SetCellSize(double cellSize);
+    /**
+     * @returns The size of the cells (m).
+     */
+    double GetCellSize() const;
+
+    /**
+     * Add a model to the grid.
+     *
+     * An item without mobility model is part of the result of every query.
+     *
+     * @param [in] item The identifier of the item, returned by the queries.
+     * @param [in] mobility The mobility model of the item, or null.
+     */
+    void Add(uint32_t item, Ptr<MobilityModel> mobility);
+    /**
+     * Add a model to the grid, which is looked up at the next query.
+     *
+     * This lets a channel add its receivers before their nodes are given
+     * a mobility model.
+     *
+     * @param [in] item The identifier of the item, returned by the queries.
+     * @param [in] getMobility The callback returning the mobility model of
+     *             the item, or null.
+     */
+    void Add(uint32_t item, Callback<Ptr<MobilityModel>> getMobility);
+    /**
+     * Remove all the models.
+     */
+    void Clear();
+    /**
+     * @returns The number of items in the grid.
+     */
+    uint32_t GetN() const;
+
+    /**
+     * Get the items within a distance of a position.
+     *
+     * @param [in] position The position.
+     * @param [in] range The distance (m).
+     * @returns The identifiers of the items, in the order they were added.
+     */
+    std::vector<uint32_t> GetWithin(const Vector& position, double range);
+
+  private:
+    /** An item of the grid. */
+    struct Entry
+    {
+        uint32_t item;                            //!< The identifier of the item.
+        Ptr<MobilityModel> mobility;              //!< The mobility model, or null.
+        Callback<Ptr<MobilityModel>> getMobility; //!< Returns the mobility model.
+        uint64_t cell;                            //!< The cell holding the item.
+        uint32_t slot;                            //!< The index of the item in its cell.
+        Time expiry;                              //!< The time the item must be sorted again.
+        bool changed;                             //!< Whether the course of the item changed.
+    };
+
+    /** A moving item to sort again, by increasing time. */
+    using Expiry = std::pair<Time, uint32_t>;
+
+    /**
+     * Get the key of a cell.
+     *
+     * @param [in] x The index of the cell along the x axis.
+     * @param [in] y The index of the cell along the y axis.
+     * @returns The key of the cell.
+     */
+    static uint64_t GetCell(int32_t x, int32_t y);
+    /**
+     * Get the index of the cells holding a coordinate.
+     *
+     * @param [in] coordinate The coordinate.
+     * @returns The index of the cells.
+     */
+    int32_t GetCellIndex(double coordinate) const;
+    /**
+     * Set the mobility model of an item, and follow its course changes.
+     *
+     * @param [in] index The index of the entry of the item.
+     * @param [in] mobility The mobility model, or null.
+     */
+    void SetMobility(uint32_t index, Ptr<MobilityModel> mobility);
+    /**
+     * Move an item to the cell of its current position.
+     *
+     * @param [in] index The index of the entry of the item.
+     */
+    void Sort(uint32_t index);
+    /**
+     * Remove an item from its cell.
+     *
+     * @param [in] index The index of the entry of the item.
+     */
+    void RemoveFromCell(uint32_t index);
+    /**
+     * Look up the mobility models added with a callback, and sort the
+     * items whose course changed, or which may have left the margin of
+     * their cell.
+     */
+    void Update();
+    /**
+     * Trace sink for the course changes of the mobility models.
+     *
+     * @param [in] mobility The mobility model.
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                                           //!< The size of the cells.
+    std::vector<Entry> m_entries;                                //!< The items.
+    std::vector<uint32_t> m_unlocated;                           //!< Items without mobility.
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells; //!< The items of each cell.
+    /// The items of each mobility model.
+    std::unordered_map<const MobilityModel*, std::vector<uint32_t>> m_models;
+    std::vector<uint32_t> m_unresolved; //!< Items whose mobility model is not looked up.
+    std::vector<uint32_t> m_changed;    //!< Items whose course changed.
+    /// The moving items, by increasing time they must be sorted again.
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<>> m_expiries;
+#ifdef NS3_MTP
+    /// Protects the grid from the threads sharing it.  It is recursive,
+    /// since a mobility model may notify a course change when queried.
+    std::recursive_mutex m_mutex;
+#endif
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_H */
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/spatial-grid.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check the items found by a SpatialGrid against all the items,
+ * while they move.
+ */
+class SpatialGridTestCase : public TestCase
+{
+  public:
+    SpatialGridTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the items of the grid within a range of a few positions.
+     *
+     * @param [in] range The range.
+     */
+    void Check(double range);
+
+    Ptr<SpatialGrid> m_grid;                    //!< The grid.
+    std::vector<Ptr<MobilityModel>> m_mobility; //!< The mobility model of each item.
+    std::vector<uint32_t> m_items;              //!< The identifier of each item.
+    Ptr<UniformRandomVariable> m_random;        //!< Random coordinates.
+    uint32_t m_checks;                          //!< Number of items found.
+};
+
+SpatialGridTestCase::SpatialGridTestCase()
+    : TestCase("Check the items within range of moving positions"),
+      m_checks(0)
+{
+}
+
+void
+SpatialGridTestCase::Check(double range)
+{
+    for (int i = 0; i < 50; i++)
+    {
+        Vector position(m_random->GetValue(-100, 2100), m_random->GetValue(-100, 2100), 0);
+        std::vector<uint32_t> expected;
+        for (std::size_t j = 0; j < m_items.size(); j++)
+        {
+            if (!m_mobility[j] ||
+                CalculateDistance(m_mobility[j]->GetPosition(), position) <= range)
+            {
+                expected.push_back(m_items[j]);
+            }
+        }
+        auto found = m_grid->GetWithin(position, range);
+        NS_TEST_EXPECT_MSG_EQ((found == expected),
+                              true,
+                              "Bad items within " << range << " of " << position << " at "
+                                                  << Simulator::Now().As(Time::S));
+        m_checks += found.size();
+    }
+}
+
+void
+SpatialGridTestCase::DoRun()
+{
+    m_random = CreateObject<UniformRandomVariable>();
+    m_random->SetStream(1);
+    m_grid = Create<SpatialGrid>(250);
+
+    // Half of the items are fixed, the others move at up to 60 m/s, and one
+    // item has no position
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        Ptr<MobilityModel> mobility;
+        if (i == 100)
+        {
+            mobility = nullptr;
+        }
+        else if (i % 2 == 0)
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        else
+        {
+            auto moving = CreateObject<ConstantVelocityMobilityModel>();
+            moving->SetVelocity(
+                Vector(m_random->GetValue(-60, 60), m_random->GetValue(-60, 60), 0));
+            mobility = moving;
+        }
+        if (mobility)
+        {
+            mobility->SetPosition(
+                Vector(m_random->GetValue(0, 2000), m_random->GetValue(0, 2000), 0));
+        }
+        m_mobility.push_back(mobility);
+        m_items.push_back(3 * i + 1);
+        if (i % 50 == 1)
+        {
+            // Looked up at the first query
+            m_grid->Add(m_items.back(),
+                        Callback<Ptr<MobilityModel>>([this, i]() { return m_mobility[i]; }));
+        }
+        else
+        {
+            m_grid->Add(m_items.back(), mobility);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_grid->GetN(), 200, "Bad number of items");
+
+    for (int t = 0; t <= 60; t++)
+    {
+        Simulator::Schedule(Seconds(t + 0.5), &SpatialGridTestCase::Check, this, 250);
+        Simulator::Schedule(Seconds(t + 0.5), &SpatialGridTestCase::Check, this, 100);
+        Simulator::Schedule(Seconds(t + 0.5), &SpatialGridTestCase::Check, this, 1000);
+    }
+    // Course changes: jumps, and moving items stopping or accelerating
+    Simulator::Schedule(Seconds(10), [this]() {
+        m_mobility[0]->SetPosition(Vector(1900, 1900, 0));
+        m_mobility[2]->SetPosition(Vector(-50, 10, 0));
+    });
+    Simulator::Schedule(Seconds(20), [this]() {
+        DynamicCast<ConstantVelocityMobilityModel>(m_mobility[1])->SetVelocity(Vector());
+    });
+    Simulator::Schedule(Seconds(30), [this]() {
+        m_mobility[3]->SetPosition(Vector(1000, 1000, 0));
+        DynamicCast<ConstantVelocityMobilityModel>(m_mobility[3])->SetVelocity(Vector(0, 80, 0));
+    });
+    Simulator::Schedule(Seconds(40), [this]() { m_grid->SetCellSize(100); });
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_GT(m_checks, 0, "No item found");
+
+    m_grid->Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_grid->GetN(), 0, "The grid should be empty");
+    NS_TEST_EXPECT_MSG_EQ(m_grid->GetWithin(Vector(), 1e6).empty(), true, "Item found");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief SpatialGrid test suite.
+ */
+class SpatialGridTestSuite : public TestSuite
+{
+  public:
+    SpatialGridTestSuite();
+};
+
+SpatialGridTestSuite::SpatialGridTestSuite()
+    : TestSuite("spatial-grid", Type::UNIT)
+{
+    AddTestCase(new SpatialGridTestCase, TestCase::Duration::QUICK);
+}
+
+static SpatialGridTestSuite g_spatialGridTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,342 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mtp
+ * Implementation of class ns3::LogicalProcess.
+ */
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("LogicalProcess");
+
+/** The logical process executed by the calling thread. */
+static thread_local LogicalProcess* g_currentLp = nullptr;
+
+LogicalProcess::LogicalProcess(uint32_t systemId, ObjectFactory schedulerFactory)
+    : m_systemId(systemId),
+      m_events(schedulerFactory.Create<Scheduler>()),
+      m_inbox(nullptr),
+      m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_eventCount(0),
+      m_messageSeq(0),
+      m_packetUid(static_cast<uint64_t>(systemId) << 48)
+{
+    NS_LOG_FUNCTION(this << systemId);
+}
+
+LogicalProcess::~LogicalProcess()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+LogicalProcess*
+LogicalProcess::GetCurrent()
+{
+    return g_currentLp;
+}
+
+uint32_t
+LogicalProcess::GetSystemId() const
+{
+    return m_systemId;
+}
+
+void
+LogicalProcess::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+    while (!m_events->IsEmpty())
+    {
+        scheduler->Insert(m_events->RemoveNext());
+    }
+    m_events = scheduler;
+}
+
+EventId
+LogicalProcess::Schedule(const Time& delay, uint32_t context, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "LogicalProcess::Schedule(): Negative delay");
+    Time tAbsolute = delay + TimeStep(m_currentTs);
+
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = static_cast<uint64_t>(tAbsolute.GetTimeStep());
+    ev.key.m_context = context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_events->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+LogicalProcess::Insert(uint64_t ts, uint32_t context, EventImpl* event)
+{
+    NS_ASSERT_MSG(ts >= m_currentTs, "LogicalProcess::Insert(): Event in the past");
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_events->Insert(ev);
+}
+
+void
+LogicalProcess::Adopt(const Scheduler::Event& ev)
+{
+    m_uid = std::max(m_uid, ev.key.m_uid + 1);
+    m_events->Insert(ev);
+}
+
+Scheduler::Event
+LogicalProcess::RemoveNext()
+{
+    return m_events->RemoveNext();
+}
+
+void
+LogicalProcess::Post(LogicalProcess* sender, uint64_t ts, uint32_t context, EventImpl* event)
+{
+    auto message = new Message;
+    message->ts = ts;
+    message->context = context;
+    message->uid = EventId::UID::INVALID;
+    message->event = event;
+    if (sender != nullptr)
+    {
+        message->sender = sender->m_systemId;
+        message->seq = sender->m_messageSeq++;
+    }
+    else
+    {
+        message->sender = std::numeric_limits<uint32_t>::max();
+        message->seq = 0;
+    }
+    Push(message);
+}
+
+void
+LogicalProcess::PostRemove(const EventId& id)
+{
+    auto message = new Message;
+    message->ts = id.GetTs();
+    message->seq = 0;
+    message->sender = 0;
+    message->context = id.GetContext();
+    message->uid = id.GetUid();
+    message->event = id.PeekEventImpl();
+    // Keep the event alive until it is removed, whatever the caller does with its id
+    message->event->Ref();
+    message->event->Cancel();
+    Push(message);
+}
+
+void
+LogicalProcess::Push(Message* message)
+{
+    message->next = m_inbox.load(std::memory_order_relaxed);
+    while (!m_inbox.compare_exchange_weak(message->next,
+                                          message,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+LogicalProcess::ReceiveMessages()
+{
+    Message* message = m_inbox.exchange(nullptr, std::memory_order_acquire);
+    if (message == nullptr)
+    {
+        return;
+    }
+
+    while (message != nullptr)
+    {
+        Message* next = message->next;
+        if (message->uid != EventId::UID::INVALID)
+        {
+            // The event has already been cancelled, take it out of the event list
+            Scheduler::Event event;
+            event.impl = message->event;
+            event.key.m_ts = message->ts;
+            event.key.m_context = message->context;
+            event.key.m_uid = message->uid;
+            m_events->Remove(event);
+            // Release the reference of the event list, then the one of the message
+            event.impl->Unref();
+            event.impl->Unref();
+            delete message;
+            message = next;
+            continue;
+        }
+        if (message->sender == std::numeric_limits<uint32_t>::max())
+        {
+            // Sent by a foreign thread, the timestamp is relative to our clock
+            message->ts += m_currentTs;
+        }
+        m_received.push_back(message);
+        message = next;
+    }
+    // The inbox is a stack, so the arrival order is reversed and, above all,
+    // depends on thread scheduling: sort to get a reproducible event order
+    std::sort(m_received.begin(), m_received.end(), [](const Message* a, const Message* b) {
+        return std::tie(a->ts, a->sender, a->seq) < std::tie(b->ts, b->sender, b->seq);
+    });
+    for (auto received : m_received)
+    {
+        Insert(received->ts, received->context, received->event);
+        delete received;
+    }
+    m_received.clear();
+}
+
+void
+LogicalProcess::ProcessEventsUntil(uint64_t end, const std::atomic<bool>* stop)
+{
+    LogicalProcess* previous = g_currentLp;
+    g_currentLp = this;
+    // The public logical process shares the global packet uid counter
+    // with the code running outside of the simulation
+    if (m_systemId != 0)
+    {
+        Packet::SetUidCounter(&m_packetUid);
+    }
+    while (!m_events->IsEmpty() && (stop == nullptr || !stop->load(std::memory_order_relaxed)))
+    {
+        if (m_events->PeekNext().key.m_ts >= end)
+        {
+            break;
+        }
+        Scheduler::Event next = m_events->RemoveNext();
+
+        NS_ASSERT(next.key.m_ts >= m_currentTs);
+        m_eventCount++;
+
+        m_currentTs = next.key.m_ts;
+        m_currentContext = next.key.m_context;
+        m_currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+    }
+    if (m_systemId != 0)
+    {
+        Packet::SetUidCounter(nullptr);
+    }
+    g_currentLp = previous;
+}
+
+bool
+LogicalProcess::IsEmpty() const
+{
+    return m_events->IsEmpty();
+}
+
+uint64_t
+LogicalProcess::GetNextTs() const
+{
+    if (m_events->IsEmpty())
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return m_events->PeekNext().key.m_ts;
+}
+
+void
+LogicalProcess::Remove(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+bool
+LogicalProcess::IsExpired(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+void
+LogicalProcess::SetNow(uint64_t ts)
+{
+    NS_ASSERT(ts >= m_currentTs);
+    m_currentTs = ts;
+}
+
+Time
+LogicalProcess::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(m_currentTs);
+}
+
+uint64_t
+LogicalProcess::GetCurrentTs() const
+{
+    return m_currentTs;
+}
+
+uint32_t
+LogicalProcess::GetContext() const
+{
+    return m_currentContext;
+}
+
+uint64_t
+LogicalProcess::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+void
+LogicalProcess::Clear()
+{
+    ReceiveMessages();
+    if (!m_events)
+    {
+        return;
+    }
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        next.impl->Unref();
+    }
+}
+
+} // namespace ns3
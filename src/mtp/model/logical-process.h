@@ -0,0 +1,249 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mtp
+ * Declaration of class ns3::LogicalProcess.
+ */
+
+#ifndef NS3_LOGICAL_PROCESS_H
+#define NS3_LOGICAL_PROCESS_H
+
+#include "ns3/event-id.h"
+#include "ns3/event-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+
+#include <atomic>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mtp
+ *
+ * @brief A partition of a multithreaded simulation.
+ *
+ * Each logical process owns the event list of the nodes assigned to it,
+ * together with its own clock, event uid counter and execution context.
+ * Within a time window granted by the MultithreadedSimulatorImpl, a
+ * logical process is executed by exactly one thread, so its event list
+ * is never accessed concurrently.
+ *
+ * Events scheduled by a logical process on a node owned by another one
+ * are posted to the receiver inbox, a lock-free multiple-producer,
+ * single-consumer stack, and are moved into the receiver event list
+ * between two windows by ReceiveMessages().  Messages are sorted by
+ * timestamp, sender and sender sequence number before being inserted,
+ * so that the order of simultaneous events does not depend on the
+ * interleaving of the threads.  The removal of an event by another
+ * logical process goes through the inbox as well, so that the event list
+ * is only ever modified by the thread owning it.
+ *
+ * The packets created while executing the events of a logical process
+ * get their uid from a counter owned by the logical process.
+ */
+class LogicalProcess
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] systemId The index of this logical process.
+     * @param [in] schedulerFactory The factory used to create the event list.
+     */
+    LogicalProcess(uint32_t systemId, ObjectFactory schedulerFactory);
+    /** Destructor. */
+    ~LogicalProcess();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogicalProcess(const LogicalProcess&) = delete;
+    LogicalProcess& operator=(const LogicalProcess&) = delete;
+
+    /**
+     * Get the logical process whose events are being executed by the
+     * calling thread.
+     *
+     * @return The current logical process, or \c nullptr if the calling
+     *         thread is not executing events.
+     */
+    static LogicalProcess* GetCurrent();
+
+    /** @return The index of this logical process. */
+    uint32_t GetSystemId() const;
+
+    /**
+     * Replace the event list, moving any pending event to the new one.
+     *
+     * @param [in] schedulerFactory The factory used to create the new event list.
+     */
+    void SetScheduler(ObjectFactory schedulerFactory);
+
+    /**
+     * Schedule an event in the event list of this logical process.
+     *
+     * @param [in] delay The delay relative to the clock of this logical process.
+     * @param [in] context The event context.
+     * @param [in] event The event to schedule.
+     * @return The id of the scheduled event.
+     */
+    EventId Schedule(const Time& delay, uint32_t context, EventImpl* event);
+
+    /**
+     * Insert an event at an absolute time in the event list of this
+     * logical process.
+     *
+     * The caller must guarantee that no other thread is accessing this
+     * logical process.
+     *
+     * @param [in] ts The absolute event timestamp.
+     * @param [in] context The event context.
+     * @param [in] event The event to insert.
+     */
+    void Insert(uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Insert an event coming from the event list of another logical
+     * process, keeping its key so that existing EventId instances
+     * still refer to it.
+     *
+     * @param [in] ev The event to insert.
+     */
+    void Adopt(const Scheduler::Event& ev);
+
+    /**
+     * Remove the earliest event from the event list without executing it.
+     *
+     * @return The removed event.
+     */
+    Scheduler::Event RemoveNext();
+
+    /**
+     * Post an event sent by another logical process.
+     *
+     * This method is thread-safe and lock-free.
+     *
+     * @param [in] sender The logical process sending the event, or
+     *             \c nullptr if the event comes from a thread which is
+     *             not executing a logical process.
+     * @param [in] ts The absolute event timestamp if \pname{sender} is
+     *             not \c nullptr, the delay relative to the receiver
+     *             clock otherwise.
+     * @param [in] context The event context.
+     * @param [in] event The event to post.
+     */
+    void Post(LogicalProcess* sender, uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Post the removal of an event of this logical process requested by
+     * another one.
+     *
+     * The event is cancelled immediately and removed from the event list
+     * by the next call to ReceiveMessages().  The event must not be
+     * executed before then.  This method is thread-safe and lock-free.
+     *
+     * @param [in] id The event to remove.
+     */
+    void PostRemove(const EventId& id);
+
+    /**
+     * Move the events posted by other logical processes into the event
+     * list, and remove the events whose removal was posted.
+     */
+    void ReceiveMessages();
+
+    /**
+     * Execute the events with a timestamp strictly lower than \pname{end}.
+     *
+     * @param [in] end The end of the time window, in time steps.
+     * @param [in] stop Flag checked after each event to stop early, or
+     *             \c nullptr to execute the whole window.
+     */
+    void ProcessEventsUntil(uint64_t end, const std::atomic<bool>* stop = nullptr);
+
+    /** @return \c true if the event list is empty. */
+    bool IsEmpty() const;
+
+    /**
+     * @return The timestamp of the next event, or the maximum
+     *         representable time if the event list is empty.
+     */
+    uint64_t GetNextTs() const;
+
+    /**
+     * Remove an event from the event list.
+     *
+     * @param [in] id The event to remove.
+     */
+    void Remove(const EventId& id);
+
+    /**
+     * @param [in] id The event to check.
+     * @return \c true if the event has been executed or cancelled.
+     */
+    bool IsExpired(const EventId& id) const;
+
+    /**
+     * Move the clock of this logical process forward.
+     *
+     * @param [in] ts The new time, in time steps.
+     */
+    void SetNow(uint64_t ts);
+
+    /** @return The current time of this logical process. */
+    Time Now() const;
+
+    /** @return The current time of this logical process, in time steps. */
+    uint64_t GetCurrentTs() const;
+
+    /** @return The context of the event being executed. */
+    uint32_t GetContext() const;
+
+    /** @return The number of events executed by this logical process. */
+    uint64_t GetEventCount() const;
+
+    /** Unref all the pending events. */
+    void Clear();
+
+  private:
+    /** An event posted by another logical process. */
+    struct Message
+    {
+        uint64_t ts;      //!< Absolute timestamp, or relative delay if sender is null.
+        uint64_t seq;     //!< Sequence number of the message at the sender.
+        uint32_t sender;  //!< Index of the sender.
+        uint32_t context; //!< Event context.
+        uint32_t uid;     //!< Uid of the event to remove, or EventId::UID::INVALID.
+        EventImpl* event; //!< The event.
+        Message* next;    //!< Next message in the inbox.
+    };
+
+    /**
+     * Push a message on the inbox.
+     *
+     * @param [in] message The message.
+     */
+    void Push(Message* message);
+
+    uint32_t m_systemId;              //!< Index of this logical process.
+    Ptr<Scheduler> m_events;          //!< The event list.
+    std::atomic<Message*> m_inbox;    //!< Events posted by other logical processes.
+    std::vector<Message*> m_received; //!< Scratch space used to sort the inbox.
+
+    uint32_t m_uid;            //!< Next event unique id.
+    uint32_t m_currentUid;     //!< Unique id of the current event.
+    uint64_t m_currentTs;      //!< Timestamp of the current event.
+    uint32_t m_currentContext; //!< Execution context of the current event.
+    uint64_t m_eventCount;     //!< The event count.
+    uint64_t m_messageSeq;     //!< Sequence number of the next message sent.
+    uint64_t m_packetUid;      //!< Uid of the next packet created by this logical process.
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOGICAL_PROCESS_H */
@@ -0,0 +1,652 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mtp
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/**
+ * @ingroup mtp
+ * Get the propagation delay of a channel.
+ *
+ * @param [in] channel The channel.
+ * @param [out] delay The value of the "Delay" attribute of the channel.
+ * @return \c true if the channel has a strictly positive "Delay" attribute.
+ */
+bool
+GetChannelDelay(Ptr<Channel> channel, Time& delay)
+{
+    TimeValue value;
+    if (!channel->GetAttributeFailSafe("Delay", value))
+    {
+        return false;
+    }
+    delay = value.Get();
+    return delay.IsStrictlyPositive();
+}
+
+} // namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads executing the partitions "
+                          "(0 to use the number of hardware threads).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AutomaticPartition",
+                          "Partition the nodes by cutting the channels with a positive "
+                          "propagation delay, instead of using the node system ids.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MultithreadedSimulatorImpl::m_automaticPartition),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_partitioned(false),
+      m_automaticPartition(false),
+      m_maxThreads(0),
+      m_lookahead(std::numeric_limits<uint64_t>::max()),
+      m_stop(false),
+      m_parallel(false),
+      m_windowStart(0),
+      m_windowEnd(0),
+      m_nextLp(0),
+      m_exitWorkers(false),
+      m_mainThreadId(std::this_thread::get_id())
+{
+    NS_LOG_FUNCTION(this);
+    m_schedulerFactory.SetTypeId("ns3::MapScheduler");
+    m_lps.push_back(std::make_unique<LogicalProcess>(0, m_schedulerFactory));
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_lps.clear();
+    m_nodeLp.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        lp->SetScheduler(schedulerFactory);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    // All the partitions belong to the same process
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_lps.size();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    if (m_lookahead == std::numeric_limits<uint64_t>::max())
+    {
+        return Time::Max();
+    }
+    return TimeStep(m_lookahead);
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetLogicalProcess(uint32_t context) const
+{
+    if (context < m_nodeLp.size())
+    {
+        return m_lps[m_nodeLp[context]].get();
+    }
+    return m_lps.front().get();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetCurrentLogicalProcess() const
+{
+    LogicalProcess* lp = LogicalProcess::GetCurrent();
+    if (lp != nullptr)
+    {
+        return lp;
+    }
+    if (std::this_thread::get_id() == m_mainThreadId)
+    {
+        return m_lps.front().get();
+    }
+    return nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nNodes = NodeList::GetNNodes();
+
+    // Partition key of each node
+    std::vector<uint32_t> keys(nNodes);
+    if (m_automaticPartition)
+    {
+        // Union-find over the channels which do not provide any lookahead
+        std::iota(keys.begin(), keys.end(), 0);
+        auto find = [&keys](uint32_t i) {
+            while (keys[i] != i)
+            {
+                keys[i] = keys[keys[i]];
+                i = keys[i];
+            }
+            return i;
+        };
+        for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+        {
+            Time delay;
+            if (GetChannelDelay(*it, delay) || (*it)->GetNDevices() == 0)
+            {
+                continue;
+            }
+            uint32_t root = nNodes;
+            for (std::size_t i = 0; i < (*it)->GetNDevices(); ++i)
+            {
+                Ptr<Node> node = (*it)->GetDevice(i)->GetNode();
+                if (!node || node->GetId() >= nNodes)
+                {
+                    continue;
+                }
+                uint32_t other = find(node->GetId());
+                if (root == nNodes)
+                {
+                    root = other;
+                }
+                keys[std::max(root, other)] = std::min(root, other);
+                root = std::min(root, other);
+            }
+        }
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            keys[i] = find(i);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < nNodes; ++i)
+        {
+            keys[i] = NodeList::GetNode(i)->GetSystemId();
+        }
+    }
+
+    // Number the partitions by order of appearance, 0 is the public one
+    std::map<uint32_t, uint32_t> lpOfKey;
+    m_nodeLp.resize(nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        auto [it, inserted] = lpOfKey.emplace(keys[i], lpOfKey.size() + 1);
+        m_nodeLp[i] = it->second;
+    }
+    LogicalProcess* pub = m_lps.front().get();
+    for (uint32_t i = 1; i <= lpOfKey.size(); ++i)
+    {
+        m_lps.push_back(std::make_unique<LogicalProcess>(i, m_schedulerFactory));
+        m_lps.back()->SetNow(pub->GetCurrentTs());
+    }
+
+    // The lookahead is the smallest delay of the channels between partitions
+    m_lookahead = std::numeric_limits<uint64_t>::max();
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        std::set<uint32_t> lps;
+        for (std::size_t i = 0; i < (*it)->GetNDevices(); ++i)
+        {
+            Ptr<Node> node = (*it)->GetDevice(i)->GetNode();
+            if (node && node->GetId() < nNodes)
+            {
+                lps.insert(m_nodeLp[node->GetId()]);
+            }
+        }
+        if (lps.size() <= 1)
+        {
+            continue;
+        }
+        Time delay;
+        if (!GetChannelDelay(*it, delay))
+        {
+            NS_FATAL_ERROR("Channel " << (*it)->GetId() << " (" << (*it)->GetInstanceTypeId()
+                                      << ") connects nodes in different partitions but does "
+                                         "not have a positive Delay attribute");
+        }
+        m_lookahead = std::min<uint64_t>(m_lookahead, delay.GetTimeStep());
+    }
+    NS_LOG_INFO("Partitioned " << nNodes << " nodes into " << lpOfKey.size()
+                               << " logical processes, lookahead " << GetLookahead());
+
+    // Move the events scheduled so far to the partition of their node
+    pub->ReceiveMessages();
+    std::vector<Scheduler::Event> publicEvents;
+    while (!pub->IsEmpty())
+    {
+        Scheduler::Event ev = pub->RemoveNext();
+        LogicalProcess* lp = GetLogicalProcess(ev.key.m_context);
+        if (lp == pub)
+        {
+            publicEvents.push_back(ev);
+        }
+        else
+        {
+            lp->Adopt(ev);
+        }
+    }
+    for (const auto& ev : publicEvents)
+    {
+        pub->Adopt(ev);
+    }
+    m_partitioned = true;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessPartitions()
+{
+    uint32_t n = m_lps.size();
+    for (uint32_t i = m_nextLp++; i < n; i = m_nextLp++)
+    {
+        LogicalProcess* lp = m_lps[i].get();
+        if (lp->GetNextTs() < m_windowEnd)
+        {
+            // A stop requested by a partition takes effect at the end of
+            // the window, once every partition has reached the same time
+            lp->ProcessEventsUntil(m_windowEnd);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop()
+{
+    while (true)
+    {
+        m_barrier->arrive_and_wait();
+        if (m_exitWorkers)
+        {
+            return;
+        }
+        ProcessPartitions();
+        m_barrier->arrive_and_wait();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    return std::all_of(m_lps.begin(), m_lps.end(), [](const auto& lp) { return lp->IsEmpty(); });
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    m_stop = false;
+
+    uint32_t nThreads = m_maxThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = std::max<uint32_t>(std::min<uint32_t>(nThreads, m_lps.size() - 1), 1);
+    NS_LOG_INFO("Running " << m_lps.size() - 1 << " partitions on " << nThreads << " threads");
+
+    m_exitWorkers = false;
+    m_barrier = std::make_unique<std::barrier<>>(nThreads);
+    for (uint32_t i = 1; i < nThreads; ++i)
+    {
+        m_workers.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this);
+    }
+
+    const uint64_t never = std::numeric_limits<uint64_t>::max();
+    LogicalProcess* pub = m_lps.front().get();
+    while (!m_stop)
+    {
+        uint64_t next = never;
+        for (auto& lp : m_lps)
+        {
+            lp->ReceiveMessages();
+            next = std::min(next, lp->GetNextTs());
+        }
+        if (next == never)
+        {
+            break;
+        }
+
+        // Global events run alone, before the node events with the same timestamp
+        uint64_t publicNext = pub->GetNextTs();
+        if (publicNext == next)
+        {
+            pub->ProcessEventsUntil(next + 1, &m_stop);
+            continue;
+        }
+
+        m_windowStart = next;
+        m_windowEnd = (next > never - m_lookahead) ? never : next + m_lookahead;
+        m_windowEnd = std::min(m_windowEnd, publicNext);
+        m_nextLp = 1;
+        m_parallel = true;
+        if (nThreads > 1)
+        {
+            m_barrier->arrive_and_wait();
+        }
+        ProcessPartitions();
+        if (nThreads > 1)
+        {
+            m_barrier->arrive_and_wait();
+        }
+        m_parallel = false;
+    }
+
+    m_exitWorkers = true;
+    if (nThreads > 1)
+    {
+        m_barrier->arrive_and_wait();
+    }
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    m_barrier = nullptr;
+
+    // The public clock follows the most advanced partition
+    uint64_t last = pub->GetCurrentTs();
+    for (auto& lp : m_lps)
+    {
+        last = std::max(last, lp->GetCurrentTs());
+    }
+    pub->SetNow(last);
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    LogicalProcess* lp = GetCurrentLogicalProcess();
+    NS_ASSERT_MSG(lp != nullptr, "Simulator::Schedule Thread-unsafe invocation!");
+    return lp->Schedule(delay, lp->GetContext(), event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(),
+                  "MultithreadedSimulatorImpl::ScheduleWithContext(): Negative delay");
+
+    LogicalProcess* src = GetCurrentLogicalProcess();
+    LogicalProcess* dst = GetLogicalProcess(context);
+    if (src == nullptr)
+    {
+        // Foreign thread: the current time is added when the event is received
+        dst->Post(nullptr, delay.GetTimeStep(), context, event);
+        return;
+    }
+
+    uint64_t ts = src->GetCurrentTs() + delay.GetTimeStep();
+    if (src == dst || !m_parallel)
+    {
+        dst->Insert(ts, context, event);
+    }
+    else
+    {
+        NS_ASSERT_MSG(ts >= m_windowEnd,
+                      "Event scheduled from partition " << src->GetSystemId() << " to partition "
+                                                        << dst->GetSystemId()
+                                                        << " violates the lookahead");
+        dst->Post(src, ts, context, event);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id() && !m_parallel,
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    LogicalProcess* lp = GetCurrentLogicalProcess();
+    if (lp == nullptr)
+    {
+        lp = m_lps.front().get();
+    }
+    return lp->Now();
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs()) - Now();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    LogicalProcess* src = GetCurrentLogicalProcess();
+    LogicalProcess* dst = GetLogicalProcess(id.GetContext());
+    if (!m_parallel || src == dst)
+    {
+        dst->Remove(id);
+    }
+    else if (!IsExpired(id))
+    {
+        // The event list of another partition is only modified by its thread
+        dst->PostRemove(id);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    LogicalProcess* dst = GetLogicalProcess(id.GetContext());
+    if (!m_parallel || GetCurrentLogicalProcess() == dst)
+    {
+        return dst->IsExpired(id);
+    }
+    if (id.PeekEventImpl() == nullptr)
+    {
+        return true;
+    }
+    // The clock of another partition is moving: only rely on the window,
+    // which all the events before have completed and no event after has started
+    NS_ASSERT_MSG(id.GetTs() < m_windowStart || id.GetTs() >= m_windowEnd,
+                  "Event of partition " << dst->GetSystemId()
+                                        << " accessed from another partition within the "
+                                           "current window violates the lookahead");
+    return id.GetTs() < m_windowStart || id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    LogicalProcess* lp = GetCurrentLogicalProcess();
+    if (lp == nullptr)
+    {
+        return Simulator::NO_CONTEXT;
+    }
+    return lp->GetContext();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->GetEventCount();
+    }
+    return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+class LogicalProcess;
+
+/**
+ * @ingroup mtp
+ *
+ * @brief Shared-memory parallel simulator implementation.
+ *
+ * The nodes of the simulation are partitioned into logical processes,
+ * either according to Node::GetSystemId() or, if the AutomaticPartition
+ * attribute is set, by grouping the nodes which are connected by channels
+ * without a positive propagation delay.  The partitions are executed by a
+ * pool of threads using a conservative synchronization algorithm: the
+ * lookahead is the smallest "Delay" attribute of the channels connecting
+ * nodes in different partitions, and at each round all the partitions
+ * execute in parallel the events falling in the window
+ * [t, t + lookahead), where t is the earliest pending event.
+ *
+ * Events scheduled without a node context (or with a context which is
+ * not a node id) belong to a public partition, executed by the main
+ * thread while the other partitions are idle, so that global events
+ * such as Simulator::Stop() behave as in the sequential simulator.  A
+ * Simulator::Stop() called by a node event takes effect at the end of the
+ * current window, after every partition has executed its events in it.
+ *
+ * The events of a partition may be removed or cancelled by another
+ * partition only if they are due after the current window; the removal
+ * is then applied by the owning partition before the next window.
+ *
+ * The nodes are partitioned when Simulator::Run() is called for the
+ * first time; nodes created afterwards are executed in the public
+ * partition.  Interactions between nodes of different partitions must
+ * only happen through channels.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * @return The number of partitions, including the public one.
+     */
+    uint32_t GetPartitionCount() const;
+
+    /**
+     * @return The lookahead computed from the channel delays.
+     */
+    Time GetLookahead() const;
+
+  private:
+    void DoDispose() override;
+
+    /**
+     * Assign the nodes to the logical processes, compute the lookahead
+     * and move the pending events to the logical process of their node.
+     */
+    void Partition();
+    /**
+     * Get the logical process which owns the events of a context.
+     *
+     * @param [in] context The event context.
+     * @return The logical process.
+     */
+    LogicalProcess* GetLogicalProcess(uint32_t context) const;
+    /**
+     * Get the logical process executed by the calling thread.
+     *
+     * @return The current logical process, or \c nullptr if the calling
+     *         thread does not belong to the simulation.
+     */
+    LogicalProcess* GetCurrentLogicalProcess() const;
+    /** Execute the current window in the partitions not yet claimed by a thread. */
+    void ProcessPartitions();
+    /** Body of the worker threads. */
+    void WorkerLoop();
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+
+    /** The scheduler factory used by the logical processes. */
+    ObjectFactory m_schedulerFactory;
+    /**
+     * The logical processes; the first one is the public partition,
+     * which owns the events without a node context.
+     */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** Index in m_lps of the logical process owning each node. */
+    std::vector<uint32_t> m_nodeLp;
+    /** Flag \c true once the nodes have been partitioned. */
+    bool m_partitioned;
+    /** Use connectivity instead of Node::GetSystemId() to partition the nodes. */
+    bool m_automaticPartition;
+    /** Maximum number of threads, 0 to use the hardware concurrency. */
+    uint32_t m_maxThreads;
+    /** Lookahead between partitions, in time steps. */
+    uint64_t m_lookahead;
+
+    /**
+     * Flag calling for the end of the simulation.  The partitions only
+     * check it at the end of a window, so that they all stop at the same
+     * time whatever the interleaving of the threads.
+     */
+    std::atomic<bool> m_stop;
+    /** Flag \c true while the partitions execute a window in parallel. */
+    bool m_parallel;
+    /** Start of the window being executed, in time steps. */
+    uint64_t m_windowStart;
+    /** End of the window being executed, in time steps. */
+    uint64_t m_windowEnd;
+    /** Index of the next partition to be claimed by a thread. */
+    std::atomic<uint32_t> m_nextLp;
+    /** Flag telling the worker threads to exit. */
+    bool m_exitWorkers;
+    /** Barrier used to start and end the parallel windows. */
+    std::unique_ptr<std::barrier<>> m_barrier;
+    /** The worker threads. */
+    std::vector<std::thread> m_workers;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,588 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp-tests
+ * Multithreaded simulator implementation test suite
+ */
+
+/**
+ * @ingroup mtp
+ * @defgroup mtp-tests mtp module tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check that a ring of nodes forwarding packets produces the same
+ * sequence of receptions with the default and the multithreaded simulator
+ * implementations.
+ */
+class MtpRingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param automaticPartition Use the automatic partitioning of the nodes.
+     * @param maxThreads Maximum number of threads.
+     */
+    MtpRingTestCase(bool automaticPartition, uint32_t maxThreads);
+
+  private:
+    void DoRun() override;
+
+    /** A packet reception: time, node and remaining size. */
+    using Reception = std::tuple<int64_t, uint32_t, uint32_t>;
+
+    /**
+     * Build the ring and run the simulation.
+     * @param implementation The simulator implementation type.
+     * @return The receptions of all the nodes, sorted by node.
+     */
+    std::vector<Reception> RunRing(std::string implementation);
+
+    /**
+     * Receive a packet and forward it, one byte shorter, to the next node.
+     * @param device The receiving device.
+     * @param packet The packet.
+     * @param protocol The protocol number.
+     * @param from The sender address.
+     * @return Always true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /**
+     * Send a packet on a device.
+     * @param device The device.
+     * @param size The packet size.
+     */
+    void Send(Ptr<NetDevice> device, uint32_t size);
+
+    bool m_automaticPartition;    //!< Use the automatic partitioning.
+    uint32_t m_maxThreads;        //!< Maximum number of threads.
+    NetDeviceContainer m_forward; //!< Device of each node toward the next node.
+    /** Receptions of each node, written only by the thread executing the node. */
+    std::vector<std::vector<Reception>> m_receptions;
+};
+
+MtpRingTestCase::MtpRingTestCase(bool automaticPartition, uint32_t maxThreads)
+    : TestCase("Check packet forwarding over a ring of " +
+               std::string(automaticPartition ? "automatically partitioned" : "partitioned") +
+               " nodes with " + std::to_string(maxThreads) + " threads"),
+      m_automaticPartition(automaticPartition),
+      m_maxThreads(maxThreads)
+{
+}
+
+void
+MtpRingTestCase::Send(Ptr<NetDevice> device, uint32_t size)
+{
+    device->Send(Create<Packet>(size), device->GetBroadcast(), 0);
+}
+
+bool
+MtpRingTestCase::Receive(Ptr<NetDevice> device,
+                         Ptr<const Packet> packet,
+                         uint16_t protocol,
+                         const Address& from)
+{
+    uint32_t node = device->GetNode()->GetId();
+    m_receptions[node].emplace_back(Simulator::Now().GetTimeStep(), node, packet->GetSize());
+    if (packet->GetSize() > 0)
+    {
+        Send(m_forward.Get(node), packet->GetSize() - 1);
+    }
+    return true;
+}
+
+std::vector<MtpRingTestCase::Reception>
+MtpRingTestCase::RunRing(std::string implementation)
+{
+    const uint32_t nNodes = 8;
+    const uint32_t nPartitions = 4;
+
+    GlobalValue::Bind("SimulatorImplementationType", StringValue(implementation));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(m_maxThreads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::AutomaticPartition",
+                       BooleanValue(m_automaticPartition));
+
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        nodes.Add(CreateObject<Node>(i % nPartitions));
+    }
+
+    // Node i forwards to node i + 1 on the first device of the link between them
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+    m_forward = NetDeviceContainer();
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        NetDeviceContainer link =
+            helper.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % nNodes)));
+        m_forward.Add(link.Get(0));
+        for (auto it = link.Begin(); it != link.End(); ++it)
+        {
+            (*it)->SetReceiveCallback(MakeCallback(&MtpRingTestCase::Receive, this));
+        }
+    }
+
+    m_receptions.assign(nNodes, {});
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(10 * i),
+                                       &MtpRingTestCase::Send,
+                                       this,
+                                       m_forward.Get(i),
+                                       20);
+    }
+    Simulator::Stop(MilliSeconds(15));
+    Simulator::Run();
+
+    if (implementation == "ns3::MultithreadedSimulatorImpl")
+    {
+        auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+        NS_TEST_EXPECT_MSG_NE(impl, nullptr, "Wrong simulator implementation");
+        if (impl)
+        {
+            NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), MilliSeconds(1), "Wrong lookahead");
+            // Every node is a partition when partitioning automatically, plus the public one
+            NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(),
+                                  (m_automaticPartition ? nNodes : nPartitions) + 1,
+                                  "Wrong number of partitions");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(15), "Simulation did not stop in time");
+
+    Simulator::Destroy();
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+
+    std::vector<Reception> receptions;
+    for (const auto& nodeReceptions : m_receptions)
+    {
+        receptions.insert(receptions.end(), nodeReceptions.begin(), nodeReceptions.end());
+    }
+    return receptions;
+}
+
+void
+MtpRingTestCase::DoRun()
+{
+    auto expected = RunRing("ns3::DefaultSimulatorImpl");
+    auto actual = RunRing("ns3::MultithreadedSimulatorImpl");
+
+    // 8 packets, each one received 14 times before the simulation stops
+    NS_TEST_ASSERT_MSG_EQ(expected.size(), 8 * 14, "Unexpected number of receptions");
+    NS_TEST_ASSERT_MSG_EQ(actual.size(), expected.size(), "Different number of receptions");
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((actual[i] == expected[i]), true, "Reception " << i << " differs");
+    }
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check the events scheduled with and without a node context
+ * before the partitioning.
+ */
+class MtpScheduleTestCase : public TestCase
+{
+  public:
+    MtpScheduleTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the execution of an event.
+     * @param value The value to record.
+     */
+    void Record(uint32_t value);
+
+    std::vector<uint32_t> m_global; //!< Values recorded by the global events.
+    std::vector<uint32_t> m_node;   //!< Values recorded by the node event.
+};
+
+MtpScheduleTestCase::MtpScheduleTestCase()
+    : TestCase("Check events scheduled before the partitioning")
+{
+}
+
+void
+MtpScheduleTestCase::Record(uint32_t value)
+{
+    if (Simulator::GetContext() == Simulator::NO_CONTEXT)
+    {
+        m_global.push_back(value);
+    }
+    else
+    {
+        m_node.push_back(value);
+    }
+}
+
+void
+MtpScheduleTestCase::DoRun()
+{
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+
+    Ptr<Node> node = CreateObject<Node>(1);
+    Simulator::Schedule(Seconds(2), &MtpScheduleTestCase::Record, this, 2);
+    Simulator::Schedule(Seconds(1), &MtpScheduleTestCase::Record, this, 1);
+    EventId removed = Simulator::Schedule(Seconds(1), &MtpScheduleTestCase::Record, this, 10);
+    Simulator::ScheduleWithContext(node->GetId(),
+                                   Seconds(1),
+                                   &MtpScheduleTestCase::Record,
+                                   this,
+                                   3);
+    EventId cancelled;
+    Simulator::ScheduleWithContext(node->GetId(), Seconds(3), [this, &cancelled]() {
+        Record(4);
+        cancelled = Simulator::Schedule(Seconds(1), &MtpScheduleTestCase::Record, this, 5);
+        NS_TEST_EXPECT_MSG_EQ(Simulator::IsExpired(cancelled), false, "Event should be pending");
+    });
+    Simulator::Schedule(Seconds(3.5), [&cancelled]() { Simulator::Cancel(cancelled); });
+    Simulator::Remove(removed);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_global.size(), 2, "Wrong number of global events");
+    NS_TEST_EXPECT_MSG_EQ(m_global[0], 1, "Wrong global event order");
+    NS_TEST_EXPECT_MSG_EQ(m_global[1], 2, "Wrong global event order");
+    NS_TEST_EXPECT_MSG_EQ(m_node.size(), 2, "Wrong number of node events");
+    NS_TEST_EXPECT_MSG_EQ(m_node[0], 3, "Wrong node event order");
+    NS_TEST_EXPECT_MSG_EQ(m_node[1], 4, "Wrong node event order");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::IsExpired(cancelled), true, "Event should be cancelled");
+    // The cancelled event is still removed from the event list at 4 s
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(4), "Wrong final time");
+    // The node initialization is an event as well
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(), 7, "Wrong event count");
+
+    Simulator::Destroy();
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check the packets created, copied and fragmented concurrently by
+ * several partitions.
+ *
+ * Every reception creates, copies and fragments packets with the packet
+ * metadata enabled, so that all the partitions allocate and recycle
+ * metadata and buffers at the same time; this test is meant to be run
+ * under a thread sanitizer as well.  The uids of the received packets
+ * must be unique and must not depend on the number of threads.
+ */
+class MtpPacketTestCase : public TestCase
+{
+  public:
+    MtpPacketTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** A packet reception: time, node and packet uid. */
+    using Reception = std::tuple<int64_t, uint32_t, uint64_t>;
+
+    /**
+     * Build the ring and run the simulation.
+     * @param maxThreads Maximum number of threads.
+     * @return The receptions of all the nodes, sorted by node.
+     */
+    std::vector<Reception> RunRing(uint32_t maxThreads);
+
+    /**
+     * Receive a packet and forward a new packet built from it to the next node.
+     * @param device The receiving device.
+     * @param packet The packet.
+     * @param protocol The protocol number.
+     * @param from The sender address.
+     * @return Always true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /**
+     * Send a new packet with a header on a device.
+     * @param device The device.
+     * @param payload The payload of the packet.
+     */
+    void Send(Ptr<NetDevice> device, Ptr<const Packet> payload);
+
+    NetDeviceContainer m_forward; //!< Device of each node toward the next node.
+    /** Receptions of each node, written only by the thread executing the node. */
+    std::vector<std::vector<Reception>> m_receptions;
+};
+
+MtpPacketTestCase::MtpPacketTestCase()
+    : TestCase("Check the packets created concurrently by several partitions")
+{
+}
+
+void
+MtpPacketTestCase::Send(Ptr<NetDevice> device, Ptr<const Packet> payload)
+{
+    Ptr<Packet> packet = Create<Packet>(10);
+    packet->AddAtEnd(payload);
+    LlcSnapHeader llc;
+    llc.SetType(device->GetNode()->GetId());
+    packet->AddHeader(llc);
+    device->Send(packet, device->GetBroadcast(), 0);
+}
+
+bool
+MtpPacketTestCase::Receive(Ptr<NetDevice> device,
+                           Ptr<const Packet> packet,
+                           uint16_t protocol,
+                           const Address& from)
+{
+    uint32_t node = device->GetNode()->GetId();
+    m_receptions[node].emplace_back(Simulator::Now().GetTimeStep(), node, packet->GetUid());
+
+    Ptr<Packet> copy = packet->Copy();
+    LlcSnapHeader llc;
+    copy->RemoveHeader(llc);
+    NS_TEST_EXPECT_MSG_EQ(copy->ToString().empty(), false, "Missing packet metadata");
+    Send(m_forward.Get(node), copy->CreateFragment(0, std::min<uint32_t>(copy->GetSize(), 50)));
+    return true;
+}
+
+std::vector<MtpPacketTestCase::Reception>
+MtpPacketTestCase::RunRing(uint32_t maxThreads)
+{
+    const uint32_t nNodes = 8;
+    const uint32_t nPartitions = 4;
+
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(maxThreads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::AutomaticPartition", BooleanValue(false));
+
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        nodes.Add(CreateObject<Node>(i % nPartitions));
+    }
+
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(MicroSeconds(100)));
+    m_forward = NetDeviceContainer();
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        NetDeviceContainer link =
+            helper.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % nNodes)));
+        m_forward.Add(link.Get(0));
+        link.Get(1)->SetReceiveCallback(MakeCallback(&MtpPacketTestCase::Receive, this));
+    }
+
+    m_receptions.assign(nNodes, {});
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        for (uint32_t j = 0; j < 10; ++j)
+        {
+            Simulator::ScheduleWithContext(i,
+                                           MicroSeconds(j),
+                                           &MtpPacketTestCase::Send,
+                                           this,
+                                           m_forward.Get(i),
+                                           Create<Packet>(100));
+        }
+    }
+    Simulator::Stop(MilliSeconds(10));
+    Simulator::Run();
+    Simulator::Destroy();
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+
+    std::vector<Reception> receptions;
+    for (const auto& nodeReceptions : m_receptions)
+    {
+        receptions.insert(receptions.end(), nodeReceptions.begin(), nodeReceptions.end());
+    }
+    return receptions;
+}
+
+void
+MtpPacketTestCase::DoRun()
+{
+    // Must be enabled before any packet is created with a payload
+    Packet::EnablePrinting();
+
+    auto expected = RunRing(1);
+    auto actual = RunRing(4);
+
+    // 80 packets, each one received 99 times before the simulation stops
+    NS_TEST_ASSERT_MSG_EQ(expected.size(), 80 * 99, "Unexpected number of receptions");
+    NS_TEST_ASSERT_MSG_EQ(actual.size(), expected.size(), "Different number of receptions");
+    std::set<uint64_t> uids;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((actual[i] == expected[i]), true, "Reception " << i << " differs");
+        uids.insert(std::get<2>(actual[i]));
+    }
+    NS_TEST_EXPECT_MSG_EQ(uids.size(), actual.size(), "Packet uids are not unique");
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check the interactions between partitions through the simulator:
+ * the removal and cancellation of the events of another partition, and a
+ * stop requested by a node event.
+ */
+class MtpCrossPartitionTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param maxThreads Maximum number of threads.
+     */
+    MtpCrossPartitionTestCase(uint32_t maxThreads);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the execution of a node event and schedule the next one.
+     * @param period The period of the node events.
+     */
+    void Tick(Time period);
+
+    uint32_t m_maxThreads; //!< Maximum number of threads.
+    /** Time of the last event of each node, written only by the thread executing the node. */
+    std::vector<Time> m_last;
+    EventId m_removed;   //!< Event of node 1 removed by node 0.
+    EventId m_cancelled; //!< Event of node 1 cancelled by node 0.
+    bool m_executed;     //!< Flag set if the removed or cancelled events are executed.
+};
+
+MtpCrossPartitionTestCase::MtpCrossPartitionTestCase(uint32_t maxThreads)
+    : TestCase("Check the events removed and the stop requested across partitions with " +
+               std::to_string(maxThreads) + " threads"),
+      m_maxThreads(maxThreads),
+      m_executed(false)
+{
+}
+
+void
+MtpCrossPartitionTestCase::Tick(Time period)
+{
+    m_last[Simulator::GetContext()] = Simulator::Now();
+    Simulator::Schedule(period, &MtpCrossPartitionTestCase::Tick, this, period);
+}
+
+void
+MtpCrossPartitionTestCase::DoRun()
+{
+    const uint32_t nNodes = 4;
+
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::MaxThreads", UintegerValue(m_maxThreads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::AutomaticPartition", BooleanValue(false));
+
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        nodes.Add(CreateObject<Node>(i));
+    }
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(MilliSeconds(1)));
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        helper.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % nNodes)));
+    }
+
+    m_last.assign(nNodes, Time());
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(i),
+                                       &MtpCrossPartitionTestCase::Tick,
+                                       this,
+                                       MicroSeconds(100));
+    }
+    Simulator::ScheduleWithContext(1, Seconds(0), [this]() {
+        m_removed = Simulator::Schedule(MilliSeconds(8), [this]() { m_executed = true; });
+        m_cancelled = Simulator::Schedule(MilliSeconds(8), [this]() { m_executed = true; });
+    });
+    Simulator::ScheduleWithContext(0, MilliSeconds(2), [this]() {
+        Simulator::Remove(m_removed);
+        Simulator::Cancel(m_cancelled);
+        NS_TEST_EXPECT_MSG_EQ(Simulator::IsExpired(m_removed), true, "Event should be removed");
+        NS_TEST_EXPECT_MSG_EQ(Simulator::IsExpired(m_cancelled),
+                              true,
+                              "Event should be cancelled");
+    });
+    // Stop in the middle of the window starting at 5 ms
+    Simulator::ScheduleWithContext(2, MicroSeconds(5500), []() { Simulator::Stop(); });
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_executed, false, "Removed or cancelled event executed");
+    // Every node executes its events up to the end of the window
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_last[i],
+                              MicroSeconds(5900 + i),
+                              "Node " << i << " did not reach the end of the window");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(5903), "Wrong final time");
+
+    Simulator::Destroy();
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief The multithreaded simulator implementation test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite()
+        : TestSuite("mtp", Type::UNIT)
+    {
+        // First, as the packet metadata must be enabled before creating any packet
+        AddTestCase(new MtpPacketTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new MtpScheduleTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new MtpRingTestCase(false, 1), TestCase::Duration::QUICK);
+        AddTestCase(new MtpRingTestCase(false, 4), TestCase::Duration::QUICK);
+        AddTestCase(new MtpRingTestCase(true, 3), TestCase::Duration::QUICK);
+        AddTestCase(new MtpCrossPartitionTestCase(1), TestCase::Duration::QUICK);
+        AddTestCase(new MtpCrossPartitionTestCase(4), TestCase::Duration::QUICK);
+    }
+};
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
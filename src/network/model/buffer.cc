@@ -10,6 +10,8 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
                    << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
@@ -43,7 +45,11 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -150,6 +156,8 @@ Buffer::Create(uint32_t size)
 #endif /* BUFFER_FREE_LIST */
 
 constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+/// Number of bytes above which shared bytes are kept in a slice rather than copied.
+constexpr uint32_t MIN_SLICE_SIZE = 128;
 
 Buffer::Data*
 Buffer::Allocate(uint32_t reqSize)
@@ -179,18 +187,27 @@ Buffer::Deallocate(Buffer::Data* data)
 }
 
 Buffer::Buffer()
+    : m_tail(nullptr),
+      m_tailSize(0),
+      m_generatorOffset(0)
 {
     NS_LOG_FUNCTION(this);
     Initialize(0);
 }
 
 Buffer::Buffer(uint32_t dataSize)
+    : m_tail(nullptr),
+      m_tailSize(0),
+      m_generatorOffset(0)
 {
     NS_LOG_FUNCTION(this << dataSize);
     Initialize(dataSize);
 }
 
 Buffer::Buffer(uint32_t dataSize, bool initialize)
+    : m_tail(nullptr),
+      m_tailSize(0),
+      m_generatorOffset(0)
 {
     NS_LOG_FUNCTION(this << dataSize << initialize);
     if (initialize)
@@ -199,6 +216,19 @@ Buffer::Buffer(uint32_t dataSize, bool initialize)
     }
 }
 
+Buffer::Buffer(uint32_t dataSize, Ptr<const PayloadGenerator> generator)
+    : m_tail(nullptr),
+      m_tailSize(0),
+      m_generatorOffset(0)
+{
+    NS_LOG_FUNCTION(this << dataSize << generator);
+    Initialize(dataSize);
+    if (dataSize > 0)
+    {
+        m_generator = generator;
+    }
+}
+
 bool
 Buffer::CheckInternalState() const
 {
@@ -245,18 +275,37 @@ Buffer::Initialize(uint32_t zeroSize)
     m_end = m_zeroAreaEnd;
     m_data->m_dirtyStart = m_start;
     m_data->m_dirtyEnd = m_end;
+    m_generator = nullptr;
+    m_generatorOffset = 0;
     NS_ASSERT(CheckInternalState());
 }
 
 Buffer&
 Buffer::operator=(const Buffer& o)
+{
+    NS_ASSERT(CheckInternalState());
+    if (m_tail != o.m_tail)
+    {
+        if (o.m_tail != nullptr)
+        {
+            o.m_tail->m_count++;
+        }
+        ReleaseTail();
+        m_tail = o.m_tail;
+    }
+    m_tailSize = o.m_tailSize;
+    SetFirstSlice(o);
+    return *this;
+}
+
+void
+Buffer::SetFirstSlice(const Buffer& o)
 {
     NS_ASSERT(CheckInternalState());
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -269,8 +318,9 @@ Buffer::operator=(const Buffer& o)
     m_zeroAreaEnd = o.m_zeroAreaEnd;
     m_start = o.m_start;
     m_end = o.m_end;
+    m_generator = o.m_generator;
+    m_generatorOffset = o.m_generatorOffset;
     NS_ASSERT(CheckInternalState());
-    return *this;
 }
 
 Buffer::~Buffer()
@@ -278,11 +328,11 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
+    ReleaseTail();
 }
 
 uint32_t
@@ -299,12 +349,202 @@ Buffer::GetInternalEnd() const
     return m_end - (m_zeroAreaEnd - m_zeroAreaStart);
 }
 
+bool
+Buffer::IsDirtyAtStart() const
+{
+    return m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+}
+
+bool
+Buffer::IsDirtyAtEnd() const
+{
+    return m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+}
+
+Buffer
+Buffer::GetFirstSlice() const
+{
+    Buffer slice = *this;
+    slice.ReleaseTail();
+    slice.m_tailSize = 0;
+    return slice;
+}
+
+bool
+Buffer::IsContinuedBy(const Buffer& slice) const
+{
+    NS_ASSERT(slice.m_tail == nullptr);
+    const Buffer& last = (m_tail == nullptr) ? *this : m_tail->m_slices.back();
+    // The bytes of the slice must directly follow those of the last slice and
+    // at most one of them can have a zero area
+    return last.m_data == slice.m_data && last.GetInternalEnd() == slice.m_start &&
+           (last.m_zeroAreaStart == last.m_zeroAreaEnd ||
+            slice.m_zeroAreaStart == slice.m_zeroAreaEnd);
+}
+
+void
+Buffer::AppendSlice(const Buffer& slice)
+{
+    NS_LOG_FUNCTION(this << &slice);
+    NS_ASSERT(slice.m_tail == nullptr && slice.GetSize() > 0);
+    uint32_t size = slice.GetSize();
+    if (IsContinuedBy(slice))
+    {
+        Buffer& last = (m_tail == nullptr) ? *this : GetWritableTail()->m_slices.back();
+        if (last.m_zeroAreaStart == last.m_zeroAreaEnd)
+        {
+            // Both slices share the offsets which precede the zero area of the new one
+            last.m_zeroAreaStart = slice.m_zeroAreaStart;
+            last.m_zeroAreaEnd = slice.m_zeroAreaEnd;
+            last.m_end = slice.m_end;
+            last.m_generator = slice.m_generator;
+            last.m_generatorOffset = slice.m_generatorOffset;
+        }
+        else
+        {
+            last.m_end += size;
+        }
+        last.m_maxZeroAreaStart = std::max(last.m_maxZeroAreaStart, last.m_zeroAreaStart);
+        if (m_tail != nullptr)
+        {
+            m_tail->m_ends.back() += size;
+            m_tailSize += size;
+        }
+        return;
+    }
+    if (m_tail == nullptr)
+    {
+        m_tail = new Tail;
+        m_tail->m_count = 1;
+    }
+    Tail* tail = GetWritableTail();
+    m_tailSize += size;
+    tail->m_slices.push_back(slice);
+    tail->m_ends.push_back(m_tailSize);
+}
+
+void
+Buffer::PushFirstSlice()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(GetSize() > 0);
+    Buffer first = GetFirstSlice();
+    uint32_t size = first.GetSize();
+    if (m_tail == nullptr)
+    {
+        m_tail = new Tail;
+        m_tail->m_count = 1;
+    }
+    Tail* tail = GetWritableTail();
+    tail->m_slices.insert(tail->m_slices.begin(), first);
+    for (auto& end : tail->m_ends)
+    {
+        end += size;
+    }
+    tail->m_ends.insert(tail->m_ends.begin(), size);
+    m_tailSize += size;
+
+    g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
+    if (--m_data->m_count == 0)
+    {
+        Recycle(m_data);
+    }
+    Initialize(0);
+}
+
+void
+Buffer::PopFirstSlice()
+{
+    NS_LOG_FUNCTION(this);
+    Tail* tail = GetWritableTail();
+    Buffer first = tail->m_slices.front();
+    uint32_t size = first.GetSize();
+    tail->m_slices.erase(tail->m_slices.begin());
+    tail->m_ends.erase(tail->m_ends.begin());
+    for (auto& end : tail->m_ends)
+    {
+        end -= size;
+    }
+    m_tailSize -= size;
+    if (tail->m_slices.empty())
+    {
+        ReleaseTail();
+    }
+    SetFirstSlice(first);
+}
+
+Buffer::Tail*
+Buffer::GetWritableTail()
+{
+    NS_ASSERT(m_tail != nullptr);
+    if (m_tail->m_count > 1)
+    {
+        auto tail = new Tail;
+        tail->m_count = 1;
+        tail->m_slices = m_tail->m_slices;
+        tail->m_ends = m_tail->m_ends;
+        ReleaseTail();
+        m_tail = tail;
+    }
+    return m_tail;
+}
+
+void
+Buffer::ReleaseTail()
+{
+    if (m_tail != nullptr && --m_tail->m_count == 0)
+    {
+        delete m_tail;
+    }
+    m_tail = nullptr;
+}
+
+uint32_t
+Buffer::GetVirtualSize() const
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t size = m_zeroAreaEnd - m_zeroAreaStart;
+    if (m_tail != nullptr)
+    {
+        for (const auto& slice : m_tail->m_slices)
+        {
+            size += slice.m_zeroAreaEnd - slice.m_zeroAreaStart;
+        }
+    }
+    return size;
+}
+
+void
+Buffer::ReadVirtual(const PayloadGenerator* generator,
+                    uint8_t* buffer,
+                    uint32_t offset,
+                    uint32_t size)
+{
+    NS_LOG_FUNCTION(generator << &buffer << offset << size);
+    if (generator == nullptr)
+    {
+        memset(buffer, 0, size);
+    }
+    else
+    {
+        generator->Generate(buffer, offset, size);
+    }
+}
+
 void
 Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+    bool isDirty = IsDirtyAtStart();
+    if (isDirty && start > 0 && GetInternalSize() > MIN_SLICE_SIZE)
+    {
+        /* the bytes are shared and too large to be copied:
+         * add the new bytes in a new first slice.
+         */
+        PushFirstSlice();
+        isDirty = false;
+    }
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -322,8 +562,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -350,7 +589,28 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+    if (m_tail != nullptr || (end > 0 && IsDirtyAtEnd() && GetInternalSize() > MIN_SLICE_SIZE))
+    {
+        Buffer& last = (m_tail == nullptr) ? *this : GetWritableTail()->m_slices.back();
+        if (end > 0 && last.IsDirtyAtEnd() && last.GetInternalSize() > MIN_SLICE_SIZE)
+        {
+            /* the bytes are shared and too large to be copied:
+             * add the new bytes in a new last slice.
+             */
+            Buffer slice;
+            slice.AddAtEnd(end);
+            AppendSlice(slice);
+        }
+        else
+        {
+            last.AddAtEnd(end);
+            m_tail->m_ends.back() += end;
+            m_tailSize += end;
+        }
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+    bool isDirty = IsDirtyAtEnd();
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -368,8 +628,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -396,7 +655,19 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+    if (o.GetSize() == 0)
+    {
+        return;
+    }
+    if (GetSize() == 0 && m_tail == nullptr)
+    {
+        *this = o;
+        return;
+    }
+
+    if (m_tail == nullptr && o.m_tail == nullptr && m_generator == nullptr &&
+        o.m_generator == nullptr && m_data->m_count == 1 &&
+        (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
         m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
         o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
@@ -424,11 +695,33 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
-    AddAtEnd(o.GetSize());
-    Buffer::Iterator destStart = End();
-    destStart.Prev(o.GetSize());
-    destStart.Write(o.Begin(), o.End());
+    const Buffer& last = (m_tail == nullptr) ? *this : m_tail->m_slices.back();
+    if (o.m_tail == nullptr && !IsContinuedBy(o) && o.GetSize() <= MIN_SLICE_SIZE &&
+        o.m_data != last.m_data &&
+        (!last.IsDirtyAtEnd() || last.GetInternalSize() <= MIN_SLICE_SIZE))
+    {
+        /* small enough to be copied at the end of the last slice. */
+        AddAtEnd(o.GetSize());
+        Buffer::Iterator destStart = End();
+        destStart.Prev(o.GetSize());
+        destStart.Write(o.Begin(), o.End());
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    // Hold a reference to the tail of o, which may be the tail of this buffer
+    Buffer other = o;
+    if (other.m_end != other.m_start)
+    {
+        AppendSlice(other.GetFirstSlice());
+    }
+    if (other.m_tail != nullptr)
+    {
+        for (const auto& slice : other.m_tail->m_slices)
+        {
+            AppendSlice(slice);
+        }
+    }
     NS_ASSERT(CheckInternalState());
 }
 
@@ -437,6 +730,12 @@ Buffer::RemoveAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+    while (m_tail != nullptr && start >= m_end - m_start)
+    {
+        /* remove the whole first slice */
+        start -= m_end - m_start;
+        PopFirstSlice();
+    }
     uint32_t newStart = m_start + start;
     if (newStart <= m_zeroAreaStart)
     {
@@ -452,6 +751,11 @@ Buffer::RemoveAtStart(uint32_t start)
         m_start = m_zeroAreaStart;
         m_zeroAreaEnd -= delta;
         m_end -= delta;
+        m_generatorOffset += delta;
+        if (m_zeroAreaStart == m_zeroAreaEnd)
+        {
+            m_generator = nullptr;
+        }
     }
     else if (newStart <= m_end)
     {
@@ -464,6 +768,7 @@ Buffer::RemoveAtStart(uint32_t start)
         m_end -= zeroSize;
         m_zeroAreaStart = m_start;
         m_zeroAreaEnd = m_start;
+        m_generator = nullptr;
     }
     else
     {
@@ -472,6 +777,7 @@ Buffer::RemoveAtStart(uint32_t start)
         m_start = m_end;
         m_zeroAreaEnd = m_end;
         m_zeroAreaStart = m_end;
+        m_generator = nullptr;
     }
     m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
     LOG_INTERNAL_STATE("rem start=" << start << ", ");
@@ -483,6 +789,33 @@ Buffer::RemoveAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+    if (m_tail != nullptr)
+    {
+        Tail* tail = GetWritableTail();
+        while (end > 0 && !tail->m_slices.empty())
+        {
+            Buffer& last = tail->m_slices.back();
+            uint32_t size = last.GetSize();
+            if (end < size)
+            {
+                last.RemoveAtEnd(end);
+                tail->m_ends.back() -= end;
+                end = 0;
+            }
+            else
+            {
+                /* remove the whole last slice */
+                tail->m_slices.pop_back();
+                tail->m_ends.pop_back();
+                end -= size;
+            }
+        }
+        m_tailSize = tail->m_ends.empty() ? 0 : tail->m_ends.back();
+        if (tail->m_slices.empty())
+        {
+            ReleaseTail();
+        }
+    }
     uint32_t newEnd = m_end - std::min(end, m_end - m_start);
     if (newEnd > m_zeroAreaEnd)
     {
@@ -501,6 +834,7 @@ Buffer::RemoveAtEnd(uint32_t end)
         m_end = newEnd;
         m_zeroAreaEnd = newEnd;
         m_zeroAreaStart = newEnd;
+        m_generator = nullptr;
     }
     else
     {
@@ -508,6 +842,7 @@ Buffer::RemoveAtEnd(uint32_t end)
         m_end = m_start;
         m_zeroAreaEnd = m_start;
         m_zeroAreaStart = m_start;
+        m_generator = nullptr;
     }
     m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
     LOG_INTERNAL_STATE("rem end=" << end << ", ");
@@ -531,11 +866,23 @@ Buffer::CreateFullCopy() const
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
+    if (m_tail != nullptr)
+    {
+        /* gather all the slices into a single one */
+        Buffer tmp;
+        tmp.AddAtEnd(GetSize());
+        CopyData(tmp.m_data->m_data + tmp.m_start, GetSize());
+        NS_ASSERT(tmp.CheckInternalState());
+        return tmp;
+    }
     if (m_zeroAreaEnd - m_zeroAreaStart != 0)
     {
         Buffer tmp;
         tmp.AddAtStart(m_zeroAreaEnd - m_zeroAreaStart);
-        tmp.Begin().WriteU8(0, m_zeroAreaEnd - m_zeroAreaStart);
+        ReadVirtual(PeekPointer(m_generator),
+                    tmp.m_data->m_data + tmp.m_start,
+                    m_generatorOffset,
+                    m_zeroAreaEnd - m_zeroAreaStart);
         uint32_t dataStart = m_zeroAreaStart - m_start;
         tmp.AddAtStart(dataStart);
         tmp.Begin().Write(m_data->m_data + m_start, dataStart);
@@ -555,8 +902,12 @@ uint32_t
 Buffer::GetSerializedSize() const
 {
     NS_LOG_FUNCTION(this);
-    uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
-    uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
+    uint32_t zeroDataLength;
+    uint32_t dataStartLength;
+    uint32_t dataEndLength;
+    GetSerializedAreas(zeroDataLength, dataStartLength, dataEndLength);
+    uint32_t dataStart = (dataStartLength + 3) & (~0x3);
+    uint32_t dataEnd = (dataEndLength + 3) & (~0x3);
 
     // total size 4-bytes for dataStart length
     // + X number of bytes for dataStart
@@ -571,6 +922,10 @@ uint32_t
 Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    uint32_t zeroDataLength;
+    uint32_t dataStartLength;
+    uint32_t dataEndLength;
+    GetSerializedAreas(zeroDataLength, dataStartLength, dataEndLength);
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -582,7 +937,7 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    *p++ = m_zeroAreaEnd - m_zeroAreaStart;
+    *p++ = zeroDataLength;
 
     // Add the length of actual start data
     size += 4;
@@ -592,7 +947,6 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    uint32_t dataStartLength = m_zeroAreaStart - m_start;
     *p++ = dataStartLength;
 
     // Add the actual data
@@ -603,7 +957,8 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    memcpy(p, m_data->m_data + m_start, dataStartLength);
+    // the generated bytes, if any, are written after the bytes before the zero area
+    CopyData(reinterpret_cast<uint8_t*>(p), dataStartLength);
     p += (((dataStartLength + 3) & (~3)) / 4); // Advance p, insuring 4 byte boundary
 
     // Add the length of the actual end data
@@ -614,7 +969,6 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    uint32_t dataEndLength = m_end - m_zeroAreaEnd;
     *p++ = dataEndLength;
 
     // Add the actual data
@@ -625,7 +979,14 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    memcpy(p, m_data->m_data + m_zeroAreaStart, dataEndLength);
+    if (m_tail != nullptr)
+    {
+        CopyData(reinterpret_cast<uint8_t*>(p), dataEndLength);
+    }
+    else
+    {
+        memcpy(p, m_data->m_data + m_zeroAreaStart, dataEndLength);
+    }
     // The following line is unnecessary.
     // p += (((dataEndLength + 3) & (~3))/4); // Advance p, insuring 4 byte boundary
 
@@ -633,6 +994,34 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
     return 1;
 }
 
+void
+Buffer::GetSerializedAreas(uint32_t& zeroDataLength,
+                           uint32_t& dataStartLength,
+                           uint32_t& dataEndLength) const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_tail != nullptr)
+    {
+        /* the bytes of all the slices are written after an empty zero area */
+        zeroDataLength = 0;
+        dataStartLength = 0;
+        dataEndLength = GetSize();
+    }
+    else if (m_generator != nullptr)
+    {
+        /* the generated bytes are written with the bytes before them */
+        zeroDataLength = 0;
+        dataStartLength = m_zeroAreaEnd - m_start;
+        dataEndLength = m_end - m_zeroAreaEnd;
+    }
+    else
+    {
+        zeroDataLength = m_zeroAreaEnd - m_zeroAreaStart;
+        dataStartLength = m_zeroAreaStart - m_start;
+        dataEndLength = m_end - m_zeroAreaEnd;
+    }
+}
+
 uint32_t
 Buffer::Deserialize(const uint8_t* buffer, uint32_t size)
 {
@@ -702,6 +1091,18 @@ void
 Buffer::CopyData(std::ostream* os, uint32_t size) const
 {
     NS_LOG_FUNCTION(this << &os << size);
+    if (m_tail != nullptr)
+    {
+        size = std::min(size, GetSize());
+        GetFirstSlice().CopyData(os, size);
+        size -= std::min(size, m_end - m_start);
+        for (auto i = m_tail->m_slices.begin(); i != m_tail->m_slices.end() && size > 0; i++)
+        {
+            i->CopyData(os, size);
+            size -= std::min(size, i->GetSize());
+        }
+        return;
+    }
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
@@ -711,10 +1112,22 @@ Buffer::CopyData(std::ostream* os, uint32_t size) const
             size -= m_zeroAreaStart - m_start;
             tmpsize = std::min(m_zeroAreaEnd - m_zeroAreaStart, size);
             uint32_t left = tmpsize;
+            uint8_t bytes[sizeof(g_zeroes.buffer)];
             while (left > 0)
             {
                 uint32_t toWrite = std::min(left, g_zeroes.size);
-                os->write(g_zeroes.buffer, toWrite);
+                if (m_generator == nullptr)
+                {
+                    os->write(g_zeroes.buffer, toWrite);
+                }
+                else
+                {
+                    ReadVirtual(PeekPointer(m_generator),
+                                bytes,
+                                m_generatorOffset + tmpsize - left,
+                                toWrite);
+                    os->write((const char*)bytes, toWrite);
+                }
                 left -= toWrite;
             }
             if (size > tmpsize)
@@ -731,6 +1144,15 @@ uint32_t
 Buffer::CopyData(uint8_t* buffer, uint32_t size) const
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    if (m_tail != nullptr)
+    {
+        uint32_t copied = GetFirstSlice().CopyData(buffer, size);
+        for (auto i = m_tail->m_slices.begin(); i != m_tail->m_slices.end() && copied < size; i++)
+        {
+            copied += i->CopyData(buffer + copied, size - copied);
+        }
+        return copied;
+    }
     uint32_t originalSize = size;
     if (size > 0)
     {
@@ -741,14 +1163,8 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
         if (size > 0)
         {
             tmpsize = std::min(m_zeroAreaEnd - m_zeroAreaStart, size);
-            uint32_t left = tmpsize;
-            while (left > 0)
-            {
-                uint32_t toWrite = std::min(left, g_zeroes.size);
-                memcpy(buffer, g_zeroes.buffer, toWrite);
-                left -= toWrite;
-                buffer += toWrite;
-            }
+            ReadVirtual(PeekPointer(m_generator), buffer, m_generatorOffset, tmpsize);
+            buffer += tmpsize;
             size -= tmpsize;
             if (size > 0)
             {
@@ -769,7 +1185,7 @@ uint32_t
 Buffer::Iterator::GetDistanceFrom(const Iterator& o) const
 {
     NS_LOG_FUNCTION(this << &o);
-    NS_ASSERT(m_data == o.m_data);
+    NS_ASSERT(m_firstData == o.m_firstData);
     int32_t diff = m_current - o.m_current;
     if (diff < 0)
     {
@@ -799,8 +1215,29 @@ bool
 Buffer::Iterator::CheckNoZero(uint32_t start, uint32_t end) const
 {
     NS_LOG_FUNCTION(this << &start << &end);
-    return !(start < m_dataStart || end > m_dataEnd ||
-             (end > m_zeroStart && start < m_zeroEnd && m_zeroEnd != m_zeroStart && start != end));
+    if (m_tail == nullptr)
+    {
+        return !(start < m_dataStart || end > m_dataEnd ||
+                 (end > m_zeroStart && start < m_zeroEnd && m_zeroEnd != m_zeroStart &&
+                  start != end));
+    }
+    if (start < m_dataStart || end > m_dataEnd)
+    {
+        return false;
+    }
+    // check the zero area of every slice within [start, end)
+    Iterator i = *this;
+    i.m_current = start;
+    while (i.m_current < end)
+    {
+        i.SelectSlice();
+        if (end > i.m_zeroStart && i.m_current < i.m_zeroEnd && i.m_zeroEnd != i.m_zeroStart)
+        {
+            return false;
+        }
+        i.m_current = i.m_sliceEnd;
+    }
+    return true;
 }
 
 bool
@@ -814,6 +1251,34 @@ void
 Buffer::Iterator::Write(Iterator start, Iterator end)
 {
     NS_LOG_FUNCTION(this << &start << &end);
+    if (m_tail != nullptr || start.m_tail != nullptr)
+    {
+        NS_ASSERT(start.m_firstData == end.m_firstData);
+        NS_ASSERT(start.m_current <= end.m_current);
+        uint32_t size = end.m_current - start.m_current;
+        NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+        while (size > 0)
+        {
+            uint32_t toCopy = size;
+            const uint8_t* from = start.GetRun(toCopy);
+            uint8_t* to = GetRun(toCopy);
+            if (from != nullptr)
+            {
+                memcpy(to, from, toCopy);
+            }
+            else
+            {
+                ReadVirtual(start.m_generator,
+                            to,
+                            start.m_current - start.m_zeroStart + start.m_generatorOffset,
+                            toCopy);
+            }
+            start.m_current += toCopy;
+            m_current += toCopy;
+            size -= toCopy;
+        }
+        return;
+    }
     NS_ASSERT(start.m_data == end.m_data);
     NS_ASSERT(start.m_current <= end.m_current);
     NS_ASSERT(start.m_zeroStart == end.m_zeroStart);
@@ -821,27 +1286,35 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    m_current += size;
+    // The destination does not overlap its zero area: it lies either before or after it
+    uint8_t* to = &m_data[m_current - size];
+    if (m_current - size >= m_zeroEnd)
+    {
+        to -= m_zeroEnd - m_zeroStart;
+    }
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        ReadVirtual(start.m_generator,
+                    to,
+                    start.m_current - start.m_zeroStart + start.m_generatorOffset,
+                    toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
@@ -937,20 +1410,116 @@ void
 Buffer::Iterator::Write(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    if (!IsInSlice(size))
+    {
+        SlowWrite(buffer, size);
+        return;
+    }
     NS_ASSERT_MSG(CheckNoZero(m_current, size), GetWriteErrorMessage());
     uint8_t* to;
     if (m_current <= m_zeroStart)
     {
-        to = &m_data[m_current];
+        to = &m_data[m_current + m_shift];
     }
     else
     {
-        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        to = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
     }
     memcpy(to, buffer, size);
     m_current += size;
 }
 
+void
+Buffer::Iterator::SlowWrite(const uint8_t* buffer, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    while (size > 0)
+    {
+        uint32_t toCopy = size;
+        uint8_t* to = GetRun(toCopy);
+        memcpy(to, buffer, toCopy);
+        buffer += toCopy;
+        m_current += toCopy;
+        size -= toCopy;
+    }
+}
+
+void
+Buffer::Iterator::SelectSlice()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_tail == nullptr || m_current < m_firstEnd)
+    {
+        m_sliceStart = m_dataStart;
+        m_sliceEnd = m_firstEnd;
+        m_shift = 0;
+        m_data = m_firstData;
+        m_zeroStart = m_firstZeroStart;
+        m_zeroEnd = m_firstZeroEnd;
+        m_generator = m_firstGenerator;
+        m_generatorOffset = m_firstGeneratorOffset;
+        return;
+    }
+    const auto& ends = m_tail->m_ends;
+    auto it = std::upper_bound(ends.begin(), ends.end(), m_current - m_firstEnd);
+    if (it == ends.end())
+    {
+        // the end of the buffer belongs to the last slice
+        --it;
+    }
+    std::size_t index = it - ends.begin();
+    const Buffer& slice = m_tail->m_slices[index];
+    m_sliceStart = m_firstEnd + (index == 0 ? 0 : ends[index - 1]);
+    m_sliceEnd = m_firstEnd + ends[index];
+    m_shift = slice.m_start - m_sliceStart;
+    m_data = slice.m_data->m_data;
+    m_zeroStart = m_sliceStart + (slice.m_zeroAreaStart - slice.m_start);
+    m_zeroEnd = m_zeroStart + (slice.m_zeroAreaEnd - slice.m_zeroAreaStart);
+    m_generator = PeekPointer(slice.m_generator);
+    m_generatorOffset = slice.m_generatorOffset;
+}
+
+uint8_t
+Buffer::Iterator::PeekVirtualU8() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_current >= m_zeroStart && m_current < m_zeroEnd);
+    uint8_t data;
+    ReadVirtual(m_generator, &data, m_current - m_zeroStart + m_generatorOffset, 1);
+    return data;
+}
+
+uint8_t*
+Buffer::Iterator::GetRun(uint32_t& size)
+{
+    NS_LOG_FUNCTION(this << size);
+    if (!IsInSlice(1))
+    {
+        SelectSlice();
+    }
+    uint8_t* run;
+    uint32_t end;
+    if (m_current < m_zeroStart)
+    {
+        run = &m_data[m_current + m_shift];
+        end = m_zeroStart;
+    }
+    else if (m_current < m_zeroEnd)
+    {
+        run = nullptr;
+        end = m_zeroEnd;
+    }
+    else
+    {
+        run = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
+        end = m_sliceEnd;
+    }
+    NS_ASSERT(end > m_current);
+    size = std::min(size, end - m_current);
+    return run;
+}
+
 uint32_t
 Buffer::Iterator::ReadU32()
 {
@@ -8,14 +8,23 @@
 #ifndef BUFFER_H
 #define BUFFER_H
 
+#include "payload-generator.h"
+
 #include "ns3/assert.h"
 #include "ns3/deprecated.h"
+#include "ns3/ptr.h"
 
 #include <ostream>
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#else
+// The free list is a process-wide container which cannot be shared by
+// the threads of a multithreaded simulation
 #define BUFFER_FREE_LIST 1
+#endif
 
 namespace ns3
 {
@@ -87,9 +96,34 @@ namespace ns3
  * @endverbatim
  *
  * A simple state invariant is that m_start <= m_zeroStart <= m_zeroEnd <= m_end
+ *
+ * The "virtual zero area" can also hold other bytes than zeros, generated
+ * on demand by a PayloadGenerator from their offset in the original area:
+ * this offset is m_generatorOffset at m_zeroAreaStart, and it is updated
+ * when bytes are removed from the start of the area.
+ *
+ * The bytes of a Buffer can also be scattered over several slices,
+ * each one described like the single BufferData above. The first
+ * slice is held by the Buffer instance itself; the next ones, if any,
+ * are kept in a Buffer::Tail which is itself shared by copy on write
+ * among Buffer instances. Slices are created instead of copying bytes
+ * when:
+ *  - a buffer is appended to another one with Buffer::AddAtEnd (const Buffer &):
+ *    fragments of the same buffer which are appended back in order are
+ *    merged back into a single slice;
+ *  - bytes are added at the start or at the end of a large slice whose
+ *    BufferData is shared and dirty there, which is typically the case of
+ *    a header added to a fragment: the new bytes go into a slice of their own.
+ *
+ * Removing bytes only trims or drops slices, and Buffer::CreateFragment
+ * references the slices of the original buffer. Only Buffer::PeekData,
+ * which must return contiguous bytes, and the serialization methods
+ * gather the slices into a single one.
  */
 class Buffer
 {
+    struct Tail;
+
   public:
     /**
      * @brief iterator in a Buffer instance
@@ -468,15 +502,47 @@ class Buffer
          * @returns the error message
          */
         std::string GetWriteErrorMessage() const;
+        /**
+         * @param size number of bytes
+         * @returns true if the size bytes from the current position are
+         *          all in the current slice.
+         */
+        inline bool IsInSlice(uint32_t size) const;
+        /**
+         * Make the slice holding the current position the current slice.
+         */
+        void SelectSlice();
+        /**
+         * Get the bytes which follow the current position in the same
+         * slice and in the same area (real bytes or "virtual zero area").
+         *
+         * @param [in,out] size the maximum number of bytes on input, the
+         *                 number of bytes available on output
+         * @returns a pointer to the bytes, or nullptr if they are in the
+         *          "virtual zero area".
+         */
+        uint8_t* GetRun(uint32_t& size);
+        /**
+         * Write bytes which span several slices.
+         *
+         * @param buffer a byte buffer to copy in the internal buffer.
+         * @param size number of bytes to copy.
+         */
+        void SlowWrite(const uint8_t* buffer, uint32_t size);
+        /**
+         * @returns the byte at the current position, which must be in the
+         *          "virtual zero area" of the current slice.
+         */
+        uint8_t PeekVirtualU8() const;
 
         /**
          * offset in virtual bytes from the start of the data buffer to the
-         * start of the "virtual zero area".
+         * start of the "virtual zero area" of the current slice.
          */
         uint32_t m_zeroStart;
         /**
          * offset in virtual bytes from the start of the data buffer to the
-         * end of the "virtual zero area".
+         * end of the "virtual zero area" of the current slice.
          */
         uint32_t m_zeroEnd;
         /**
@@ -495,10 +561,67 @@ class Buffer
          */
         uint32_t m_current;
         /**
-         * a pointer to the underlying byte buffer. All offsets are relative
-         * to this pointer.
+         * offset in virtual bytes from the start of the data buffer to the
+         * start of the current slice.
+         */
+        uint32_t m_sliceStart;
+        /**
+         * offset in virtual bytes from the start of the data buffer to the
+         * end of the current slice.
+         */
+        uint32_t m_sliceEnd;
+        /**
+         * difference between the offsets in the byte buffer of the current
+         * slice and the offsets of this iterator. It is zero in the first slice.
+         */
+        uint32_t m_shift;
+        /**
+         * a pointer to the byte buffer of the current slice.
          */
         uint8_t* m_data;
+        /**
+         * a pointer to the byte buffer of the first slice. All offsets are
+         * relative to this pointer.
+         */
+        uint8_t* m_firstData;
+        /**
+         * offset in virtual bytes from the start of the data buffer to the
+         * start of the "virtual zero area" of the first slice.
+         */
+        uint32_t m_firstZeroStart;
+        /**
+         * offset in virtual bytes from the start of the data buffer to the
+         * end of the "virtual zero area" of the first slice.
+         */
+        uint32_t m_firstZeroEnd;
+        /**
+         * offset in virtual bytes from the start of the data buffer to the
+         * end of the first slice.
+         */
+        uint32_t m_firstEnd;
+        /**
+         * the generator of the "virtual zero area" of the current slice,
+         * nullptr if the area is made of zeros.
+         */
+        const PayloadGenerator* m_generator;
+        /**
+         * offset given to the generator for the start of the "virtual zero
+         * area" of the current slice.
+         */
+        uint32_t m_generatorOffset;
+        /**
+         * the generator of the "virtual zero area" of the first slice.
+         */
+        const PayloadGenerator* m_firstGenerator;
+        /**
+         * offset given to the generator for the start of the "virtual zero
+         * area" of the first slice.
+         */
+        uint32_t m_firstGeneratorOffset;
+        /**
+         * the slices which follow the first one, nullptr if none.
+         */
+        const Tail* m_tail;
     };
 
     /**
@@ -506,6 +629,12 @@ class Buffer
      */
     inline uint32_t GetSize() const;
 
+    /**
+     * @return the number of bytes of this buffer which are virtual, that
+     * is, which are not stored in memory but generated when read.
+     */
+    uint32_t GetVirtualSize() const;
+
     /**
      * @return a pointer to the start of the internal
      * byte buffer.
@@ -658,6 +787,17 @@ class Buffer
      * @param initialize initialize the buffer with zeroes.
      */
     Buffer(uint32_t dataSize, bool initialize);
+    /**
+     * @brief Constructor
+     *
+     * The buffer will hold dataSize virtual bytes, whose content is
+     * generated when they are read.
+     *
+     * @param dataSize the buffer size.
+     * @param generator the generator of the content of the buffer, or
+     *        nullptr for zeroes.
+     */
+    Buffer(uint32_t dataSize, Ptr<const PayloadGenerator> generator);
     ~Buffer();
 
   private:
@@ -681,7 +821,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -744,6 +888,85 @@ class Buffer
      */
     uint32_t GetInternalEnd() const;
 
+    /**
+     * @brief Check whether adding bytes at the start of the first slice
+     * would write into bytes referenced by another Buffer instance.
+     * @returns true if the start of the first slice is shared and dirty.
+     */
+    bool IsDirtyAtStart() const;
+    /**
+     * @brief Check whether adding bytes at the end of the first slice
+     * would write into bytes referenced by another Buffer instance.
+     * @returns true if the end of the first slice is shared and dirty.
+     */
+    bool IsDirtyAtEnd() const;
+    /**
+     * @brief Get the first slice of the buffer.
+     * @returns a buffer referencing only the first slice of this buffer.
+     */
+    Buffer GetFirstSlice() const;
+    /**
+     * @brief Replace the first slice of the buffer, keeping the other ones.
+     * @param slice a buffer with a single slice
+     */
+    void SetFirstSlice(const Buffer& slice);
+    /**
+     * @brief Check whether a slice continues the last slice of this buffer
+     * in the same buffer data storage.
+     * @param slice a buffer with a single slice
+     * @returns true if the slice can be merged with the last slice.
+     */
+    bool IsContinuedBy(const Buffer& slice) const;
+    /**
+     * @brief Append a slice, merging it with the last slice if possible.
+     * @param slice a non-empty buffer with a single slice
+     */
+    void AppendSlice(const Buffer& slice);
+    /**
+     * @brief Move the first slice to the front of the tail, and replace it
+     * with an empty slice backed by new buffer data storage.
+     */
+    void PushFirstSlice();
+    /**
+     * @brief Replace the first slice by the first slice of the tail.
+     */
+    void PopFirstSlice();
+    /**
+     * @brief Get the tail, copying it first if it is shared with other
+     * Buffer instances.
+     * @returns the tail, which must exist.
+     */
+    Tail* GetWritableTail();
+    /**
+     * @brief Release the reference to the tail, if any.
+     */
+    void ReleaseTail();
+    /**
+     * @brief Get the lengths of the areas of the serialized buffer.
+     *
+     * The bytes of a buffer with several slices or a generated zero area are
+     * serialized as the bytes of a full copy of the buffer, without creating it.
+     *
+     * @param zeroDataLength the length of the zero area, whose bytes are not written
+     * @param dataStartLength the number of bytes written before the zero area
+     * @param dataEndLength the number of bytes written after the zero area
+     */
+    void GetSerializedAreas(uint32_t& zeroDataLength,
+                            uint32_t& dataStartLength,
+                            uint32_t& dataEndLength) const;
+
+    /**
+     * @brief Read bytes of a "virtual zero area"
+     * @param generator the generator of the area, nullptr for zeroes
+     * @param buffer the buffer to fill
+     * @param offset the offset given to the generator for the first byte
+     * @param size the number of bytes to read
+     */
+    static void ReadVirtual(const PayloadGenerator* generator,
+                            uint8_t* buffer,
+                            uint32_t offset,
+                            uint32_t size);
+
     /**
      * @brief Recycle the buffer memory
      * @param data the buffer data storage
@@ -783,9 +1006,13 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value. Each thread of a multithreaded simulation keeps its own.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -807,6 +1034,24 @@ class Buffer
      * instance from the start of m_data->m_data
      */
     uint32_t m_end;
+    /**
+     * the slices which follow the first one, nullptr if the buffer
+     * has a single slice.
+     */
+    Tail* m_tail;
+    /**
+     * number of bytes in the slices which follow the first one.
+     */
+    uint32_t m_tailSize;
+    /**
+     * the generator of the content of the "virtual zero area" of the
+     * first slice, null if the area is made of zeroes.
+     */
+    Ptr<const PayloadGenerator> m_generator;
+    /**
+     * offset given to m_generator for the byte at m_zeroAreaStart.
+     */
+    uint32_t m_generatorOffset;
 
 #ifdef BUFFER_FREE_LIST
     /// Container for buffer data
@@ -824,6 +1069,31 @@ class Buffer
 #endif
 };
 
+/**
+ * @brief The slices which follow the first slice of a Buffer.
+ *
+ * Each slice is a non-empty Buffer which has a single slice.
+ */
+struct Buffer::Tail
+{
+    /**
+     * The reference count of an instance of this data structure.
+     * Each buffer which references an instance holds a count.
+     */
+#ifdef NS3_MTP
+    std::atomic<uint32_t> m_count;
+#else
+    uint32_t m_count;
+#endif
+    /** The slices. */
+    std::vector<Buffer> m_slices;
+    /**
+     * The end of each slice, in bytes from the end of the first slice.
+     * The last element is the size of the tail.
+     */
+    std::vector<uint32_t> m_ends;
+};
+
 } // namespace ns3
 
 #include "ns3/assert.h"
@@ -839,7 +1109,19 @@ Buffer::Iterator::Iterator()
       m_dataStart(0),
       m_dataEnd(0),
       m_current(0),
-      m_data(nullptr)
+      m_sliceStart(0),
+      m_sliceEnd(0),
+      m_shift(0),
+      m_data(nullptr),
+      m_firstData(nullptr),
+      m_firstZeroStart(0),
+      m_firstZeroEnd(0),
+      m_firstEnd(0),
+      m_generator(nullptr),
+      m_generatorOffset(0),
+      m_firstGenerator(nullptr),
+      m_firstGeneratorOffset(0),
+      m_tail(nullptr)
 {
 }
 
@@ -861,8 +1143,26 @@ Buffer::Iterator::Construct(const Buffer* buffer)
     m_zeroStart = buffer->m_zeroAreaStart;
     m_zeroEnd = buffer->m_zeroAreaEnd;
     m_dataStart = buffer->m_start;
-    m_dataEnd = buffer->m_end;
+    m_dataEnd = buffer->m_end + buffer->m_tailSize;
+    m_sliceStart = buffer->m_start;
+    m_sliceEnd = buffer->m_end;
+    m_shift = 0;
     m_data = buffer->m_data->m_data;
+    m_firstData = m_data;
+    m_firstZeroStart = m_zeroStart;
+    m_firstZeroEnd = m_zeroEnd;
+    m_firstEnd = m_sliceEnd;
+    m_generator = PeekPointer(buffer->m_generator);
+    m_generatorOffset = buffer->m_generatorOffset;
+    m_firstGenerator = m_generator;
+    m_firstGeneratorOffset = m_generatorOffset;
+    m_tail = buffer->m_tail;
+}
+
+bool
+Buffer::Iterator::IsInSlice(uint32_t size) const
+{
+    return m_current >= m_sliceStart && m_current + size <= m_sliceEnd;
 }
 
 void
@@ -896,16 +1196,20 @@ Buffer::Iterator::Prev(uint32_t delta)
 void
 Buffer::Iterator::WriteU8(uint8_t data)
 {
+    if (!IsInSlice(1))
+    {
+        SelectSlice();
+    }
     NS_ASSERT_MSG(Check(m_current), GetWriteErrorMessage());
 
     if (m_current < m_zeroStart)
     {
-        m_data[m_current] = data;
+        m_data[m_current + m_shift] = data;
         m_current++;
     }
     else
     {
-        m_data[m_current - (m_zeroEnd - m_zeroStart)] = data;
+        m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)] = data;
         m_current++;
     }
 }
@@ -913,15 +1217,23 @@ Buffer::Iterator::WriteU8(uint8_t data)
 void
 Buffer::Iterator::WriteU8(uint8_t data, uint32_t len)
 {
+    if (!IsInSlice(len))
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            WriteU8(data);
+        }
+        return;
+    }
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + len), GetWriteErrorMessage());
     if (m_current <= m_zeroStart)
     {
-        std::memset(&(m_data[m_current]), data, len);
+        std::memset(&(m_data[m_current + m_shift]), data, len);
         m_current += len;
     }
     else
     {
-        uint8_t* buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        uint8_t* buffer = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
         std::memset(buffer, data, len);
         m_current += len;
     }
@@ -930,15 +1242,21 @@ Buffer::Iterator::WriteU8(uint8_t data, uint32_t len)
 void
 Buffer::Iterator::WriteHtonU16(uint16_t data)
 {
+    if (!IsInSlice(2))
+    {
+        WriteU8((data >> 8) & 0xff);
+        WriteU8((data >> 0) & 0xff);
+        return;
+    }
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 2), GetWriteErrorMessage());
     uint8_t* buffer;
     if (m_current + 2 <= m_zeroStart)
     {
-        buffer = &m_data[m_current];
+        buffer = &m_data[m_current + m_shift];
     }
     else
     {
-        buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        buffer = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
     }
     buffer[0] = (data >> 8) & 0xff;
     buffer[1] = (data >> 0) & 0xff;
@@ -948,16 +1266,24 @@ Buffer::Iterator::WriteHtonU16(uint16_t data)
 void
 Buffer::Iterator::WriteHtonU32(uint32_t data)
 {
+    if (!IsInSlice(4))
+    {
+        WriteU8((data >> 24) & 0xff);
+        WriteU8((data >> 16) & 0xff);
+        WriteU8((data >> 8) & 0xff);
+        WriteU8((data >> 0) & 0xff);
+        return;
+    }
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + 4), GetWriteErrorMessage());
 
     uint8_t* buffer;
     if (m_current + 4 <= m_zeroStart)
     {
-        buffer = &m_data[m_current];
+        buffer = &m_data[m_current + m_shift];
     }
     else
     {
-        buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        buffer = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
     }
     buffer[0] = (data >> 24) & 0xff;
     buffer[1] = (data >> 16) & 0xff;
@@ -970,13 +1296,17 @@ uint16_t
 Buffer::Iterator::ReadNtohU16()
 {
     uint8_t* buffer;
-    if (m_current + 2 <= m_zeroStart)
+    if (!IsInSlice(2))
+    {
+        return SlowReadNtohU16();
+    }
+    else if (m_current + 2 <= m_zeroStart)
     {
-        buffer = &m_data[m_current];
+        buffer = &m_data[m_current + m_shift];
     }
     else if (m_current >= m_zeroEnd)
     {
-        buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        buffer = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
     }
     else
     {
@@ -994,13 +1324,17 @@ uint32_t
 Buffer::Iterator::ReadNtohU32()
 {
     uint8_t* buffer;
-    if (m_current + 4 <= m_zeroStart)
+    if (!IsInSlice(4))
+    {
+        return SlowReadNtohU32();
+    }
+    else if (m_current + 4 <= m_zeroStart)
     {
-        buffer = &m_data[m_current];
+        buffer = &m_data[m_current + m_shift];
     }
     else if (m_current >= m_zeroEnd)
     {
-        buffer = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        buffer = &m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
     }
     else
     {
@@ -1023,18 +1357,22 @@ Buffer::Iterator::PeekU8()
 {
     NS_ASSERT_MSG(m_current >= m_dataStart && m_current < m_dataEnd, GetReadErrorMessage());
 
+    if (!IsInSlice(1))
+    {
+        SelectSlice();
+    }
     if (m_current < m_zeroStart)
     {
-        uint8_t data = m_data[m_current];
+        uint8_t data = m_data[m_current + m_shift];
         return data;
     }
     else if (m_current < m_zeroEnd)
     {
-        return 0;
+        return m_generator == nullptr ? 0 : PeekVirtualU8();
     }
     else
     {
-        uint8_t data = m_data[m_current - (m_zeroEnd - m_zeroStart)];
+        uint8_t data = m_data[m_current + m_shift - (m_zeroEnd - m_zeroStart)];
         return data;
     }
 }
@@ -1074,16 +1412,24 @@ Buffer::Buffer(const Buffer& o)
       m_zeroAreaStart(o.m_zeroAreaStart),
       m_zeroAreaEnd(o.m_zeroAreaEnd),
       m_start(o.m_start),
-      m_end(o.m_end)
+      m_end(o.m_end),
+      m_tail(o.m_tail),
+      m_tailSize(o.m_tailSize),
+      m_generator(o.m_generator),
+      m_generatorOffset(o.m_generatorOffset)
 {
     m_data->m_count++;
+    if (m_tail != nullptr)
+    {
+        m_tail->m_count++;
+    }
     NS_ASSERT(CheckInternalState());
 }
 
 uint32_t
 Buffer::GetSize() const
 {
-    return m_end - m_start;
+    return m_end - m_start + m_tailSize;
 }
 
 Buffer::Iterator
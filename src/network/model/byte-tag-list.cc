@@ -9,10 +9,16 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+// The free list is per thread, so that it can also be used by the threads
+// of a multithreaded simulation
 #define USE_FREE_LIST 1
 #define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
@@ -31,8 +37,12 @@ NS_LOG_COMPONENT_DEFINE("ByteTagList");
  */
 struct ByteTagListData
 {
-    uint32_t size;   //!< size of the data
-    uint32_t count;  //!< use counter (for smart deallocation)
+    uint32_t size; //!< size of the data
+#ifdef NS3_MTP
+    std::atomic<uint32_t> count; //!< use counter (for smart deallocation)
+#else
+    uint32_t count; //!< use counter (for smart deallocation)
+#endif
     uint32_t dirty;  //!< number of bytes actually in use
     uint8_t data[4]; //!< data
 };
@@ -45,13 +55,15 @@ struct ByteTagListData
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+static thread_local class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
 } g_freeList; //!< Container for struct ByteTagListData
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+/// Flag set when the free list of the calling thread has been destroyed
+static thread_local bool g_freeListDestroyed = false;
+static thread_local uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
@@ -61,6 +73,7 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList()
         auto buffer = (uint8_t*)(*i);
         delete[] buffer;
     }
+    g_freeListDestroyed = true;
 }
 #endif /* USE_FREE_LIST */
 
@@ -202,7 +215,8 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
     }
     else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
     {
-        ByteTagListData* newData = Allocate(spaceNeeded);
+        // grow geometrically, so that adding n tags takes O(log n) allocations
+        ByteTagListData* newData = Allocate(std::max(spaceNeeded, 2 * m_used));
         std::memcpy(&newData->data, &m_data->data, m_used);
         Deallocate(m_data);
         m_data = newData;
@@ -282,6 +296,7 @@ ByteTagList::AddAtEnd(int32_t appendOffset)
         return;
     }
     ByteTagList list;
+    list.m_data = Allocate(m_used);
     ByteTagList::Iterator i = BeginAll();
     while (i.HasNext())
     {
@@ -315,6 +330,7 @@ ByteTagList::AddAtStart(int32_t prependOffset)
     }
     m_minStart = INT32_MAX;
     ByteTagList list;
+    list.m_data = Allocate(m_used);
     ByteTagList::Iterator i = BeginAll();
     while (i.HasNext())
     {
@@ -344,7 +360,7 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    while (!g_freeListDestroyed && !g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
         g_freeList.pop_back();
@@ -358,7 +374,8 @@ ByteTagList::Allocate(uint32_t size)
         auto buffer = (uint8_t*)data;
         delete[] buffer;
     }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
+    size = std::max(size, g_maxSize);
+    auto buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
     auto data = (ByteTagListData*)buffer;
     data->count = 1;
     data->size = size;
@@ -375,10 +392,9 @@ ByteTagList::Deallocate(ByteTagListData* data)
         return;
     }
     g_maxSize = std::max(g_maxSize, data->size);
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        if (g_freeListDestroyed || g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
             auto buffer = (uint8_t*)data;
             delete[] buffer;
@@ -412,8 +428,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
         uint8_t* buffer = (uint8_t*)data;
         delete[] buffer;
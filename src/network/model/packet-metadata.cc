@@ -26,9 +26,19 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
+#ifdef NS3_MTP
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+/**
+ * Set when the free list of the calling thread has been destroyed:
+ * the metadata released afterwards by this thread are deallocated.
+ */
+static thread_local bool g_freeListDestroyed = false;
+#else
+uint32_t PacketMetadata::m_maxSize = 0;
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+#endif
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -37,7 +47,12 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
+#ifdef NS3_MTP
+    // Only this thread loses its free list, the others keep recycling
+    g_freeListDestroyed = true;
+#else
     PacketMetadata::m_enable = false;
+#endif
 }
 
 void
@@ -69,8 +84,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -580,7 +594,11 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+#ifdef NS3_MTP
+    if (!m_enable || g_freeListDestroyed)
+#else
     if (!m_enable)
+#endif
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -8,7 +8,7 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a list of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
@@ -20,276 +20,282 @@
 #include "ns3/log.h"
 
 #include <cstring>
+#include <limits>
+#include <new>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
-PacketTagList::TagData*
-PacketTagList::CreateTagData(size_t dataSize)
+/**
+ * @ingroup packet
+ * Unnamed namespace for the pool of overflow buffers.
+ */
+namespace
 {
-    NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
-                  "Requested TagData size " << dataSize << " exceeds maximum "
-                                            << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
-
-    auto tag = new (p) TagData;
-    tag->size = dataSize;
-    return tag;
-}
+/** Capacity of the smallest overflow buffers. */
+constexpr uint32_t MIN_OVERFLOW_CAPACITY = 2 * PacketTagList::INLINE_SIZE;
+/** Number of buffer capacities, doubling from MIN_OVERFLOW_CAPACITY, kept by the pools. */
+constexpr uint32_t OVERFLOW_CLASSES = 6;
+/** Number of free buffers of a capacity above which buffers are given back to the system. */
+constexpr uint32_t MAX_FREE_OVERFLOWS = 256;
 
-bool
-PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
+/** A free overflow buffer, linked in the free list of its capacity. */
+struct FreeOverflow
 {
-    TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
+    FreeOverflow* next; //!< Next free buffer.
+};
 
-    // trivial case when list is empty
-    if (m_next == nullptr)
-    {
-        return false;
-    }
+/** Free overflow buffers of a thread. */
+struct OverflowPool
+{
+    FreeOverflow* free[OVERFLOW_CLASSES]{}; //!< Free buffers of each capacity.
+    uint32_t count[OVERFLOW_CLASSES]{};     //!< Number of free buffers of each capacity.
 
-    bool found = false;
+    /** Destructor: give the free buffers back to the system. */
+    ~OverflowPool();
+};
 
-    TagData** prevNext = &m_next; // previous node's next pointer
-    TagData* cur = m_next;        // cursor to current node
-    TagData* it = nullptr;        // utility
+/** The pool of the calling thread. */
+thread_local OverflowPool g_overflowPool;
+/** Flag set when the pool of the calling thread has been destroyed. */
+thread_local bool g_overflowPoolDestroyed = false;
 
-    // Search from the head of the list until we find tid or a merge
-    while (cur != nullptr)
+OverflowPool::~OverflowPool()
+{
+    for (uint32_t index = 0; index < OVERFLOW_CLASSES; index++)
     {
-        if (cur->count > 1)
+        while (free[index] != nullptr)
         {
-            // found merge
-            NS_LOG_INFO("found initial merge before tid");
-            break;
-        }
-        else if (cur->tid == tid)
-        {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
-            found = (this->*Writer)(tag, true, cur, prevNext);
-            break;
-        }
-        else
-        {
-            // no merge or tid found yet, move on
-            prevNext = &cur->next;
-            cur = cur->next;
+            FreeOverflow* block = free[index];
+            free[index] = block->next;
+            ::operator delete(block);
         }
     }
+    g_overflowPoolDestroyed = true;
+}
 
-    // did we find it or run out of tags?
-    if (cur == nullptr || found)
+/**
+ * @param [in] capacity The minimum capacity of an overflow buffer.
+ * @returns The index of the smallest buffer capacity of the pools that fits
+ *          \pname{capacity}, or OVERFLOW_CLASSES if none.
+ */
+uint32_t
+GetOverflowClass(uint32_t capacity)
+{
+    uint32_t index = 0;
+    while (index < OVERFLOW_CLASSES && (MIN_OVERFLOW_CAPACITY << index) < capacity)
     {
-        NS_LOG_INFO("returning after header with found: " << found);
-        return found;
+        index++;
     }
+    return index;
+}
 
-    // From here on out, we have to copy the list
-    // until we find tid, then link past it
+} // unnamed namespace
 
-    // Before we do all that work, let's make sure tid really exists
-    for (it = cur; it != nullptr; it = it->next)
+PacketTagList::Overflow*
+PacketTagList::AllocateOverflow(uint32_t capacity)
+{
+    NS_LOG_FUNCTION(capacity);
+    uint32_t index = GetOverflowClass(capacity);
+    if (index < OVERFLOW_CLASSES)
     {
-        if (it->tid == tid)
-        {
-            break;
-        }
+        capacity = MIN_OVERFLOW_CAPACITY << index;
     }
-    if (it == nullptr)
+    void* p = nullptr;
+    if (index < OVERFLOW_CLASSES && !g_overflowPoolDestroyed &&
+        g_overflowPool.free[index] != nullptr)
     {
-        // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
-        return found;
+        OverflowPool& pool = g_overflowPool;
+        FreeOverflow* block = pool.free[index];
+        pool.free[index] = block->next;
+        pool.count[index]--;
+        p = block;
     }
-
-    // At this point cur is a merge, but untested for tid
-    NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
-
-    /*
-       Walk the remainder of the list, copying, until we find tid
-       As we put a copy of the cur node onto our list,
-       we move the merge point down the list.
-
-       Starting position                  End position
-         T1 is a merge                     T1.count decremented
-                                           T2 is a merge
-                                           T1' is a copy of T1
-
-            other                             other
-                 \                                 \
-        Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-             /   /                                         /|
-        pNext cur                         Prev  ->  T1' --/ |
-                                                       /    |
-                                                  pNext   cur
-
-       When we reach tid, we link past it, decrement count, and we're done.
-    */
-
-    // Should normally check for null cur pointer,
-    // but since we know tid exists, we'll skip this test
-    while (/* cur && */ cur->tid != tid)
+    else
     {
-        NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(cur->size);
-        copy->tid = cur->tid;
-        copy->count = 1;
-        copy->size = cur->size;
-        memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
-        cur = copy->next;
+        // The matching delete is in ReleaseOverflow, or in the pool destructor
+        p = ::operator new(offsetof(Overflow, data) + capacity);
     }
-    // Sanity check:
-    NS_ASSERT(cur != nullptr);  // cur should be non-zero
-    NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
-
-    // link around tid, removing it from our list
-    found = (this->*Writer)(tag, false, cur, prevNext);
-    return found;
+    auto overflow = new (p) Overflow;
+    overflow->count = 1;
+    overflow->capacity = capacity;
+    return overflow;
 }
 
-bool
-PacketTagList::Remove(Tag& tag)
+void
+PacketTagList::ReleaseOverflow(PacketTagList::Overflow* overflow)
 {
-    return COWTraverse(tag, &PacketTagList::RemoveWriter);
+    NS_LOG_FUNCTION(overflow);
+    if (--overflow->count > 0)
+    {
+        return;
+    }
+    uint32_t index = GetOverflowClass(overflow->capacity);
+    overflow->~Overflow();
+    if (index < OVERFLOW_CLASSES && !g_overflowPoolDestroyed &&
+        g_overflowPool.count[index] < MAX_FREE_OVERFLOWS)
+    {
+        OverflowPool& pool = g_overflowPool;
+        auto block = reinterpret_cast<FreeOverflow*>(overflow);
+        block->next = pool.free[index];
+        pool.free[index] = block;
+        pool.count[index]++;
+        return;
+    }
+    ::operator delete(overflow);
 }
 
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter(Tag& tag,
-                            bool preMerge,
-                            PacketTagList::TagData* cur,
-                            PacketTagList::TagData** prevNext)
+uint8_t*
+PacketTagList::Resize(uint32_t offset, uint32_t oldSize, uint32_t newSize)
 {
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-    *prevNext = cur->next; // link around cur
-
-    if (preMerge)
+    NS_LOG_FUNCTION(this << offset << oldSize << newSize);
+    NS_ASSERT(offset + oldSize <= m_used);
+    uint32_t used = m_used - oldSize + newSize;
+    uint32_t tail = m_used - offset - oldSize;
+    uint8_t* data = GetData();
+    if (m_overflow == nullptr ? used <= INLINE_SIZE
+                              : m_overflow->count == 1 && used > INLINE_SIZE &&
+                                    used <= m_overflow->capacity)
     {
-        // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        // the records stay where they are
+        std::memmove(data + offset + newSize, data + offset + oldSize, tail);
     }
     else
     {
-        // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
-        if (cur->next != nullptr)
+        // the records move to the inline buffer, or to a new overflow buffer
+        Overflow* overflow = nullptr;
+        uint8_t* to = m_inline;
+        if (used > INLINE_SIZE)
+        {
+            overflow = AllocateOverflow(used);
+            to = overflow->data;
+        }
+        std::memcpy(to, data, offset);
+        std::memcpy(to + offset + newSize, data + offset + oldSize, tail);
+        if (m_overflow != nullptr)
         {
-            // there's a next, so make it a merge
-            cur->next->count++;
+            ReleaseOverflow(m_overflow);
         }
+        m_overflow = overflow;
+        data = to;
     }
-    return found;
+    m_used = used;
+    return data;
 }
 
-bool
-PacketTagList::Replace(Tag& tag)
+uint32_t
+PacketTagList::Find(TypeId tid) const
 {
-    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
-    if (!found)
+    if ((m_index & GetIndexBit(tid)) == 0)
     {
-        Add(tag);
+        return m_used;
+    }
+    const uint8_t* data = GetData();
+    uint32_t offset = 0;
+    while (offset < m_used)
+    {
+        auto cur = reinterpret_cast<const TagData*>(data + offset);
+        if (cur->tid == tid)
+        {
+            break;
+        }
+        offset += GetRecordSize(cur->size);
     }
-    return found;
+    return offset;
 }
 
-// COWWriter implementing Replace
-bool
-PacketTagList::ReplaceWriter(Tag& tag,
-                             bool preMerge,
-                             PacketTagList::TagData* cur,
-                             PacketTagList::TagData** prevNext)
+void
+PacketTagList::UpdateIndex()
 {
-    NS_LOG_FUNCTION_NOARGS();
+    m_index = 0;
+    for (const TagData* cur = Head(); cur != End(); cur = Next(cur))
+    {
+        m_index |= GetIndexBit(cur->tid);
+    }
+}
 
-    // found tid
-    bool found = true;
-    if (preMerge)
+bool
+PacketTagList::Remove(Tag& tag)
+{
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t offset = Find(tid);
+    if (offset == m_used)
     {
-        // found tid before first merge, so just rewrite
-        tag.Serialize(TagBuffer(cur->data, cur->data + cur->size));
+        return false;
     }
-    else
+    auto cur = reinterpret_cast<TagData*>(GetData() + offset);
+    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
+    Resize(offset, GetRecordSize(cur->size), 0);
+    UpdateIndex();
+    return true;
+}
+
+bool
+PacketTagList::Replace(Tag& tag)
+{
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t offset = Find(tid);
+    if (offset == m_used)
     {
-        // cur is always a merge at this point
-        // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(tag.GetSerializedSize());
-        copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
-        tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
-        copy->next = cur->next; // merge into tail
-        if (copy->next != nullptr)
-        {
-            copy->next->count++; // mark new merge
-        }
-        *prevNext = copy; // point prior list at copy
+        Add(tag);
+        return false;
     }
-    return found;
+    uint32_t size = tag.GetSerializedSize();
+    NS_ASSERT_MSG(size <= std::numeric_limits<decltype(TagData::size)>::max(),
+                  "Tag size " << size << " exceeds maximum "
+                              << std::numeric_limits<decltype(TagData::size)>::max());
+    auto cur = reinterpret_cast<TagData*>(GetData() + offset);
+    uint8_t* data = Resize(offset, GetRecordSize(cur->size), GetRecordSize(size));
+    cur = new (data + offset) TagData;
+    cur->tid = tid;
+    cur->size = size;
+    tag.Serialize(TagBuffer(cur->data, cur->data + size));
+    return true;
 }
 
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
     // ensure this id was not yet added
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
-                      "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
-    }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
-    head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
-    head->next = m_next;
-    tag.Serialize(TagBuffer(head->data, head->data + head->size));
-
-    const_cast<PacketTagList*>(this)->m_next = head;
+    NS_ASSERT_MSG(Find(tid) == m_used,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tid.GetName());
+    uint32_t size = tag.GetSerializedSize();
+    NS_ASSERT_MSG(size <= std::numeric_limits<decltype(TagData::size)>::max(),
+                  "Tag size " << size << " exceeds maximum "
+                              << std::numeric_limits<decltype(TagData::size)>::max());
+
+    auto self = const_cast<PacketTagList*>(this);
+    uint8_t* data = self->Resize(0, 0, GetRecordSize(size));
+    auto head = new (data) TagData;
+    head->tid = tid;
+    head->size = size;
+    tag.Serialize(TagBuffer(head->data, head->data + size));
+    self->m_index |= GetIndexBit(tid);
 }
 
 bool
 PacketTagList::Peek(Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t offset = Find(tid);
+    if (offset == m_used)
     {
-        if (cur->tid == tid)
-        {
-            /* found tag */
-            tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-            return true;
-        }
+        /* no tag found */
+        return false;
     }
-    /* no tag found */
-    return false;
-}
-
-const PacketTagList::TagData*
-PacketTagList::Head() const
-{
-    return m_next;
+    /* found tag */
+    auto cur = reinterpret_cast<TagData*>(GetData() + offset);
+    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
+    return true;
 }
 
 uint32_t
@@ -301,7 +307,7 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != End(); cur = Next(cur))
     {
         size += 4; // TagData -> size
 
@@ -335,7 +341,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != End(); cur = Next(cur))
     {
         size += 4;
 
@@ -393,7 +399,7 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
     NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-    TagData* prevTag = nullptr;
+    RemoveAll();
     for (uint32_t i = 0; i < numberOfTags; ++i)
     {
         NS_ASSERT(sizeCheck >= 4);
@@ -411,10 +417,12 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
+        // Append the record to the list.
+        uint8_t* data = Resize(m_used, 0, GetRecordSize(tagSize));
+        auto newTag = new (data + m_used - GetRecordSize(tagSize)) TagData;
         newTag->tid = tid;
+        newTag->size = tagSize;
+        m_index |= GetIndexBit(tid);
 
         NS_ASSERT(sizeCheck >= tagSize);
         memcpy(newTag->data, p, tagSize);
@@ -423,18 +431,6 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
     }
 
     NS_ASSERT(sizeCheck == 0);
@@ -10,14 +10,20 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a list of Packet tags, including copy-on-write semantics.
 */
 
 #include "ns3/type-id.h"
 
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -33,88 +39,34 @@ class Tag;
  *
  * @internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
- *
- * @dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * @enddot
- *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (``T1-T7`` in the diagram)
- *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
- *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     ``count \> 1`` (\c T3, \c T5); successive links along
- *     a branch have ``count = 1`` (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (``T5-T7``)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ * The tags are stored in serialized form, as a sequence of TagData
+ * records, most recent tag first.  Each record holds the TypeId of
+ * the tag, the size of its serialization, and the serialization itself,
+ * padded to a multiple of 4 bytes.
  *
- * @par <b> Copy-on-write </b> is implemented as follows:
+ *   - The records are kept in a buffer of #INLINE_SIZE bytes inside the
+ *     list itself, so that the handful of small tags a packet usually
+ *     carries costs no memory allocation.
+ *   - When the records no longer fit in the inline buffer, they are
+ *     moved to an overflow buffer, taken from a per-thread pool of
+ *     recycled buffers.  The overflow buffer is reference-counted and
+ *     shared by the copies of the list, and unshared as needed to
+ *     emulate copy-on-write semantics.  The records are moved back to
+ *     the inline buffer when a change makes them fit again.
+ *   - A 64-bit summary of the TypeIds present in the list, one bit per
+ *     TypeId uid modulo 64, lets #Peek, #Remove and #Replace return
+ *     without looking at the records when the tag is absent, and #Add
+ *     look for duplicates only when needed.  Otherwise, only the few
+ *     contiguous records of the list are searched.
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
- *   - Copy constructor (PacketTagList(const PacketTagList & o))
- *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
- *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ * Copying a list thus either copies the used part of the inline buffer,
+ * or increments the reference count of the overflow buffer.
  */
 class PacketTagList
 {
   public:
     /**
-     * Tree node for sharing serialized tags.
+     * Serialized tag record.
      *
      * See PacketTagList for a discussion of the data structure.
      *
@@ -124,19 +76,19 @@ class PacketTagList
      * The Item nested class can't be forward declared, so friending isn't
      * possible.
      *
-     * We use placement new so we can allocate enough room for the Tag
-     * type which will be serialized into data.  See Object::Aggregates
-     * for a similar construction.
+     * The records are stored back to back in the buffer of the list:
+     * \c data actually holds \c size bytes, rounded up to a multiple of 4.
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
         TypeId tid;      //!< Type of the tag serialized into #data
-        uint32_t size;   //!< Size of the \c data buffer
-        uint8_t data[1]; //!< Serialization buffer
+        uint16_t size;   //!< Size of the \c data buffer
+        uint8_t data[4]; //!< Serialization buffer
     };
 
+    /** Size of the buffer holding the records inside the list. */
+    static constexpr uint32_t INLINE_SIZE = 64;
+
     /**
      * Create a new PacketTagList.
      */
@@ -146,8 +98,8 @@ class PacketTagList
      *
      * @param [in] o The PacketTagList to copy.
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This copies the inline records of \pname{o}, or shares
+     * its overflow buffer.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -156,19 +108,19 @@ class PacketTagList
      * @param [in] o The PacketTagList to copy.
      * @returns the copied object
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This makes a light-weight copy by #RemoveAll, then copying
+     * the inline records of \pname{o}, or sharing its overflow buffer.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
      * Destructor
      *
-     * #RemoveAll's the tags up to the first merge.
+     * Releases the overflow buffer, if any.
      */
     inline ~PacketTagList();
 
     /**
-     * Add a tag to the head of this branch.
+     * Add a tag to the head of this list.
      *
      * @param [in] tag The tag to add
      */
@@ -200,13 +152,24 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list.
      */
     inline void RemoveAll();
     /**
-     * @returns pointer to head of tag list
+     * @returns pointer to the first record of the list
+     *
+     * The records are invalidated by any change of the list.
      */
-    const PacketTagList::TagData* Head() const;
+    inline const PacketTagList::TagData* Head() const;
+    /**
+     * @returns pointer past the last record of the list
+     */
+    inline const PacketTagList::TagData* End() const;
+    /**
+     * @param [in] data A record of the list.
+     * @returns pointer to the record which follows \pname{data}
+     */
+    static inline const PacketTagList::TagData* Next(const PacketTagList::TagData* data);
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -234,66 +197,77 @@ class PacketTagList
 
   private:
     /**
-     * Allocate and construct a TagData struct, sizing the data area
-     * large enough to serialize dataSize bytes from a Tag.
-     *
-     * @param [in] dataSize The serialized size of the Tag.
-     * @returns The newly constructed TagData object.
+     * Reference-counted buffer holding the records which do not fit
+     * in the inline buffer.
      */
-    static TagData* CreateTagData(size_t dataSize);
+    struct Overflow
+    {
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of lists sharing the buffer
+#else
+        uint32_t count; //!< Number of lists sharing the buffer
+#endif
+        uint32_t capacity; //!< Size of the \c data buffer
+        uint8_t data[4];   //!< Records; actually \c capacity bytes
+    };
 
     /**
-     * Typedef of method function pointer for copy-on-write operations
-     *
-     * @param [in] tag The tag type to operate on.
-     * @param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * @param [in] cur Pointer to the tag.
-     * @param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * @returns True if operation successful, false otherwise
+     * @param [in] dataSize The serialized size of a Tag.
+     * @returns The size of the record holding the Tag.
      */
-    typedef bool (PacketTagList::*COWWriter)(Tag& tag,
-                                             bool preMerge,
-                                             TagData* cur,
-                                             TagData** prevNext);
+    static inline uint32_t GetRecordSize(uint32_t dataSize);
     /**
-     * Traverse the list implementing copy-on-write, using \pname{Writer}.
-     *
-     * @param [in] tag The tag type to operate on.
-     * @param [in] Writer The copy-on-write function to use.
-     * @returns True if \pname{tag} found, false otherwise.
+     * @param [in] tid A TypeId.
+     * @returns The bit of \pname{tid} in #m_index.
      */
-    bool COWTraverse(Tag& tag, PacketTagList::COWWriter Writer);
+    static inline uint64_t GetIndexBit(TypeId tid);
     /**
-     * Copy-on-write implementing Remove.
+     * @returns The buffer holding the records.
+     */
+    inline uint8_t* GetData() const;
+    /**
+     * Find the record of a tag.
      *
-     * @param [in] tag The target tag type to remove.
-     * @param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * @param [in] cur Pointer to the tag.
-     * @param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * @returns True, since tag will definitely be removed.
+     * @param [in] tid The type of the tag.
+     * @returns The offset of the record, or #m_used if the list does not
+     *          hold a \pname{tid} tag.
      */
-    bool RemoveWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    uint32_t Find(TypeId tid) const;
     /**
-     * Copy-on-write implementing Replace
+     * Make the records writable without affecting the other lists, and
+     * resize the record at \pname{offset} from \pname{oldSize} to
+     * \pname{newSize} bytes, moving the records which follow it.
      *
-     * @param [in] tag The target tag type to replace
-     * @param [in] preMerge True if \pname{tag} was found before the first merge,
-     *          false otherwise.
-     * @param [in] cur Pointer to the tag
-     * @param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * @returns True, since tag value will definitely be replaced.
+     * @param [in] offset The offset of the record.
+     * @param [in] oldSize The current size of the record, zero to insert one.
+     * @param [in] newSize The new size of the record, zero to remove it.
+     * @returns The buffer holding the records.
+     */
+    uint8_t* Resize(uint32_t offset, uint32_t oldSize, uint32_t newSize);
+    /**
+     * Recompute #m_index from the records.
      */
-    bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    void UpdateIndex();
 
     /**
-     * Pointer to first \ref TagData on the list
+     * Take a buffer from the pool of the calling thread.
+     *
+     * @param [in] capacity The minimum capacity of the buffer.
+     * @returns A buffer with a reference count of 1.
      */
-    TagData* m_next;
+    static Overflow* AllocateOverflow(uint32_t capacity);
+    /**
+     * Release a reference to a buffer, and give it back to the pool of the
+     * calling thread when it was the last one.
+     *
+     * @param [in] overflow The buffer.
+     */
+    static void ReleaseOverflow(Overflow* overflow);
+
+    uint64_t m_index;                         //!< Summary of the TypeIds in the list
+    uint32_t m_used;                          //!< Number of bytes used by the records
+    Overflow* m_overflow;                     //!< Buffer of the records, or null if inline
+    alignas(8) uint8_t m_inline[INLINE_SIZE]; //!< Inline buffer of the records
 };
 
 } // namespace ns3
@@ -306,16 +280,24 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_index(0),
+      m_used(0),
+      m_overflow(nullptr)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_index(o.m_index),
+      m_used(o.m_used),
+      m_overflow(o.m_overflow)
 {
-    if (m_next != nullptr)
+    if (m_overflow != nullptr)
+    {
+        m_overflow->count++;
+    }
+    else
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_used);
     }
 }
 
@@ -323,15 +305,21 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
+    if (o.m_overflow != nullptr)
+    {
+        o.m_overflow->count++;
+    }
     RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    m_index = o.m_index;
+    m_used = o.m_used;
+    m_overflow = o.m_overflow;
+    if (m_overflow == nullptr)
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_used);
     }
     return *this;
 }
@@ -344,27 +332,50 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
-    TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    if (m_overflow != nullptr)
     {
-        cur->count--;
-        if (cur->count > 0)
-        {
-            break;
-        }
-        if (prev != nullptr)
-        {
-            prev->~TagData();
-            std::free(prev);
-        }
-        prev = cur;
+        ReleaseOverflow(m_overflow);
+        m_overflow = nullptr;
     }
-    if (prev != nullptr)
-    {
-        prev->~TagData();
-        std::free(prev);
-    }
-    m_next = nullptr;
+    m_index = 0;
+    m_used = 0;
+}
+
+const PacketTagList::TagData*
+PacketTagList::Head() const
+{
+    return reinterpret_cast<const TagData*>(GetData());
+}
+
+const PacketTagList::TagData*
+PacketTagList::End() const
+{
+    return reinterpret_cast<const TagData*>(GetData() + m_used);
+}
+
+const PacketTagList::TagData*
+PacketTagList::Next(const PacketTagList::TagData* data)
+{
+    return reinterpret_cast<const TagData*>(reinterpret_cast<const uint8_t*>(data) +
+                                            GetRecordSize(data->size));
+}
+
+uint32_t
+PacketTagList::GetRecordSize(uint32_t dataSize)
+{
+    return offsetof(TagData, data) + ((dataSize + 3) & (~3));
+}
+
+uint64_t
+PacketTagList::GetIndexBit(TypeId tid)
+{
+    return uint64_t(1) << (tid.GetUid() & 63);
+}
+
+uint8_t*
+PacketTagList::GetData() const
+{
+    return m_overflow != nullptr ? m_overflow->data : const_cast<uint8_t*>(m_inline);
 }
 
 } // namespace ns3
@@ -19,7 +19,12 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+thread_local uint64_t* Packet::m_uidCounter = nullptr;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -78,15 +83,17 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head,
+                                     const PacketTagList::TagData* end)
+    : m_current(head),
+      m_end(end)
 {
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_current != m_end;
 }
 
 PacketTagIterator::Item
@@ -94,7 +101,7 @@ PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
     const PacketTagList::TagData* prev = m_current;
-    m_current = m_current->next;
+    m_current = PacketTagList::Next(m_current);
     return PacketTagIterator::Item(prev);
 }
 
@@ -125,20 +132,31 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+uint64_t
+Packet::AllocateUid()
+{
+#ifdef NS3_MTP
+    if (m_uidCounter != nullptr)
+    {
+        return (*m_uidCounter)++;
+    }
+#endif
+    /* The upper 32 bits of the packet id in
+     * metadata is for the system id. For non-
+     * distributed simulations, this is simply
+     * zero.  The lower 32 bits are for the
+     * global UID
+     */
+    return static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++;
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -169,16 +187,18 @@ Packet::Packet(uint32_t size)
     : m_buffer(size),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
+      m_nixVector(nullptr)
+{
+}
+
+Packet::Packet(uint32_t size, Ptr<const PayloadGenerator> generator)
+    : m_buffer(size, generator),
+      m_byteTagList(),
+      m_packetTagList(),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -196,16 +216,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -397,6 +410,12 @@ Packet::CopyData(std::ostream* os, uint32_t size) const
     return m_buffer.CopyData(os, size);
 }
 
+uint32_t
+Packet::GetVirtualSize() const
+{
+    return m_buffer.GetVirtualSize();
+}
+
 uint64_t
 Packet::GetUid() const
 {
@@ -595,6 +614,14 @@ Packet::EnableChecking()
     PacketMetadata::EnableChecking();
 }
 
+#ifdef NS3_MTP
+void
+Packet::SetUidCounter(uint64_t* counter)
+{
+    m_uidCounter = counter;
+}
+#endif
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -1008,7 +1035,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList.Head(), m_packetTagList.End());
 }
 
 std::ostream&
@@ -14,6 +14,7 @@
 #include "nix-vector.h"
 #include "packet-metadata.h"
 #include "packet-tag-list.h"
+#include "payload-generator.h"
 #include "tag.h"
 #include "trailer.h"
 
@@ -24,6 +25,10 @@
 
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -170,9 +175,11 @@ class PacketTagIterator
     /**
      * Constructor
      * @param head head of the items
+     * @param end end of the items
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
+    PacketTagIterator(const PacketTagList::TagData* head, const PacketTagList::TagData* end);
     const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
+    const PacketTagList::TagData* m_end;     //!< end of the set of tags in a packet
 };
 
 /**
@@ -247,14 +254,27 @@ class Packet : public SimpleRefCount<Packet>
      * @brief Create a packet with a zero-filled payload.
      *
      * The memory necessary for the payload is not allocated:
-     * it will be allocated at any later point if you attempt
-     * to fragment this packet or to access the zero-filled
-     * bytes. The packet is allocated with a new uid (as
-     * returned by getUid).
+     * the payload is virtual, and it remains so when headers
+     * and trailers are added, or when the packet is fragmented
+     * or aggregated. Its bytes are only written in memory
+     * by Packet::CopyData or Packet::Serialize. The packet is
+     * allocated with a new uid (as returned by getUid).
      *
      * @param size the size of the zero-filled payload
      */
     Packet(uint32_t size);
+    /**
+     * @brief Create a packet with a virtual payload whose content
+     * is generated on demand.
+     *
+     * Like the zero-filled payload of Packet(uint32_t), the payload
+     * is not stored in memory: the generator writes its bytes only
+     * when they are read.
+     *
+     * @param size the size of the payload
+     * @param generator the generator of the content of the payload
+     */
+    Packet(uint32_t size, Ptr<const PayloadGenerator> generator);
     /**
      * @brief Create a new packet from the serialized buffer.
      *
@@ -297,6 +317,13 @@ class Packet : public SimpleRefCount<Packet>
      * @returns the size in bytes of the packet
      */
     inline uint32_t GetSize() const;
+    /**
+     * @brief Returns the number of bytes of the packet which are
+     * virtual, that is, which are not stored in memory.
+     *
+     * @returns the size in bytes of the virtual payload
+     */
+    uint32_t GetVirtualSize() const;
     /**
      * @brief Add header to this packet.
      *
@@ -526,6 +553,21 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+#ifdef NS3_MTP
+    /**
+     * @brief Set the counter allocating the uids of the packets created
+     * by the calling thread.
+     *
+     * A multithreaded simulator gives each partition its own counter, so
+     * that the packet uids do not depend on the interleaving of the
+     * threads. The upper 16 bits of the initial value of the counter
+     * should identify the partition.
+     *
+     * @param [in] counter The counter, or nullptr to use the global one.
+     */
+    static void SetUidCounter(uint64_t* counter);
+#endif
+
     /**
      * @brief Returns number of bytes required for packet
      * serialization.
@@ -784,7 +826,18 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+    /**
+     * @brief Allocate the uid of a new packet.
+     * @returns the packet uid
+     */
+    static uint64_t AllocateUid();
+
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid;    //!< Global counter of packets Uid
+    static thread_local uint64_t* m_uidCounter; //!< Packet Uid counter of the thread
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
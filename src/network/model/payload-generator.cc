@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "payload-generator.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PayloadGenerator");
+
+PayloadGenerator::~PayloadGenerator()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PatternPayloadGenerator::PatternPayloadGenerator(std::vector<uint8_t> pattern)
+    : m_pattern(std::move(pattern))
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!m_pattern.empty(), "The pattern must not be empty");
+}
+
+void
+PatternPayloadGenerator::Generate(uint8_t* buffer, uint32_t offset, uint32_t size) const
+{
+    NS_LOG_FUNCTION(this << &buffer << offset << size);
+    uint32_t start = offset % m_pattern.size();
+    while (size > 0)
+    {
+        uint32_t toCopy = std::min<uint32_t>(size, m_pattern.size() - start);
+        std::memcpy(buffer, m_pattern.data() + start, toCopy);
+        buffer += toCopy;
+        size -= toCopy;
+        start = 0;
+    }
+}
+
+} // namespace ns3
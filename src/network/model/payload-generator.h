@@ -0,0 +1,70 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PAYLOAD_GENERATOR_H
+#define PAYLOAD_GENERATOR_H
+
+#include "ns3/simple-ref-count.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ *
+ * @brief Content of the virtual payload of a packet.
+ *
+ * The payload of a Packet created with a size only is virtual: it is
+ * represented by its length, and its bytes, which are all zero, are
+ * never stored in memory. A PayloadGenerator gives another content to
+ * a virtual payload, without storing it either: the bytes are generated
+ * only when they are read, for instance by Packet::CopyData or by a
+ * Buffer::Iterator.
+ *
+ * The content must only depend on the offsets of the bytes in the
+ * original payload, which are preserved by fragmentation and
+ * aggregation.
+ */
+class PayloadGenerator : public SimpleRefCount<PayloadGenerator>
+{
+  public:
+    virtual ~PayloadGenerator();
+
+    /**
+     * Generate bytes of the payload.
+     *
+     * @param buffer the buffer to fill.
+     * @param offset the offset of the first byte in the original payload.
+     * @param size the number of bytes to generate.
+     */
+    virtual void Generate(uint8_t* buffer, uint32_t offset, uint32_t size) const = 0;
+};
+
+/**
+ * @ingroup packet
+ *
+ * @brief Virtual payload made of a repeated pattern of bytes.
+ */
+class PatternPayloadGenerator : public PayloadGenerator
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param pattern the bytes to repeat, which must not be empty.
+     */
+    PatternPayloadGenerator(std::vector<uint8_t> pattern);
+
+    void Generate(uint8_t* buffer, uint32_t offset, uint32_t size) const override;
+
+  private:
+    std::vector<uint8_t> m_pattern; //!< The bytes to repeat.
+};
+
+} // namespace ns3
+
+#endif /* PAYLOAD_GENERATOR_H */
@@ -8,9 +8,13 @@
 
 #include "ns3/buffer.h"
 #include "ns3/double.h"
+#include "ns3/payload-generator.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -378,6 +382,284 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer unit tests for the buffers scattered over several slices.
+ */
+class BufferSliceTest : public TestCase
+{
+  private:
+    /**
+     * Checks the buffer content with all the read methods
+     * @param b The buffer to check
+     * @param expected The bytes that should be in the buffer
+     * @param what The checked operation
+     */
+    void Check(const Buffer& b, const std::vector<uint8_t>& expected, std::string what);
+    /**
+     * Add bytes at the start of a buffer
+     * @param b The buffer
+     * @param expected The bytes of the buffer
+     * @param n The number of bytes to add
+     * @param first The value of the first byte, incremented for the next ones
+     */
+    void AddAtStart(Buffer& b, std::vector<uint8_t>& expected, uint32_t n, uint8_t first);
+    /**
+     * Add bytes at the end of a buffer
+     * @param b The buffer
+     * @param expected The bytes of the buffer
+     * @param n The number of bytes to add
+     * @param first The value of the first byte, incremented for the next ones
+     */
+    void AddAtEnd(Buffer& b, std::vector<uint8_t>& expected, uint32_t n, uint8_t first);
+
+  public:
+    void DoRun() override;
+    BufferSliceTest();
+};
+
+BufferSliceTest::BufferSliceTest()
+    : TestCase("Buffer slices")
+{
+}
+
+void
+BufferSliceTest::Check(const Buffer& b, const std::vector<uint8_t>& expected, std::string what)
+{
+    NS_TEST_ASSERT_MSG_EQ(b.GetSize(), expected.size(), what << ": bad size");
+
+    std::vector<uint8_t> copy(expected.size());
+    NS_TEST_ASSERT_MSG_EQ(b.CopyData(copy.data(), copy.size()),
+                          expected.size(),
+                          what << ": CopyData returned a bad size");
+    NS_TEST_EXPECT_MSG_EQ((copy == expected), true, what << ": bad bytes copied");
+
+    std::vector<uint8_t> read;
+    for (Buffer::Iterator i = b.Begin(); !i.IsEnd();)
+    {
+        read.push_back(i.ReadU8());
+    }
+    NS_TEST_EXPECT_MSG_EQ((read == expected), true, what << ": bad bytes read");
+
+    read.clear();
+    Buffer::Iterator i = b.Begin();
+    while (i.GetRemainingSize() >= 4)
+    {
+        uint32_t v = i.ReadNtohU32();
+        read.insert(read.end(), {uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v)});
+    }
+    while (!i.IsEnd())
+    {
+        read.push_back(i.ReadU8());
+    }
+    NS_TEST_EXPECT_MSG_EQ((read == expected), true, what << ": bad 32 bit words read");
+
+    read.clear();
+    for (i = b.End(); !i.IsStart();)
+    {
+        i.Prev();
+        read.insert(read.begin(), i.PeekU8());
+    }
+    NS_TEST_EXPECT_MSG_EQ((read == expected), true, what << ": bad bytes read backward");
+
+    uint32_t size = b.GetSerializedSize();
+    std::vector<uint8_t> serialized(size);
+    NS_TEST_ASSERT_MSG_EQ(b.Serialize(serialized.data(), size), true, what << ": no serialization");
+    Buffer deserialized(0, false);
+    deserialized.Deserialize(serialized.data(), size + 4);
+    NS_TEST_ASSERT_MSG_EQ(deserialized.GetSize(), expected.size(), what << ": bad deserialization");
+    deserialized.CopyData(copy.data(), copy.size());
+    NS_TEST_EXPECT_MSG_EQ((copy == expected), true, what << ": bad bytes deserialized");
+
+    if (!expected.empty())
+    {
+        Buffer gathered = b;
+        const uint8_t* data = gathered.PeekData();
+        NS_TEST_EXPECT_MSG_EQ(std::equal(expected.begin(), expected.end(), data),
+                              true,
+                              what << ": bad bytes peeked");
+    }
+}
+
+void
+BufferSliceTest::AddAtStart(Buffer& b, std::vector<uint8_t>& expected, uint32_t n, uint8_t first)
+{
+    b.AddAtStart(n);
+    Buffer::Iterator i = b.Begin();
+    for (uint32_t j = 0; j < n; j++)
+    {
+        i.WriteU8(first + j);
+    }
+    for (uint32_t j = n; j > 0; j--)
+    {
+        expected.insert(expected.begin(), first + j - 1);
+    }
+}
+
+void
+BufferSliceTest::AddAtEnd(Buffer& b, std::vector<uint8_t>& expected, uint32_t n, uint8_t first)
+{
+    b.AddAtEnd(n);
+    Buffer::Iterator i = b.End();
+    i.Prev(n);
+    for (uint32_t j = 0; j < n; j++)
+    {
+        i.WriteU8(first + j);
+        expected.push_back(first + j);
+    }
+}
+
+void
+BufferSliceTest::DoRun()
+{
+    // Fragment a buffer and put the fragments back together
+    Buffer original;
+    std::vector<uint8_t> originalBytes;
+    AddAtStart(original, originalBytes, 3000, 1);
+    Buffer reassembled;
+    for (uint32_t offset = 0; offset < 3000; offset += 700)
+    {
+        uint32_t size = std::min<uint32_t>(700, 3000 - offset);
+        reassembled.AddAtEnd(original.CreateFragment(offset, size));
+    }
+    Check(reassembled, originalBytes, "reassembly");
+
+    // Add a header to each fragment, then aggregate the fragments
+    Buffer aggregate;
+    std::vector<uint8_t> aggregateBytes;
+    for (uint32_t offset = 0; offset < 3000; offset += 700)
+    {
+        uint32_t size = std::min<uint32_t>(700, 3000 - offset);
+        Buffer fragment = original.CreateFragment(offset, size);
+        std::vector<uint8_t> fragmentBytes(originalBytes.begin() + offset,
+                                           originalBytes.begin() + offset + size);
+        AddAtStart(fragment, fragmentBytes, 3, 0xa0);
+        AddAtEnd(fragment, fragmentBytes, 2, 0xb0);
+        Check(fragment, fragmentBytes, "fragment");
+        aggregate.AddAtEnd(fragment);
+        aggregateBytes.insert(aggregateBytes.end(), fragmentBytes.begin(), fragmentBytes.end());
+        Check(aggregate, aggregateBytes, "aggregation");
+    }
+    Check(original, originalBytes, "original after aggregation");
+
+    // Add and remove bytes at both ends of a buffer with several slices
+    Buffer copy = aggregate;
+    std::vector<uint8_t> copyBytes = aggregateBytes;
+    AddAtStart(copy, copyBytes, 300, 0x10);
+    AddAtEnd(copy, copyBytes, 300, 0x20);
+    Check(copy, copyBytes, "addition to slices");
+    Check(aggregate, aggregateBytes, "copy of slices");
+    copy.RemoveAtStart(1000);
+    copyBytes.erase(copyBytes.begin(), copyBytes.begin() + 1000);
+    copy.RemoveAtEnd(1000);
+    copyBytes.resize(copyBytes.size() - 1000);
+    Check(copy, copyBytes, "removal from slices");
+    Buffer fragment = aggregate.CreateFragment(650, 800);
+    Check(fragment,
+          std::vector<uint8_t>(aggregateBytes.begin() + 650, aggregateBytes.begin() + 1450),
+          "fragment of slices");
+
+    // Write through an iterator over a slice boundary
+    Buffer target;
+    target.AddAtStart(aggregate.GetSize());
+    target.Begin().Write(aggregate.Begin(), aggregate.End());
+    Check(target, aggregateBytes, "iterator copy of slices");
+    Buffer::Iterator i = aggregate.Begin();
+    i.Next(703);
+    i.WriteHtonU32(0x01020304);
+    for (uint8_t j = 0; j < 4; j++)
+    {
+        aggregateBytes[703 + j] = j + 1;
+    }
+    Check(aggregate, aggregateBytes, "write over a slice boundary");
+
+    // Append a buffer with a zero area to a buffer ending with a zero area
+    Buffer zeros(10);
+    std::vector<uint8_t> zerosBytes(10);
+    Buffer other(20);
+    std::vector<uint8_t> otherBytes(20);
+    AddAtEnd(other, otherBytes, 4, 0x30);
+    zeros.AddAtEnd(other);
+    zerosBytes.insert(zerosBytes.end(), otherBytes.begin(), otherBytes.end());
+    Check(zeros, zerosBytes, "zero area aggregation");
+
+    // Random operations
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    const uint32_t nBuffers = 4;
+    std::vector<Buffer> buffers(nBuffers);
+    std::vector<std::vector<uint8_t>> bytes(nBuffers);
+    for (uint32_t step = 0; step < 2000; step++)
+    {
+        uint32_t k = rng->GetInteger(0, nBuffers - 1);
+        uint32_t o = rng->GetInteger(0, nBuffers - 1);
+        uint32_t n = rng->GetInteger(0, rng->GetInteger(0, 1) ? 40 : 600);
+        uint32_t size = bytes[k].size();
+        uint8_t first = step;
+        switch (rng->GetInteger(0, 6))
+        {
+        case 0:
+            AddAtStart(buffers[k], bytes[k], n, first);
+            break;
+        case 1:
+            AddAtEnd(buffers[k], bytes[k], n, first);
+            break;
+        case 2:
+            n = std::min(n, size);
+            buffers[k].RemoveAtStart(n);
+            bytes[k].erase(bytes[k].begin(), bytes[k].begin() + n);
+            break;
+        case 3:
+            n = std::min(n, size);
+            buffers[k].RemoveAtEnd(n);
+            bytes[k].resize(size - n);
+            break;
+        case 4: {
+            Buffer otherBuffer = buffers[o];
+            std::vector<uint8_t> otherBytes = bytes[o];
+            buffers[k].AddAtEnd(otherBuffer);
+            bytes[k].insert(bytes[k].end(), otherBytes.begin(), otherBytes.end());
+            break;
+        }
+        case 5: {
+            uint32_t start = rng->GetInteger(0, bytes[o].size());
+            uint32_t length = rng->GetInteger(0, bytes[o].size() - start);
+            buffers[k] = buffers[o].CreateFragment(start, length);
+            bytes[k].assign(bytes[o].begin() + start, bytes[o].begin() + start + length);
+            break;
+        }
+        case 6:
+            if (rng->GetInteger(0, 1))
+            {
+                buffers[k] = Buffer(n);
+                bytes[k].assign(n, 0);
+            }
+            else
+            {
+                std::vector<uint8_t> pattern{first, 1, 2, 3, 5, 8, 13};
+                buffers[k] = Buffer(n, Create<PatternPayloadGenerator>(pattern));
+                bytes[k].resize(n);
+                for (uint32_t j = 0; j < n; j++)
+                {
+                    bytes[k][j] = pattern[j % pattern.size()];
+                }
+            }
+            break;
+        }
+        if (bytes[k].size() > 10000)
+        {
+            buffers[k].RemoveAtStart(bytes[k].size() - 5000);
+            bytes[k].erase(bytes[k].begin(), bytes[k].end() - 5000);
+        }
+        for (uint32_t j = 0; j < nBuffers; j++)
+        {
+            Check(buffers[j], bytes[j], "random operation " + std::to_string(step));
+        }
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -394,6 +676,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferSliceTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -7,6 +7,7 @@
  */
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
+#include "ns3/payload-generator.h"
 #include "ns3/test.h"
 
 #include <cstdarg>
@@ -14,7 +15,9 @@
 #include <iomanip>
 #include <iostream>
 #include <limits> // std:numeric_limits
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -1257,6 +1260,230 @@ PacketTagListTest::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet tag storage unit tests: moves between the inline and the
+ * overflow buffers, and copy-on-write of the overflow buffer.
+ */
+class PacketTagListStorageTest : public TestCase
+{
+  public:
+    PacketTagListStorageTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Checks a tag of a list
+     * @param ptl The list
+     * @param t The tag type to look for
+     * @param data The expected tag data, or -1 if the tag should be missing
+     * @param msg Message
+     */
+    void Check(const PacketTagList& ptl, ATestTagBase&& t, int data, std::string msg);
+};
+
+PacketTagListStorageTest::PacketTagListStorageTest()
+    : TestCase("PacketTagList inline and overflow storage")
+{
+}
+
+void
+PacketTagListStorageTest::Check(const PacketTagList& ptl,
+                                ATestTagBase&& t,
+                                int data,
+                                std::string msg)
+{
+    bool found = ptl.Peek(t);
+    NS_TEST_EXPECT_MSG_EQ(found, data >= 0, msg << ": bad presence of " << t.GetInstanceTypeId());
+    if (found)
+    {
+        NS_TEST_EXPECT_MSG_EQ(t.m_error,
+                              false,
+                              msg << ": bad content of " << t.GetInstanceTypeId());
+        NS_TEST_EXPECT_MSG_EQ(t.GetData(), data, msg << ": bad data of " << t.GetInstanceTypeId());
+    }
+}
+
+void
+PacketTagListStorageTest::DoRun()
+{
+    // Two small tags fit in the inline buffer
+    PacketTagList a;
+    a.Add(ATestTag<10>(1));
+    a.Add(ATestTag<11>(2));
+
+    // A large one does not
+    PacketTagList b = a;
+    b.Add(ATestTag<40>(3));
+    Check(a, ATestTag<40>(), -1, "a after b add");
+    Check(b, ATestTag<10>(), 1, "b after b add");
+    Check(b, ATestTag<11>(), 2, "b after b add");
+    Check(b, ATestTag<40>(), 3, "b after b add");
+
+    // Copies share the overflow buffer until one of them changes
+    PacketTagList c = b;
+    ATestTag<40> t40;
+    NS_TEST_EXPECT_MSG_EQ(c.Remove(t40), true, "c remove");
+    NS_TEST_EXPECT_MSG_EQ(t40.GetData(), 3, "c remove");
+    Check(c, ATestTag<40>(), -1, "c after c remove");
+    Check(c, ATestTag<10>(), 1, "c after c remove");
+    Check(b, ATestTag<40>(), 3, "b after c remove");
+
+    ATestTag<10> t10(7);
+    NS_TEST_EXPECT_MSG_EQ(b.Replace(t10), true, "b replace");
+    Check(b, ATestTag<10>(), 7, "b after b replace");
+    Check(c, ATestTag<10>(), 1, "c after b replace");
+    Check(a, ATestTag<10>(), 1, "a after b replace");
+
+    // Grow the overflow buffer, and shrink back to the inline buffer
+    PacketTagList d = b;
+    d.Add(ATestTag<100>(4));
+    d.Add(ATestTag<200>(5));
+    ATestTag<20> t20(6);
+    NS_TEST_EXPECT_MSG_EQ(d.Replace(t20), false, "d replace missing tag");
+    Check(d, ATestTag<20>(), 6, "d after d replace");
+    Check(d, ATestTag<200>(), 5, "d after d add");
+    Check(b, ATestTag<200>(), -1, "b after d add");
+    ATestTag<200> t200;
+    ATestTag<100> t100;
+    NS_TEST_EXPECT_MSG_EQ(d.Remove(t200), true, "d remove");
+    NS_TEST_EXPECT_MSG_EQ(d.Remove(t100), true, "d remove");
+    NS_TEST_EXPECT_MSG_EQ(d.Remove(t40), true, "d remove");
+    NS_TEST_EXPECT_MSG_EQ(d.Remove(t40), false, "d remove missing tag");
+    Check(d, ATestTag<10>(), 7, "d after d remove");
+    Check(d, ATestTag<11>(), 2, "d after d remove");
+    Check(d, ATestTag<20>(), 6, "d after d remove");
+    Check(b, ATestTag<40>(), 3, "b after d remove");
+
+    // The records are visited most recent first
+    std::vector<TypeId> tids;
+    for (auto cur = b.Head(); cur != b.End(); cur = PacketTagList::Next(cur))
+    {
+        tids.push_back(cur->tid);
+    }
+    std::vector<TypeId> expected{ATestTag<40>::GetTypeId(),
+                                 ATestTag<11>::GetTypeId(),
+                                 ATestTag<10>::GetTypeId()};
+    NS_TEST_EXPECT_MSG_EQ((tids == expected), true, "b records");
+
+    // Serialization
+    uint32_t size = b.GetSerializedSize();
+    std::vector<uint32_t> buffer(size / 4);
+    NS_TEST_ASSERT_MSG_EQ(b.Serialize(buffer.data(), size), 1, "b serialization");
+    PacketTagList e;
+    NS_TEST_ASSERT_MSG_EQ(e.Deserialize(buffer.data(), size + 4), 1, "b deserialization");
+    Check(e, ATestTag<10>(), 7, "e after deserialization");
+    Check(e, ATestTag<11>(), 2, "e after deserialization");
+    Check(e, ATestTag<40>(), 3, "e after deserialization");
+
+    a.RemoveAll();
+    b.RemoveAll();
+    Check(a, ATestTag<11>(), -1, "a after remove all");
+    Check(b, ATestTag<11>(), -1, "b after remove all");
+    Check(c, ATestTag<11>(), 2, "c after remove all");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet virtual payload unit tests.
+ */
+class PacketVirtualPayloadTest : public TestCase
+{
+  public:
+    PacketVirtualPayloadTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Checks the content of a packet
+     * @param p The packet
+     * @param expected The expected bytes
+     * @param msg Message
+     */
+    void CheckContent(Ptr<const Packet> p, const std::vector<uint8_t>& expected, std::string msg);
+};
+
+PacketVirtualPayloadTest::PacketVirtualPayloadTest()
+    : TestCase("Packet virtual payload")
+{
+}
+
+void
+PacketVirtualPayloadTest::CheckContent(Ptr<const Packet> p,
+                                       const std::vector<uint8_t>& expected,
+                                       std::string msg)
+{
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), expected.size(), msg << ": bad size");
+    std::vector<uint8_t> bytes(expected.size());
+    p->CopyData(bytes.data(), bytes.size());
+    NS_TEST_EXPECT_MSG_EQ((bytes == expected), true, msg << ": bad content");
+    std::ostringstream oss;
+    p->CopyData(&oss, p->GetSize());
+    NS_TEST_EXPECT_MSG_EQ((oss.str() == std::string(expected.begin(), expected.end())),
+                          true,
+                          msg << ": bad content written to a stream");
+}
+
+void
+PacketVirtualPayloadTest::DoRun()
+{
+    const uint32_t size = 10000;
+    Ptr<Packet> zeros = Create<Packet>(size);
+    NS_TEST_EXPECT_MSG_EQ(zeros->GetVirtualSize(), size, "The payload should be virtual");
+    zeros->AddHeader(ATestHeader<20>());
+    NS_TEST_EXPECT_MSG_EQ(zeros->GetVirtualSize(), size, "The header should not be virtual");
+
+    std::vector<uint8_t> pattern{1, 2, 3, 5, 8, 13, 21};
+    Ptr<Packet> p = Create<Packet>(size, Create<PatternPayloadGenerator>(pattern));
+    std::vector<uint8_t> expected(size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        expected[i] = pattern[i % pattern.size()];
+    }
+    NS_TEST_EXPECT_MSG_EQ(p->GetVirtualSize(), size, "The payload should be virtual");
+    CheckContent(p, expected, "generated payload");
+
+    // Fragment the packet, then reassemble it
+    p->AddHeader(ATestHeader<20>());
+    expected.insert(expected.begin(), 20, 20);
+    const uint32_t mtu = 1400;
+    Ptr<Packet> reassembled = Create<Packet>();
+    for (uint32_t offset = 0; offset < p->GetSize(); offset += mtu)
+    {
+        Ptr<Packet> fragment = p->CreateFragment(offset, std::min(mtu, p->GetSize() - offset));
+        fragment->AddHeader(ATestHeader<8>());
+        CheckContent(
+            fragment->CreateFragment(8, fragment->GetSize() - 8),
+            std::vector<uint8_t>(expected.begin() + offset,
+                                 expected.begin() + offset + fragment->GetSize() - 8),
+            "fragment at " + std::to_string(offset));
+
+        ATestHeader<8> header;
+        fragment->RemoveHeader(header);
+        NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Bad fragment header");
+        reassembled->AddAtEnd(fragment);
+    }
+    NS_TEST_EXPECT_MSG_EQ(reassembled->GetVirtualSize(), size, "The payload should be virtual");
+    CheckContent(reassembled, expected, "reassembled packet");
+    ATestHeader<20> header;
+    reassembled->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Bad packet header");
+
+    // The serialized packet holds the generated bytes
+    uint32_t serializedSize = p->GetSerializedSize();
+    std::vector<uint8_t> serialized(serializedSize);
+    NS_TEST_ASSERT_MSG_EQ(p->Serialize(serialized.data(), serializedSize),
+                          1,
+                          "Packet serialization failed");
+    Ptr<Packet> deserialized = Create<Packet>(serialized.data(), serializedSize, true);
+    NS_TEST_EXPECT_MSG_EQ(deserialized->GetVirtualSize(), 0, "The payload should be real");
+    CheckContent(deserialized, expected, "deserialized packet");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1501,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketTagListStorageTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketVirtualPayloadTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
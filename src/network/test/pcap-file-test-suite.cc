@@ -4,15 +4,28 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
+#include "ns3/output-stream-wrapper.h"
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
+#include "ns3/trace-file-stream.h"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
+
+#ifndef __WIN32__
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace ns3;
 
@@ -1364,6 +1377,252 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * Copy the packets of a pcap file to another one.
+ *
+ * @param from The name of the file read.
+ * @param to The name of the file written.
+ * @param pcapng Whether the file written is in the pcapng format.
+ * @returns true if the packets were copied.
+ */
+static bool
+CopyPcapFile(const std::string& from, const std::string& to, bool pcapng)
+{
+    PcapFile in;
+    PcapFile out;
+    in.Open(from, std::ios::in);
+    out.Open(to, std::ios::out);
+    out.Init(in.GetDataLinkType(), in.GetSnapLen(), in.GetTimeZoneOffset(), false, false, pcapng);
+    if (in.Fail() || out.Fail())
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(in.GetSnapLen());
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+    uint32_t readLen;
+    while (true)
+    {
+        in.Read(data.data(), data.size(), tsSec, tsUsec, inclLen, origLen, readLen);
+        if (in.Fail())
+        {
+            break;
+        }
+        out.Write(tsSec, tsUsec, data.data(), readLen);
+    }
+    bool copied = in.Eof() && !out.Fail();
+    out.Close();
+    return copied && !out.Fail();
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the pcapng files are written and read
+ * back like the pcap files.
+ */
+class PcapNgTestCase : public TestCase
+{
+  public:
+    PcapNgTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapNgTestCase::PcapNgTestCase()
+    : TestCase("Check that PcapFile writes and reads pcapng files")
+{
+}
+
+void
+PcapNgTestCase::DoRun()
+{
+    std::string filename = CreateDataDirFilename("known.pcap");
+    std::string ngFilename = CreateTempDirFilename("known.pcapng");
+    NS_TEST_ASSERT_MSG_EQ(CopyPcapFile(filename, ngFilename, true),
+                          true,
+                          "Copy of " << filename << " to a pcapng file failed");
+
+    PcapFile known;
+    PcapFile f;
+    known.Open(filename, std::ios::in);
+    f.Open(ngFilename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << ngFilename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ(f.IsPcapNg(), true, "The file should be in the pcapng format");
+    NS_TEST_EXPECT_MSG_EQ(known.IsPcapNg(), false, "The file should be in the pcap format");
+    NS_TEST_EXPECT_MSG_EQ(f.GetDataLinkType(), known.GetDataLinkType(), "Bad data link type");
+    NS_TEST_EXPECT_MSG_EQ(f.GetSnapLen(), known.GetSnapLen(), "Bad snap length");
+    NS_TEST_EXPECT_MSG_EQ(f.IsNanoSecMode(), false, "Bad timestamp resolution");
+    f.Close();
+
+    uint32_t sec(0);
+    uint32_t usec(0);
+    uint32_t packets(0);
+    bool diff = PcapFile::Diff(filename, ngFilename, sec, usec, packets);
+    NS_TEST_EXPECT_MSG_EQ(diff, false, "The pcapng file should hold the same packets");
+    NS_TEST_EXPECT_MSG_EQ(packets, N_KNOWN_PACKETS, "Bad number of packets");
+    remove(ngFilename.c_str());
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the trace files written by a background
+ * thread hold the same data.
+ */
+class AsynchronousTraceFileTestCase : public TestCase
+{
+  public:
+    AsynchronousTraceFileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AsynchronousTraceFileTestCase::AsynchronousTraceFileTestCase()
+    : TestCase("Check the trace files written by a background thread")
+{
+}
+
+void
+AsynchronousTraceFileTestCase::DoRun()
+{
+    Config::SetGlobal("TraceFileAsynchronous", BooleanValue(true));
+    NS_TEST_ASSERT_MSG_EQ(TraceFileStream::IsAsynchronous(), true, "Asynchronous files expected");
+
+    std::string filename = CreateDataDirFilename("known.pcap");
+    std::string asyncFilename = CreateTempDirFilename("async.pcap");
+    NS_TEST_ASSERT_MSG_EQ(CopyPcapFile(filename, asyncFilename, false),
+                          true,
+                          "Copy of " << filename << " failed");
+    uint32_t sec(0);
+    uint32_t usec(0);
+    uint32_t packets(0);
+    bool diff = PcapFile::Diff(filename, asyncFilename, sec, usec, packets);
+    NS_TEST_EXPECT_MSG_EQ(diff, false, "The file should hold the same packets");
+    remove(asyncFilename.c_str());
+
+    // Lines spanning many blocks, flushed one by one
+    std::string asciiFilename = CreateTempDirFilename("async.tr");
+    const uint32_t lines = 20000;
+    {
+        auto stream = Create<OutputStreamWrapper>(asciiFilename, std::ios::out);
+        for (uint32_t i = 0; i < lines; i++)
+        {
+            *stream->GetStream() << "+ " << i << " line of an ASCII trace" << std::endl;
+        }
+    }
+    std::ifstream ascii(asciiFilename);
+    std::string line;
+    uint32_t read = 0;
+    while (std::getline(ascii, line))
+    {
+        NS_TEST_ASSERT_MSG_EQ(line,
+                              "+ " + std::to_string(read) + " line of an ASCII trace",
+                              "Bad line " << read);
+        read++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(read, lines, "Bad number of lines");
+    ascii.close();
+    remove(asciiFilename.c_str());
+
+    if (TraceFileStream::IsCompressionSupported(TraceFileStream::GZIP))
+    {
+        Config::SetGlobal("TraceFileCompression", EnumValue(TraceFileStream::GZIP));
+        std::string gzipFilename = CreateTempDirFilename("async.pcap.gz");
+        NS_TEST_ASSERT_MSG_EQ(CopyPcapFile(filename, gzipFilename, false),
+                              true,
+                              "Copy of " << filename << " failed");
+        std::ifstream gzip(gzipFilename, std::ios::binary);
+        unsigned char magic[2] = {0, 0};
+        gzip.read(reinterpret_cast<char*>(magic), sizeof(magic));
+        NS_TEST_EXPECT_MSG_EQ((magic[0] == 0x1f && magic[1] == 0x8b),
+                              true,
+                              "The file should be compressed in the gzip format");
+        gzip.close();
+        remove(gzipFilename.c_str());
+        Config::SetGlobal("TraceFileCompression", EnumValue(TraceFileStream::NONE));
+    }
+    Config::SetGlobal("TraceFileAsynchronous", BooleanValue(false));
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that a process forked after trace files
+ * were written by a background thread can write its own trace files.
+ */
+class ForkedTraceFileTestCase : public TestCase
+{
+  public:
+    ForkedTraceFileTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ForkedTraceFileTestCase::ForkedTraceFileTestCase()
+    : TestCase("Check the trace files written by a background thread after a fork")
+{
+}
+
+void
+ForkedTraceFileTestCase::DoRun()
+{
+#ifndef __WIN32__
+    // Start the writer thread of this process, and keep streams open across the fork
+    std::string parentFilename = CreateTempDirFilename("parent.tr");
+    std::string sharedFilename = CreateTempDirFilename("shared.tr");
+    std::string childFilename = CreateTempDirFilename("child.tr");
+    TraceFileStream parent(parentFilename, std::ios::out);
+    TraceFileStream shared(sharedFilename, std::ios::out);
+    parent << "parent" << std::endl;
+    shared << "shared" << std::endl;
+    shared.Flush();
+
+    pid_t pid = fork();
+    NS_TEST_ASSERT_MSG_NE(pid, -1, "Cannot fork: " << std::strerror(errno));
+    if (pid == 0)
+    {
+        // Fail instead of blocking forever if the writer thread is missing
+        alarm(10);
+        TraceFileStream child(childFilename, std::ios::out);
+        child << "child" << std::endl;
+        child.Close();
+        // The block flushed by the parent is not waited for
+        shared.Close();
+        _exit(child.fail() || shared.fail() ? 1 : 0);
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+    NS_TEST_EXPECT_MSG_EQ((WIFEXITED(status) && WEXITSTATUS(status) == 0),
+                          true,
+                          "The forked process could not write its trace files");
+    parent.Close();
+    shared.Close();
+
+    std::string line;
+    std::ifstream parentFile(parentFilename);
+    std::getline(parentFile, line);
+    NS_TEST_EXPECT_MSG_EQ(line, "parent", "Bad trace file written by the parent");
+    std::ifstream childFile(childFilename);
+    std::getline(childFile, line);
+    NS_TEST_EXPECT_MSG_EQ(line, "child", "Bad trace file written by the forked process");
+    remove(parentFilename.c_str());
+    remove(sharedFilename.c_str());
+    remove(childFilename.c_str());
+#endif
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1646,9 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PcapNgTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new AsynchronousTraceFileTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ForkedTraceFileTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -62,6 +62,11 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
   public:
     /**
      * Constructor
+     *
+     * The file is written by a background thread through a TraceFileStream
+     * if the \ref GlobalValueTraceFileAsynchronous "TraceFileAsynchronous"
+     * global value is true.
+     *
      * @param filename file name
      * @param filemode std::ios::openmode flags
      */
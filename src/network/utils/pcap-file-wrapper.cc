@@ -37,6 +37,12 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("PcapNg",
+                          "Whether the file is written in the pcapng format instead of the "
+                          "pcap format.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_pcapng),
                           MakeBooleanChecker());
     return tid;
 }
@@ -98,11 +104,11 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     NS_LOG_FUNCTION(this << dataLinkType << snapLen << tzCorrection);
     if (snapLen != std::numeric_limits<uint32_t>::max())
     {
-        m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
+        m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode, m_pcapng);
     }
     else
     {
-        m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
+        m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode, m_pcapng);
     }
 }
 
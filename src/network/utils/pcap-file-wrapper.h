@@ -214,6 +214,7 @@ class PcapFileWrapper : public Object
     PcapFile m_file;    //!< Pcap file
     uint32_t m_snapLen; //!< max length of saved packets
     bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    bool m_pcapng;      //!< File in the pcapng format
 };
 
 } // namespace ns3
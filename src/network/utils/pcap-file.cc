@@ -40,10 +40,35 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+const uint32_t NG_SECTION_HEADER = 0x0a0d0d0a; /**< Type of a pcapng Section Header Block */
+const uint32_t NG_INTERFACE = 0x00000001; /**< Type of a pcapng Interface Description Block */
+const uint32_t NG_ENHANCED_PACKET = 0x00000006; /**< Type of a pcapng Enhanced Packet Block */
+const uint32_t NG_BYTE_ORDER_MAGIC = 0x1a2b3c4d; /**< Byte order magic of a pcapng section */
+const uint16_t NG_VERSION_MAJOR = 1; /**< Major version of supported pcapng file format */
+const uint16_t NG_VERSION_MINOR = 0; /**< Minor version of supported pcapng file format */
+const uint16_t NG_OPTION_END = 0;    /**< Code of the end of the options of a pcapng block */
+const uint16_t NG_OPTION_TSRESOL = 9; /**< Code of the if_tsresol option of a pcapng block */
+
+/**
+ * Write a value to a stream, in the byte order of the system.
+ *
+ * @tparam T \deduced The type of the value.
+ * @param out The stream.
+ * @param value The value.
+ */
+template <typename T>
+static void
+WriteValue(std::ostream* out, T value)
+{
+    out->write((const char*)&value, sizeof(value));
+}
+
 PcapFile::PcapFile()
     : m_file(),
+      m_out(&m_file),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_pcapng(false)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -60,7 +85,7 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
-    return m_file.fail();
+    return m_out->fail();
 }
 
 bool
@@ -74,13 +99,25 @@ void
 PcapFile::Clear()
 {
     NS_LOG_FUNCTION(this);
-    m_file.clear();
+    m_out->clear();
 }
 
 void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_async)
+    {
+        FatalImpl::UnregisterStream(m_async.get());
+        m_async->Close();
+        if (m_async->fail())
+        {
+            m_file.setstate(std::ios::failbit);
+        }
+        m_async.reset();
+        m_out = &m_file;
+        return;
+    }
     m_file.close();
 }
 
@@ -147,6 +184,13 @@ PcapFile::IsNanoSecMode()
     return m_nanosecMode;
 }
 
+bool
+PcapFile::IsPcapNg()
+{
+    NS_LOG_FUNCTION(this);
+    return m_pcapng;
+}
+
 uint8_t
 PcapFile::Swap(uint8_t val)
 {
@@ -198,9 +242,44 @@ PcapFile::WriteFileHeader()
     NS_LOG_FUNCTION(this);
     //
     // If we're initializing the file, we need to write the pcap file header
-    // at the start of the file.
+    // at the start of the file.  A file written by a background thread was
+    // just created, and cannot seek.
     //
-    m_file.seekp(0, std::ios::beg);
+    if (!m_async)
+    {
+        m_file.seekp(0, std::ios::beg);
+    }
+
+    if (m_pcapng)
+    {
+        //
+        // A Section Header Block of unspecified length, without options
+        //
+        WriteValue(m_out, NG_SECTION_HEADER);
+        WriteValue(m_out, uint32_t(28));
+        WriteValue(m_out, NG_BYTE_ORDER_MAGIC);
+        WriteValue(m_out, NG_VERSION_MAJOR);
+        WriteValue(m_out, NG_VERSION_MINOR);
+        WriteValue(m_out, int64_t(-1));
+        WriteValue(m_out, uint32_t(28));
+
+        //
+        // The Interface Description Block of the packets, with the resolution
+        // of their timestamps
+        //
+        WriteValue(m_out, NG_INTERFACE);
+        WriteValue(m_out, uint32_t(32));
+        WriteValue(m_out, uint16_t(m_fileHeader.m_type));
+        WriteValue(m_out, uint16_t(0));
+        WriteValue(m_out, m_fileHeader.m_snapLen);
+        WriteValue(m_out, NG_OPTION_TSRESOL);
+        WriteValue(m_out, uint16_t(1));
+        WriteValue(m_out, uint32_t(m_nanosecMode ? 9 : 6)); // value and padding
+        WriteValue(m_out, NG_OPTION_END);
+        WriteValue(m_out, uint16_t(0));
+        WriteValue(m_out, uint32_t(32));
+        return;
+    }
 
     //
     // We have the ability to write out the pcap file header in a foreign endian
@@ -228,13 +307,13 @@ PcapFile::WriteFileHeader()
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
     //
-    m_file.write((const char*)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
-    m_file.write((const char*)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
-    m_file.write((const char*)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
-    m_file.write((const char*)&headerOut->m_zone, sizeof(headerOut->m_zone));
-    m_file.write((const char*)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
-    m_file.write((const char*)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
-    m_file.write((const char*)&headerOut->m_type, sizeof(headerOut->m_type));
+    m_out->write((const char*)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
+    m_out->write((const char*)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
+    m_out->write((const char*)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
+    m_out->write((const char*)&headerOut->m_zone, sizeof(headerOut->m_zone));
+    m_out->write((const char*)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
+    m_out->write((const char*)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
+    m_out->write((const char*)&headerOut->m_type, sizeof(headerOut->m_type));
 }
 
 void
@@ -251,6 +330,11 @@ PcapFile::ReadAndVerifyFileHeader()
     // them all individually.
     //
     m_file.read((char*)&m_fileHeader.m_magicNumber, sizeof(m_fileHeader.m_magicNumber));
+    if (m_fileHeader.m_magicNumber == NG_SECTION_HEADER)
+    {
+        ReadAndVerifyNgHeader();
+        return;
+    }
     m_file.read((char*)&m_fileHeader.m_versionMajor, sizeof(m_fileHeader.m_versionMajor));
     m_file.read((char*)&m_fileHeader.m_versionMinor, sizeof(m_fileHeader.m_versionMinor));
     m_file.read((char*)&m_fileHeader.m_zone, sizeof(m_fileHeader.m_zone));
@@ -316,6 +400,118 @@ PcapFile::ReadAndVerifyFileHeader()
     }
 }
 
+template <typename T>
+void
+PcapFile::ReadNg(T& value)
+{
+    m_file.read((char*)&value, sizeof(value));
+    if (m_swapMode)
+    {
+        if constexpr (sizeof(T) == 2)
+        {
+            value = Swap(uint16_t(value));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            value = Swap(uint32_t(value));
+        }
+    }
+}
+
+void
+PcapFile::ReadAndVerifyNgHeader()
+{
+    NS_LOG_FUNCTION(this);
+    m_pcapng = true;
+
+    //
+    // The byte order magic tells whether the blocks of the section are
+    // swapped, including the length of the Section Header Block
+    //
+    uint32_t length;
+    uint32_t byteOrderMagic;
+    m_file.read((char*)&length, sizeof(length));
+    m_file.read((char*)&byteOrderMagic, sizeof(byteOrderMagic));
+    m_swapMode = (byteOrderMagic == Swap(NG_BYTE_ORDER_MAGIC));
+    if (m_swapMode)
+    {
+        length = Swap(length);
+    }
+    m_fileHeader.m_zone = 0;
+    m_fileHeader.m_sigFigs = 0;
+    ReadNg(m_fileHeader.m_versionMajor);
+    ReadNg(m_fileHeader.m_versionMinor);
+    if (m_file.fail() || (byteOrderMagic != NG_BYTE_ORDER_MAGIC && !m_swapMode) ||
+        m_fileHeader.m_versionMajor != NG_VERSION_MAJOR || length < 28)
+    {
+        m_file.setstate(std::ios::failbit);
+        m_file.close();
+        return;
+    }
+    // Skip the section length and the options
+    m_file.seekg(length - 16, std::ios::cur);
+
+    //
+    // The first interface gives the data link type and the resolution of the
+    // timestamps of the file
+    //
+    uint32_t type;
+    ReadNg(type);
+    ReadNg(length);
+    uint16_t linkType;
+    uint16_t reserved;
+    ReadNg(linkType);
+    ReadNg(reserved);
+    ReadNg(m_fileHeader.m_snapLen);
+    if (m_file.fail() || type != NG_INTERFACE || length < 20)
+    {
+        m_file.setstate(std::ios::failbit);
+        m_file.close();
+        return;
+    }
+    m_fileHeader.m_type = linkType;
+    m_nanosecMode = false;
+    uint32_t read = 16;
+    while (read + 4 <= length - 4)
+    {
+        uint16_t code;
+        uint16_t optionLength;
+        ReadNg(code);
+        ReadNg(optionLength);
+        uint32_t padded = (optionLength + 3) & ~3U;
+        if (code == NG_OPTION_END)
+        {
+            read += 4;
+            break;
+        }
+        if (code == NG_OPTION_TSRESOL && optionLength == 1)
+        {
+            uint8_t resolution;
+            m_file.read((char*)&resolution, sizeof(resolution));
+            if (resolution != 6 && resolution != 9)
+            {
+                // Only microsecond and nanosecond timestamps are supported
+                m_file.setstate(std::ios::failbit);
+            }
+            m_nanosecMode = (resolution == 9);
+            m_file.seekg(padded - 1, std::ios::cur);
+        }
+        else
+        {
+            m_file.seekg(padded, std::ios::cur);
+        }
+        read += 4 + padded;
+    }
+    // Skip the other options and the trailing length
+    m_file.seekg(length - read, std::ios::cur);
+    m_fileHeader.m_magicNumber = NG_SECTION_HEADER;
+
+    if (m_file.fail())
+    {
+        m_file.close();
+    }
+}
+
 void
 PcapFile::Open(const std::string& filename, std::ios::openmode mode)
 {
@@ -328,6 +524,15 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
     mode |= std::ios::binary;
 
     m_filename = filename;
+    if ((mode & std::ios::in) == 0 && TraceFileStream::IsAsynchronous())
+    {
+        m_async = std::make_unique<TraceFileStream>(filename,
+                                                    mode,
+                                                    TraceFileStream::GetDefaultCompression());
+        m_out = m_async.get();
+        FatalImpl::RegisterStream(m_async.get());
+        return;
+    }
     m_file.open(filename, mode);
     if (mode & std::ios::in)
     {
@@ -341,9 +546,10 @@ PcapFile::Init(uint32_t dataLinkType,
                uint32_t snapLen,
                int32_t timeZoneCorrection,
                bool swapMode,
-               bool nanosecMode)
+               bool nanosecMode,
+               bool pcapng)
 {
-    NS_LOG_FUNCTION(this << dataLinkType << snapLen << timeZoneCorrection << swapMode);
+    NS_LOG_FUNCTION(this << dataLinkType << snapLen << timeZoneCorrection << swapMode << pcapng);
 
     //
     // Initialize the magic number and nanosecond mode flag
@@ -395,6 +601,16 @@ PcapFile::Init(uint32_t dataLinkType,
     //
     m_swapMode = swapMode || bigEndian;
 
+    //
+    // A pcapng file tells its byte order, so it is written in the order of
+    // the running system.
+    //
+    m_pcapng = pcapng;
+    if (m_pcapng)
+    {
+        m_swapMode = false;
+    }
+
     WriteFileHeader();
 }
 
@@ -402,10 +618,23 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
+    NS_ASSERT(m_out->good());
 
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
+    if (m_pcapng)
+    {
+        uint64_t timestamp = tsSec * (m_nanosecMode ? 1000000000ULL : 1000000ULL) + tsUsec;
+        WriteValue(m_out, NG_ENHANCED_PACKET);
+        WriteValue(m_out, uint32_t(32 + ((inclLen + 3) & ~3U)));
+        WriteValue(m_out, uint32_t(0)); // interface
+        WriteValue(m_out, uint32_t(timestamp >> 32));
+        WriteValue(m_out, uint32_t(timestamp));
+        WriteValue(m_out, inclLen);
+        WriteValue(m_out, totalLen);
+        return inclLen;
+    }
+
     PcapRecordHeader header;
     header.m_tsSec = tsSec;
     header.m_tsUsec = tsUsec;
@@ -421,20 +650,34 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
     //
-    m_file.write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
-    m_file.write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
-    m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
-    m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
+    m_out->write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
+    m_out->write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
+    m_out->write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
+    m_out->write((const char*)&header.m_origLen, sizeof(header.m_origLen));
     NS_BUILD_DEBUG(m_file.flush());
     return inclLen;
 }
 
+void
+PcapFile::WritePacketTrailer(uint32_t inclLen)
+{
+    NS_LOG_FUNCTION(this << inclLen);
+    if (m_pcapng)
+    {
+        const char padding[4] = {0, 0, 0, 0};
+        uint32_t padded = (inclLen + 3) & ~3U;
+        m_out->write(padding, padded - inclLen);
+        WriteValue(m_out, uint32_t(32 + padded));
+    }
+}
+
 void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
-    m_file.write((const char*)data, inclLen);
+    m_out->write((const char*)data, inclLen);
+    WritePacketTrailer(inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
 
@@ -443,7 +686,8 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
-    p->CopyData(&m_file, inclLen);
+    p->CopyData(m_out, inclLen);
+    WritePacketTrailer(inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
 
@@ -459,9 +703,9 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
-    headerBuffer.CopyData(&m_file, toCopy);
-    inclLen -= toCopy;
-    p->CopyData(&m_file, inclLen);
+    headerBuffer.CopyData(m_out, toCopy);
+    p->CopyData(m_out, inclLen - toCopy);
+    WritePacketTrailer(inclLen);
 }
 
 void
@@ -478,6 +722,53 @@ PcapFile::Read(uint8_t* const data,
 
     PcapRecordHeader header;
 
+    if (m_pcapng)
+    {
+        //
+        // Skip the blocks up to the next Enhanced Packet Block, whose
+        // timestamp is split in seconds and micro or nanoseconds
+        //
+        uint32_t type;
+        uint32_t length;
+        while (true)
+        {
+            ReadNg(type);
+            ReadNg(length);
+            if (m_file.fail())
+            {
+                return;
+            }
+            if (type == NG_ENHANCED_PACKET && length >= 32)
+            {
+                break;
+            }
+            m_file.seekg(length - 8, std::ios::cur);
+        }
+        uint32_t interface;
+        uint32_t timestampHigh;
+        uint32_t timestampLow;
+        ReadNg(interface);
+        ReadNg(timestampHigh);
+        ReadNg(timestampLow);
+        ReadNg(header.m_inclLen);
+        ReadNg(header.m_origLen);
+        if (m_file.fail())
+        {
+            return;
+        }
+        uint64_t timestamp = (uint64_t(timestampHigh) << 32) | timestampLow;
+        uint64_t resolution = m_nanosecMode ? 1000000000 : 1000000;
+        tsSec = timestamp / resolution;
+        tsUsec = timestamp % resolution;
+        inclLen = header.m_inclLen;
+        origLen = header.m_origLen;
+        readLen = maxBytes < header.m_inclLen ? maxBytes : header.m_inclLen;
+        m_file.read((char*)data, readLen);
+        // Skip the rest of the data, the padding and the trailing length
+        m_file.seekg(length - 28 - readLen, std::ios::cur);
+        return;
+    }
+
     //
     // Watch out for memory alignment differences between machines, so read
     // them all individually.
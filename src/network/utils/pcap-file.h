@@ -9,9 +9,12 @@
 #ifndef PCAP_FILE_H
 #define PCAP_FILE_H
 
+#include "trace-file-stream.h"
+
 #include "ns3/ptr.h"
 
 #include <fstream>
+#include <memory>
 #include <stdint.h>
 #include <string>
 
@@ -27,6 +30,11 @@ class Header;
  * A class representing a pcap file.  This allows easy creation, writing and
  * reading of files composed of stored packets; which may be viewed using
  * standard tools.
+ *
+ * The files can also be written in the pcapng format, where the
+ * interface of the packets is described in an Interface Description
+ * Block, and each packet is an Enhanced Packet Block.  Both formats are
+ * read back transparently.
  */
 class PcapFile
 {
@@ -64,6 +72,11 @@ class PcapFile
      * selected as a binary file (fstream::binary is automatically ored with the mode
      * field).
      *
+     * A file opened for writing only is written by a background thread through
+     * a TraceFileStream, possibly compressed, if the
+     * \ref GlobalValueTraceFileAsynchronous "TraceFileAsynchronous" global
+     * value is true.  Such a file is complete once closed.
+     *
      * @param filename String containing the name of the file.
      *
      * @param mode the access mode for the file.
@@ -101,6 +114,10 @@ class PcapFile
      * @param nanosecMode Flag indicating the time resolution of the writing
      * system. Default to false.
      *
+     * @param pcapng Flag indicating whether the file is written in the pcapng
+     * format, in the byte order of the writing system and without time zone
+     * correction.  Defaults to false.
+     *
      * @warning Calling this method on an existing file will result in the loss
      * any existing data.
      */
@@ -108,7 +125,8 @@ class PcapFile
               uint32_t snapLen = SNAPLEN_DEFAULT,
               int32_t timeZoneCorrection = ZONE_DEFAULT,
               bool swapMode = false,
-              bool nanosecMode = false);
+              bool nanosecMode = false,
+              bool pcapng = false);
 
     /**
      * @brief Write next packet to file
@@ -190,12 +208,21 @@ class PcapFile
      */
     bool IsNanoSecMode();
 
+    /**
+     * @brief Get the format of the file.
+     *
+     * @returns true if the file is in the pcapng format.
+     */
+    bool IsPcapNg();
+
     /**
      * @brief Returns the magic number of the pcap file as defined by the magic_number
      * field in the pcap global header.
      *
      * See http://wiki.wireshark.org/Development/LibpcapFileFormat
      *
+     * The magic number of a pcapng file is the type of its Section Header Block.
+     *
      * @returns magic number
      */
     uint32_t GetMagic();
@@ -356,17 +383,41 @@ class PcapFile
      * @returns the length of the packet to write in the Pcap file
      */
     uint32_t WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
+    /**
+     * @brief Write the end of a packet, after its data
+     *
+     * Only a pcapng Enhanced Packet Block has an end, which pads the data
+     * and repeats the length of the block.
+     *
+     * @param inclLen the length of the packet written in the Pcap file
+     */
+    void WritePacketTrailer(uint32_t inclLen);
 
     /**
      * @brief Read and verify a Pcap file header
      */
     void ReadAndVerifyFileHeader();
-
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    /**
+     * @brief Read and verify a pcapng Section Header Block, whose type was read,
+     * and the first Interface Description Block
+     */
+    void ReadAndVerifyNgHeader();
+    /**
+     * @brief Read a value of a pcapng file, in the byte order of the file
+     * @tparam T \deduced the type of the value
+     * @param value [out] the value read
+     */
+    template <typename T>
+    void ReadNg(T& value);
+
+    std::string m_filename;                   //!< file name
+    std::fstream m_file;                      //!< file stream
+    std::unique_ptr<TraceFileStream> m_async; //!< stream written by a background thread
+    std::ostream* m_out;                      //!< stream written, m_file or m_async
+    PcapFileHeader m_fileHeader;              //!< file header
+    bool m_swapMode;                          //!< swap mode
+    bool m_nanosecMode;                       //!< nanosecond timestamp mode
+    bool m_pcapng;                            //!< pcapng format
 };
 
 } // namespace ns3
@@ -15,6 +15,7 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace ns3
 {
@@ -51,6 +52,7 @@ SimpleChannel::Send(Ptr<Packet> p,
                     Ptr<SimpleNetDevice> sender)
 {
     NS_LOG_FUNCTION(this << p << protocol << to << from << sender);
+    std::vector<Simulator::ContextEvent> events;
     for (auto i = m_devices.begin(); i != m_devices.end(); ++i)
     {
         Ptr<SimpleNetDevice> tmp = *i;
@@ -66,15 +68,12 @@ SimpleChannel::Send(Ptr<Packet> p,
                 continue;
             }
         }
-        Simulator::ScheduleWithContext(tmp->GetNode()->GetId(),
-                                       m_delay,
-                                       &SimpleNetDevice::Receive,
-                                       tmp,
-                                       p->Copy(),
-                                       protocol,
-                                       to,
-                                       from);
+        events.push_back(
+            {tmp->GetNode()->GetId(),
+             m_delay,
+             MakeEvent(&SimpleNetDevice::Receive, tmp, p->Copy(), protocol, to, from)});
     }
+    Simulator::ScheduleWithContextBatch(events);
 }
 
 void
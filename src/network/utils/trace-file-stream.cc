@@ -0,0 +1,497 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "trace-file-stream.h"
+
+#include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifndef __WIN32__
+#include <pthread.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TraceFileStream");
+
+/**
+ * @relates TraceFileStream
+ * @anchor GlobalValueTraceFileAsynchronous
+ * @brief A global switch to write the trace files from a background thread.
+ */
+static GlobalValue g_traceFileAsynchronous =
+    GlobalValue("TraceFileAsynchronous",
+                "Whether the pcap and ASCII trace files are written by a background thread",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+/**
+ * @relates TraceFileStream
+ * @anchor GlobalValueTraceFileCompression
+ * @brief The compression of the trace files written from a background thread.
+ */
+static GlobalValue g_traceFileCompression =
+    GlobalValue("TraceFileCompression",
+                "The compression of the trace files written by a background thread",
+                EnumValue(TraceFileStream::NONE),
+                MakeEnumChecker(TraceFileStream::NONE, "None", TraceFileStream::GZIP, "Gzip"));
+
+class TraceFileStream::WriteBuffer : public std::streambuf
+{
+  public:
+    WriteBuffer();
+    ~WriteBuffer() override;
+
+    /**
+     * Open a file.
+     *
+     * @param filename The name of the file.
+     * @param mode The mode of the file.
+     * @param compression The compression of the file.
+     * @return true if the file was opened.
+     */
+    bool Open(const std::string& filename, std::ios::openmode mode, Compression compression);
+
+    /**
+     * @return true if a file is open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Write all the data to the file, and close it.
+     *
+     * @return true if all the data was written.
+     */
+    bool Close();
+
+    /**
+     * Hand the data written so far to the writer thread.
+     *
+     * @return true if no error occurred so far.
+     */
+    bool Flush();
+
+  protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    int sync() override;
+
+  private:
+    /// Size of the blocks handed to the writer thread
+    static constexpr std::size_t BLOCK_SIZE{65536};
+    /// Number of blocks queued beyond which the simulation waits for the writer thread
+    static constexpr std::size_t MAX_QUEUED_BLOCKS{256};
+
+    /** A block to write. */
+    struct Job
+    {
+        WriteBuffer* buffer;     //!< The buffer whose file is written.
+        std::vector<char> block; //!< The data to write.
+        bool close;              //!< Whether to close the file after the block.
+    };
+
+    /** The writer thread, shared by all the buffers. */
+    struct Writer
+    {
+        Writer();
+
+        /// Write the blocks queued, forever.
+        void Run();
+
+        std::mutex mutex;                      //!< Protects the members below.
+        std::condition_variable jobQueued;     //!< Signals a new job.
+        std::condition_variable jobDone;       //!< Signals a job written.
+        std::deque<Job> jobs;                  //!< The jobs queued.
+        std::vector<std::vector<char>> unused; //!< The blocks which can be reused.
+        std::thread thread;                    //!< The writer thread.
+    };
+
+    /**
+     * @return The writer thread of the process, which is never destroyed,
+     * so that the files can still be closed while the program exits.
+     */
+    static Writer& GetWriter();
+
+    /**
+     * Hand the current block to the writer thread, and start a new one.
+     *
+     * @param close Whether to close the file after the block.
+     * @return false if some data could not be written.
+     */
+    bool Submit(bool close);
+
+    /**
+     * Write a block to the file, in the writer thread.
+     *
+     * @param block The data to write.
+     * @param close Whether to close the file after the block.
+     * @return true if the block was written.
+     */
+    bool Write(const std::vector<char>& block, bool close);
+
+    std::FILE* m_file{nullptr};        //!< The file written.
+    Compression m_compression{NONE};   //!< The compression of the file.
+    std::vector<char> m_block;         //!< The block filled by the stream.
+    std::size_t m_pending{0};          //!< Blocks queued, protected by the writer mutex.
+    Writer* m_writer{nullptr};         //!< The writer of the blocks queued.
+    bool m_error{false};               //!< Write error, protected by the writer mutex.
+#ifdef HAVE_ZLIB
+    z_stream m_zstream;                //!< The state of the compression.
+    std::vector<unsigned char> m_zout; //!< The compressed data.
+#endif
+};
+
+TraceFileStream::WriteBuffer::Writer::Writer()
+    : thread(&Writer::Run, this)
+{
+}
+
+void
+TraceFileStream::WriteBuffer::Writer::Run()
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        jobQueued.wait(lock, [this] { return !jobs.empty(); });
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+        bool written = job.buffer->Write(job.block, job.close);
+        lock.lock();
+        job.buffer->m_error |= !written;
+        job.buffer->m_pending--;
+        job.block.clear();
+        unused.push_back(std::move(job.block));
+        jobDone.notify_all();
+    }
+}
+
+TraceFileStream::WriteBuffer::Writer&
+TraceFileStream::WriteBuffer::GetWriter()
+{
+    static std::mutex creation;
+    static Writer* writer = nullptr;
+#ifndef __WIN32__
+    // A forked process does not inherit the writer thread: it abandons the
+    // writer of its parent, whose mutex may be held, and starts its own
+    [[maybe_unused]] static int atfork = pthread_atfork([] { creation.lock(); },
+                                                        [] { creation.unlock(); },
+                                                        [] {
+                                                            creation.unlock();
+                                                            writer = nullptr;
+                                                        });
+#endif
+    std::lock_guard lock(creation);
+    if (writer == nullptr)
+    {
+        writer = new Writer;
+    }
+    return *writer;
+}
+
+TraceFileStream::WriteBuffer::WriteBuffer()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TraceFileStream::WriteBuffer::~WriteBuffer()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+bool
+TraceFileStream::WriteBuffer::Open(const std::string& filename,
+                                   std::ios::openmode mode,
+                                   Compression compression)
+{
+    NS_LOG_FUNCTION(this << filename << mode << compression);
+    NS_ASSERT_MSG(!m_file, "The file is already open");
+    NS_ASSERT_MSG((mode & std::ios::in) == 0, "A trace file stream can only be written");
+    if (!IsCompressionSupported(compression))
+    {
+        NS_LOG_WARN("Compression not supported, " << filename << " is not opened");
+        return false;
+    }
+    m_file = std::fopen(filename.c_str(), (mode & std::ios::app) ? "ab" : "wb");
+    if (!m_file)
+    {
+        return false;
+    }
+    m_compression = compression;
+#ifdef HAVE_ZLIB
+    if (m_compression == GZIP)
+    {
+        std::memset(&m_zstream, 0, sizeof(m_zstream));
+        // 16 is added to the window bits to write a gzip header
+        if (deflateInit2(&m_zstream,
+                         Z_DEFAULT_COMPRESSION,
+                         Z_DEFLATED,
+                         15 + 16,
+                         8,
+                         Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            std::fclose(m_file);
+            m_file = nullptr;
+            return false;
+        }
+        m_zout.resize(BLOCK_SIZE);
+    }
+#endif
+    m_error = false;
+    m_block.resize(BLOCK_SIZE);
+    setp(m_block.data(), m_block.data() + m_block.size());
+    return true;
+}
+
+bool
+TraceFileStream::WriteBuffer::IsOpen() const
+{
+    return m_file != nullptr;
+}
+
+bool
+TraceFileStream::WriteBuffer::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file)
+    {
+        return true;
+    }
+    Writer& writer = GetWriter();
+    Submit(true);
+    std::unique_lock lock(writer.mutex);
+    writer.jobDone.wait(lock, [this] { return m_pending == 0; });
+    m_file = nullptr;
+    setp(nullptr, nullptr);
+    return !m_error;
+}
+
+bool
+TraceFileStream::WriteBuffer::Submit(bool close)
+{
+    Writer& writer = GetWriter();
+    std::unique_lock lock(writer.mutex);
+    if (m_writer != &writer)
+    {
+        // The blocks queued before a fork are written by the parent process
+        m_pending = 0;
+        m_writer = &writer;
+    }
+    writer.jobDone.wait(lock, [&writer] { return writer.jobs.size() < MAX_QUEUED_BLOCKS; });
+    m_block.resize(pptr() - pbase());
+    writer.jobs.push_back({this, std::move(m_block), close});
+    m_pending++;
+    if (writer.unused.empty())
+    {
+        m_block = std::vector<char>();
+    }
+    else
+    {
+        m_block = std::move(writer.unused.back());
+        writer.unused.pop_back();
+    }
+    bool error = m_error;
+    lock.unlock();
+    writer.jobQueued.notify_one();
+
+    m_block.resize(BLOCK_SIZE);
+    setp(m_block.data(), m_block.data() + m_block.size());
+    return !error;
+}
+
+bool
+TraceFileStream::WriteBuffer::Write(const std::vector<char>& block, bool close)
+{
+    bool written = true;
+#ifdef HAVE_ZLIB
+    if (m_compression == GZIP)
+    {
+        m_zstream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(block.data()));
+        m_zstream.avail_in = block.size();
+        do
+        {
+            m_zstream.next_out = m_zout.data();
+            m_zstream.avail_out = m_zout.size();
+            deflate(&m_zstream, close ? Z_FINISH : Z_NO_FLUSH);
+            std::size_t size = m_zout.size() - m_zstream.avail_out;
+            written &= std::fwrite(m_zout.data(), 1, size, m_file) == size;
+        } while (m_zstream.avail_out == 0);
+        if (close)
+        {
+            deflateEnd(&m_zstream);
+        }
+    }
+    else
+#endif
+    {
+        written = std::fwrite(block.data(), 1, block.size(), m_file) == block.size();
+    }
+    if (close)
+    {
+        written &= std::fclose(m_file) == 0;
+    }
+    return written;
+}
+
+TraceFileStream::WriteBuffer::int_type
+TraceFileStream::WriteBuffer::overflow(int_type c)
+{
+    if (!m_file || !Submit(false))
+    {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize
+TraceFileStream::WriteBuffer::xsputn(const char* s, std::streamsize n)
+{
+    std::streamsize copied = 0;
+    while (copied < n)
+    {
+        if (pptr() == epptr() && (!m_file || !Submit(false)))
+        {
+            break;
+        }
+        std::streamsize size = std::min<std::streamsize>(n - copied, epptr() - pptr());
+        std::memcpy(pptr(), s + copied, size);
+        pbump(size);
+        copied += size;
+    }
+    return copied;
+}
+
+bool
+TraceFileStream::WriteBuffer::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file)
+    {
+        return false;
+    }
+    if (pptr() == pbase())
+    {
+        return true;
+    }
+    return Submit(false);
+}
+
+int
+TraceFileStream::WriteBuffer::sync()
+{
+    // The ASCII trace sinks flush their stream after each line: keep
+    // filling the block, which is handed to the writer thread once full
+    return m_file ? 0 : -1;
+}
+
+TraceFileStream::TraceFileStream()
+    : std::ostream(nullptr),
+      m_buffer(std::make_unique<WriteBuffer>())
+{
+    NS_LOG_FUNCTION(this);
+    rdbuf(m_buffer.get());
+}
+
+TraceFileStream::TraceFileStream(const std::string& filename,
+                                 std::ios::openmode mode,
+                                 Compression compression)
+    : TraceFileStream()
+{
+    Open(filename, mode, compression);
+}
+
+TraceFileStream::~TraceFileStream()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+TraceFileStream::Open(const std::string& filename,
+                      std::ios::openmode mode,
+                      Compression compression)
+{
+    NS_LOG_FUNCTION(this << filename << mode << compression);
+    if (!m_buffer->Open(filename, mode, compression))
+    {
+        setstate(std::ios::failbit);
+    }
+}
+
+bool
+TraceFileStream::IsOpen() const
+{
+    return m_buffer->IsOpen();
+}
+
+void
+TraceFileStream::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_buffer->Close())
+    {
+        setstate(std::ios::failbit);
+    }
+}
+
+void
+TraceFileStream::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_buffer->Flush())
+    {
+        setstate(std::ios::badbit);
+    }
+}
+
+bool
+TraceFileStream::IsCompressionSupported(Compression compression)
+{
+#ifdef HAVE_ZLIB
+    return compression == NONE || compression == GZIP;
+#else
+    return compression == NONE;
+#endif
+}
+
+bool
+TraceFileStream::IsAsynchronous()
+{
+    BooleanValue value;
+    g_traceFileAsynchronous.GetValue(value);
+    return value.Get();
+}
+
+TraceFileStream::Compression
+TraceFileStream::GetDefaultCompression()
+{
+    EnumValue<Compression> value;
+    g_traceFileCompression.GetValue(value);
+    return value.Get();
+}
+
+} // namespace ns3
@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TRACE_FILE_STREAM_H
+#define TRACE_FILE_STREAM_H
+
+#include <ios>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ * @brief An output file stream written by a background thread.
+ *
+ * The data written to a TraceFileStream is gathered in blocks, which
+ * are handed to a writer thread shared by all the TraceFileStreams
+ * once full, or when the stream is flushed.  The simulation thread thus
+ * only copies the records of the traces into memory, while the writer
+ * thread compresses them if requested and writes them to their file.
+ *
+ * Flushing the stream with std::flush or std::endl does not hand a
+ * partial block to the writer thread, since the ASCII trace sinks flush
+ * their stream after each line; Flush() does, without waiting for the
+ * data to be written.  Close() waits for all the data to be written: the
+ * trace file is complete only once its stream is closed or destroyed.
+ *
+ * The writer thread is started on first use in each process, so that
+ * a process forked from a simulation can write its own trace files.
+ *
+ * The pcap and ASCII trace files are written by a TraceFileStream when
+ * the \ref GlobalValueTraceFileAsynchronous "TraceFileAsynchronous"
+ * global value is true.
+ */
+class TraceFileStream : public std::ostream
+{
+  public:
+    /// The compression of the file written
+    enum Compression
+    {
+        NONE, //!< The data is written as is
+        GZIP  //!< The data is compressed in the gzip format
+    };
+
+    TraceFileStream();
+
+    /**
+     * Construct and open a file stream.
+     *
+     * @param filename The name of the file.
+     * @param mode The mode of the file, which must not include std::ios::in.
+     * @param compression The compression of the file.
+     */
+    TraceFileStream(const std::string& filename,
+                    std::ios::openmode mode,
+                    Compression compression = NONE);
+
+    /** Destructor, closing the file. */
+    ~TraceFileStream() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    TraceFileStream(const TraceFileStream&) = delete;
+    TraceFileStream& operator=(const TraceFileStream&) = delete;
+
+    /**
+     * Open a file, setting the failbit of the stream on failure.
+     *
+     * @param filename The name of the file.
+     * @param mode The mode of the file, which must not include std::ios::in.
+     * @param compression The compression of the file.
+     */
+    void Open(const std::string& filename,
+              std::ios::openmode mode,
+              Compression compression = NONE);
+
+    /**
+     * @return true if a file is open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Write all the data to the file, and close it.  The failbit of the
+     * stream is set if the data could not be written.
+     */
+    void Close();
+
+    /**
+     * Hand the data written so far to the writer thread, without waiting
+     * for it to be written.  The badbit of the stream is set if some data
+     * could not be written.
+     */
+    void Flush();
+
+    /**
+     * @param compression A compression.
+     * @return true if the files can be compressed this way, which depends
+     * on the libraries found when ns-3 was configured.
+     */
+    static bool IsCompressionSupported(Compression compression);
+
+    /**
+     * @return true if the trace files should be written by a
+     * TraceFileStream, from the
+     * \ref GlobalValueTraceFileAsynchronous "TraceFileAsynchronous"
+     * global value.
+     */
+    static bool IsAsynchronous();
+
+    /**
+     * @return The compression of the trace files written by a
+     * TraceFileStream, from the
+     * \ref GlobalValueTraceFileCompression "TraceFileCompression"
+     * global value.
+     */
+    static Compression GetDefaultCompression();
+
+  private:
+    /** The buffer of the stream, handing its blocks to the writer thread. */
+    class WriteBuffer;
+
+    std::unique_ptr<WriteBuffer> m_buffer; //!< The buffer of the stream
+};
+
+} // namespace ns3
+
+#endif /* TRACE_FILE_STREAM_H */
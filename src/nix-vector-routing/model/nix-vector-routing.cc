@@ -14,13 +14,17 @@
 #include "nix-vector-routing.h"
 
 #include "ns3/abort.h"
+#include "ns3/global-value.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <queue>
+#include <unordered_set>
 
 namespace ns3
 {
@@ -30,6 +34,19 @@ NS_LOG_COMPONENT_DEFINE("NixVectorRouting");
 NS_OBJECT_TEMPLATE_CLASS_DEFINE(NixVectorRouting, Ipv4RoutingProtocol);
 NS_OBJECT_TEMPLATE_CLASS_DEFINE(NixVectorRouting, Ipv6RoutingProtocol);
 
+/**
+ * @relates NixVectorRouting
+ * @anchor GlobalValueNixVectorTreeCacheSize
+ * Maximum number of shortest path trees kept by the nix-vector routing,
+ * one per source node, or 0 for no limit.
+ */
+static GlobalValue g_nixVectorTreeCacheSize =
+    GlobalValue("NixVectorTreeCacheSize",
+                "The maximum number of shortest path trees kept by the nix-vector routing, "
+                "one per source node, or 0 for no limit",
+                UintegerValue(64),
+                MakeUintegerChecker<uint32_t>());
+
 /// Flag to mark when caches are dirty and need to be flushed
 template <typename T>
 bool NixVectorRouting<T>::g_isCacheDirty = false;
@@ -38,6 +55,16 @@ bool NixVectorRouting<T>::g_isCacheDirty = false;
 template <typename T>
 uint32_t NixVectorRouting<T>::g_epoch = 1;
 
+/// Link changes recorded since the last invalidation of the caches
+template <typename T>
+std::vector<typename NixVectorRouting<T>::LinkChange> NixVectorRouting<T>::g_linkChanges;
+
+/// Shortest path trees based on the source node ID
+template <typename T>
+typename NixVectorRouting<T>::template LruCache<uint32_t,
+                                                typename NixVectorRouting<T>::ShortestPathTree>
+    NixVectorRouting<T>::g_trees;
+
 /// Mapping of IP address to ns-3 node
 template <typename T>
 typename NixVectorRouting<T>::IpAddressToNodeMap NixVectorRouting<T>::g_ipAddressToNodeMap;
@@ -60,16 +87,29 @@ NixVectorRouting<T>::GetTypeId()
     {
         name = "Ipv6";
     }
-    static TypeId tid = TypeId("ns3::" + name + "NixVectorRouting")
-                            .SetParent<T>()
-                            .SetGroupName("NixVectorRouting")
-                            .template AddConstructor<NixVectorRouting<T>>();
+    static TypeId tid =
+        TypeId("ns3::" + name + "NixVectorRouting")
+            .SetParent<T>()
+            .SetGroupName("NixVectorRouting")
+            .template AddConstructor<NixVectorRouting<T>>()
+            .AddAttribute("NixCacheSize",
+                          "The maximum number of nix-vectors cached by the node, or 0 for no limit",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NixVectorRouting<T>::m_nixCacheSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("IpRouteCacheSize",
+                          "The maximum number of routes cached by the node, or 0 for no limit",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NixVectorRouting<T>::m_ipRouteCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 template <typename T>
 NixVectorRouting<T>::NixVectorRouting()
-    : m_totalNeighbors(0)
+    : m_nixCacheSize(0),
+      m_ipRouteCacheSize(0),
+      m_totalNeighbors(0)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -156,6 +196,7 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache() const
         rp->FlushIpRouteCache();
         rp->m_totalNeighbors = 0;
     }
+    g_trees.Clear();
 
     // IP address to node mapping is potentially invalid so clear it.
     // Will be repopulated in lazy evaluation when mapping is needed.
@@ -167,7 +208,7 @@ void
 NixVectorRouting<T>::FlushNixCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_nixCache.clear();
+    m_nixCache.Clear();
 }
 
 template <typename T>
@@ -175,12 +216,15 @@ void
 NixVectorRouting<T>::FlushIpRouteCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_ipRouteCache.clear();
+    m_ipRouteCache.Clear();
 }
 
 template <typename T>
 Ptr<NixVector>
-NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevice> oif) const
+NixVectorRouting<T>::GetNixVector(Ptr<Node> source,
+                                  IpAddress dest,
+                                  Ptr<NetDevice> oif,
+                                  std::vector<uint32_t>* path) const
 {
     NS_LOG_FUNCTION(this << source << dest << oif);
 
@@ -208,20 +252,32 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
     else
     {
         // otherwise proceed as normal
-        // and build the nix vector
-        std::vector<Ptr<Node>> parentVector;
+        // and build the nix vector, from the shortest path
+        // tree of the source unless the output interface is given
+        std::vector<Ptr<Node>> oifParentVector;
+        const std::vector<Ptr<Node>>* parentVector = &oifParentVector;
+        if (!oif)
+        {
+            parentVector = &GetShortestPathTree(source).parents;
+        }
+        else if (!BFS(NodeList::GetNNodes(), source, destNode, oifParentVector, oif))
+        {
+            NS_LOG_ERROR("No routing path exists");
+            return nullptr;
+        }
 
-        if (BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif))
+        if (BuildNixVector(*parentVector, source->GetId(), destNode->GetId(), nixVector))
         {
-            if (BuildNixVector(parentVector, source->GetId(), destNode->GetId(), nixVector))
-            {
-                return nixVector;
-            }
-            else
+            if (path)
             {
-                NS_LOG_ERROR("No routing path exists");
-                return nullptr;
+                Ptr<Node> node = destNode;
+                for (; node != source; node = parentVector->at(node->GetId()))
+                {
+                    path->push_back(node->GetId());
+                }
+                path->push_back(source->GetId());
             }
+            return nixVector;
         }
         else
         {
@@ -239,12 +295,12 @@ NixVectorRouting<T>::GetNixVectorInCache(const IpAddress& address, bool& foundIn
 
     CheckCacheStateAndFlush();
 
-    auto iter = m_nixCache.find(address);
-    if (iter != m_nixCache.end())
+    auto entry = m_nixCache.Find(address);
+    if (entry)
     {
         NS_LOG_LOGIC("Found Nix-vector in cache.");
         foundInCache = true;
-        return iter->second;
+        return entry->nixVector;
     }
 
     // not in cache
@@ -254,17 +310,18 @@ NixVectorRouting<T>::GetNixVectorInCache(const IpAddress& address, bool& foundIn
 
 template <typename T>
 Ptr<typename NixVectorRouting<T>::IpRoute>
-NixVectorRouting<T>::GetIpRouteInCache(IpAddress address)
+NixVectorRouting<T>::GetIpRouteInCache(IpAddress address, uint32_t nixIndex)
 {
-    NS_LOG_FUNCTION(this << address);
+    NS_LOG_FUNCTION(this << address << nixIndex);
 
     CheckCacheStateAndFlush();
 
-    auto iter = m_ipRouteCache.find(address);
-    if (iter != m_ipRouteCache.end())
+    // the route of a destination whose path changed leads elsewhere
+    auto entry = m_ipRouteCache.Find(address);
+    if (entry && entry->nixIndex == nixIndex)
     {
         NS_LOG_LOGIC("Found IpRoute in cache.");
-        return iter->second;
+        return entry->route;
     }
 
     // not in cache
@@ -749,11 +806,14 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         NS_LOG_LOGIC("Nix-vector not in cache, build: ");
         // Build the nix-vector, given this node and the
         // dest IP address
-        nixVectorInCache = GetNixVector(m_node, destAddress, oif);
+        NixCacheEntry entry;
+        nixVectorInCache = GetNixVector(m_node, destAddress, oif, &entry.path);
         if (nixVectorInCache)
         {
             // cache it
-            m_nixCache.insert(typename NixMap_t::value_type(destAddress, nixVectorInCache));
+            entry.nixVector = nixVectorInCache;
+            entry.oif = oif != nullptr;
+            m_nixCache.Insert(destAddress, std::move(entry), m_nixCacheSize);
         }
     }
 
@@ -765,6 +825,8 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         // create a new nix vector to be used,
         // we want to keep the cached version clean
         nixVectorForPacket = nixVectorInCache->Copy();
+        // the cached nix-vector may predate link changes which spared its path
+        nixVectorForPacket->SetEpoch(g_epoch);
 
         // Get the interface number that we go out of, by extracting
         // from the nix-vector
@@ -780,7 +842,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
 
         // Search here in a cache for this node index
         // and look for a IpRoute
-        rtentry = GetIpRouteInCache(destAddress);
+        rtentry = GetIpRouteInCache(destAddress, nodeIndex);
 
         if (!rtentry || !(rtentry->GetOutputDevice() == oif))
         {
@@ -791,7 +853,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
             // rtentry from the map
             if (rtentry)
             {
-                m_ipRouteCache.erase(destAddress);
+                m_ipRouteCache.Erase(destAddress);
             }
 
             NS_LOG_LOGIC("IpRoute not in cache, build: ");
@@ -831,7 +893,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
             sockerr = Socket::ERROR_NOTERROR;
 
             // add rtentry to cache
-            m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+            m_ipRouteCache.Insert(destAddress, {rtentry, nodeIndex}, m_ipRouteCacheSize);
         }
 
         NS_LOG_LOGIC("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: "
@@ -945,7 +1007,7 @@ NixVectorRouting<T>::RouteInput(Ptr<const Packet> p,
     uint32_t numberOfBits = nixVector->BitCount(m_totalNeighbors);
     uint32_t nodeIndex = nixVector->ExtractNeighborIndex(numberOfBits);
 
-    rtentry = GetIpRouteInCache(destAddress);
+    rtentry = GetIpRouteInCache(destAddress, nodeIndex);
     // not in cache
     if (!rtentry)
     {
@@ -964,7 +1026,7 @@ NixVectorRouting<T>::RouteInput(Ptr<const Packet> p,
         rtentry->SetOutputDevice(m_ip->GetNetDevice(interfaceIndex));
 
         // add rtentry to cache
-        m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+        m_ipRouteCache.Insert(destAddress, {rtentry, nodeIndex}, m_ipRouteCacheSize);
     }
 
     NS_LOG_LOGIC("At Node " << m_node->GetId() << ", Extracting " << numberOfBits
@@ -1005,18 +1067,18 @@ NixVectorRouting<T>::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Un
         << ", Local time: " << m_node->GetLocalTime().As(unit) << ", Nix Routing" << std::endl;
 
     *os << "NixCache:" << std::endl;
-    if (m_nixCache.size() > 0)
+    if (!m_nixCache.GetItems().empty())
     {
         *os << std::setw(30) << "Destination";
         *os << "NixVector" << std::endl;
-        for (auto it = m_nixCache.begin(); it != m_nixCache.end(); it++)
+        for (const auto& [address, item] : m_nixCache.GetItems())
         {
             std::ostringstream dest;
-            dest << it->first;
+            dest << address;
             *os << std::setw(30) << dest.str();
-            if (it->second)
+            if (item.value.nixVector)
             {
-                *os << *(it->second) << std::endl;
+                *os << *(item.value.nixVector) << std::endl;
             }
             else
             {
@@ -1026,31 +1088,32 @@ NixVectorRouting<T>::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Un
     }
 
     *os << "IpRouteCache:" << std::endl;
-    if (m_ipRouteCache.size() > 0)
+    if (!m_ipRouteCache.GetItems().empty())
     {
         *os << std::setw(30) << "Destination";
         *os << std::setw(30) << "Gateway";
         *os << std::setw(30) << "Source";
         *os << "OutputDevice" << std::endl;
-        for (auto it = m_ipRouteCache.begin(); it != m_ipRouteCache.end(); it++)
+        for (const auto& [address, item] : m_ipRouteCache.GetItems())
         {
+            Ptr<IpRoute> route = item.value.route;
             std::ostringstream dest;
             std::ostringstream gw;
             std::ostringstream src;
-            dest << it->second->GetDestination();
+            dest << route->GetDestination();
             *os << std::setw(30) << dest.str();
-            gw << it->second->GetGateway();
+            gw << route->GetGateway();
             *os << std::setw(30) << gw.str();
-            src << it->second->GetSource();
+            src << route->GetSource();
             *os << std::setw(30) << src.str();
             *os << "  ";
-            if (Names::FindName(it->second->GetOutputDevice()) != "")
+            if (Names::FindName(route->GetOutputDevice()) != "")
             {
-                *os << Names::FindName(it->second->GetOutputDevice());
+                *os << Names::FindName(route->GetOutputDevice());
             }
             else
             {
-                *os << it->second->GetOutputDevice()->GetIfIndex();
+                *os << route->GetOutputDevice()->GetIfIndex();
             }
             *os << std::endl;
         }
@@ -1065,14 +1128,14 @@ template <typename T>
 void
 NixVectorRouting<T>::NotifyInterfaceUp(uint32_t i)
 {
-    g_isCacheDirty = true;
+    NotifyLinkChange(i, true);
 }
 
 template <typename T>
 void
 NixVectorRouting<T>::NotifyInterfaceDown(uint32_t i)
 {
-    g_isCacheDirty = true;
+    NotifyLinkChange(i, false);
 }
 
 template <typename T>
@@ -1117,15 +1180,24 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
                          Ptr<Node> source,
                          Ptr<Node> dest,
                          std::vector<Ptr<Node>>& parentVector,
-                         Ptr<NetDevice> oif) const
+                         Ptr<NetDevice> oif,
+                         std::vector<uint32_t>* order) const
 {
     NS_LOG_FUNCTION(this << numberOfNodes << source << dest << parentVector << oif);
 
-    NS_LOG_LOGIC("Going from Node " << source->GetId() << " to Node " << dest->GetId());
+    if (dest)
+    {
+        NS_LOG_LOGIC("Going from Node " << source->GetId() << " to Node " << dest->GetId());
+    }
     std::queue<Ptr<Node>> greyNodeList; // discovered nodes with unexplored children
 
     // reset the parent vector
     parentVector.assign(numberOfNodes, nullptr); // initialize to 0
+    if (order)
+    {
+        order->assign(numberOfNodes, 0);
+    }
+    uint32_t reached = 0;
 
     // Add the source node to the queue, set its parent to itself
     greyNodeList.push(source);
@@ -1196,6 +1268,10 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
                 {
                     parentVector.at(remoteNode->GetId()) = currNode;
                     greyNodeList.push(remoteNode);
+                    if (order)
+                    {
+                        order->at(remoteNode->GetId()) = ++reached;
+                    }
                 }
             }
         }
@@ -1259,6 +1335,10 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
                     {
                         parentVector.at(remoteNode->GetId()) = currNode;
                         greyNodeList.push(remoteNode);
+                        if (order)
+                        {
+                            order->at(remoteNode->GetId()) = ++reached;
+                        }
                     }
                 }
             }
@@ -1415,9 +1495,177 @@ NixVectorRouting<T>::CheckCacheStateAndFlush() const
     if (g_isCacheDirty)
     {
         FlushGlobalNixRoutingCache();
+        g_linkChanges.clear();
         g_epoch++;
         g_isCacheDirty = false;
     }
+    else if (!g_linkChanges.empty())
+    {
+        InvalidateLinkChanges();
+        g_linkChanges.clear();
+        g_epoch++;
+    }
+}
+
+template <typename T>
+const typename NixVectorRouting<T>::ShortestPathTree&
+NixVectorRouting<T>::GetShortestPathTree(Ptr<Node> source) const
+{
+    NS_LOG_FUNCTION(this << source);
+
+    uint32_t numberOfNodes = NodeList::GetNNodes();
+    ShortestPathTree* tree = g_trees.Find(source->GetId());
+    if (tree && tree->parents.size() == numberOfNodes)
+    {
+        return *tree;
+    }
+
+    NS_LOG_LOGIC("Shortest path tree not in cache, build: ");
+    ShortestPathTree newTree;
+    BFS(numberOfNodes, source, nullptr, newTree.parents, nullptr, &newTree.order);
+    UintegerValue treeCacheSize;
+    g_nixVectorTreeCacheSize.GetValue(treeCacheSize);
+    g_trees.Insert(source->GetId(), std::move(newTree), treeCacheSize.Get());
+    return *g_trees.Find(source->GetId());
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::NotifyLinkChange(uint32_t interface, bool up)
+{
+    NS_LOG_FUNCTION(this << interface << up);
+
+    Ptr<NetDevice> device = m_ip ? m_ip->GetNetDevice(interface) : nullptr;
+    Ptr<Channel> channel = device ? device->GetChannel() : nullptr;
+    if (!channel || NetDeviceIsBridged(device))
+    {
+        g_isCacheDirty = true;
+        return;
+    }
+
+    LinkChange change{up, device->GetNode()->GetId(), {}};
+    for (std::size_t i = 0; i < channel->GetNDevices(); i++)
+    {
+        Ptr<NetDevice> remoteDevice = channel->GetDevice(i);
+        if (NetDeviceIsBridged(remoteDevice))
+        {
+            // the neighbors through a bridge are beyond the channel
+            g_isCacheDirty = true;
+            return;
+        }
+        change.nodes.push_back(remoteDevice->GetNode()->GetId());
+    }
+    g_linkChanges.push_back(std::move(change));
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::InvalidateLinkChanges() const
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    std::unordered_set<uint32_t> changedNodes;
+    bool linkUp = false;
+    for (const auto& change : g_linkChanges)
+    {
+        changedNodes.insert(change.nodes.begin(), change.nodes.end());
+        linkUp |= change.up;
+    }
+
+    g_trees.EraseIf([](uint32_t source, const ShortestPathTree& tree) {
+        return std::any_of(g_linkChanges.begin(),
+                           g_linkChanges.end(),
+                           [&tree](const LinkChange& change) {
+                               return IsTreeAffected(tree, change);
+                           });
+    });
+
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<NixVectorRouting<T>> rp = node->GetObject<NixVectorRouting>();
+        if (!rp)
+        {
+            continue;
+        }
+
+        // the neighbors of the nodes on the changed channels are renumbered
+        if (changedNodes.count(node->GetId()))
+        {
+            rp->FlushIpRouteCache();
+            rp->m_totalNeighbors = 0;
+        }
+
+        // a new link may shorten the paths from the sources whose tree
+        // changed or is unknown, and the paths through an output interface
+        bool sourceChanged = linkUp && !g_trees.GetItems().count(node->GetId());
+        rp->m_nixCache.EraseIf([&](const IpAddress& dest, const NixCacheEntry& entry) {
+            bool erase = sourceChanged || (linkUp && entry.oif) ||
+                         std::any_of(entry.path.begin(), entry.path.end(), [&](uint32_t id) {
+                             return changedNodes.count(id);
+                         });
+            if (erase)
+            {
+                rp->m_ipRouteCache.Erase(dest);
+            }
+            return erase;
+        });
+    }
+}
+
+template <typename T>
+bool
+NixVectorRouting<T>::IsTreeAffected(const ShortestPathTree& tree, const LinkChange& change)
+{
+    const std::vector<Ptr<Node>>& parents = tree.parents;
+    if (change.node >= parents.size())
+    {
+        return true;
+    }
+
+    for (uint32_t id : change.nodes)
+    {
+        if (id == change.node)
+        {
+            continue;
+        }
+        if (id >= parents.size())
+        {
+            return true;
+        }
+        if (change.up)
+        {
+            if (IsReachedSooner(tree, change.node, id) || IsReachedSooner(tree, id, change.node))
+            {
+                return true;
+            }
+        }
+        // the links of the interface which went down may lead to a child
+        else if ((parents[id] && parents[id]->GetId() == change.node) ||
+                 (parents[change.node] && parents[change.node]->GetId() == id))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool
+NixVectorRouting<T>::IsReachedSooner(const ShortestPathTree& tree, uint32_t from, uint32_t to)
+{
+    const std::vector<Ptr<Node>>& parents = tree.parents;
+    if (!parents[from])
+    {
+        return false;
+    }
+    if (!parents[to])
+    {
+        return true;
+    }
+    // a node is reached by the first node of the search linked to it, and
+    // the order of the children of a node follows its devices
+    return tree.order[from] <= tree.order[parents[to]->GetId()];
 }
 
 /* Public template function declarations */
@@ -30,8 +30,10 @@
 #include "ns3/node-list.h"
 #include "ns3/nstime.h"
 
+#include <list>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 // NOLINTBEGIN(modernize-use-override)
 
@@ -49,6 +51,13 @@ namespace ns3
  * @ingroup nix-vector-routing
  * Nix-vector routing protocol
  *
+ * The shortest path trees computed by the breadth first searches are kept
+ * per source node and shared by all its destinations.  When an interface
+ * goes up or down, only the nix-vectors whose path goes through the nodes
+ * of the changed channel, and the trees the change may alter, are dropped;
+ * the caches are bounded by the NixCacheSize and IpRouteCacheSize
+ * attributes and by the NixVectorTreeCacheSize global value.
+ *
  * @internal
  * Since this class is meant to be specialized only by Ipv4RoutingProtocol or
  * Ipv6RoutingProtocol the implementation of this class doesn't need to be
@@ -153,12 +162,16 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      * BFS, accounting for any output interface specified, and finally
      * BuildNixVector to return the built nix-vector
      *
-     * @param source Source node
-     * @param dest Destination node address
-     * @param oif Preferred output interface
+     * @param [in] source Source node
+     * @param [in] dest Destination node address
+     * @param [in] oif Preferred output interface
+     * @param [out] path if not null, the IDs of the nodes of the path, from the destination
      * @returns The NixVector to be used in routing.
      */
-    Ptr<NixVector> GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevice> oif) const;
+    Ptr<NixVector> GetNixVector(Ptr<Node> source,
+                                IpAddress dest,
+                                Ptr<NetDevice> oif,
+                                std::vector<uint32_t>* path = nullptr) const;
 
     /**
      * Checks the cache based on dest IP for the nix-vector
@@ -171,9 +184,10 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
     /**
      * Checks the cache based on dest IP for the IpRoute
      * @param address Address to check
+     * @param nixIndex Nix index of the next hop, which the cached route must lead to
      * @returns The cached route.
      */
-    Ptr<IpRoute> GetIpRouteInCache(IpAddress address);
+    Ptr<IpRoute> GetIpRouteInCache(IpAddress address, uint32_t nixIndex);
 
     /**
      * Given a net-device returns all the adjacent net-devices,
@@ -249,13 +263,179 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      * @param [in] dest Destination Node
      * @param [out] parentVector Parent vector for retracing routes
      * @param [in] oif specific output interface to use from source node, if not null
+     * @param [out] order if not null, the order in which each node was reached
      * @returns false if dest not found, true o.w.
      */
     bool BFS(uint32_t numberOfNodes,
              Ptr<Node> source,
              Ptr<Node> dest,
              std::vector<Ptr<Node>>& parentVector,
-             Ptr<NetDevice> oif) const;
+             Ptr<NetDevice> oif,
+             std::vector<uint32_t>* order = nullptr) const;
+
+    /// Shortest path tree of a source node, computed by a breadth first search
+    struct ShortestPathTree
+    {
+        std::vector<Ptr<Node>> parents; //!< Parent of each node by ID, null if unreachable
+        std::vector<uint32_t> order;    //!< Order in which each node was reached
+    };
+
+    /**
+     * Get the shortest path tree of a source node, from the cache if the
+     * tree is there.
+     * @param source Source node
+     * @returns The shortest path tree.
+     */
+    const ShortestPathTree& GetShortestPathTree(Ptr<Node> source) const;
+
+    /// An interface which went up or down
+    struct LinkChange
+    {
+        bool up;                     //!< Whether the interface went up
+        uint32_t node;               //!< ID of the node of the interface
+        std::vector<uint32_t> nodes; //!< IDs of the nodes on the channel of the interface
+    };
+
+    /**
+     * Record an interface which went up or down, for the caches to be
+     * invalidated lazily.  The caches are flushed if the neighbors through
+     * the interface are not known.
+     * @param interface Interface index
+     * @param up Whether the interface went up
+     */
+    void NotifyLinkChange(uint32_t interface, bool up);
+
+    /**
+     * Drop the cached shortest path trees, nix-vectors and routes which the
+     * recorded link changes may have invalidated.
+     */
+    void InvalidateLinkChanges() const;
+
+    /**
+     * Determine whether a link change may alter a shortest path tree.
+     * @param tree Shortest path tree
+     * @param change Link change
+     * @returns true if the tree may change, false o.w.
+     */
+    static bool IsTreeAffected(const ShortestPathTree& tree, const LinkChange& change);
+
+    /**
+     * Determine whether a new link from a node may alter how a shortest
+     * path tree reaches another node.
+     * @param tree Shortest path tree
+     * @param from ID of the node from which the link goes
+     * @param to ID of the node to which the link goes
+     * @returns true if the tree may change, false o.w.
+     */
+    static bool IsReachedSooner(const ShortestPathTree& tree, uint32_t from, uint32_t to);
+
+    /**
+     * Cache of bounded size, which evicts its least recently used entries.
+     * The entries are sorted by key, to be printed in order.
+     */
+    template <typename Key, typename Value>
+    class LruCache
+    {
+      public:
+        /// Entry of the cache, with its position in the recency list
+        struct Item
+        {
+            Value value;                               //!< Value
+            typename std::list<Key>::iterator recency; //!< Position in the recency list
+        };
+
+        /// Entries of the cache by key
+        using Items = std::map<Key, Item>;
+
+        /**
+         * Find an entry, and mark it as the most recently used.
+         * @param key Key of the entry
+         * @returns The value of the entry, or null if not found.
+         */
+        Value* Find(const Key& key)
+        {
+            auto it = m_items.find(key);
+            if (it == m_items.end())
+            {
+                return nullptr;
+            }
+            m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+            return &it->second.value;
+        }
+
+        /**
+         * Add or replace an entry, as the most recently used, and evict the
+         * least recently used entries beyond a capacity.
+         * @param key Key of the entry
+         * @param value Value of the entry
+         * @param capacity Maximum number of entries, or 0 for no limit
+         */
+        void Insert(const Key& key, Value value, uint32_t capacity)
+        {
+            Erase(key);
+            m_recency.push_front(key);
+            m_items.emplace(key, Item{std::move(value), m_recency.begin()});
+            while (capacity > 0 && m_items.size() > capacity)
+            {
+                m_items.erase(m_recency.back());
+                m_recency.pop_back();
+            }
+        }
+
+        /**
+         * Remove an entry, if found.
+         * @param key Key of the entry
+         */
+        void Erase(const Key& key)
+        {
+            auto it = m_items.find(key);
+            if (it != m_items.end())
+            {
+                m_recency.erase(it->second.recency);
+                m_items.erase(it);
+            }
+        }
+
+        /**
+         * Remove the entries matching a predicate.
+         * @param predicate Predicate called with the key and the value of each entry
+         */
+        template <typename Predicate>
+        void EraseIf(Predicate predicate)
+        {
+            for (auto it = m_items.begin(); it != m_items.end();)
+            {
+                if (predicate(it->first, it->second.value))
+                {
+                    m_recency.erase(it->second.recency);
+                    it = m_items.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+        }
+
+        /// Remove all the entries
+        void Clear()
+        {
+            m_items.clear();
+            m_recency.clear();
+        }
+
+        /**
+         * @returns The entries, sorted by key.
+         */
+        const Items& GetItems() const
+        {
+            return m_items;
+        }
+
+      private:
+        Items m_items;            //!< Entries by key
+        std::list<Key> m_recency; //!< Keys from the most recently used
+    };
 
     /**
      * \sa Ipv4RoutingProtocol::DoInitialize
@@ -269,10 +449,20 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     void DoDispose();
 
-    /// Map of IpAddress to NixVector
-    typedef std::map<IpAddress, Ptr<NixVector>> NixMap_t;
-    /// Map of IpAddress to IpRoute
-    typedef std::map<IpAddress, Ptr<IpRoute>> IpRouteMap_t;
+    /// Entry of the nix-vector cache
+    struct NixCacheEntry
+    {
+        Ptr<NixVector> nixVector;   //!< Nix-vector to the destination
+        std::vector<uint32_t> path; //!< IDs of the nodes of the path, from the destination
+        bool oif;                   //!< Whether the path was built for an output interface
+    };
+
+    /// Entry of the IpRoute cache
+    struct IpRouteCacheEntry
+    {
+        Ptr<IpRoute> route; //!< Route to the destination
+        uint32_t nixIndex;  //!< Nix index of the next hop
+    };
 
     /// Callback for IPv4 unicast packets to be forwarded
     typedef Callback<void, Ptr<IpRoute>, Ptr<const Packet>, const IpHeader&>
@@ -473,15 +663,24 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
     static bool g_isCacheDirty;
 
     /**
-     * Nix Epoch, incremented each time a flush is performed.
+     * Nix Epoch, incremented each time a flush or an invalidation is performed.
      */
     static uint32_t g_epoch;
 
+    /// Link changes recorded since the last invalidation of the caches
+    static std::vector<LinkChange> g_linkChanges;
+
+    /// Shortest path trees based on the source node ID
+    static LruCache<uint32_t, ShortestPathTree> g_trees;
+
     /** Cache stores nix-vectors based on destination ip */
-    mutable NixMap_t m_nixCache;
+    mutable LruCache<IpAddress, NixCacheEntry> m_nixCache;
 
     /** Cache stores IpRoutes based on destination ip */
-    mutable IpRouteMap_t m_ipRouteCache;
+    mutable LruCache<IpAddress, IpRouteCacheEntry> m_ipRouteCache;
+
+    uint32_t m_nixCacheSize;     //!< Maximum number of cached nix-vectors, or 0 for no limit
+    uint32_t m_ipRouteCacheSize; //!< Maximum number of cached routes, or 0 for no limit
 
     Ptr<Ip> m_ip;     //!< IP object
     Ptr<Node> m_node; //!< Node object
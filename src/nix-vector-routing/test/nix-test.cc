@@ -14,6 +14,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/nix-vector-helper.h"
+#include "ns3/nix-vector-routing.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -21,6 +22,7 @@
 #include "ns3/test.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -382,6 +384,142 @@ NixVectorRoutingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup nix-vector-routing-test
+ * @ingroup tests
+ *
+ * The topology is of the form:
+ * @verbatim
+    nSrc -- nA -- nB -- nC -- nD
+   \endverbatim
+ *
+ * nSrc caches a single nix-vector and a single route.
+ *
+ * Following are the tests in this test case:
+ * - Test that nSrc keeps the nix-vector of its last destination only.
+ * (Set down the interface of nD on nC-nD channel.)
+ * - Test that the nix-vector of nB, whose path avoids the changed channel,
+ *   is kept.
+ * - Test the routing from nSrc to nB with the kept nix-vector.
+ *
+ * @brief IPv4 Nix-Vector Routing Cache Invalidation Test
+ */
+class NixVectorRoutingCacheTest : public TestCase
+{
+    uint32_t m_received; //!< Number of received packets
+
+    /**
+     * @brief Receive data.
+     * @param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+
+    /**
+     * @brief Send data immediately after being called.
+     * @param socket The sending socket.
+     * @param to IPv4 Destination address.
+     */
+    void DoSendData(Ptr<Socket> socket, Ipv4Address to);
+
+  public:
+    void DoRun() override;
+    NixVectorRoutingCacheTest();
+};
+
+NixVectorRoutingCacheTest::NixVectorRoutingCacheTest()
+    : TestCase("link change invalidation and bounded cache test"),
+      m_received(0)
+{
+}
+
+void
+NixVectorRoutingCacheTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_received++;
+    }
+}
+
+void
+NixVectorRoutingCacheTest::DoSendData(Ptr<Socket> socket, Ipv4Address to)
+{
+    socket->SendTo(Create<Packet>(123), 0, InetSocketAddress(to, 1234));
+}
+
+void
+NixVectorRoutingCacheTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(5);
+
+    Ipv4NixVectorHelper ipv4NixRouting;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(ipv4NixRouting);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.255.0");
+    NetDeviceContainer lastDevices;
+    for (uint32_t i = 0; i + 1 < nodes.GetN(); i++)
+    {
+        lastDevices = devHelper.Install(NodeContainer(nodes.Get(i), nodes.Get(i + 1)));
+        address.Assign(lastDevices);
+        address.NewNetwork();
+    }
+
+    Ptr<Ipv4NixVectorRouting> srcRouting = nodes.Get(0)->GetObject<Ipv4NixVectorRouting>();
+    srcRouting->SetAttribute("NixCacheSize", UintegerValue(1));
+    srcRouting->SetAttribute("IpRouteCacheSize", UintegerValue(1));
+
+    Ptr<Socket> rxSocket = nodes.Get(2)->GetObject<UdpSocketFactory>()->CreateSocket();
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234)),
+                          0,
+                          "trivial");
+    rxSocket->SetRecvCallback(MakeCallback(&NixVectorRoutingCacheTest::ReceivePkt, this));
+    Ptr<Socket> txSocket = nodes.Get(0)->GetObject<UdpSocketFactory>()->CreateSocket();
+
+    const Ipv4Address nB("10.1.1.2");
+    const Ipv4Address nD("10.1.3.2");
+    Simulator::Schedule(Seconds(1), &NixVectorRoutingCacheTest::DoSendData, this, txSocket, nD);
+    Simulator::Schedule(Seconds(2), &NixVectorRoutingCacheTest::DoSendData, this, txSocket, nB);
+
+    std::ostringstream boundedCache;
+    Ipv4NixVectorHelper::PrintRoutingTableAt(Seconds(3),
+                                             nodes.Get(0),
+                                             Create<OutputStreamWrapper>(&boundedCache));
+
+    // Set the nD interface on nC - nD channel down.
+    Ptr<Ipv4> ipv4 = nodes.Get(4)->GetObject<Ipv4>();
+    int32_t ifIndex = ipv4->GetInterfaceForDevice(lastDevices.Get(1));
+    Simulator::Schedule(Seconds(4), &Ipv4::SetDown, ipv4, ifIndex);
+
+    std::ostringstream keptCache;
+    Ipv4NixVectorHelper::PrintRoutingTableAt(Seconds(5),
+                                             nodes.Get(0),
+                                             Create<OutputStreamWrapper>(&keptCache));
+    Simulator::Schedule(Seconds(6), &NixVectorRoutingCacheTest::DoSendData, this, txSocket, nB);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, 2, "nB should have received 2 packets.");
+    for (const auto& cache : {boundedCache.str(), keptCache.str()})
+    {
+        NS_TEST_EXPECT_MSG_NE(cache.find("NixCache:\nDestination"),
+                              std::string::npos,
+                              "The nix-vector of nB should be cached.");
+        NS_TEST_EXPECT_MSG_EQ(cache.find("10.1.3.2"),
+                              std::string::npos,
+                              "The nix-vector and route of nD should have been evicted.");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup nix-vector-routing-test
  * @ingroup tests
@@ -395,6 +533,7 @@ class NixVectorRoutingTestSuite : public TestSuite
         : TestSuite("nix-vector-routing", Type::UNIT)
     {
         AddTestCase(new NixVectorRoutingTest(), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorRoutingCacheTest(), TestCase::Duration::QUICK);
     }
 };
 
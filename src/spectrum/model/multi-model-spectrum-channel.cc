@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -116,6 +117,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         if (phyIt != rxInfoIterator->second.m_rxPhys.end())
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
+            rxInfoIterator->second.m_grid = CreateGrid(rxInfoIterator->second.m_rxPhys);
             --m_numDevices;
             break; // there should be at most one entry
         }
@@ -145,6 +147,16 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    auto& rxInfo = rxInfoIterator->second;
+    if (rxInfo.m_grid)
+    {
+        rxInfo.m_grid->Add(static_cast<uint32_t>(rxInfo.m_rxPhys.size() - 1),
+                           MakeCallback(&SpectrumPhy::GetMobility, phy));
+    }
+    else
+    {
+        rxInfo.m_grid = CreateGrid(rxInfo.m_rxPhys);
+    }
 
     if (inserted)
     {
@@ -170,6 +182,17 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     }
 }
 
+void
+MultiModelSpectrumChannel::SetMaxRange(double range)
+{
+    NS_LOG_FUNCTION(this << range);
+    SpectrumChannel::SetMaxRange(range);
+    for (auto& [rxSpectrumModelUid, rxInfo] : m_rxSpectrumModelInfoMap)
+    {
+        rxInfo.m_grid = CreateGrid(rxInfo.m_rxPhys);
+    }
+}
+
 TxSpectrumModelInfoMap_t::const_iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel(
     Ptr<const SpectrumModel> txSpectrumModel)
@@ -278,6 +301,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
     }
 
+    std::vector<Simulator::ContextEvent> events;
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -299,9 +323,20 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             continue;
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        // Only look at the receivers within range, if the range is limited
+        std::vector<Ptr<SpectrumPhy>> inRange;
+        const auto& grid = rxInfoIterator->second.m_grid;
+        const bool limited = grid && refTxMobility && !wraparound;
+        if (limited)
+        {
+            for (auto i : grid->GetWithin(refTxMobility->GetPosition(), m_maxRange))
+            {
+                inRange.push_back(rxInfoIterator->second.m_rxPhys[i]);
+            }
+        }
+        const auto& rxPhys = limited ? inRange : rxInfoIterator->second.m_rxPhys;
+
+        for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
         {
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
@@ -371,25 +406,17 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                               .params = rxParams,
                               .receiver = *rxPhyIterator,
                               .availableConvertedPsds = convertedPsds};
-                if (rxNetDevice)
-                {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    auto dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxInfo);
-                }
-                else
-                {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay, &MultiModelSpectrumChannel::StartRx, this, rxInfo);
-                }
+                // If the receiver has a NetDevice, we expect that it is attached to a Node;
+                // otherwise we cannot assume that it is attached to a node, and the
+                // reception keeps the current context
+                auto dstNode =
+                    rxNetDevice ? rxNetDevice->GetNode()->GetId() : Simulator::GetContext();
+                events.push_back(
+                    {dstNode, delay, MakeEvent(&MultiModelSpectrumChannel::StartRx, this, rxInfo)});
             }
         }
     }
+    Simulator::ScheduleWithContextBatch(events);
 }
 
 void
@@ -68,6 +68,7 @@ class RxSpectrumModelInfo
 
     Ptr<const SpectrumModel> m_rxSpectrumModel; //!< Rx Spectrum model.
     std::vector<Ptr<SpectrumPhy>> m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
+    Ptr<SpatialGrid> m_grid;                    //!< Positions of the Rx phys, if range limited.
 };
 
 /**
@@ -104,6 +105,7 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     void RemoveRx(Ptr<SpectrumPhy> phy) override;
     void AddRx(Ptr<SpectrumPhy> phy) override;
     void StartTx(Ptr<SpectrumSignalParameters> params) override;
+    void SetMaxRange(double range) override;
 
     // inherited from Channel
     std::size_t GetNDevices() const override;
@@ -28,6 +28,7 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace ns3
 {
@@ -46,6 +47,7 @@ SingleModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_grid = nullptr;
     m_spectrumModel = nullptr;
     SpectrumChannel::DoDispose();
 }
@@ -69,6 +71,7 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     if (it != std::end(m_phyList))
     {
         m_phyList.erase(it);
+        m_grid = CreateGrid(m_phyList);
     }
 }
 
@@ -79,6 +82,11 @@ SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     if (std::find(m_phyList.cbegin(), m_phyList.cend(), phy) == m_phyList.cend())
     {
         m_phyList.push_back(phy);
+        if (m_grid)
+        {
+            m_grid->Add(static_cast<uint32_t>(m_phyList.size() - 1),
+                        MakeCallback(&SpectrumPhy::GetMobility, phy));
+        }
     }
     else
     {
@@ -87,6 +95,14 @@ SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     }
 }
 
+void
+SingleModelSpectrumChannel::SetMaxRange(double range)
+{
+    NS_LOG_FUNCTION(this << range);
+    SpectrumChannel::SetMaxRange(range);
+    m_grid = CreateGrid(m_phyList);
+}
+
 void
 SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 {
@@ -116,7 +132,20 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     Ptr<MobilityModel> refSenderMobility = txParams->txPhy->GetMobility();
     Ptr<MobilityModel> senderMobility = refSenderMobility;
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    // Only look at the receivers within range, if the range is limited
+    PhyList inRange;
+    const bool limited = m_grid && refSenderMobility && !wraparound;
+    if (limited)
+    {
+        for (auto i : m_grid->GetWithin(refSenderMobility->GetPosition(), m_maxRange))
+        {
+            inRange.push_back(m_phyList[i]);
+        }
+    }
+    const PhyList& rxPhys = limited ? inRange : m_phyList;
+
+    std::vector<Simulator::ContextEvent> events;
+    for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
         Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
@@ -206,29 +235,18 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 }
             }
 
-            if (rxNetDevice)
-            {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
-            }
-            else
-            {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
-            }
+            // If the receiver has a NetDevice, we expect that it is attached to a Node;
+            // otherwise we cannot assume that it is attached to a node, and the
+            // reception keeps the current context
+            uint32_t dstNode =
+                rxNetDevice ? rxNetDevice->GetNode()->GetId() : Simulator::GetContext();
+            events.push_back(
+                {dstNode,
+                 delay,
+                 MakeEvent(&SingleModelSpectrumChannel::StartRx, this, rxParams, *rxPhyIterator)});
         }
     }
+    Simulator::ScheduleWithContextBatch(events);
 }
 
 void
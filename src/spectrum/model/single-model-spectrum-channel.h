@@ -39,6 +39,7 @@ class SingleModelSpectrumChannel : public SpectrumChannel
     void RemoveRx(Ptr<SpectrumPhy> phy) override;
     void AddRx(Ptr<SpectrumPhy> phy) override;
     void StartTx(Ptr<SpectrumSignalParameters> params) override;
+    void SetMaxRange(double range) override;
 
     // inherited from Channel
     std::size_t GetNDevices() const override;
@@ -63,6 +64,11 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      */
     PhyList m_phyList;
 
+    /**
+     * Positions of the SpectrumPhy instances, if the range is limited.
+     */
+    Ptr<SpatialGrid> m_grid;
+
     /**
      * SpectrumModel that this channel instance is supporting.
      */
@@ -21,6 +21,7 @@ NS_LOG_COMPONENT_DEFINE("SpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED(SpectrumChannel);
 
 SpectrumChannel::SpectrumChannel()
+    : m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -69,6 +70,21 @@ SpectrumChannel::GetTypeId()
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
 
+            .AddAttribute("MaxRange",
+                          "If positive, the maximum distance (m) between the transmitter "
+                          "and the receivers of a transmission. Unlike MaxLossDb, which "
+                          "is checked once the loss to each receiver is computed, the "
+                          "receivers beyond this distance are not looked at: they are "
+                          "found with a spatial index of the positions of the receivers, "
+                          "and no loss is computed or traced for them. This parameter "
+                          "reduces the computational load of large networks, provided "
+                          "that the distance is beyond the interference range. It is not "
+                          "used with a WraparoundModel. Zero means no limit.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::SetMaxRange,
+                                             &SpectrumChannel::GetMaxRange),
+                          MakeDoubleChecker<double>(0))
+
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
                           PointerValue(nullptr),
@@ -111,6 +127,34 @@ SpectrumChannel::GetTypeId()
     return tid;
 }
 
+void
+SpectrumChannel::SetMaxRange(double range)
+{
+    NS_LOG_FUNCTION(this << range);
+    m_maxRange = range;
+}
+
+double
+SpectrumChannel::GetMaxRange() const
+{
+    return m_maxRange;
+}
+
+Ptr<SpatialGrid>
+SpectrumChannel::CreateGrid(const std::vector<Ptr<SpectrumPhy>>& phys) const
+{
+    if (m_maxRange <= 0)
+    {
+        return nullptr;
+    }
+    auto grid = Create<SpatialGrid>(m_maxRange);
+    for (uint32_t i = 0; i < phys.size(); i++)
+    {
+        grid->Add(i, MakeCallback(&SpectrumPhy::GetMobility, phys[i]));
+    }
+    return grid;
+}
+
 void
 SpectrumChannel::AddPropagationLossModel(Ptr<PropagationLossModel> loss)
 {
@@ -21,6 +21,7 @@
 #include "ns3/object.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/spatial-grid.h"
 #include "ns3/traced-callback.h"
 
 namespace ns3
@@ -184,6 +185,20 @@ class SpectrumChannel : public Channel
      */
     virtual void AddRx(Ptr<SpectrumPhy> phy) = 0;
 
+    /**
+     * Set the distance beyond which the receivers are not passed the
+     * transmissions.
+     *
+     * @param range the distance (m), or zero for no limit
+     */
+    virtual void SetMaxRange(double range);
+
+    /**
+     * @return the distance beyond which the receivers are not passed the
+     * transmissions (m), or zero
+     */
+    double GetMaxRange() const;
+
     /**
      * TracedCallback signature for path loss calculation events.
      *
@@ -227,6 +242,17 @@ class SpectrumChannel : public Channel
      */
     virtual int64_t DoAssignStreams(int64_t stream);
 
+    /**
+     * Create the index of the positions of receivers, if the range of the
+     * transmissions is limited.  The mobility models of the receivers are
+     * looked up at the first transmission.
+     *
+     * @param phys the receivers
+     * @return the index of the receivers, identified by their position in
+     * \pname{phys}, or null if the range is not limited
+     */
+    Ptr<SpatialGrid> CreateGrid(const std::vector<Ptr<SpectrumPhy>>& phys) const;
+
     /**
      * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
      * SpectrumPhy and a pathloss value, in dB.
@@ -258,6 +284,13 @@ class SpectrumChannel : public Channel
      */
     double m_maxLossDb;
 
+    /**
+     * Maximum distance between the transmitter and the receivers [m], or zero.
+     *
+     * Any device beyond this distance is considered out of range.
+     */
+    double m_maxRange;
+
     /**
      * Single-frequency propagation loss model to be used with this channel.
      */
@@ -72,6 +72,26 @@ ConvertAlignedSpectrumModels(Ptr<const SpectrumValue> txPsd,
     return convertedPsd;
 }
 
+/**
+ * Sum the products of contiguous values by their conversion coefficients, in their order,
+ * so that the result does not depend on the way it is computed.
+ *
+ * @param values the values to convert
+ * @param coeffs the conversion coefficients of the values
+ * @param n the number of values
+ * @return the sum of the products
+ */
+double
+DotProduct(const double* values, const double* coeffs, size_t n)
+{
+    double sum = 0;
+    for (size_t k = 0; k < n; ++k)
+    {
+        sum += values[k] * coeffs[k];
+    }
+    return sum;
+}
+
 } // namespace
 
 SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
@@ -143,14 +163,23 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
     auto tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
     auto tvit = tvvf->ValuesBegin();
+    const auto fromValues = fvvf->GetValues().data();
     size_t i = 0; // Index of conversion coefficient
 
     for (auto convIt = m_conversionRowPtr.begin(); convIt != m_conversionRowPtr.end(); ++convIt)
     {
         double sum = 0;
+        const auto n = *convIt - i;
+        if (n > 0 && m_conversionColInd[*convIt - 1] - m_conversionColInd[i] == n - 1)
+        {
+            // the bands overlapping a band of the target model are usually contiguous,
+            // hence their values are read without going through their column indices
+            sum = DotProduct(fromValues + m_conversionColInd[i], &m_conversionMatrix[i], n);
+            i = *convIt;
+        }
         while (i < *convIt)
         {
-            sum += (*fvvf)[m_conversionColInd[i]] * m_conversionMatrix[i];
+            sum += fromValues[m_conversionColInd[i]] * m_conversionMatrix[i];
             ++i;
         }
         *tvit = sum;
@@ -22,11 +22,14 @@
 #include "ns3/shuffle.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <map>
 #include <random>
+#include <thread>
 
 namespace ns3
 {
@@ -53,6 +56,22 @@ constexpr double kMaxConsistencyStepMeters = 1.0;
  */
 static constexpr double kNoDisplacementEpsMeters = 1e-6;
 
+/**
+ * Minimum number of (rx element, tx element) pairs of a channel matrix for its
+ * coefficients to be computed by several threads.
+ *
+ * The coefficients of smaller matrices are computed faster than the threads are started.
+ */
+static constexpr size_t MIN_PARALLEL_ELEMENT_PAIRS = 1024;
+
+/**
+ * Number of consecutive rx elements whose coefficients are computed by the same thread.
+ *
+ * The coefficients of consecutive rx elements are adjacent in memory: the threads write
+ * blocks of them to avoid sharing cache lines.
+ */
+static constexpr size_t PARALLEL_ROW_BLOCK = 8;
+
 /// The ray offset angles within a cluster, given for rms angle spread normalized to 1.
 /// (Table 7.5-3)
 static constexpr std::array offSetAlpha = {
@@ -1141,6 +1160,7 @@ ThreeGppChannelModel::DoDispose()
     m_channelMatrixMap.clear();
     m_channelParamsMap.clear();
     m_channelConditionModel = nullptr;
+    m_workerPool.Stop();
 }
 
 TypeId
@@ -1209,7 +1229,15 @@ ThreeGppChannelModel::GetTypeId()
                           "delayed (reflected) paths",
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&ThreeGppChannelModel::m_vScatt),
-                          MakeDoubleChecker<double>(0.0));
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("Threads",
+                          "The number of threads computing the coefficients of a channel matrix, "
+                          "or 0 for one per hardware thread. The random variables are drawn by "
+                          "the simulation thread only, so the channel matrices do not depend on "
+                          "the number of threads.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::m_threads),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -4145,25 +4173,12 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         sPols[i] = sAntenna->GetElemPol(i);
     }
 
-    // The rx-side rotation exp(j*rxArg) depends only on (cluster, uIndex, ray),
-    // and its product with raysPreComp(n, m) does not depend on sIndex, so both
-    // are hoisted out of the sIndex loop: for each (cluster, uIndex) the product
-    // is folded into this per-ray scratch for every possible tx polarization,
-    // leaving the innermost loop as rays += rxPre[m] * exp(j*txArg).
-    // The scratch is split into real/imag halves so that the innermost ray loop
-    // is plain double arithmetic: it stays fast in unoptimized (-O0) builds and
-    // avoids the NaN-recovery branches of std::complex operator*.
-    std::array<std::vector<double>, 2> rxPreRe{std::vector<double>(nRays),
-                                               std::vector<double>(nRays)};
-    std::array<std::vector<double>, 2> rxPreIm{std::vector<double>(nRays),
-                                               std::vector<double>(nRays)};
-
     // The tx-side rotation exp(j*txArg) depends only on (cluster, sIndex, ray),
-    // not on the rx element, so it is precomputed once per cluster into a flat
-    // [sIndex * nRays + ray] table, also split into real (cos) and imag (sin)
-    // halves, that the (u, s, m) loops below read by index.
-    std::vector<double> txRotRe(sSize * nRays);
-    std::vector<double> txRotIm(sSize * nRays);
+    // not on the rx element, so it is precomputed once for all the clusters into
+    // a flat [(cluster * sSize + sIndex) * nRays + ray] table, split into real
+    // (cos) and imag (sin) halves, that the (u, n, s, m) loops below read by index.
+    std::vector<double> txRotRe(nm * sSize);
+    std::vector<double> txRotIm(nm * sSize);
 
     // Cluster-power normalisation factor: clusterPower changes per
     // cluster but is constant across (u,s,m). Hoist sqrt out of the
@@ -4245,8 +4260,8 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     std::vector<double> basePhasorIm(useSeparableTxSteering ? nRays : 0);
 
     // Fill txRotRe/txRotIm with exp(j*txArg) for every (s, ray) of the cluster
-    // whose ray angle caches start at nmBase, using the separable lattice
-    // factorization described above.
+    // whose ray angle caches start at nmBase (and whose txRot table starts at
+    // nmBase * sSize), using the separable lattice factorization described above.
     auto fillTxRotationSeparable = [&](size_t nmBase) {
         // First build the base, row and column phasor tables:
         // (1 + sNumRows + sNumCols) * nRays sincos calls.
@@ -4280,7 +4295,7 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         // with two complex multiplies per (s, ray) and no further trig.
         for (size_t sIndex = 0; sIndex < sSize; ++sIndex)
         {
-            const size_t sBase = sIndex * nRays;
+            const size_t sBase = nmBase * sSize + sIndex * nRays;
             const size_t rowOffset = static_cast<size_t>(sRowIdx[sIndex]) * nRays;
             const size_t colOffset = static_cast<size_t>(sColIdx[sIndex]) * nRays;
             for (uint8_t mIndex = 0; mIndex < nRays; mIndex++)
@@ -4304,7 +4319,7 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         for (size_t sIndex = 0; sIndex < sSize; sIndex++)
         {
             const Vector& sLoc = sLocs[sIndex];
-            const size_t sBase = sIndex * nRays;
+            const size_t sBase = nmBase * sSize + sIndex * nRays;
             for (uint8_t mIndex = 0; mIndex < nRays; mIndex++)
             {
                 const size_t idx = nmBase + mIndex;
@@ -4317,18 +4332,11 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     };
 
-    // The following for loops computes the channel coefficients.
-    // Keeps track of how many sub-clusters have been added up to now.
-    uint8_t numSubClustersAdded = 0;
+    // The tx-side rotations of all the clusters are computed first, so that the
+    // rows of the channel matrix below only read shared tables.
     for (uint8_t nIndex = 0; nIndex < nClusters; nIndex++)
     {
-        const bool isStrongest =
-            nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd;
         const size_t nmBase = static_cast<size_t>(nIndex) * nRays;
-        const double scale = clusterScale[nIndex];
-
-        // Precompute the tx-side rotation exp(j*txArg) for every (s, ray) of
-        // this cluster, once (see the txRot / separable-steering notes above).
         if (useSeparableTxSteering)
         {
             fillTxRotationSeparable(nmBase);
@@ -4337,11 +4345,46 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         {
             fillTxRotationPerElement(nmBase);
         }
+    }
 
-        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+    // The two strongest clusters are split into 3 sub-clusters: the first one
+    // keeps the page of the cluster, and the other two are appended after the
+    // nClusters pages, in the order of the clusters.
+    std::vector<uint16_t> subClusterPage(nClusters, 0);
+    uint16_t numSubClustersAdded = 0;
+    for (uint8_t nIndex = 0; nIndex < nClusters; nIndex++)
+    {
+        if (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd)
         {
-            const Vector& uLoc = uLocs[uIndex];
-            const uint8_t polU = uPols[uIndex];
+            subClusterPage[nIndex] = nClusters + numSubClustersAdded;
+            numSubClustersAdded += 2;
+        }
+    }
+
+    // The following function computes the channel coefficients of an rx element,
+    // which are a row of every page of hUsn. No other row reads them, hence the
+    // rows can be computed by several threads without changing the coefficients.
+    //
+    // The rx-side rotation exp(j*rxArg) depends only on (cluster, uIndex, ray),
+    // and its product with raysPreComp(n, m) does not depend on sIndex, so both
+    // are hoisted out of the sIndex loop: for each (cluster, uIndex) the product
+    // is folded into the per-ray scratch rxPre for every possible tx polarization,
+    // leaving the innermost loop as rays += rxPre[m] * exp(j*txArg).
+    // The scratch is split into real/imag halves so that the innermost ray loop
+    // is plain double arithmetic: it stays fast in unoptimized (-O0) builds and
+    // avoids the NaN-recovery branches of std::complex operator*.
+    auto computeRow = [&](size_t uIndex,
+                          std::array<std::vector<double>, 2>& rxPreRe,
+                          std::array<std::vector<double>, 2>& rxPreIm) {
+        const Vector& uLoc = uLocs[uIndex];
+        const uint8_t polU = uPols[uIndex];
+
+        for (uint8_t nIndex = 0; nIndex < nClusters; nIndex++)
+        {
+            const bool isStrongest =
+                nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd;
+            const size_t nmBase = static_cast<size_t>(nIndex) * nRays;
+            const double scale = clusterScale[nIndex];
 
             // Fold the rx-side rotation exp(j*rxArg) of this (cluster, u)
             // into raysPreComp, for each possible tx polarization, so the
@@ -4370,8 +4413,8 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                 const uint8_t polS = sPols[sIndex];
                 const double* preRe = rxPreRe[polS].data();
                 const double* preIm = rxPreIm[polS].data();
-                const double* txRe = &txRotRe[sIndex * nRays];
-                const double* txIm = &txRotIm[sIndex * nRays];
+                const double* txRe = &txRotRe[nmBase * sSize + sIndex * nRays];
+                const double* txIm = &txRotIm[nmBase * sSize + sIndex * nRays];
 
                 if (!isStrongest)
                 {
@@ -4435,18 +4478,45 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     }
                     hUsn(uIndex, sIndex, nIndex) =
                         std::complex<double>(sub1Re * scale, sub1Im * scale);
-                    hUsn(uIndex, sIndex, nClusters + numSubClustersAdded) =
+                    hUsn(uIndex, sIndex, subClusterPage[nIndex]) =
                         std::complex<double>(sub2Re * scale, sub2Im * scale);
-                    hUsn(uIndex, sIndex, nClusters + numSubClustersAdded + 1) =
+                    hUsn(uIndex, sIndex, subClusterPage[nIndex] + 1) =
                         std::complex<double>(sub3Re * scale, sub3Im * scale);
                 }
             }
         }
-        if (isStrongest)
+    };
+
+    // Each thread computes the blocks of rows taken from a shared counter, until
+    // there is none left, with its own scratch.
+    auto computeRows = [&](std::atomic<size_t>& nextRow) {
+        std::array<std::vector<double>, 2> rxPreRe{std::vector<double>(nRays),
+                                                   std::vector<double>(nRays)};
+        std::array<std::vector<double>, 2> rxPreIm{std::vector<double>(nRays),
+                                                   std::vector<double>(nRays)};
+        for (size_t firstRow = nextRow.fetch_add(PARALLEL_ROW_BLOCK); firstRow < uSize;
+             firstRow = nextRow.fetch_add(PARALLEL_ROW_BLOCK))
         {
-            numSubClustersAdded += 2;
+            const size_t lastRow = std::min(firstRow + PARALLEL_ROW_BLOCK, uSize);
+            for (size_t uIndex = firstRow; uIndex < lastRow; uIndex++)
+            {
+                computeRow(uIndex, rxPreRe, rxPreIm);
+            }
         }
+    };
+
+    std::size_t threads = m_threads;
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    if (uSize * sSize < MIN_PARALLEL_ELEMENT_PAIRS)
+    {
+        threads = 1;
     }
+    threads = std::min(threads, (uSize + PARALLEL_ROW_BLOCK - 1) / PARALLEL_ROW_BLOCK);
+    std::atomic<size_t> nextRow{0};
+    m_workerPool.Run(threads, [&]() { computeRows(nextRow); });
 
     if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
     {
@@ -12,6 +12,7 @@
 #define THREE_GPP_CHANNEL_H
 
 #include "matrix-based-channel-model.h"
+#include "worker-pool.h"
 
 #include "ns3/channel-condition-model.h"
 
@@ -1133,6 +1134,11 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     /// the blocker speed
     double m_blockerSpeed;
 
+    /// the number of threads computing the coefficients of a channel matrix
+    uint32_t m_threads;
+    /// the threads computing the coefficients of a channel matrix with the simulation thread
+    mutable WorkerPool m_workerPool;
+
     /// index of the PHI value in the m_nonSelfBlocking array
     static constexpr uint8_t PHI_INDEX = 0;
     /// index of the X value in the m_nonSelfBlocking array
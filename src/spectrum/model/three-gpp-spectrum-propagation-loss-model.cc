@@ -19,8 +19,11 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 namespace ns3
 {
@@ -44,6 +47,7 @@ ThreeGppSpectrumPropagationLossModel::DoDispose()
 {
     m_longTermMap.clear();
     m_channelModel = nullptr;
+    m_workerPool.Stop();
 }
 
 TypeId
@@ -60,7 +64,13 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId()
                 StringValue("ns3::ThreeGppChannelModel"),
                 MakePointerAccessor(&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                     &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
-                MakePointerChecker<MatrixBasedChannelModel>());
+                MakePointerChecker<MatrixBasedChannelModel>())
+            .AddAttribute("Threads",
+                          "The number of threads computing the long term component of a "
+                          "channel matrix, or 0 for one per hardware thread.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ThreeGppSpectrumPropagationLossModel::m_threads),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -104,6 +114,12 @@ ThreeGppSpectrumPropagationLossModel::GetChannelModelAttribute(const std::string
 namespace
 {
 
+/**
+ * Minimum number of products of the weights and the coefficients of a channel
+ * matrix for its long term component to be computed by several threads.
+ */
+constexpr size_t MIN_PARALLEL_PRODUCTS = 1 << 16;
+
 /**
  * Compute the array-index offsets, relative to a port's first element, of all
  * elements belonging to one port of a phased array.
@@ -188,47 +204,65 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     const size_t numRows = channelMatrix->m_channel.GetNumRows();
     const size_t sPortElems = sOffsets.size();
     const size_t uPortElems = uOffsets.size();
-    for (uint16_t sPortIdx = 0; sPortIdx < sPorts; ++sPortIdx)
-    {
-        const size_t startS = sAnt->ArrayIndexFromPortIndex(sPortIdx, 0);
-        for (uint16_t uPortIdx = 0; uPortIdx < uPorts; ++uPortIdx)
+    // Each cluster page of the long term only depends on the same page of the
+    // channel matrix, hence the pages can be computed by several threads, which
+    // take the next page from a shared counter until there is none left.
+    auto computePages = [&](std::atomic<size_t>& nextPage) {
+        for (size_t cIndex = nextPage++; cIndex < numClusters; cIndex = nextPage++)
         {
-            const size_t startU = uAnt->ArrayIndexFromPortIndex(uPortIdx, 0);
-            for (size_t cIndex = 0; cIndex < numClusters; ++cIndex)
+            const auto* pagePtr = channelMatrix->m_channel.GetPagePtr(cIndex);
+            for (uint16_t sPortIdx = 0; sPortIdx < sPorts; ++sPortIdx)
             {
-                const auto* pagePtr = channelMatrix->m_channel.GetPagePtr(cIndex);
-                std::complex<double> txSum(0, 0);
-                if (uPortElems == 1)
+                const size_t startS = sAnt->ArrayIndexFromPortIndex(sPortIdx, 0);
+                for (uint16_t uPortIdx = 0; uPortIdx < uPorts; ++uPortIdx)
                 {
-                    // One rx element per port (the typical NR UE layout):
-                    // the rx-side reduction is a single multiply.
-                    const std::complex<double> uWeightConj0 = uWeightsConj[0];
-                    for (size_t tIndex = 0; tIndex < sPortElems; ++tIndex)
+                    const size_t startU = uAnt->ArrayIndexFromPortIndex(uPortIdx, 0);
+                    std::complex<double> txSum(0, 0);
+                    if (uPortElems == 1)
                     {
-                        const size_t sIndex = startS + sOffsets[tIndex];
-                        txSum += sWeights[sOffsets[tIndex]] *
-                                 (uWeightConj0 * pagePtr[startU + numRows * sIndex]);
+                        // One rx element per port (the typical NR UE layout):
+                        // the rx-side reduction is a single multiply.
+                        const std::complex<double> uWeightConj0 = uWeightsConj[0];
+                        for (size_t tIndex = 0; tIndex < sPortElems; ++tIndex)
+                        {
+                            const size_t sIndex = startS + sOffsets[tIndex];
+                            txSum += sWeights[sOffsets[tIndex]] *
+                                     (uWeightConj0 * pagePtr[startU + numRows * sIndex]);
+                        }
                     }
-                }
-                else
-                {
-                    for (size_t tIndex = 0; tIndex < sPortElems; ++tIndex)
+                    else
                     {
-                        const size_t sIndex = startS + sOffsets[tIndex];
-                        const auto* column = &pagePtr[numRows * sIndex];
-                        std::complex<double> rxSum(0, 0);
-                        for (size_t rIndex = 0; rIndex < uPortElems; ++rIndex)
+                        for (size_t tIndex = 0; tIndex < sPortElems; ++tIndex)
                         {
-                            rxSum +=
-                                uWeightsConj[uOffsets[rIndex]] * column[startU + uOffsets[rIndex]];
+                            const size_t sIndex = startS + sOffsets[tIndex];
+                            const auto* column = &pagePtr[numRows * sIndex];
+                            std::complex<double> rxSum(0, 0);
+                            for (size_t rIndex = 0; rIndex < uPortElems; ++rIndex)
+                            {
+                                rxSum += uWeightsConj[uOffsets[rIndex]] *
+                                         column[startU + uOffsets[rIndex]];
+                            }
+                            txSum += sWeights[sOffsets[tIndex]] * rxSum;
                         }
-                        txSum += sWeights[sOffsets[tIndex]] * rxSum;
                     }
+                    longTerm->Elem(uPortIdx, sPortIdx, cIndex) = txSum;
                 }
-                longTerm->Elem(uPortIdx, sPortIdx, cIndex) = txSum;
             }
         }
+    };
+
+    std::size_t threads = m_threads;
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    if (numClusters * sPorts * uPorts * sPortElems * uPortElems < MIN_PARALLEL_PRODUCTS)
+    {
+        threads = 1;
     }
+    threads = std::min(threads, numClusters);
+    std::atomic<size_t> nextPage{0};
+    m_workerPool.Run(threads, [&]() { computePages(nextPage); });
     return longTerm;
 }
 
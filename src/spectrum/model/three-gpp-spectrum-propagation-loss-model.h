@@ -12,6 +12,7 @@
 
 #include "matrix-based-channel-model.h"
 #include "phased-array-spectrum-propagation-loss-model.h"
+#include "worker-pool.h"
 
 #include "ns3/random-variable-stream.h"
 
@@ -20,6 +21,7 @@
 
 class ThreeGppCalcLongTermMultiPortTest;
 class ThreeGppMimoPolarizationTest;
+class ThreeGppParallelChannelMatrixTest;
 
 namespace ns3
 {
@@ -44,6 +46,7 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
 {
     friend class ::ThreeGppCalcLongTermMultiPortTest;
     friend class ::ThreeGppMimoPolarizationTest;
+    friend class ::ThreeGppParallelChannelMatrixTest;
 
   public:
     /**
@@ -219,6 +222,10 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
     mutable std::unordered_map<uint64_t, Ptr<const LongTerm>> m_longTermMap;
     //! the model to generate the channel matrix
     Ptr<MatrixBasedChannelModel> m_channelModel;
+    //! the number of threads computing the long term component of a channel matrix
+    uint32_t m_threads;
+    //! the threads computing the long term components with the simulation thread
+    mutable WorkerPool m_workerPool;
 };
 } // namespace ns3
 
@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "worker-pool.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef __WIN32__
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("WorkerPool");
+
+/// The state shared by the threads of a pool
+struct WorkerPool::State
+{
+    std::mutex mutex;                           //!< protects the fields below
+    std::condition_variable start;              //!< notified when a task is posted or on stop
+    std::condition_variable done;               //!< notified when the last worker completes
+    const std::function<void()>* task{nullptr}; //!< the current task
+    std::size_t workers{0};                     //!< the number of threads running the task
+    std::size_t running{0};                     //!< the threads which did not complete it yet
+    uint64_t generation{0};                     //!< the number of tasks posted
+    bool stop{false};                           //!< whether the threads must exit
+    std::vector<std::thread> threads;           //!< the threads of the pool
+#ifndef __WIN32__
+    pid_t pid{getpid()}; //!< the process which started the threads
+#endif
+};
+
+WorkerPool::WorkerPool()
+    : m_state(nullptr)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+}
+
+void
+WorkerPool::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_state == nullptr)
+    {
+        return;
+    }
+#ifndef __WIN32__
+    if (m_state->pid != getpid())
+    {
+        // The threads, and possibly the lock, belong to the parent process
+        m_state = nullptr;
+        return;
+    }
+#endif
+    {
+        std::lock_guard lock(m_state->mutex);
+        m_state->stop = true;
+    }
+    m_state->start.notify_all();
+    for (auto& thread : m_state->threads)
+    {
+        thread.join();
+    }
+    delete m_state;
+    m_state = nullptr;
+}
+
+void
+WorkerPool::Run(std::size_t threads, const std::function<void()>& task)
+{
+    NS_LOG_FUNCTION(this << threads);
+    if (threads <= 1)
+    {
+        task();
+        return;
+    }
+#ifndef __WIN32__
+    if (m_state != nullptr && m_state->pid != getpid())
+    {
+        Stop();
+    }
+#endif
+    if (m_state == nullptr)
+    {
+        m_state = new State;
+    }
+
+    std::unique_lock lock(m_state->mutex);
+    while (m_state->threads.size() < threads - 1)
+    {
+        m_state->threads.emplace_back(&WorkerPool::Work,
+                                      m_state,
+                                      m_state->threads.size(),
+                                      m_state->generation);
+    }
+    m_state->task = &task;
+    m_state->workers = threads - 1;
+    m_state->running = threads - 1;
+    m_state->generation++;
+    lock.unlock();
+    m_state->start.notify_all();
+
+    task();
+
+    lock.lock();
+    m_state->done.wait(lock, [this]() { return m_state->running == 0; });
+    m_state->task = nullptr;
+}
+
+void
+WorkerPool::Work(State* state, std::size_t index, uint64_t generation)
+{
+    std::unique_lock lock(state->mutex);
+    for (;;)
+    {
+        state->start.wait(lock,
+                          [state, generation]() {
+                              return state->stop || state->generation != generation;
+                          });
+        if (state->stop)
+        {
+            return;
+        }
+        generation = state->generation;
+        if (index >= state->workers)
+        {
+            continue;
+        }
+        const std::function<void()>* task = state->task;
+        lock.unlock();
+        (*task)();
+        lock.lock();
+        NS_ASSERT(state->running > 0);
+        if (--state->running == 0)
+        {
+            state->done.notify_one();
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace ns3
+{
+
+/**
+ * @ingroup spectrum
+ *
+ * Threads running a task together with the calling thread.
+ *
+ * The threads are started when a task first needs them, and wait for the
+ * next task until the pool is stopped or destroyed, so that a model which
+ * splits each of its computations over several threads does not start
+ * and join them on every computation.
+ *
+ * The threads do not survive a fork(): in a child process, the pool
+ * forgets the threads of the parent and starts its own.
+ */
+class WorkerPool
+{
+  public:
+    WorkerPool();
+    ~WorkerPool();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Run a task on several threads, and return when all of them returned.
+     *
+     * The calling thread is one of them, so that a single thread runs the
+     * task without any synchronization.
+     *
+     * @param threads the number of threads
+     * @param task the task, which the threads share
+     */
+    void Run(std::size_t threads, const std::function<void()>& task);
+
+    /**
+     * Stop and join the threads.  The next task starts them again.
+     */
+    void Stop();
+
+  private:
+    struct State;
+
+    /**
+     * Wait for the tasks of a pool and run them.
+     * @param state the state of the pool
+     * @param index the index of the thread in the pool
+     * @param generation the number of tasks posted before the thread started
+     */
+    static void Work(State* state, std::size_t index, uint64_t generation);
+
+    /// The threads and the task they run, allocated with the first thread
+    State* m_state;
+};
+
+} // namespace ns3
+
+#endif /* WORKER_POOL_H */
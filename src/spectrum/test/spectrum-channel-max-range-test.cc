@@ -0,0 +1,228 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/net-device.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief A SpectrumPhy counting the signals it receives.
+ */
+class MaxRangeTestSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param model the spectrum model of the received signals
+     */
+    MaxRangeTestSpectrumPhy(Ptr<const SpectrumModel> model)
+        : m_model(model),
+          m_rxCount(0)
+    {
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_rxCount++;
+    }
+
+    /**
+     * @return the number of signals received
+     */
+    uint32_t GetRxCount() const
+    {
+        return m_rxCount;
+    }
+
+  private:
+    Ptr<const SpectrumModel> m_model; //!< The spectrum model of the received signals.
+    Ptr<MobilityModel> m_mobility;    //!< The mobility model.
+    uint32_t m_rxCount;               //!< The number of signals received.
+};
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Check the receivers reached by the transmissions of a spectrum channel
+ * whose MaxRange attribute is set, or not.
+ *
+ * A transmitter sends a signal before and after a receiver beyond the range
+ * moves within the range: the receiver within the range gets both signals, the
+ * receiver which stays beyond the range gets none, and the moving receiver gets
+ * the second one.  Without a range, all the receivers get both signals.
+ */
+class SpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param channelType the TypeId name of the channel
+     * @param maxRange the MaxRange attribute of the channel, zero for no limit
+     */
+    SpectrumChannelMaxRangeTestCase(std::string channelType, double maxRange);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Add a receiver to the channel.
+     *
+     * @param position the position of the receiver
+     * @return the receiver
+     */
+    Ptr<MaxRangeTestSpectrumPhy> AddPhy(const Vector& position);
+
+    /**
+     * Start the transmission of a signal by the first receiver.
+     */
+    void StartTx();
+
+    std::string m_channelType;                        //!< The TypeId name of the channel.
+    double m_maxRange;                                //!< The MaxRange attribute of the channel.
+    Ptr<SpectrumModel> m_model;                       //!< The spectrum model of the signals.
+    Ptr<SpectrumChannel> m_channel;                   //!< The channel.
+    std::vector<Ptr<MaxRangeTestSpectrumPhy>> m_phys; //!< The receivers, the first one sending.
+};
+
+SpectrumChannelMaxRangeTestCase::SpectrumChannelMaxRangeTestCase(std::string channelType,
+                                                                 double maxRange)
+    : TestCase(channelType + (maxRange > 0 ? " with a maximum range" : " without maximum range")),
+      m_channelType(channelType),
+      m_maxRange(maxRange)
+{
+}
+
+Ptr<MaxRangeTestSpectrumPhy>
+SpectrumChannelMaxRangeTestCase::AddPhy(const Vector& position)
+{
+    auto mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(position);
+    auto phy = CreateObject<MaxRangeTestSpectrumPhy>(m_model);
+    phy->SetMobility(mobility);
+    m_channel->AddRx(phy);
+    m_phys.push_back(phy);
+    return phy;
+}
+
+void
+SpectrumChannelMaxRangeTestCase::StartTx()
+{
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(m_model);
+    (*params->psd) = 1e-12;
+    params->txPhy = m_phys.front();
+    params->duration = MicroSeconds(100);
+    m_channel->StartTx(params);
+}
+
+void
+SpectrumChannelMaxRangeTestCase::DoRun()
+{
+    m_model = Create<SpectrumModel>(std::vector<double>{2.4e9, 2.41e9});
+    ObjectFactory factory(m_channelType);
+    factory.Set("MaxRange", DoubleValue(m_maxRange));
+    m_channel = factory.Create<SpectrumChannel>();
+
+    AddPhy(Vector(0, 0, 0));
+    auto near = AddPhy(Vector(50, 0, 50));
+    auto far = AddPhy(Vector(150, 0, 0));
+    auto moving = AddPhy(Vector(-300, 20, 0));
+
+    Simulator::Schedule(Seconds(1), &SpectrumChannelMaxRangeTestCase::StartTx, this);
+    Simulator::Schedule(Seconds(2),
+                        &MobilityModel::SetPosition,
+                        moving->GetMobility(),
+                        Vector(-80, 20, 0));
+    Simulator::Schedule(Seconds(3), &SpectrumChannelMaxRangeTestCase::StartTx, this);
+    Simulator::Run();
+
+    const bool limited = m_maxRange > 0;
+    NS_TEST_EXPECT_MSG_EQ(m_phys.front()->GetRxCount(), 0, "The transmitter got its signals");
+    NS_TEST_EXPECT_MSG_EQ(near->GetRxCount(), 2, "The receiver within range missed a signal");
+    NS_TEST_EXPECT_MSG_EQ(far->GetRxCount(),
+                          (limited ? 0 : 2),
+                          "Wrong number of signals beyond range");
+    NS_TEST_EXPECT_MSG_EQ(moving->GetRxCount(),
+                          (limited ? 1 : 2),
+                          "Wrong number of signals received by the moving receiver");
+
+    Simulator::Destroy();
+    m_phys.clear();
+    m_channel = nullptr;
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Test suite for the MaxRange attribute of the spectrum channels
+ */
+class SpectrumChannelMaxRangeTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelMaxRangeTestSuite();
+};
+
+SpectrumChannelMaxRangeTestSuite::SpectrumChannelMaxRangeTestSuite()
+    : TestSuite("spectrum-channel-max-range", Type::UNIT)
+{
+    for (const auto& channelType :
+         {"ns3::SingleModelSpectrumChannel", "ns3::MultiModelSpectrumChannel"})
+    {
+        AddTestCase(new SpectrumChannelMaxRangeTestCase(channelType, 0),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new SpectrumChannelMaxRangeTestCase(channelType, 100),
+                    TestCase::Duration::QUICK);
+    }
+}
+
+/// Static variable for test initialization
+static SpectrumChannelMaxRangeTestSuite g_spectrumChannelMaxRangeTestSuite;
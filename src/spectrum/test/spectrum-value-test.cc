@@ -13,6 +13,7 @@
 #include "ns3/spectrum-value.h"
 #include "ns3/test.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -137,6 +138,115 @@ SpectrumValueTestCase::DoRun()
     NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(m_a, m_b, TOLERANCE, "");
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief Spectrum Value kernels Test: the element-wise operations give, for any number
+ * of bands, the values computed one by one, and the conversion between large models gives
+ * the sums of the overlapping values computed in the order of the bands.
+ */
+class SpectrumValueKernelsTestCase : public TestCase
+{
+  public:
+    SpectrumValueKernelsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SpectrumValueKernelsTestCase::SpectrumValueKernelsTestCase()
+    : TestCase("SpectrumValue element-wise and conversion kernels")
+{
+}
+
+void
+SpectrumValueKernelsTestCase::DoRun()
+{
+    for (uint32_t n : {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1031})
+    {
+        Bands bands;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            bands.push_back({1e9 + i * 1e5, 1e9 + (i + 0.5) * 1e5, 1e9 + (i + 1) * 1e5});
+        }
+        auto model = Create<SpectrumModel>(bands);
+        SpectrumValue a(model);
+        SpectrumValue b(model);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            a[i] = std::sin(i + 1.0) * 1e-9;
+            b[i] = std::cos(i + 0.5) + 1.5;
+        }
+        const double s = 0.3;
+        const auto sum = a + b;
+        const auto difference = a - b;
+        const auto product = a * b;
+        const auto quotient = a / b;
+        const auto sumScalar = a + s;
+        const auto productScalar = a * s;
+        const auto quotientScalar = a / s;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(sum[i], a[i] + b[i], "Bad sum of band " << i << "/" << n);
+            NS_TEST_ASSERT_MSG_EQ(difference[i],
+                                  a[i] - b[i],
+                                  "Bad difference of band " << i << "/" << n);
+            NS_TEST_ASSERT_MSG_EQ(product[i], a[i] * b[i], "Bad product of band " << i << "/" << n);
+            NS_TEST_ASSERT_MSG_EQ(quotient[i],
+                                  a[i] / b[i],
+                                  "Bad quotient of band " << i << "/" << n);
+            NS_TEST_ASSERT_MSG_EQ(sumScalar[i], a[i] + s, "Bad sum of band " << i << "/" << n);
+            NS_TEST_ASSERT_MSG_EQ(productScalar[i],
+                                  a[i] * s,
+                                  "Bad product of band " << i << "/" << n);
+            NS_TEST_ASSERT_MSG_EQ(quotientScalar[i],
+                                  a[i] / s,
+                                  "Bad quotient of band " << i << "/" << n);
+        }
+    }
+
+    // a fine model converted to a coarse model whose bands overlap several fine bands
+    std::vector<double> fineFreqs;
+    for (uint32_t i = 0; i < 4000; i++)
+    {
+        fineFreqs.push_back(5e9 + i * 78125);
+    }
+    auto fineModel = Create<SpectrumModel>(fineFreqs);
+    std::vector<double> coarseFreqs;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        coarseFreqs.push_back(5e9 + 117187.5 + i * 312500 * 0.99);
+    }
+    auto coarseModel = Create<SpectrumModel>(coarseFreqs);
+    auto fine = Create<SpectrumValue>(fineModel);
+    for (uint32_t i = 0; i < 4000; i++)
+    {
+        (*fine)[i] = 1e-12 * (1 + std::sin(i * 0.1));
+    }
+    SpectrumConverter converter(fineModel, coarseModel);
+    auto coarse = converter.Convert(fine);
+    for (auto to = coarseModel->Begin(); to != coarseModel->End(); ++to)
+    {
+        double expected = 0;
+        auto value = fine->ConstValuesBegin();
+        for (auto from = fineModel->Begin(); from != fineModel->End(); ++from, ++value)
+        {
+            if (from->fh <= to->fl || to->fh <= from->fl)
+            {
+                continue;
+            }
+            const auto coeff = (std::min(from->fh, to->fh) - std::max(from->fl, to->fl)) *
+                               (1.0 / (to->fh - to->fl));
+            if (coeff > 0)
+            {
+                expected += *value * std::min(coeff, 1.0);
+            }
+        }
+        const auto i = std::distance(coarseModel->Begin(), to);
+        NS_TEST_ASSERT_MSG_EQ((*coarse)[i], expected, "Bad converted value of band " << i);
+    }
+}
+
 /**
  * @ingroup spectrum-tests
  *
@@ -151,6 +261,8 @@ class SpectrumValueTestSuite : public TestSuite
 SpectrumValueTestSuite::SpectrumValueTestSuite()
     : TestSuite("spectrum-value", Type::UNIT)
 {
+    AddTestCase(new SpectrumValueKernelsTestCase, TestCase::Duration::QUICK);
+
     // NS_LOG_INFO("creating SpectrumValueTestSuite");
 
     std::vector<double> freqs;
@@ -2103,6 +2103,128 @@ ThreeGppReversedDirectionFieldPatternTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup spectrum-tests
+ * Test case for the computation of the channel matrix and of its long term
+ * component by several threads. It generates the channel matrix of a link
+ * between large arrays with two ThreeGppChannelModel instances which draw the
+ * same random variables, one using a single thread and the other one using
+ * several threads, and checks that the two channel matrices are identical.
+ * Likewise, it checks that the long term components computed by a single
+ * thread and by several threads are identical.
+ */
+class ThreeGppParallelChannelMatrixTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param los whether the link is in LOS condition
+     */
+    ThreeGppParallelChannelMatrixTest(bool los);
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Create a channel model
+     * @param threads the number of threads computing the channel matrices
+     * @return the channel model
+     */
+    Ptr<ThreeGppChannelModel> CreateChannelModel(uint32_t threads) const;
+
+    bool m_los; //!< whether the link is in LOS condition
+};
+
+ThreeGppParallelChannelMatrixTest::ThreeGppParallelChannelMatrixTest(bool los)
+    : TestCase(std::string("Check the channel matrix computed by several threads, ") +
+               (los ? "LOS" : "NLOS")),
+      m_los(los)
+{
+}
+
+Ptr<ThreeGppChannelModel>
+ThreeGppParallelChannelMatrixTest::CreateChannelModel(uint32_t threads) const
+{
+    Ptr<ChannelConditionModel> channelConditionModel;
+    if (m_los)
+    {
+        channelConditionModel = CreateObject<AlwaysLosChannelConditionModel>();
+    }
+    else
+    {
+        channelConditionModel = CreateObject<NeverLosChannelConditionModel>();
+    }
+    auto channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel", PointerValue(channelConditionModel));
+    channelModel->SetAttribute("Threads", UintegerValue(threads));
+    channelModel->AssignStreams(1);
+    return channelModel;
+}
+
+void
+ThreeGppParallelChannelMatrixTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+    rxMob->SetPosition(Vector(50.0, 20.0, 1.5));
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+
+    // each channel model needs its own antennas, which record their peers
+    auto createAntennas = [&]() {
+        Ptr<PhasedArrayModel> txAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(16),
+            "NumRows",
+            UintegerValue(8),
+            "IsDualPolarized",
+            BooleanValue(true));
+        Ptr<PhasedArrayModel> rxAntenna = CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(8),
+            "NumRows",
+            UintegerValue(4));
+        txAntenna->SetBeamformingVector(txAntenna->GetBeamformingVector(
+            Angles(rxMob->GetPosition(), txMob->GetPosition())));
+        rxAntenna->SetBeamformingVector(rxAntenna->GetBeamformingVector(
+            Angles(txMob->GetPosition(), rxMob->GetPosition())));
+        return std::make_pair(txAntenna, rxAntenna);
+    };
+
+    auto [txAntenna, rxAntenna] = createAntennas();
+    auto serialMatrix = CreateChannelModel(1)->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
+    auto [txAntenna2, rxAntenna2] = createAntennas();
+    auto parallelMatrix = CreateChannelModel(4)->GetChannel(txMob, rxMob, txAntenna2, rxAntenna2);
+    NS_TEST_ASSERT_MSG_EQ(parallelMatrix->m_channel.GetNumPages(),
+                          serialMatrix->m_channel.GetNumPages(),
+                          "The channel matrices should have the same number of clusters");
+    NS_TEST_ASSERT_MSG_EQ((parallelMatrix->m_channel == serialMatrix->m_channel),
+                          true,
+                          "The channel matrices should be identical");
+
+    auto serialSplm = CreateObjectWithAttributes<ThreeGppSpectrumPropagationLossModel>(
+        "Threads",
+        UintegerValue(1));
+    auto parallelSplm = CreateObjectWithAttributes<ThreeGppSpectrumPropagationLossModel>(
+        "Threads",
+        UintegerValue(4));
+    auto serialLongTerm = serialSplm->CalcLongTerm(serialMatrix, txAntenna, rxAntenna);
+    auto parallelLongTerm = parallelSplm->CalcLongTerm(serialMatrix, txAntenna, rxAntenna);
+    NS_TEST_ASSERT_MSG_EQ((*parallelLongTerm == *serialLongTerm),
+                          true,
+                          "The long term components should be identical");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup spectrum-tests
  *
@@ -2167,6 +2289,8 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
 
     AddTestCase(new ThreeGppCalcLongTermMultiPortTest(), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppReversedDirectionFieldPatternTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppParallelChannelMatrixTest(true), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppParallelChannelMatrixTest(false), TestCase::Duration::QUICK);
 
     /**
      *  The TX and RX antennas are configured face-to-face.
@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "replication-helper.h"
+
+#include "ns3/basic-data-calculators.h"
+#include "ns3/data-calculator.h"
+#include "ns3/data-output-interface.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationHelper");
+
+/**
+ * @ingroup stats
+ * Unnamed namespace for the replication results callback.
+ */
+namespace
+{
+
+/**
+ * Data output callback storing the numeric values of the data
+ * calculators into the results of a replication.
+ *
+ * A result is named after the context and the name of the value,
+ * separated by a space.
+ */
+class ResultsOutputCallback : public DataOutputCallback
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [out] results The results of the replication.
+     */
+    ResultsOutputCallback(ReplicationRunner::Results& results)
+        : m_results(results)
+    {
+    }
+
+    void OutputStatistic(std::string key,
+                         std::string variable,
+                         const StatisticalSummary* statSum) override
+    {
+        Store(key, variable + "-count", statSum->getCount());
+        Store(key, variable + "-total", statSum->getSum());
+        Store(key, variable + "-average", statSum->getMean());
+        Store(key, variable + "-min", statSum->getMin());
+        Store(key, variable + "-max", statSum->getMax());
+        Store(key, variable + "-stddev", statSum->getStddev());
+    }
+
+    void OutputSingleton(std::string key, std::string variable, int val) override
+    {
+        Store(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, uint32_t val) override
+    {
+        Store(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, double val) override
+    {
+        Store(key, variable, val);
+    }
+
+    void OutputSingleton(std::string key, std::string variable, std::string val) override
+    {
+        // Only the numeric values are aggregated
+    }
+
+    void OutputSingleton(std::string key, std::string variable, Time val) override
+    {
+        Store(key, variable, val.GetSeconds());
+    }
+
+  private:
+    /**
+     * Store a value, unless it is not a number.
+     *
+     * @param [in] context The context of the value.
+     * @param [in] name The name of the value.
+     * @param [in] value The value.
+     */
+    void Store(const std::string& context, const std::string& name, double value)
+    {
+        if (!std::isnan(value))
+        {
+            m_results[context + " " + name] = value;
+        }
+    }
+
+    ReplicationRunner::Results& m_results; //!< The results of the replication.
+};
+
+} // unnamed namespace
+
+ReplicationHelper::ReplicationHelper()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ReplicationHelper::SetMaxProcesses(uint32_t processes)
+{
+    NS_LOG_FUNCTION(this << processes);
+    m_runner.SetMaxProcesses(processes);
+}
+
+Ptr<DataCollector>
+ReplicationHelper::Run(Ptr<DataCollector> collector, uint64_t firstRun, uint32_t count)
+{
+    NS_LOG_FUNCTION(this << collector << firstRun << count);
+    auto replications =
+        m_runner.Run(firstRun, count, [collector](uint64_t, ReplicationRunner::Results& results) {
+            ResultsOutputCallback callback(results);
+            for (auto i = collector->DataCalculatorBegin(); i != collector->DataCalculatorEnd();
+                 i++)
+            {
+                if ((*i)->GetEnabled())
+                {
+                    (*i)->Output(callback);
+                }
+            }
+        });
+
+    Ptr<DataCollector> aggregate = CreateObject<DataCollector>();
+    aggregate->DescribeRun(collector->GetExperimentLabel(),
+                           collector->GetStrategyLabel(),
+                           collector->GetInputLabel(),
+                           std::to_string(firstRun) + "-" + std::to_string(firstRun + count - 1),
+                           collector->GetDescription());
+    for (auto i = collector->MetadataBegin(); i != collector->MetadataEnd(); i++)
+    {
+        aggregate->AddMetadata(i->first, i->second);
+    }
+
+    std::map<std::string, Ptr<MinMaxAvgTotalCalculator<double>>> calculators;
+    uint32_t completed = 0;
+    for (const auto& replication : replications)
+    {
+        if (!replication.completed)
+        {
+            NS_LOG_WARN("Run " << replication.run << " failed");
+            continue;
+        }
+        completed++;
+        for (const auto& [name, value] : replication.results)
+        {
+            auto& calculator = calculators[name];
+            if (!calculator)
+            {
+                std::size_t separator = name.find(' ');
+                calculator = CreateObject<MinMaxAvgTotalCalculator<double>>();
+                calculator->SetContext(name.substr(0, separator));
+                calculator->SetKey(name.substr(separator + 1));
+                aggregate->AddDataCalculator(calculator);
+            }
+            calculator->Update(value);
+        }
+    }
+    aggregate->AddMetadata("replications", completed);
+    return aggregate;
+}
+
+} // namespace ns3
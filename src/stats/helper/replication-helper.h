@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef REPLICATION_HELPER_H
+#define REPLICATION_HELPER_H
+
+#include "ns3/data-collector.h"
+#include "ns3/ptr.h"
+#include "ns3/replication-runner.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ * @brief Helper running replications of a simulation set up once, and
+ * aggregating their data calculators.
+ *
+ * The helper runs the replications with a ReplicationRunner.  At the end
+ * of each replication, the numeric values output by the data calculators
+ * of the DataCollector of the scenario are sent back to the calling
+ * process:
+ *   - each singleton value is sent with its name,
+ *   - each statistic is sent as its \c -count, \c -total, \c -average,
+ *     \c -min, \c -max and \c -stddev values.
+ *
+ * Each of these values is aggregated over the completed replications by
+ * a MinMaxAvgTotalCalculator<double>, with the context and name of the
+ * value.  The calculators are returned in a new DataCollector, which can
+ * be written with any DataOutputInterface.
+ *
+ * \code
+ *   Ptr<DataCollector> collector = CreateObject<DataCollector>();
+ *   collector->DescribeRun("experiment", "strategy", "input", "run");
+ *   // build the scenario and add its data calculators to collector, then
+ *   ReplicationHelper replications;
+ *   Ptr<DataCollector> aggregate = replications.Run(collector, 1, 100);
+ *   Simulator::Destroy();
+ *   OmnetDataOutput output;
+ *   output.Output(*aggregate);
+ * \endcode
+ *
+ * As for OmnetDataOutput, the contexts of the data calculators must not
+ * contain spaces.
+ */
+class ReplicationHelper
+{
+  public:
+    /** Constructor. */
+    ReplicationHelper();
+
+    /**
+     * Set the maximum number of replications running at the same time.
+     *
+     * @param [in] processes The number of replications, or zero for the
+     *             number of hardware threads.
+     */
+    void SetMaxProcesses(uint32_t processes);
+
+    /**
+     * Run replications of the simulation set up by the calling process.
+     *
+     * @param [in] collector The data collector of the scenario.
+     * @param [in] firstRun The run number of the first replication.
+     * @param [in] count The number of replications.
+     * @returns The data collector aggregating the values of the completed
+     *          replications.  Its run label is the range of run numbers,
+     *          and its \c replications metadata the number of completed
+     *          replications.
+     */
+    Ptr<DataCollector> Run(Ptr<DataCollector> collector, uint64_t firstRun, uint32_t count);
+
+  private:
+    ReplicationRunner m_runner; //!< The replication runner.
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_HELPER_H */
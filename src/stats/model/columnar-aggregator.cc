@@ -0,0 +1,596 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "columnar-aggregator.h"
+
+#include "ns3/abort.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ColumnarAggregator");
+
+NS_OBJECT_ENSURE_REGISTERED(ColumnarAggregator);
+
+namespace
+{
+
+/// Magic bytes at the start of a columnar file
+const char MAGIC[8] = {'N', 'S', '3', 'C', 'O', 'L', 'S', '\0'};
+/// Version of the format of the columnar files
+const uint32_t VERSION = 1;
+/// Byte order mark of a columnar file, as written by the system
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// Type of a schema block
+const uint32_t SCHEMA_BLOCK = 1;
+/// Type of a chunk block
+const uint32_t CHUNK_BLOCK = 2;
+
+/**
+ * Append a value to the content of a block.
+ *
+ * @tparam T \deduced the type of the value.
+ * @param content the content of the block.
+ * @param value the value.
+ */
+template <typename T>
+void
+AppendValue(std::vector<uint8_t>& content, T value)
+{
+    std::size_t size = content.size();
+    content.resize(size + sizeof(value));
+    std::memcpy(content.data() + size, &value, sizeof(value));
+}
+
+/**
+ * Append a string, preceded by its length, to the content of a block.
+ *
+ * @param content the content of the block.
+ * @param value the string.
+ */
+void
+AppendString(std::vector<uint8_t>& content, const std::string& value)
+{
+    AppendValue(content, static_cast<uint32_t>(value.size()));
+    content.insert(content.end(), value.begin(), value.end());
+}
+
+/**
+ * Convert a value to an integer type, as a cast does within the range of
+ * the type.  The cast of NaN or of a value out of the range is undefined:
+ * NaN is converted to zero, and the other values to the bound they exceed.
+ *
+ * @tparam T the integer type.
+ * @param value the value.
+ * @returns the converted value.
+ */
+template <typename T>
+T
+SaturatingCast(double value)
+{
+    if (std::isnan(value))
+    {
+        return 0;
+    }
+    // The minimum is 0 or a power of two, and the maximum one less than a
+    // power of two: both bounds of the range are exact as doubles
+    const double lower = static_cast<double>(std::numeric_limits<T>::min());
+    const double upper = std::ldexp(1.0, std::numeric_limits<T>::digits);
+    if (value <= lower)
+    {
+        return std::numeric_limits<T>::min();
+    }
+    if (value >= upper)
+    {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(value);
+}
+
+/**
+ * Read a value from the content of a block.
+ *
+ * @tparam T \deduced the type of the value.
+ * @param content the content of the block.
+ * @param offset the offset of the value, moved past it.
+ * @param value the value read.
+ * @return false if the content is too short.
+ */
+template <typename T>
+bool
+ReadValue(const std::vector<uint8_t>& content, std::size_t& offset, T& value)
+{
+    if (offset + sizeof(value) > content.size())
+    {
+        return false;
+    }
+    std::memcpy(&value, content.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+}
+
+/**
+ * Read a string, preceded by its length, from the content of a block.
+ *
+ * @param content the content of the block.
+ * @param offset the offset of the string, moved past it.
+ * @param value the string read.
+ * @return false if the content is too short.
+ */
+bool
+ReadString(const std::vector<uint8_t>& content, std::size_t& offset, std::string& value)
+{
+    uint32_t length;
+    if (!ReadValue(content, offset, length) || offset + length > content.size())
+    {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(content.data() + offset), length);
+    offset += length;
+    return true;
+}
+
+} // namespace
+
+TypeId
+ColumnarAggregator::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ColumnarAggregator")
+            .SetParent<DataCollectionObject>()
+            .SetGroupName("Stats")
+            .AddAttribute("ChunkRows",
+                          "The number of rows of a dataset buffered before they are written.",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&ColumnarAggregator::m_chunkRows),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Compression",
+                          "The compression of the chunks written.  The chunks are written "
+                          "uncompressed if zlib was not found when ns-3 was configured.",
+                          EnumValue(ColumnarAggregator::ZLIB),
+                          MakeEnumAccessor<Compression>(&ColumnarAggregator::m_compression),
+                          MakeEnumChecker(ColumnarAggregator::NONE,
+                                          "None",
+                                          ColumnarAggregator::ZLIB,
+                                          "Zlib"));
+
+    return tid;
+}
+
+ColumnarAggregator::ColumnarAggregator(const std::string& outputFileName)
+    : m_outputFileName(outputFileName),
+      m_chunkRows(65536),
+      m_compression(ZLIB),
+      m_schemaN(0)
+{
+    NS_LOG_FUNCTION(this << outputFileName);
+
+    m_file.open(m_outputFileName, std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Unable to open " << m_outputFileName);
+    m_file.write(MAGIC, sizeof(MAGIC));
+    m_file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    m_file.write(reinterpret_cast<const char*>(&BYTE_ORDER_MARK), sizeof(BYTE_ORDER_MARK));
+}
+
+ColumnarAggregator::~ColumnarAggregator()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    m_file.close();
+}
+
+void
+ColumnarAggregator::AddDataset(const std::string& context,
+                               const std::vector<std::string>& names,
+                               const std::vector<ColumnType>& types)
+{
+    NS_LOG_FUNCTION(this << context);
+    NS_ABORT_MSG_IF(m_datasets.count(context) != 0, "Dataset " << context << " already exists");
+    NS_ABORT_MSG_IF(names.empty() || names.size() != types.size(),
+                    "Dataset " << context << " needs one type per column");
+
+    Dataset& dataset = m_datasets[context];
+    dataset.id = 0;
+    dataset.schemaWritten = false;
+    dataset.names = names;
+    dataset.types = types;
+    dataset.columns.resize(names.size());
+}
+
+void
+ColumnarAggregator::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [context, dataset] : m_datasets)
+    {
+        WriteChunk(context, dataset);
+    }
+    m_file.flush();
+}
+
+bool
+ColumnarAggregator::IsCompressionSupported(Compression compression)
+{
+#ifdef HAVE_ZLIB
+    return compression == NONE || compression == ZLIB;
+#else
+    return compression == NONE;
+#endif
+}
+
+void
+ColumnarAggregator::Write1d(std::string context, double v1)
+{
+    NS_LOG_FUNCTION(this << context << v1);
+
+    if (m_enabled)
+    {
+        double values[] = {v1};
+        Append(context, values, 1);
+    }
+}
+
+void
+ColumnarAggregator::Write2d(std::string context, double v1, double v2)
+{
+    NS_LOG_FUNCTION(this << context << v1 << v2);
+
+    if (m_enabled)
+    {
+        double values[] = {v1, v2};
+        Append(context, values, 2);
+    }
+}
+
+void
+ColumnarAggregator::Write3d(std::string context, double v1, double v2, double v3)
+{
+    NS_LOG_FUNCTION(this << context << v1 << v2 << v3);
+
+    if (m_enabled)
+    {
+        double values[] = {v1, v2, v3};
+        Append(context, values, 3);
+    }
+}
+
+void
+ColumnarAggregator::Write4d(std::string context, double v1, double v2, double v3, double v4)
+{
+    NS_LOG_FUNCTION(this << context << v1 << v2 << v3 << v4);
+
+    if (m_enabled)
+    {
+        double values[] = {v1, v2, v3, v4};
+        Append(context, values, 4);
+    }
+}
+
+void
+ColumnarAggregator::Write(const std::string& context, const std::vector<double>& values)
+{
+    NS_LOG_FUNCTION(this << context << values.size());
+
+    if (m_enabled)
+    {
+        Append(context, values.data(), values.size());
+    }
+}
+
+void
+ColumnarAggregator::Append(const std::string& context, const double* values, std::size_t n)
+{
+    auto it = m_datasets.find(context);
+    if (it == m_datasets.end())
+    {
+        // A dataset which was not declared holds doubles
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            names.push_back("v" + std::to_string(i + 1));
+        }
+        AddDataset(context, names, std::vector<ColumnType>(n, DOUBLE));
+        it = m_datasets.find(context);
+    }
+
+    Dataset& dataset = it->second;
+    NS_ABORT_MSG_IF(n != dataset.columns.size(),
+                    "Dataset " << context << " has " << dataset.columns.size() << " columns, "
+                               << n << " values written");
+    for (std::size_t i = 0; i < n; i++)
+    {
+        uint64_t bits;
+        switch (dataset.types[i])
+        {
+        case INT64:
+            bits = static_cast<uint64_t>(SaturatingCast<int64_t>(values[i]));
+            break;
+        case UINT64:
+            bits = SaturatingCast<uint64_t>(values[i]);
+            break;
+        default:
+            std::memcpy(&bits, &values[i], sizeof(bits));
+            break;
+        }
+        dataset.columns[i].push_back(bits);
+    }
+
+    if (dataset.columns[0].size() >= m_chunkRows)
+    {
+        WriteChunk(context, dataset);
+    }
+}
+
+void
+ColumnarAggregator::WriteChunk(const std::string& context, Dataset& dataset)
+{
+    uint32_t rows = dataset.columns[0].size();
+    if (rows == 0)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << context << rows);
+
+    if (!dataset.schemaWritten)
+    {
+        std::vector<uint8_t> schema;
+        AppendString(schema, context);
+        AppendValue(schema, static_cast<uint32_t>(dataset.names.size()));
+        for (std::size_t i = 0; i < dataset.names.size(); i++)
+        {
+            AppendValue(schema, static_cast<uint8_t>(dataset.types[i]));
+            AppendString(schema, dataset.names[i]);
+        }
+        // The datasets are numbered in the order of their schema blocks
+        dataset.id = m_schemaN++;
+        WriteBlock(SCHEMA_BLOCK, dataset.id, schema);
+        dataset.schemaWritten = true;
+    }
+
+    uint64_t size = uint64_t(rows) * sizeof(uint64_t) * dataset.columns.size();
+    Compression compression = m_compression;
+    if (!IsCompressionSupported(compression))
+    {
+        NS_LOG_WARN("Compression not supported, " << context << " written uncompressed");
+        compression = NONE;
+    }
+
+    m_chunk.clear();
+    AppendValue(m_chunk, rows);
+    AppendValue(m_chunk, static_cast<uint32_t>(compression));
+    AppendValue(m_chunk, size);
+    std::size_t offset = m_chunk.size();
+    m_chunk.resize(offset + size);
+    for (auto& column : dataset.columns)
+    {
+        std::memcpy(m_chunk.data() + offset, column.data(), rows * sizeof(uint64_t));
+        offset += rows * sizeof(uint64_t);
+        column.clear();
+    }
+
+#ifdef HAVE_ZLIB
+    if (compression == ZLIB)
+    {
+        std::size_t header = m_chunk.size() - size;
+        uLongf compressedSize = compressBound(size);
+        m_compressed.resize(header + compressedSize);
+        std::memcpy(m_compressed.data(), m_chunk.data(), header);
+        int status = compress2(m_compressed.data() + header,
+                               &compressedSize,
+                               m_chunk.data() + header,
+                               size,
+                               Z_BEST_SPEED);
+        NS_ABORT_MSG_IF(status != Z_OK, "Unable to compress " << context);
+        m_compressed.resize(header + compressedSize);
+        m_chunk.swap(m_compressed);
+    }
+#endif
+
+    WriteBlock(CHUNK_BLOCK, dataset.id, m_chunk);
+}
+
+void
+ColumnarAggregator::WriteBlock(uint32_t type, uint32_t id, const std::vector<uint8_t>& content)
+{
+    uint64_t length = content.size();
+    m_file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    m_file.write(reinterpret_cast<const char*>(&id), sizeof(id));
+    m_file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    m_file.write(reinterpret_cast<const char*>(content.data()), content.size());
+}
+
+ColumnarReader::ColumnarReader()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+ColumnarReader::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_datasets.clear();
+    m_index.clear();
+
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&byteOrderMark), sizeof(byteOrderMark));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+        byteOrderMark != BYTE_ORDER_MARK)
+    {
+        NS_LOG_WARN(fileName << " is not a columnar file of this version and byte order");
+        return false;
+    }
+
+    std::vector<uint8_t> content;
+    std::vector<uint8_t> values;
+    while (true)
+    {
+        uint32_t type;
+        uint32_t id;
+        uint64_t length;
+        file.read(reinterpret_cast<char*>(&type), sizeof(type));
+        if (file.eof())
+        {
+            return true;
+        }
+        file.read(reinterpret_cast<char*>(&id), sizeof(id));
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        content.resize(length);
+        file.read(reinterpret_cast<char*>(content.data()), length);
+        if (!file)
+        {
+            NS_LOG_WARN(fileName << " is truncated");
+            return false;
+        }
+
+        std::size_t offset = 0;
+        if (type == SCHEMA_BLOCK)
+        {
+            Dataset dataset;
+            uint32_t columns;
+            if (id != m_datasets.size() || !ReadString(content, offset, dataset.context) ||
+                !ReadValue(content, offset, columns) || columns == 0)
+            {
+                return false;
+            }
+            for (uint32_t i = 0; i < columns; i++)
+            {
+                uint8_t columnType;
+                std::string name;
+                if (!ReadValue(content, offset, columnType) || !ReadString(content, offset, name))
+                {
+                    return false;
+                }
+                dataset.types.push_back(static_cast<ColumnarAggregator::ColumnType>(columnType));
+                dataset.names.push_back(name);
+            }
+            dataset.columns.resize(columns);
+            m_index[dataset.context] = id;
+            m_datasets.push_back(dataset);
+        }
+        else if (type == CHUNK_BLOCK)
+        {
+            uint32_t rows;
+            uint32_t compression;
+            uint64_t size;
+            if (id >= m_datasets.size() || !ReadValue(content, offset, rows) ||
+                !ReadValue(content, offset, compression) || !ReadValue(content, offset, size))
+            {
+                return false;
+            }
+            Dataset& dataset = m_datasets[id];
+            if (size != uint64_t(rows) * sizeof(uint64_t) * dataset.columns.size())
+            {
+                return false;
+            }
+            if (compression == ColumnarAggregator::NONE)
+            {
+                if (offset + size != content.size())
+                {
+                    return false;
+                }
+                values.assign(content.begin() + offset, content.end());
+            }
+#ifdef HAVE_ZLIB
+            else if (compression == ColumnarAggregator::ZLIB)
+            {
+                values.resize(size);
+                uLongf uncompressedSize = size;
+                if (uncompress(values.data(),
+                               &uncompressedSize,
+                               content.data() + offset,
+                               content.size() - offset) != Z_OK ||
+                    uncompressedSize != size)
+                {
+                    return false;
+                }
+            }
+#endif
+            else
+            {
+                NS_LOG_WARN("Compression " << compression << " of " << fileName
+                                           << " not supported");
+                return false;
+            }
+            for (std::size_t i = 0; i < dataset.columns.size(); i++)
+            {
+                auto& column = dataset.columns[i];
+                std::size_t start = column.size();
+                column.resize(start + rows);
+                std::memcpy(column.data() + start,
+                            values.data() + i * rows * sizeof(uint64_t),
+                            rows * sizeof(uint64_t));
+            }
+        }
+        // Other blocks are skipped
+    }
+}
+
+std::vector<std::string>
+ColumnarReader::GetDatasets() const
+{
+    std::vector<std::string> contexts;
+    for (const auto& dataset : m_datasets)
+    {
+        contexts.push_back(dataset.context);
+    }
+    return contexts;
+}
+
+std::size_t
+ColumnarReader::GetColumnN(const std::string& context) const
+{
+    return GetDataset(context).names.size();
+}
+
+std::string
+ColumnarReader::GetColumnName(const std::string& context, std::size_t i) const
+{
+    return GetDataset(context).names.at(i);
+}
+
+ColumnarAggregator::ColumnType
+ColumnarReader::GetColumnType(const std::string& context, std::size_t i) const
+{
+    return GetDataset(context).types.at(i);
+}
+
+std::size_t
+ColumnarReader::GetRowN(const std::string& context) const
+{
+    return GetDataset(context).columns[0].size();
+}
+
+const ColumnarReader::Dataset&
+ColumnarReader::GetDataset(const std::string& context) const
+{
+    auto it = m_index.find(context);
+    NS_ABORT_MSG_IF(it == m_index.end(), "Dataset " << context << " not found");
+    return m_datasets[it->second];
+}
+
+double
+ColumnarReader::ToDouble(uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace ns3
@@ -0,0 +1,327 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef COLUMNAR_AGGREGATOR_H
+#define COLUMNAR_AGGREGATOR_H
+
+#include "data-collection-object.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup aggregator
+ *
+ * This aggregator stores the values it receives in a binary file, by
+ * column.
+ *
+ * Each context written is a dataset, whose values are buffered in
+ * memory in one typed column per dimension.  Once a dataset holds
+ * \ref ColumnarAggregator::ChunkRows "ChunkRows" rows, or when the
+ * aggregator is flushed or destroyed, its columns are written as a
+ * chunk, compressed with zlib if requested and available.  The values
+ * are thus neither formatted as text nor written one at a time.
+ *
+ * The columns of a dataset are named "v1", "v2", etc., and hold doubles,
+ * unless the dataset is declared with AddDataset() before its first
+ * value is written.
+ *
+ * The file is read back with a ColumnarReader, or printed as text by
+ * utils/print-columnar.  Its format, in the byte order of the writing
+ * system, is:
+ *
+ * - a file header: the 8 bytes "NS3COLS" followed by a null byte, the
+ *   version of the format (uint32_t, currently 1) and the byte order
+ *   mark 0x01020304 (uint32_t);
+ * - blocks, each one made of its type (uint32_t), the identifier of its
+ *   dataset (uint32_t), the length of its content (uint64_t) and its
+ *   content:
+ *   - a schema block (type 1), written before the first chunk of a
+ *     dataset, holds the length and the characters of the dataset name
+ *     (uint32_t and bytes), the number of columns (uint32_t), and for
+ *     each column its type (uint8_t, a ColumnType) and the length and
+ *     the characters of its name;
+ *   - a chunk block (type 2) holds the number of rows (uint32_t), the
+ *     compression of the values (uint32_t, a Compression), the size of
+ *     the values once uncompressed (uint64_t), and the values, column
+ *     after column, each value on 8 bytes.
+ **/
+class ColumnarAggregator : public DataCollectionObject
+{
+  public:
+    /// The type of the values of a column.
+    enum ColumnType : uint8_t
+    {
+        DOUBLE = 0, //!< IEEE 754 double precision values
+        INT64 = 1,  //!< Signed 64-bit integers
+        UINT64 = 2  //!< Unsigned 64-bit integers
+    };
+
+    /// The compression of the chunks.
+    enum Compression
+    {
+        NONE = 0, //!< The values are written as is
+        ZLIB = 1  //!< The values are compressed with zlib
+    };
+
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * @param outputFileName name of the file to write.
+     *
+     * Constructs a columnar aggregator that will create a file named
+     * outputFileName.
+     */
+    ColumnarAggregator(const std::string& outputFileName);
+
+    ~ColumnarAggregator() override;
+
+    /**
+     * @param context the context of the dataset.
+     * @param names the names of the columns.
+     * @param types the types of the columns, one per name.
+     *
+     * @brief Declares the columns of a dataset, before its first value is
+     * written.  The values written are converted to the type of their
+     * column: the integer columns truncate them toward zero, saturate them
+     * at the bounds of their type, and store NaN as zero.
+     */
+    void AddDataset(const std::string& context,
+                    const std::vector<std::string>& names,
+                    const std::vector<ColumnType>& types);
+
+    /**
+     * @brief Writes the values buffered to the file, as one chunk per
+     * dataset.
+     */
+    void Flush();
+
+    /**
+     * @param compression the compression of the chunks.
+     * @return true if the chunks can be compressed this way, which
+     * depends on the libraries found when ns-3 was configured.
+     */
+    static bool IsCompressionSupported(Compression compression);
+
+    // Below are hooked to connectors exporting data
+    // They are not overloaded since it confuses the compiler when made
+    // into callbacks
+
+    /**
+     * @param context specifies the 1D dataset these values came from.
+     * @param v1 value for the new data point.
+     *
+     * @brief Writes 1 value to the dataset.
+     */
+    void Write1d(std::string context, double v1);
+
+    /**
+     * @param context specifies the 2D dataset these values came from.
+     * @param v1 first value for the new data point.
+     * @param v2 second value for the new data point.
+     *
+     * @brief Writes 2 values to the dataset.
+     */
+    void Write2d(std::string context, double v1, double v2);
+
+    /**
+     * @param context specifies the 3D dataset these values came from.
+     * @param v1 first value for the new data point.
+     * @param v2 second value for the new data point.
+     * @param v3 third value for the new data point.
+     *
+     * @brief Writes 3 values to the dataset.
+     */
+    void Write3d(std::string context, double v1, double v2, double v3);
+
+    /**
+     * @param context specifies the 4D dataset these values came from.
+     * @param v1 first value for the new data point.
+     * @param v2 second value for the new data point.
+     * @param v3 third value for the new data point.
+     * @param v4 fourth value for the new data point.
+     *
+     * @brief Writes 4 values to the dataset.
+     */
+    void Write4d(std::string context, double v1, double v2, double v3, double v4);
+
+    /**
+     * @param context specifies the dataset these values came from.
+     * @param values the values of the new data point, one per column.
+     *
+     * @brief Writes any number of values to the dataset.
+     */
+    void Write(const std::string& context, const std::vector<double>& values);
+
+  private:
+    /// The columns of a dataset.
+    struct Dataset
+    {
+        uint32_t id;                                //!< Identifier of the dataset in the file
+        bool schemaWritten;                         //!< Whether the schema block was written
+        std::vector<std::string> names;             //!< Names of the columns
+        std::vector<ColumnType> types;              //!< Types of the columns
+        std::vector<std::vector<uint64_t>> columns; //!< Values buffered, by column
+    };
+
+    /**
+     * @param context the context of the dataset.
+     * @param values the values of the new data point.
+     * @param n the number of values.
+     *
+     * @brief Appends a data point to a dataset, and writes the dataset if
+     * it is full.
+     */
+    void Append(const std::string& context, const double* values, std::size_t n);
+
+    /**
+     * @param context the context of the dataset.
+     * @param dataset the dataset to write.
+     *
+     * @brief Writes the values buffered in a dataset to the file.
+     */
+    void WriteChunk(const std::string& context, Dataset& dataset);
+
+    /**
+     * @param type the type of the block.
+     * @param id the identifier of the dataset of the block.
+     * @param content the content of the block.
+     *
+     * @brief Writes a block to the file.
+     */
+    void WriteBlock(uint32_t type, uint32_t id, const std::vector<uint8_t>& content);
+
+    std::string m_outputFileName;              //!< The output file name.
+    std::ofstream m_file;                      //!< The output file.
+    uint32_t m_chunkRows;                      //!< Number of rows per chunk.
+    Compression m_compression;                 //!< Compression of the chunks.
+    uint32_t m_schemaN;                        //!< Number of schema blocks written.
+    std::map<std::string, Dataset> m_datasets; //!< The datasets, by context.
+    std::vector<uint8_t> m_chunk;              //!< The values of the chunk written.
+    std::vector<uint8_t> m_compressed;         //!< The compressed values of the chunk written.
+};
+
+/**
+ * @ingroup aggregator
+ *
+ * This class reads the file written by a ColumnarAggregator.
+ */
+class ColumnarReader
+{
+  public:
+    ColumnarReader();
+
+    /**
+     * @param fileName name of the file to read.
+     * @return true if the file was read.
+     *
+     * @brief Reads all the datasets of a file.
+     */
+    bool Open(const std::string& fileName);
+
+    /**
+     * @return the contexts of the datasets, in the order of their
+     * schema blocks.
+     */
+    std::vector<std::string> GetDatasets() const;
+
+    /**
+     * @param context the context of a dataset.
+     * @return the number of columns of the dataset.
+     */
+    std::size_t GetColumnN(const std::string& context) const;
+
+    /**
+     * @param context the context of a dataset.
+     * @param i the index of a column.
+     * @return the name of the column.
+     */
+    std::string GetColumnName(const std::string& context, std::size_t i) const;
+
+    /**
+     * @param context the context of a dataset.
+     * @param i the index of a column.
+     * @return the type of the column.
+     */
+    ColumnarAggregator::ColumnType GetColumnType(const std::string& context, std::size_t i) const;
+
+    /**
+     * @param context the context of a dataset.
+     * @return the number of rows of the dataset.
+     */
+    std::size_t GetRowN(const std::string& context) const;
+
+    /**
+     * @tparam T \explicit the type of the values returned.
+     * @param context the context of a dataset.
+     * @param i the index of a column.
+     * @return the values of the column, converted to \pname{T}.
+     */
+    template <typename T>
+    std::vector<T> GetColumn(const std::string& context, std::size_t i) const;
+
+  private:
+    /// The columns of a dataset.
+    struct Dataset
+    {
+        std::string context;                               //!< Context of the dataset
+        std::vector<std::string> names;                    //!< Names of the columns
+        std::vector<ColumnarAggregator::ColumnType> types; //!< Types of the columns
+        std::vector<std::vector<uint64_t>> columns;        //!< Values, by column
+    };
+
+    /**
+     * @param context the context of a dataset.
+     * @return the dataset, which must exist.
+     */
+    const Dataset& GetDataset(const std::string& context) const;
+
+    /**
+     * @param bits the 8 bytes of a DOUBLE value.
+     * @return the value.
+     */
+    static double ToDouble(uint64_t bits);
+
+    std::vector<Dataset> m_datasets;         //!< The datasets, by identifier.
+    std::map<std::string, uint32_t> m_index; //!< The identifiers of the datasets, by context.
+};
+
+template <typename T>
+std::vector<T>
+ColumnarReader::GetColumn(const std::string& context, std::size_t i) const
+{
+    const Dataset& dataset = GetDataset(context);
+    std::vector<T> values;
+    values.reserve(dataset.columns[i].size());
+    for (uint64_t bits : dataset.columns[i])
+    {
+        switch (dataset.types[i])
+        {
+        case ColumnarAggregator::INT64:
+            values.push_back(static_cast<T>(static_cast<int64_t>(bits)));
+            break;
+        case ColumnarAggregator::UINT64:
+            values.push_back(static_cast<T>(bits));
+            break;
+        default:
+            values.push_back(static_cast<T>(ToDouble(bits)));
+            break;
+        }
+    }
+    return values;
+}
+
+} // namespace ns3
+
+#endif // COLUMNAR_AGGREGATOR_H
@@ -12,8 +12,10 @@
 #include "data-collector.h"
 #include "sqlite-output.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 #include <sstream>
 
@@ -39,10 +41,29 @@ SqliteDataOutput::~SqliteDataOutput()
 TypeId
 SqliteDataOutput::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::SqliteDataOutput")
-                            .SetParent<DataOutputInterface>()
-                            .SetGroupName("Stats")
-                            .AddConstructor<SqliteDataOutput>();
+    static TypeId tid =
+        TypeId("ns3::SqliteDataOutput")
+            .SetParent<DataOutputInterface>()
+            .SetGroupName("Stats")
+            .AddConstructor<SqliteDataOutput>()
+            .AddAttribute("TransactionSize",
+                          "The maximum number of rows inserted per transaction.",
+                          UintegerValue(10000),
+                          MakeUintegerAccessor(&SqliteDataOutput::m_transactionSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("WriterThread",
+                          "Whether the rows are inserted by a writer thread, while the next "
+                          "ones are generated.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SqliteDataOutput::m_writerThread),
+                          MakeBooleanChecker())
+            .AddAttribute("WalJournal",
+                          "Whether the journal of the database is a write-ahead log, which "
+                          "makes commits cheaper and lets other processes read the database "
+                          "while it is written.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SqliteDataOutput::m_walJournal),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -57,6 +78,10 @@ SqliteDataOutput::Output(DataCollector& dc)
     bool res;
 
     m_sqliteOut = new SQLiteOutput(m_dbFile);
+    if (m_walJournal)
+    {
+        m_sqliteOut->SetJournalWal();
+    }
 
     res = m_sqliteOut->SpinExec("CREATE TABLE IF NOT EXISTS Experiments (run, experiment, "
                                 "strategy, input, description text)");
@@ -99,31 +124,27 @@ SqliteDataOutput::Output(DataCollector& dc)
                                 "Metadata ( run text, key text, value)");
     NS_ASSERT(res);
 
-    res = m_sqliteOut->WaitPrepare(&stmt,
-                                   "INSERT INTO Metadata "
-                                   "(run, key, value)"
-                                   "values (?, ?, ?)");
+    res = m_sqliteOut->WaitExec("CREATE TABLE IF NOT EXISTS Singletons "
+                                "( run text, name text, variable text, value )");
     NS_ASSERT(res);
 
+    // The rows are inserted by batches, in transactions without a time limit
+    m_sqliteOut->EnableBatching(m_transactionSize, std::chrono::hours(1), m_writerThread);
     for (auto i = dc.MetadataBegin(); i != dc.MetadataEnd(); i++)
     {
         const auto& blob = (*i);
-        SQLiteOutput::SpinReset(stmt);
-        m_sqliteOut->Bind(stmt, 1, run);
-        m_sqliteOut->Bind(stmt, 2, blob.first);
-        m_sqliteOut->Bind(stmt, 3, blob.second);
-        SQLiteOutput::SpinStep(stmt);
+        m_sqliteOut->BatchExec("INSERT INTO Metadata (run, key, value) values (?, ?, ?)",
+                               run,
+                               blob.first,
+                               blob.second);
     }
 
-    SQLiteOutput::SpinFinalize(stmt);
-
-    m_sqliteOut->SpinExec("BEGIN");
     SqliteOutputCallback callback(m_sqliteOut, run);
     for (auto i = dc.DataCalculatorBegin(); i != dc.DataCalculatorEnd(); i++)
     {
         (*i)->Output(callback);
     }
-    m_sqliteOut->SpinExec("COMMIT");
+    m_sqliteOut->Flush();
     // end SqliteDataOutput::Output
     m_sqliteOut->Unref();
 }
@@ -134,20 +155,11 @@ SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback(const Ptr<SQLiteOut
       m_runLabel(run)
 {
     NS_LOG_FUNCTION(this << db << run);
-
-    m_db->WaitExec("CREATE TABLE IF NOT EXISTS Singletons "
-                   "( run text, name text, variable text, value )");
-
-    m_db->WaitPrepare(&m_insertSingletonStatement,
-                      "INSERT INTO Singletons "
-                      "(run, name, variable, value)"
-                      "values (?, ?, ?, ?)");
-    m_db->Bind(m_insertSingletonStatement, 1, m_runLabel);
 }
 
 SqliteDataOutput::SqliteOutputCallback::~SqliteOutputCallback()
 {
-    SQLiteOutput::SpinFinalize(m_insertSingletonStatement);
+    NS_LOG_FUNCTION(this);
 }
 
 void
@@ -187,11 +199,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_db->BatchExec("INSERT INTO Singletons (run, name, variable, value) values (?, ?, ?, ?)",
+                    m_runLabel,
+                    key,
+                    variable,
+                    val);
 }
 
 void
@@ -201,11 +213,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_db->BatchExec("INSERT INTO Singletons (run, name, variable, value) values (?, ?, ?, ?)",
+                    m_runLabel,
+                    key,
+                    variable,
+                    val);
 }
 
 void
@@ -215,11 +227,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_db->BatchExec("INSERT INTO Singletons (run, name, variable, value) values (?, ?, ?, ?)",
+                    m_runLabel,
+                    key,
+                    variable,
+                    val);
 }
 
 void
@@ -229,11 +241,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_db->BatchExec("INSERT INTO Singletons (run, name, variable, value) values (?, ?, ?, ?)",
+                    m_runLabel,
+                    key,
+                    variable,
+                    val);
 }
 
 void
@@ -243,11 +255,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val.GetTimeStep());
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_db->BatchExec("INSERT INTO Singletons (run, name, variable, value) values (?, ?, ?, ?)",
+                    m_runLabel,
+                    key,
+                    variable,
+                    val.GetTimeStep());
 }
 
 } // namespace ns3
@@ -13,8 +13,6 @@
 
 #include "ns3/nstime.h"
 
-struct sqlite3_stmt;
-
 namespace ns3
 {
 
@@ -26,6 +24,10 @@ class SQLiteOutput;
  * @ingroup dataoutput
  * @class SqliteDataOutput
  * @brief Outputs data in a format compatible with SQLite
+ *
+ * The metadata and the singletons are inserted by batches of
+ * \ref SqliteDataOutput::TransactionSize "TransactionSize" rows per
+ * transaction, possibly by a writer thread.
  */
 class SqliteDataOutput : public DataOutputInterface
 {
@@ -115,12 +117,12 @@ class SqliteDataOutput : public DataOutputInterface
       private:
         Ptr<SQLiteOutput> m_db; //!< Db
         std::string m_runLabel; //!< Run label
-
-        /// Pointer to a Sqlite3 singleton statement
-        sqlite3_stmt* m_insertSingletonStatement;
     };
 
     Ptr<SQLiteOutput> m_sqliteOut; //!< Database
+    uint32_t m_transactionSize;    //!< Maximum number of rows inserted per transaction
+    bool m_writerThread;           //!< Whether the rows are inserted by a writer thread
+    bool m_walJournal;             //!< Whether the journal is a write-ahead log
 };
 
 // end namespace ns3
@@ -29,6 +29,21 @@ SQLiteOutput::~SQLiteOutput()
 {
     int rc = SQLITE_FAIL;
 
+    Flush();
+    if (m_writer.joinable())
+    {
+        {
+            std::unique_lock lock{m_queueMutex};
+            m_stopWriter = true;
+        }
+        m_queueChanged.notify_all();
+        m_writer.join();
+    }
+    for (auto& [cmd, stmt] : m_statements)
+    {
+        SpinFinalize(stmt);
+    }
+
     rc = sqlite3_close_v2(m_db);
     NS_ABORT_MSG_UNLESS(rc == SQLITE_OK, "Failed to close DB");
 }
@@ -40,6 +55,207 @@ SQLiteOutput::SetJournalInMemory()
     SpinExec("PRAGMA journal_mode = MEMORY");
 }
 
+void
+SQLiteOutput::SetJournalWal()
+{
+    NS_LOG_FUNCTION(this);
+    // The journal_mode pragma returns the new mode as a row
+    sqlite3_stmt* stmt;
+    int rc = SpinPrepare(m_db, &stmt, "PRAGMA journal_mode = WAL");
+    if (!CheckError(m_db, rc, "PRAGMA journal_mode = WAL", false))
+    {
+        SpinStep(stmt);
+        SpinFinalize(stmt);
+    }
+    // A commit in WAL mode only needs to be durable at checkpoints
+    SpinExec("PRAGMA synchronous = NORMAL");
+}
+
+void
+SQLiteOutput::EnableBatching(uint32_t statements,
+                             std::chrono::milliseconds duration,
+                             bool writerThread)
+{
+    NS_LOG_FUNCTION(this << statements << duration.count() << writerThread);
+    NS_ABORT_MSG_IF(statements == 0, "A transaction should hold at least one statement");
+    NS_ABORT_MSG_IF(m_writer.joinable(), "The writer thread is already running");
+    Flush();
+    {
+        std::unique_lock lock{m_mutex};
+        m_batchStatements = statements;
+        m_batchDuration = duration;
+    }
+    if (writerThread)
+    {
+        m_writer = std::thread(&SQLiteOutput::RunWriter, this);
+    }
+}
+
+bool
+SQLiteOutput::DoBatchExec(BatchStatement&& statement)
+{
+    if (m_writer.joinable())
+    {
+        {
+            std::unique_lock lock{m_queueMutex};
+            m_queue.push_back(std::move(statement));
+        }
+        m_queueChanged.notify_all();
+        return true;
+    }
+
+    std::unique_lock lock{m_mutex};
+    if (m_batchStatements == 0)
+    {
+        return ExecuteStatement(statement);
+    }
+    return ExecuteBatched(statement);
+}
+
+bool
+SQLiteOutput::ExecuteBatched(const BatchStatement& statement)
+{
+    if (!m_inTransaction)
+    {
+        SpinExec(m_db, "BEGIN");
+        m_inTransaction = true;
+        m_transactionStatements = 0;
+        m_transactionStart = std::chrono::steady_clock::now();
+    }
+    bool ret = ExecuteStatement(statement);
+    m_transactionStatements++;
+    if (m_transactionStatements >= m_batchStatements ||
+        std::chrono::steady_clock::now() - m_transactionStart >= m_batchDuration)
+    {
+        Commit();
+    }
+    return ret;
+}
+
+bool
+SQLiteOutput::ExecuteStatement(const BatchStatement& statement)
+{
+    auto it = m_statements.find(statement.cmd);
+    if (it == m_statements.end())
+    {
+        sqlite3_stmt* stmt;
+        int rc = SpinPrepare(m_db, &stmt, statement.cmd);
+        if (CheckError(m_db, rc, statement.cmd, false))
+        {
+            return false;
+        }
+        it = m_statements.emplace(statement.cmd, stmt).first;
+    }
+
+    sqlite3_stmt* stmt = it->second;
+    SpinReset(stmt);
+    sqlite3_clear_bindings(stmt);
+    for (std::size_t i = 0; i < statement.values.size(); i++)
+    {
+        int pos = static_cast<int>(i + 1);
+        int rc = std::visit(
+            [stmt, pos](const auto& value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, int64_t>)
+                {
+                    return sqlite3_bind_int64(stmt, pos, value);
+                }
+                else if constexpr (std::is_same_v<T, double>)
+                {
+                    return sqlite3_bind_double(stmt, pos, value);
+                }
+                else
+                {
+                    return sqlite3_bind_text(stmt,
+                                             pos,
+                                             value.c_str(),
+                                             static_cast<int>(value.size()),
+                                             SQLITE_TRANSIENT);
+                }
+            },
+            statement.values[i]);
+        if (CheckError(m_db, rc, statement.cmd, false))
+        {
+            return false;
+        }
+    }
+    int rc = SpinStep(stmt);
+    return !CheckError(m_db, rc, statement.cmd, false);
+}
+
+void
+SQLiteOutput::Commit()
+{
+    if (m_inTransaction)
+    {
+        SpinExec(m_db, "COMMIT");
+        m_inTransaction = false;
+    }
+}
+
+void
+SQLiteOutput::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_writer.joinable())
+    {
+        std::unique_lock lock{m_queueMutex};
+        m_queueChanged.wait(lock, [this] { return m_queue.empty() && !m_writerBusy; });
+    }
+    std::unique_lock lock{m_mutex};
+    Commit();
+}
+
+void
+SQLiteOutput::RunWriter()
+{
+    std::deque<BatchStatement> statements;
+    std::unique_lock queueLock{m_queueMutex};
+    while (true)
+    {
+        // Wake up at the end of the open transaction, to commit it even if
+        // no other statement comes
+        bool inTransaction;
+        {
+            std::unique_lock lock{m_mutex};
+            inTransaction = m_inTransaction;
+        }
+        auto ready = [this] { return !m_queue.empty() || m_stopWriter; };
+        if (inTransaction)
+        {
+            m_queueChanged.wait_for(queueLock, m_batchDuration, ready);
+        }
+        else
+        {
+            m_queueChanged.wait(queueLock, ready);
+        }
+        if (m_queue.empty() && m_stopWriter)
+        {
+            return;
+        }
+
+        statements.swap(m_queue);
+        m_writerBusy = true;
+        queueLock.unlock();
+        {
+            std::unique_lock lock{m_mutex};
+            for (const auto& statement : statements)
+            {
+                ExecuteBatched(statement);
+            }
+            if (m_inTransaction &&
+                std::chrono::steady_clock::now() - m_transactionStart >= m_batchDuration)
+            {
+                Commit();
+            }
+        }
+        statements.clear();
+        queueLock.lock();
+        m_writerBusy = false;
+        m_queueChanged.notify_all();
+    }
+}
+
 bool
 SQLiteOutput::SpinExec(const std::string& cmd) const
 {
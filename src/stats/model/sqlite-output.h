@@ -7,11 +7,20 @@
 #ifndef SQLITE_OUTPUT_H
 #define SQLITE_OUTPUT_H
 
+#include "ns3/nstime.h"
 #include "ns3/simple-ref-count.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <sqlite3.h>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
 namespace ns3
 {
@@ -30,6 +39,11 @@ namespace ns3
  * recommended to use the "Wait" prefixed methods. Otherwise, if the access to
  * the database is unique, using "Spin" methods will speed up database access.
  *
+ * Many rows are written faster with BatchExec(), once batching is enabled
+ * with EnableBatching(): the statements are prepared once per SQL text, and
+ * executed in transactions grouping several statements, possibly by a
+ * writer thread.  Flush() commits the statements batched so far.
+ *
  * The database is opened in the constructor, and closed in the deconstructor.
  */
 class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
@@ -52,6 +66,52 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
      */
     void SetJournalInMemory();
 
+    /**
+     * @brief Instruct SQLite to use a write-ahead log as journal, which
+     * makes transactions cheaper, and lets other processes read the
+     * database while it is written.
+     */
+    void SetJournalWal();
+
+    /**
+     * @brief Group the statements executed by BatchExec() in transactions
+     *
+     * A transaction is committed once it holds \pname{statements} statements,
+     * or once it has been open for \pname{duration} (wall clock time).
+     *
+     * With a writer thread, BatchExec() only queues the statements, which the
+     * thread executes.  The other methods can still be called, and are then
+     * executed between two groups of statements of the writer thread.
+     *
+     * @param statements Maximum number of statements per transaction
+     * @param duration Maximum duration of a transaction
+     * @param writerThread Whether the statements are executed by a writer thread
+     */
+    void EnableBatching(uint32_t statements,
+                        std::chrono::milliseconds duration,
+                        bool writerThread = false);
+
+    /**
+     * @brief Execute a statement, binding values to its parameters
+     *
+     * The statement is prepared once per SQL text.  If batching is enabled,
+     * the statement is executed in a transaction grouping several statements,
+     * and possibly by the writer thread, so that its success is not known.
+     *
+     * @tparam Ts \deduced Types of the values bound: integers, floating point
+     * values, Time (bound in seconds) or strings
+     * @param cmd Command, with one parameter per value
+     * @param values Values bound to the parameters of the command
+     * @return true in case of success, or if the statement was batched
+     */
+    template <typename... Ts>
+    bool BatchExec(const std::string& cmd, const Ts&... values);
+
+    /**
+     * @brief Execute the statements batched so far, and commit their transaction
+     */
+    void Flush();
+
     /**
      * @brief Execute a command until the return value is OK or an ERROR
      *
@@ -216,10 +276,115 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
     static bool CheckError(sqlite3* db, int rc, const std::string& cmd, bool hardExit);
 
   private:
+    /// A value bound to a parameter of a batched statement
+    using Value = std::variant<int64_t, double, std::string>;
+
+    /// A statement executed by BatchExec()
+    struct BatchStatement
+    {
+        std::string cmd;           //!< Command
+        std::vector<Value> values; //!< Values bound to the parameters
+    };
+
+    /**
+     * @brief Convert a value bound to a parameter
+     * @tparam T \deduced Type of the value
+     * @param value Value
+     * @return the value to bind
+     */
+    template <typename T>
+    static Value ToValue(const T& value);
+
+    /**
+     * @brief Execute or queue a statement of BatchExec()
+     * @param statement Statement
+     * @return true in case of success, or if the statement was queued
+     */
+    bool DoBatchExec(BatchStatement&& statement);
+
+    /**
+     * @brief Execute a statement in the current transaction, opening it if
+     * needed, and commit the transaction if it is full or too old
+     *
+     * The mutex must be held.
+     *
+     * @param statement Statement
+     * @return true in case of success
+     */
+    bool ExecuteBatched(const BatchStatement& statement);
+
+    /**
+     * @brief Execute a statement with a prepared statement of the cache
+     *
+     * The mutex must be held.
+     *
+     * @param statement Statement
+     * @return true in case of success
+     */
+    bool ExecuteStatement(const BatchStatement& statement);
+
+    /**
+     * @brief Commit the current transaction, if any
+     *
+     * The mutex must be held.
+     */
+    void Commit();
+
+    /**
+     * @brief Execute the statements queued, in the writer thread
+     */
+    void RunWriter();
+
     std::string m_dBname;       //!< Database name
     mutable std::mutex m_mutex; //!< Mutex
     sqlite3* m_db{nullptr};     //!< Database pointer
+
+    /// Prepared statements of BatchExec(), by command
+    std::unordered_map<std::string, sqlite3_stmt*> m_statements;
+    uint32_t m_batchStatements{0};       //!< Statements per transaction, 0 if not batching
+    bool m_inTransaction{false};         //!< Whether a transaction is open
+    uint32_t m_transactionStatements{0}; //!< Statements of the open transaction
+    /// Maximum duration of a transaction
+    std::chrono::milliseconds m_batchDuration{0};
+    /// Start of the open transaction
+    std::chrono::steady_clock::time_point m_transactionStart;
+
+    std::thread m_writer;                   //!< Writer thread, if any
+    std::mutex m_queueMutex;                //!< Protects the queue of the writer thread
+    std::condition_variable m_queueChanged; //!< Signals a change of the queue
+    std::deque<BatchStatement> m_queue;     //!< Statements queued for the writer thread
+    bool m_writerBusy{false};               //!< Whether the writer executes statements
+    bool m_stopWriter{false};               //!< Whether the writer thread should stop
 };
 
+template <typename T>
+SQLiteOutput::Value
+SQLiteOutput::ToValue(const T& value)
+{
+    if constexpr (std::is_same_v<T, Time>)
+    {
+        return value.GetSeconds();
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        return static_cast<int64_t>(value);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return static_cast<double>(value);
+    }
+    else
+    {
+        return std::string(value);
+    }
+}
+
+template <typename... Ts>
+bool
+SQLiteOutput::BatchExec(const std::string& cmd, const Ts&... values)
+{
+    return DoBatchExec({cmd, {ToValue(values)...}});
+}
+
 } // namespace ns3
 #endif
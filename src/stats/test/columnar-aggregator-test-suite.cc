@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/columnar-aggregator.h"
+#include "ns3/enum.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarAggregator Test: the datasets written are read back by a
+ * ColumnarReader, across several chunks.
+ */
+class ColumnarAggregatorTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param compression the compression of the chunks.
+     */
+    ColumnarAggregatorTestCase(ColumnarAggregator::Compression compression);
+
+  private:
+    void DoRun() override;
+
+    ColumnarAggregator::Compression m_compression; //!< The compression of the chunks.
+};
+
+ColumnarAggregatorTestCase::ColumnarAggregatorTestCase(
+    ColumnarAggregator::Compression compression)
+    : TestCase(std::string("Columnar aggregator, compression ") +
+               (compression == ColumnarAggregator::ZLIB ? "zlib" : "none")),
+      m_compression(compression)
+{
+}
+
+void
+ColumnarAggregatorTestCase::DoRun()
+{
+    if (!ColumnarAggregator::IsCompressionSupported(m_compression))
+    {
+        return;
+    }
+
+    std::string fileName = CreateTempDirFilename("columnar-aggregator.col");
+    const uint32_t rows = 1000;
+    {
+        auto aggregator = CreateObject<ColumnarAggregator>(fileName);
+        aggregator->SetAttribute("ChunkRows", UintegerValue(64));
+        aggregator->SetAttribute("Compression", EnumValue(m_compression));
+        aggregator->Enable();
+        aggregator->AddDataset("Typed",
+                               {"time", "count", "value"},
+                               {ColumnarAggregator::INT64,
+                                ColumnarAggregator::UINT64,
+                                ColumnarAggregator::DOUBLE});
+        for (uint32_t i = 0; i < rows; i++)
+        {
+            aggregator->Write2d("Doubles", i * 0.5, -1.0 / (i + 1));
+            aggregator->Write3d("Typed", -1000.0 * i, i * 3.0, i + 0.25);
+        }
+        aggregator->Disable();
+        aggregator->Write2d("Doubles", 0, 0);
+    }
+
+    ColumnarReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "The file should be read");
+    auto datasets = reader.GetDatasets();
+    NS_TEST_ASSERT_MSG_EQ(datasets.size(), 2, "Two datasets should be read");
+
+    NS_TEST_ASSERT_MSG_EQ(reader.GetColumnN("Doubles"), 2, "Bad number of columns");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnName("Doubles", 1), "v2", "Bad default column name");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnType("Doubles", 0),
+                          ColumnarAggregator::DOUBLE,
+                          "Bad default column type");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetRowN("Doubles"), rows, "The disabled write should be dropped");
+    auto x = reader.GetColumn<double>("Doubles", 0);
+    auto y = reader.GetColumn<double>("Doubles", 1);
+
+    NS_TEST_ASSERT_MSG_EQ(reader.GetColumnN("Typed"), 3, "Bad number of columns");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnName("Typed", 0), "time", "Bad column name");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnType("Typed", 1),
+                          ColumnarAggregator::UINT64,
+                          "Bad column type");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetRowN("Typed"), rows, "Bad number of rows");
+    auto time = reader.GetColumn<int64_t>("Typed", 0);
+    auto count = reader.GetColumn<uint64_t>("Typed", 1);
+    auto value = reader.GetColumn<double>("Typed", 2);
+
+    for (uint32_t i = 0; i < rows; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(x[i], i * 0.5, "Bad value " << i);
+        NS_TEST_ASSERT_MSG_EQ(y[i], -1.0 / (i + 1), "Bad value " << i);
+        NS_TEST_ASSERT_MSG_EQ(time[i], -1000 * int64_t(i), "Bad value " << i);
+        NS_TEST_ASSERT_MSG_EQ(count[i], 3 * i, "Bad value " << i);
+        NS_TEST_ASSERT_MSG_EQ(value[i], i + 0.25, "Bad value " << i);
+    }
+    std::remove(fileName.c_str());
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarAggregator Test: the values written to integer columns
+ * saturate at the bounds of their type, and NaN is written as zero.
+ */
+class ColumnarAggregatorConversionTestCase : public TestCase
+{
+  public:
+    ColumnarAggregatorConversionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ColumnarAggregatorConversionTestCase::ColumnarAggregatorConversionTestCase()
+    : TestCase("Columnar aggregator, conversion to integer columns")
+{
+}
+
+void
+ColumnarAggregatorConversionTestCase::DoRun()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<double> values = {nan, inf, -inf, 1e30, -1e30, 9223372036854775808.0, -2.5};
+    const std::vector<int64_t> int64s = {0,
+                                         std::numeric_limits<int64_t>::max(),
+                                         std::numeric_limits<int64_t>::min(),
+                                         std::numeric_limits<int64_t>::max(),
+                                         std::numeric_limits<int64_t>::min(),
+                                         std::numeric_limits<int64_t>::max(),
+                                         -2};
+    const std::vector<uint64_t> uint64s = {0,
+                                           std::numeric_limits<uint64_t>::max(),
+                                           0,
+                                           std::numeric_limits<uint64_t>::max(),
+                                           0,
+                                           uint64_t(1) << 63,
+                                           0};
+
+    std::string fileName = CreateTempDirFilename("columnar-aggregator-conversion.col");
+    {
+        auto aggregator = CreateObject<ColumnarAggregator>(fileName);
+        aggregator->SetAttribute("Compression", EnumValue(ColumnarAggregator::NONE));
+        aggregator->Enable();
+        aggregator->AddDataset("Typed",
+                               {"signed", "unsigned"},
+                               {ColumnarAggregator::INT64, ColumnarAggregator::UINT64});
+        for (double value : values)
+        {
+            aggregator->Write2d("Typed", value, value);
+        }
+    }
+
+    ColumnarReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "The file should be read");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetRowN("Typed"), values.size(), "Bad number of rows");
+    auto signedColumn = reader.GetColumn<int64_t>("Typed", 0);
+    auto unsignedColumn = reader.GetColumn<uint64_t>("Typed", 1);
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(signedColumn[i], int64s[i], "Bad signed value for " << values[i]);
+        NS_TEST_EXPECT_MSG_EQ(unsignedColumn[i],
+                              uint64s[i],
+                              "Bad unsigned value for " << values[i]);
+    }
+    std::remove(fileName.c_str());
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarAggregator TestSuite
+ */
+class ColumnarAggregatorTestSuite : public TestSuite
+{
+  public:
+    ColumnarAggregatorTestSuite();
+};
+
+ColumnarAggregatorTestSuite::ColumnarAggregatorTestSuite()
+    : TestSuite("columnar-aggregator", Type::UNIT)
+{
+    AddTestCase(new ColumnarAggregatorTestCase(ColumnarAggregator::NONE),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ColumnarAggregatorTestCase(ColumnarAggregator::ZLIB),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ColumnarAggregatorConversionTestCase(), TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static ColumnarAggregatorTestSuite g_columnarAggregatorTestSuite;
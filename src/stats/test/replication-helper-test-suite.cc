@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/basic-data-calculators.h"
+#include "ns3/data-collector.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/replication-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ReplicationHelper class - Test the aggregation of the data calculators.
+ */
+class ReplicationHelperTestCase : public TestCase
+{
+  public:
+    ReplicationHelperTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ReplicationHelperTestCase::ReplicationHelperTestCase()
+    : TestCase("Aggregate the data calculators of the replications")
+{
+}
+
+void
+ReplicationHelperTestCase::DoRun()
+{
+    const uint64_t originalRun = RngSeedManager::GetRun();
+    const uint64_t firstRun = 1;
+    const uint32_t count = 4;
+
+    // Each replication draws 10 values and counts the events
+    Ptr<DataCollector> collector = CreateObject<DataCollector>();
+    collector->DescribeRun("experiment", "strategy", "input", "run");
+    collector->AddMetadata("author", "test");
+    Ptr<MinMaxAvgTotalCalculator<double>> values = CreateObject<MinMaxAvgTotalCalculator<double>>();
+    values->SetContext("node");
+    values->SetKey("value");
+    collector->AddDataCalculator(values);
+    Ptr<CounterCalculator<>> events = CreateObject<CounterCalculator<>>();
+    events->SetContext("node");
+    events->SetKey("events");
+    collector->AddDataCalculator(events);
+
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    uniform->SetStream(3);
+    for (int i = 1; i <= 10; i++)
+    {
+        Simulator::Schedule(Seconds(i), [=]() {
+            values->Update(uniform->GetValue());
+            events->Update();
+        });
+    }
+
+    ReplicationHelper helper;
+    helper.SetMaxProcesses(2);
+    Ptr<DataCollector> aggregate = helper.Run(collector, firstRun, count);
+    Simulator::Destroy();
+
+    // Compute the expected averages
+    double expectedAverage = 0;
+    for (uint64_t run = firstRun; run < firstRun + count; run++)
+    {
+        RngSeedManager::SetRun(run);
+        Ptr<UniformRandomVariable> expected = CreateObject<UniformRandomVariable>();
+        expected->SetStream(3);
+        double sum = 0;
+        for (int i = 0; i < 10; i++)
+        {
+            sum += expected->GetValue();
+        }
+        expectedAverage += sum / 10 / count;
+    }
+    RngSeedManager::SetRun(originalRun);
+
+    NS_TEST_EXPECT_MSG_EQ(aggregate->GetRunLabel(), "1-4", "Bad run label");
+    NS_TEST_EXPECT_MSG_EQ(aggregate->GetExperimentLabel(), "experiment", "Bad experiment label");
+    bool foundReplications = false;
+    for (auto i = aggregate->MetadataBegin(); i != aggregate->MetadataEnd(); i++)
+    {
+        if (i->first == "replications")
+        {
+            foundReplications = true;
+            NS_TEST_EXPECT_MSG_EQ(i->second, "4", "Bad number of replications");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(foundReplications, true, "Missing number of replications");
+
+    bool foundAverage = false;
+    bool foundEvents = false;
+    for (auto i = aggregate->DataCalculatorBegin(); i != aggregate->DataCalculatorEnd(); i++)
+    {
+        auto calculator = DynamicCast<MinMaxAvgTotalCalculator<double>>(*i);
+        NS_TEST_ASSERT_MSG_NE(calculator, nullptr, "Bad calculator type");
+        NS_TEST_EXPECT_MSG_EQ(calculator->GetContext(), "node", "Bad context");
+        NS_TEST_EXPECT_MSG_EQ(calculator->getCount(), count, "Bad count of " << (*i)->GetKey());
+        if (calculator->GetKey() == "value-average")
+        {
+            foundAverage = true;
+            NS_TEST_EXPECT_MSG_EQ_TOL(calculator->getMean(),
+                                      expectedAverage,
+                                      1e-12,
+                                      "Bad average of the average values");
+            NS_TEST_EXPECT_MSG_NE(calculator->getMin(),
+                                  calculator->getMax(),
+                                  "The replications should draw different values");
+        }
+        else if (calculator->GetKey() == "events")
+        {
+            foundEvents = true;
+            NS_TEST_EXPECT_MSG_EQ(calculator->getMin(), 10, "Bad number of events");
+            NS_TEST_EXPECT_MSG_EQ(calculator->getMax(), 10, "Bad number of events");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(foundAverage, true, "Missing average value");
+    NS_TEST_EXPECT_MSG_EQ(foundEvents, true, "Missing number of events");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ReplicationHelper class TestSuite
+ */
+class ReplicationHelperTestSuite : public TestSuite
+{
+  public:
+    ReplicationHelperTestSuite();
+};
+
+ReplicationHelperTestSuite::ReplicationHelperTestSuite()
+    : TestSuite("replication-helper", Type::UNIT)
+{
+#ifndef __WIN32__
+    AddTestCase(new ReplicationHelperTestCase, TestCase::Duration::QUICK);
+#endif
+}
+
+/// Static variable for test initialization
+static ReplicationHelperTestSuite replicationHelperTestSuite;
@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/sqlite-output.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief SQLiteOutput Test: the statements executed by BatchExec() are all
+ * committed, in the order they were executed, once flushed.
+ */
+class SQLiteOutputBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param batching whether the statements are batched.
+     * @param writerThread whether the statements are executed by a writer thread.
+     */
+    SQLiteOutputBatchTestCase(bool batching, bool writerThread);
+
+  private:
+    void DoRun() override;
+
+    bool m_batching;     //!< Whether the statements are batched.
+    bool m_writerThread; //!< Whether the statements are executed by a writer thread.
+};
+
+SQLiteOutputBatchTestCase::SQLiteOutputBatchTestCase(bool batching, bool writerThread)
+    : TestCase(std::string("SQLiteOutput batched statements, ") +
+               (batching ? (writerThread ? "writer thread" : "batching") : "no batching")),
+      m_batching(batching),
+      m_writerThread(writerThread)
+{
+}
+
+void
+SQLiteOutputBatchTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("sqlite-output.db");
+    std::remove(fileName.c_str());
+    const uint32_t rows = 2500;
+    {
+        Ptr<SQLiteOutput> db = Create<SQLiteOutput>(fileName);
+        db->SetJournalWal();
+        NS_TEST_ASSERT_MSG_EQ(db->SpinExec("CREATE TABLE Samples (id, flow text, value)"),
+                              true,
+                              "The table should be created");
+        if (m_batching)
+        {
+            db->EnableBatching(1000, std::chrono::seconds(10), m_writerThread);
+        }
+        for (uint32_t i = 0; i < rows; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(
+                db->BatchExec("INSERT INTO Samples (id, flow, value) values (?, ?, ?)",
+                              i,
+                              "flow-" + std::to_string(i % 10),
+                              i * 0.5),
+                true,
+                "The row should be inserted");
+        }
+        db->Flush();
+
+        sqlite3_stmt* stmt;
+        NS_TEST_ASSERT_MSG_EQ(db->WaitPrepare(&stmt, "SELECT COUNT(*), SUM(value) FROM Samples"),
+                              true,
+                              "The query should be prepared");
+        NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "A row expected");
+        NS_TEST_EXPECT_MSG_EQ(db->RetrieveColumn<uint32_t>(stmt, 0), rows, "Rows missing");
+        NS_TEST_EXPECT_MSG_EQ(db->RetrieveColumn<double>(stmt, 1),
+                              0.5 * rows * (rows - 1) / 2,
+                              "Bad sum of the values");
+        SQLiteOutput::SpinFinalize(stmt);
+
+        NS_TEST_ASSERT_MSG_EQ(db->WaitPrepare(&stmt, "SELECT id, flow FROM Samples ORDER BY rowid"),
+                              true,
+                              "The query should be prepared");
+        for (uint32_t i = 0; i < rows; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "A row expected");
+            NS_TEST_ASSERT_MSG_EQ(db->RetrieveColumn<uint32_t>(stmt, 0),
+                                  i,
+                                  "The rows should keep their order");
+            NS_TEST_ASSERT_MSG_EQ(
+                std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1))),
+                "flow-" + std::to_string(i % 10),
+                "Bad text value");
+        }
+        SQLiteOutput::SpinFinalize(stmt);
+
+        // Statements batched after the flush are committed when the database
+        // is closed
+        db->BatchExec("INSERT INTO Samples (id, flow, value) values (?, ?, ?)", rows, "last", 0.0);
+    }
+
+    Ptr<SQLiteOutput> db = Create<SQLiteOutput>(fileName);
+    sqlite3_stmt* stmt;
+    NS_TEST_ASSERT_MSG_EQ(db->WaitPrepare(&stmt, "SELECT COUNT(*) FROM Samples"),
+                          true,
+                          "The query should be prepared");
+    NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "A row expected");
+    NS_TEST_EXPECT_MSG_EQ(db->RetrieveColumn<uint32_t>(stmt, 0), rows + 1, "Rows missing");
+    SQLiteOutput::SpinFinalize(stmt);
+    db = nullptr;
+    std::remove(fileName.c_str());
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief SQLiteOutput TestSuite
+ */
+class SQLiteOutputTestSuite : public TestSuite
+{
+  public:
+    SQLiteOutputTestSuite();
+};
+
+SQLiteOutputTestSuite::SQLiteOutputTestSuite()
+    : TestSuite("sqlite-output", Type::UNIT)
+{
+    AddTestCase(new SQLiteOutputBatchTestCase(false, false), TestCase::Duration::QUICK);
+    AddTestCase(new SQLiteOutputBatchTestCase(true, false), TestCase::Duration::QUICK);
+    AddTestCase(new SQLiteOutputBatchTestCase(true, true), TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SQLiteOutputTestSuite g_sqliteOutputTestSuite;
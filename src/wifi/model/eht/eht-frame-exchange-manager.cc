@@ -354,7 +354,7 @@ EhtFrameExchangeManager::ForwardPsduDown(Ptr<const WifiPsdu> psdu, WifiTxVector&
         txVector.SetSigBMode(sigBMode);
     }
 
-    auto txDuration = WifiPhy::CalculateTxDuration(psdu, txVector, m_phy->GetPhyBand());
+    auto txDuration = m_phy->GetTxDuration(psdu, txVector);
 
     if (m_apMac && psdu->GetHeader(0).IsTrigger())
     {
@@ -429,7 +429,7 @@ EhtFrameExchangeManager::ForwardPsduMapDown(WifiConstPsduMap psduMap, WifiTxVect
 {
     NS_LOG_FUNCTION(this << psduMap << txVector);
 
-    auto txDuration = WifiPhy::CalculateTxDuration(psduMap, txVector, m_phy->GetPhyBand());
+    auto txDuration = m_phy->GetTxDuration(psduMap, txVector);
 
     HeFrameExchangeManager::ForwardPsduMapDown(psduMap, txVector);
     UpdateTxopEndOnTxStart(txDuration, psduMap.begin()->second->GetDuration());
@@ -555,9 +555,8 @@ FrameExchangeManager::SendMpdu()
 {
     NS_LOG_FUNCTION(this);
 
-    Time txDuration = WifiPhy::CalculateTxDuration(GetPsduSize(m_mpdu, m_txParams.m_txVector),
-                                                   m_txParams.m_txVector,
-                                                   m_phy->GetPhyBand());
+    Time txDuration = m_phy->GetTxDuration(GetPsduSize(m_mpdu, m_txParams.m_txVector),
+                                           m_txParams.m_txVector);
 
     NS_ASSERT(m_txParams.m_acknowledgment);
 
@@ -672,7 +671,7 @@ FrameExchangeManager::ForwardMpduDown(Ptr<WifiMpdu> mpdu, WifiTxVector& txVector
     auto psdu = Create<WifiPsdu>(mpdu, false);
     FinalizeMacHeader(psdu);
     m_allowedWidth = std::min(m_allowedWidth, txVector.GetChannelWidth());
-    const auto txDuration = WifiPhy::CalculateTxDuration(psdu, txVector, m_phy->GetPhyBand());
+    const auto txDuration = m_phy->GetTxDuration(psdu, txVector);
     SetTxNav(mpdu, txDuration);
 
     const auto& hdr = psdu->GetHeader(0);
@@ -778,21 +777,15 @@ FrameExchangeManager::CalculateProtectionTime(WifiProtection* protection) const
     {
         auto rtsCtsProtection = static_cast<WifiRtsCtsProtection*>(protection);
         rtsCtsProtection->protectionTime =
-            WifiPhy::CalculateTxDuration(GetRtsSize(),
-                                         rtsCtsProtection->rtsTxVector,
-                                         m_phy->GetPhyBand()) +
-            WifiPhy::CalculateTxDuration(GetCtsSize(),
-                                         rtsCtsProtection->ctsTxVector,
-                                         m_phy->GetPhyBand()) +
+            m_phy->GetTxDuration(GetRtsSize(), rtsCtsProtection->rtsTxVector) +
+            m_phy->GetTxDuration(GetCtsSize(), rtsCtsProtection->ctsTxVector) +
             2 * m_phy->GetSifs();
     }
     else if (protection->method == WifiProtection::CTS_TO_SELF)
     {
         auto ctsToSelfProtection = static_cast<WifiCtsToSelfProtection*>(protection);
         ctsToSelfProtection->protectionTime =
-            WifiPhy::CalculateTxDuration(GetCtsSize(),
-                                         ctsToSelfProtection->ctsTxVector,
-                                         m_phy->GetPhyBand()) +
+            m_phy->GetTxDuration(GetCtsSize(), ctsToSelfProtection->ctsTxVector) +
             m_phy->GetSifs();
     }
 }
@@ -811,9 +804,8 @@ FrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowledg
     {
         auto normalAcknowledgment = static_cast<WifiNormalAck*>(acknowledgment);
         normalAcknowledgment->acknowledgmentTime =
-            m_phy->GetSifs() + WifiPhy::CalculateTxDuration(GetAckSize(),
-                                                            normalAcknowledgment->ackTxVector,
-                                                            m_phy->GetPhyBand());
+            m_phy->GetSifs() +
+            m_phy->GetTxDuration(GetAckSize(), normalAcknowledgment->ackTxVector);
     }
 }
 
@@ -822,7 +814,7 @@ FrameExchangeManager::GetTxDuration(uint32_t ppduPayloadSize,
                                     Mac48Address receiver,
                                     const WifiTxParameters& txParams) const
 {
-    return WifiPhy::CalculateTxDuration(ppduPayloadSize, txParams.m_txVector, m_phy->GetPhyBand());
+    return m_phy->GetTxDuration(ppduPayloadSize, txParams.m_txVector);
 }
 
 void
@@ -854,11 +846,8 @@ FrameExchangeManager::GetFrameDurationId(const WifiMacHeader& header,
         WifiTxVector ackTxVector =
             GetWifiRemoteStationManager()->GetAckTxVector(header.GetAddr1(), txParams.m_txVector);
 
-        durationId += 2 * m_phy->GetSifs() +
-                      WifiPhy::CalculateTxDuration(GetAckSize(), ackTxVector, m_phy->GetPhyBand()) +
-                      WifiPhy::CalculateTxDuration(nextFragmentSize,
-                                                   txParams.m_txVector,
-                                                   m_phy->GetPhyBand());
+        durationId += 2 * m_phy->GetSifs() + m_phy->GetTxDuration(GetAckSize(), ackTxVector) +
+                      m_phy->GetTxDuration(nextFragmentSize, txParams.m_txVector);
     }
     return durationId;
 }
@@ -874,7 +863,7 @@ FrameExchangeManager::GetRtsDurationId(const WifiTxVector& rtsTxVector,
     ctsTxVector = GetWifiRemoteStationManager()->GetCtsTxVector(m_self, rtsTxVector.GetMode());
 
     return m_phy->GetSifs() +
-           WifiPhy::CalculateTxDuration(GetCtsSize(), ctsTxVector, m_phy->GetPhyBand()) /* CTS */
+           m_phy->GetTxDuration(GetCtsSize(), ctsTxVector) /* CTS */
            + m_phy->GetSifs() + txDuration + response;
 }
 
@@ -910,9 +899,7 @@ FrameExchangeManager::SendRts(const WifiTxParameters& txParams)
     // After transmitting an RTS frame, the STA shall wait for a CTSTimeout interval with
     // a value of aSIFSTime + aSlotTime + aRxPHYStartDelay (IEEE 802.11-2016 sec. 10.3.2.7).
     // aRxPHYStartDelay equals the time to transmit the PHY header.
-    Time timeout = WifiPhy::CalculateTxDuration(GetRtsSize(),
-                                                rtsCtsProtection->rtsTxVector,
-                                                m_phy->GetPhyBand()) +
+    Time timeout = m_phy->GetTxDuration(GetRtsSize(), rtsCtsProtection->rtsTxVector) +
                    m_phy->GetSifs() + m_phy->GetSlot() +
                    WifiPhy::CalculatePhyPreambleAndHeaderDuration(rtsCtsProtection->ctsTxVector);
     NS_ASSERT(!m_txTimer.IsRunning());
@@ -945,7 +932,7 @@ FrameExchangeManager::DoSendCtsAfterRts(const WifiMacHeader& rtsHdr,
     cts.SetNoRetry();
     cts.SetAddr1(rtsHdr.GetAddr2());
     Time duration = rtsHdr.GetDuration() - m_phy->GetSifs() -
-                    WifiPhy::CalculateTxDuration(GetCtsSize(), ctsTxVector, m_phy->GetPhyBand());
+                    m_phy->GetTxDuration(GetCtsSize(), ctsTxVector);
     // The TXOP holder may exceed the TXOP limit in some situations (Sec. 10.22.2.8 of 802.11-2016)
     if (duration.IsStrictlyNegative())
     {
@@ -1010,9 +997,7 @@ FrameExchangeManager::SendCtsToSelf(const WifiTxParameters& txParams)
 
     ForwardMpduDown(Create<WifiMpdu>(Create<Packet>(), cts), ctsToSelfProtection->ctsTxVector);
 
-    Time ctsDuration = WifiPhy::CalculateTxDuration(GetCtsSize(),
-                                                    ctsToSelfProtection->ctsTxVector,
-                                                    m_phy->GetPhyBand());
+    Time ctsDuration = m_phy->GetTxDuration(GetCtsSize(), ctsToSelfProtection->ctsTxVector);
     Simulator::Schedule(ctsDuration, &FrameExchangeManager::ProtectionCompleted, this);
 }
 
@@ -1039,7 +1024,7 @@ FrameExchangeManager::SendNormalAck(const WifiMacHeader& hdr,
         hdr.IsPsPoll()
             ? Time{0}
             : hdr.GetDuration() - m_phy->GetSifs() -
-                  WifiPhy::CalculateTxDuration(GetAckSize(), ackTxVector, m_phy->GetPhyBand());
+                  m_phy->GetTxDuration(GetAckSize(), ackTxVector);
     // The TXOP holder may exceed the TXOP limit in some situations (Sec. 10.22.2.8 of 802.11-2016)
     if (duration.IsStrictlyNegative())
     {
@@ -1492,8 +1477,7 @@ FrameExchangeManager::UpdateNav(const WifiMacHeader& hdr,
             WifiTxVector ctsTxVector =
                 GetWifiRemoteStationManager()->GetCtsTxVector(addr2, txVector.GetMode());
             Time navResetDelay =
-                2 * m_phy->GetSifs() +
-                WifiPhy::CalculateTxDuration(GetCtsSize(), ctsTxVector, m_phy->GetPhyBand()) +
+                2 * m_phy->GetSifs() + m_phy->GetTxDuration(GetCtsSize(), ctsTxVector) +
                 WifiPhy::CalculatePhyPreambleAndHeaderDuration(ctsTxVector) + 2 * m_phy->GetSlot();
             m_navResetEvent.Cancel();
             m_navResetEvent =
@@ -350,7 +350,7 @@ HeFrameExchangeManager::GetMuRtsDurationId(uint32_t muRtsSize,
     // of 802.11-2016)
     auto duration =
         std::max(m_edca->GetRemainingTxop(m_linkId) -
-                     WifiPhy::CalculateTxDuration(muRtsSize, muRtsTxVector, m_phy->GetPhyBand()),
+                     m_phy->GetTxDuration(muRtsSize, muRtsTxVector),
                  Seconds(0));
 
     if (m_protectSingleExchange)
@@ -400,9 +400,7 @@ HeFrameExchangeManager::SendMuRts(const WifiTxParameters& txParams)
     // After transmitting an MU-RTS frame, the STA shall wait for a CTSTimeout interval of
     // aSIFSTime + aSlotTime + aRxPHYStartDelay (Sec. 27.2.5.2 of 802.11ax D3.0).
     // aRxPHYStartDelay equals the time to transmit the PHY header.
-    Time timeout = WifiPhy::CalculateTxDuration(mpdu->GetSize(),
-                                                protection->muRtsTxVector,
-                                                m_phy->GetPhyBand()) +
+    Time timeout = m_phy->GetTxDuration(mpdu->GetSize(), protection->muRtsTxVector) +
                    m_phy->GetSifs() + m_phy->GetSlot() +
                    WifiPhy::CalculatePhyPreambleAndHeaderDuration(ctsTxVector);
 
@@ -620,9 +618,8 @@ HeFrameExchangeManager::SendPsduMap()
             }
 
             Ptr<WifiPsdu> triggerPsdu = GetWifiPsdu(m_triggerFrame, acknowledgment->muBarTxVector);
-            Time txDuration = WifiPhy::CalculateTxDuration(triggerPsdu->GetSize(),
-                                                           acknowledgment->muBarTxVector,
-                                                           m_phy->GetPhyBand());
+            Time txDuration = m_phy->GetTxDuration(triggerPsdu->GetSize(),
+                                                   acknowledgment->muBarTxVector);
             // update acknowledgmentTime to correctly set the Duration/ID
             *acknowledgment->acknowledgmentTime -= (m_phy->GetSifs() + txDuration);
             m_triggerFrame->GetHeader().SetDuration(GetPsduDurationId(txDuration, m_txParams));
@@ -787,8 +784,7 @@ HeFrameExchangeManager::SendPsduMap()
     }
     else
     {
-        txDuration =
-            WifiPhy::CalculateTxDuration(psduMap, m_txParams.m_txVector, m_phy->GetPhyBand());
+        txDuration = m_phy->GetTxDuration(psduMap, m_txParams.m_txVector);
 
         // Set Duration/ID
         Time durationId = GetPsduDurationId(txDuration, m_txParams);
@@ -954,7 +950,7 @@ HeFrameExchangeManager::ForwardPsduMapDown(WifiConstPsduMap psduMap, WifiTxVecto
         txVector.SetAggregation(true);
     }
 
-    const auto txDuration = WifiPhy::CalculateTxDuration(psduMap, txVector, m_phy->GetPhyBand());
+    const auto txDuration = m_phy->GetTxDuration(psduMap, txVector);
     SetTxNav(*psduMap.cbegin()->second->begin(), txDuration);
 
     m_phy->Send(psduMap, txVector);
@@ -1032,11 +1028,8 @@ HeFrameExchangeManager::CalculateProtectionTime(WifiProtection* protection) cons
         uint32_t muRtsSize = WifiMacHeader(WIFI_MAC_CTL_TRIGGER).GetSize() +
                              muRtsCtsProtection->muRts.GetSerializedSize() + WIFI_MAC_FCS_LENGTH;
         muRtsCtsProtection->protectionTime =
-            WifiPhy::CalculateTxDuration(muRtsSize,
-                                         muRtsCtsProtection->muRtsTxVector,
-                                         m_phy->GetPhyBand()) +
-            WifiPhy::CalculateTxDuration(GetCtsSize(), ctsTxVector, m_phy->GetPhyBand()) +
-            2 * m_phy->GetSifs();
+            m_phy->GetTxDuration(muRtsSize, muRtsCtsProtection->muRtsTxVector) +
+            m_phy->GetTxDuration(GetCtsSize(), ctsTxVector) + 2 * m_phy->GetSifs();
     }
     else
     {
@@ -1068,32 +1061,25 @@ HeFrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowle
         {
             const auto& info =
                 dlMuBarBaAcknowledgment->stationsReplyingWithNormalAck.begin()->second;
-            duration +=
-                m_phy->GetSifs() +
-                WifiPhy::CalculateTxDuration(GetAckSize(), info.ackTxVector, m_phy->GetPhyBand());
+            duration += m_phy->GetSifs() + m_phy->GetTxDuration(GetAckSize(), info.ackTxVector);
         }
 
         if (!dlMuBarBaAcknowledgment->stationsReplyingWithBlockAck.empty())
         {
             const auto& info =
                 dlMuBarBaAcknowledgment->stationsReplyingWithBlockAck.begin()->second;
-            duration +=
-                m_phy->GetSifs() + WifiPhy::CalculateTxDuration(GetBlockAckSize(info.baType),
-                                                                info.blockAckTxVector,
-                                                                m_phy->GetPhyBand());
+            duration += m_phy->GetSifs() +
+                        m_phy->GetTxDuration(GetBlockAckSize(info.baType), info.blockAckTxVector);
         }
 
         for (const auto& stations : dlMuBarBaAcknowledgment->stationsSendBlockAckReqTo)
         {
             const auto& info = stations.second;
             duration += m_phy->GetSifs() +
-                        WifiPhy::CalculateTxDuration(GetBlockAckRequestSize(info.barType),
-                                                     info.blockAckReqTxVector,
-                                                     m_phy->GetPhyBand()) +
+                        m_phy->GetTxDuration(GetBlockAckRequestSize(info.barType),
+                                             info.blockAckReqTxVector) +
                         m_phy->GetSifs() +
-                        WifiPhy::CalculateTxDuration(GetBlockAckSize(info.baType),
-                                                     info.blockAckTxVector,
-                                                     m_phy->GetPhyBand());
+                        m_phy->GetTxDuration(GetBlockAckSize(info.baType), info.blockAckTxVector);
         }
 
         dlMuBarBaAcknowledgment->acknowledgmentTime = duration;
@@ -1113,10 +1099,9 @@ HeFrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowle
             const auto& info = stations.second;
             NS_ASSERT(info.blockAckTxVector.GetHeMuUserInfoMap().size() == 1);
             uint16_t staId = info.blockAckTxVector.GetHeMuUserInfoMap().begin()->first;
-            Time currBlockAckDuration = WifiPhy::CalculateTxDuration(GetBlockAckSize(info.baType),
-                                                                     info.blockAckTxVector,
-                                                                     m_phy->GetPhyBand(),
-                                                                     staId);
+            Time currBlockAckDuration = m_phy->GetTxDuration(GetBlockAckSize(info.baType),
+                                                             info.blockAckTxVector,
+                                                             staId);
             // update the max duration among all the Block Ack responses
             if (currBlockAckDuration > duration)
             {
@@ -1145,9 +1130,7 @@ HeFrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowle
         }
         dlMuTfMuBarAcknowledgment->acknowledgmentTime =
             m_phy->GetSifs() +
-            WifiPhy::CalculateTxDuration(muBarSize,
-                                         dlMuTfMuBarAcknowledgment->muBarTxVector,
-                                         m_phy->GetPhyBand()) +
+            m_phy->GetTxDuration(muBarSize, dlMuTfMuBarAcknowledgment->muBarTxVector) +
             m_phy->GetSifs() + duration;
     }
     /*
@@ -1165,10 +1148,9 @@ HeFrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowle
             const auto& info = stations.second;
             NS_ASSERT(info.blockAckTxVector.GetHeMuUserInfoMap().size() == 1);
             uint16_t staId = info.blockAckTxVector.GetHeMuUserInfoMap().begin()->first;
-            Time currBlockAckDuration = WifiPhy::CalculateTxDuration(GetBlockAckSize(info.baType),
-                                                                     info.blockAckTxVector,
-                                                                     m_phy->GetPhyBand(),
-                                                                     staId);
+            Time currBlockAckDuration = m_phy->GetTxDuration(GetBlockAckSize(info.baType),
+                                                             info.blockAckTxVector,
+                                                             staId);
             // update the max duration among all the Block Ack responses
             if (currBlockAckDuration > duration)
             {
@@ -1191,9 +1173,8 @@ HeFrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowle
     {
         auto ulMuMultiStaBa = static_cast<WifiUlMuMultiStaBa*>(acknowledgment);
 
-        Time duration = WifiPhy::CalculateTxDuration(GetBlockAckSize(ulMuMultiStaBa->baType),
-                                                     ulMuMultiStaBa->multiStaBaTxVector,
-                                                     m_phy->GetPhyBand());
+        Time duration = m_phy->GetTxDuration(GetBlockAckSize(ulMuMultiStaBa->baType),
+                                             ulMuMultiStaBa->multiStaBaTxVector);
         ulMuMultiStaBa->acknowledgmentTime = m_phy->GetSifs() + duration;
     }
     /*
@@ -1294,10 +1275,7 @@ HeFrameExchangeManager::GetTxDuration(uint32_t ppduPayloadSize,
 
     uint16_t staId = (txParams.m_txVector.IsDlMu() ? m_apMac->GetAssociationId(receiver, m_linkId)
                                                    : m_staMac->GetAssociationId());
-    Time psduDuration = WifiPhy::CalculateTxDuration(ppduPayloadSize,
-                                                     txParams.m_txVector,
-                                                     m_phy->GetPhyBand(),
-                                                     staId);
+    Time psduDuration = m_phy->GetTxDuration(ppduPayloadSize, txParams.m_txVector, staId);
 
     return txParams.m_txDuration ? std::max(psduDuration, *txParams.m_txDuration) : psduDuration;
 }
@@ -1746,9 +1724,8 @@ HeFrameExchangeManager::SendMultiStaBlockAck(const WifiTxParameters& txParams, T
     Ptr<WifiPsdu> psdu =
         GetWifiPsdu(Create<WifiMpdu>(packet, hdr), acknowledgment->multiStaBaTxVector);
 
-    Time txDuration = WifiPhy::CalculateTxDuration(GetBlockAckSize(acknowledgment->baType),
-                                                   acknowledgment->multiStaBaTxVector,
-                                                   m_phy->GetPhyBand());
+    Time txDuration = m_phy->GetTxDuration(GetBlockAckSize(acknowledgment->baType),
+                                           acknowledgment->multiStaBaTxVector);
     /**
      * In a BlockAck frame transmitted in response to a frame carried in HE TB PPDU under
      * single protection settings, the Duration/ID field is set to the value obtained from
@@ -2128,8 +2105,7 @@ HeFrameExchangeManager::UpdateNav(const WifiMacHeader& hdr,
             WifiTxVector ctsTxVector =
                 GetWifiRemoteStationManager()->GetCtsTxVector(addr2, txVector.GetMode());
             auto navResetDelay =
-                2 * m_phy->GetSifs() +
-                WifiPhy::CalculateTxDuration(GetCtsSize(), ctsTxVector, m_phy->GetPhyBand()) +
+                2 * m_phy->GetSifs() + m_phy->GetTxDuration(GetCtsSize(), ctsTxVector) +
                 WifiPhy::CalculatePhyPreambleAndHeaderDuration(ctsTxVector) + 2 * m_phy->GetSlot();
             m_intraBssNavResetEvent.Cancel();
             m_intraBssNavResetEvent =
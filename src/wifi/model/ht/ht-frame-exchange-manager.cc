@@ -801,23 +801,18 @@ HtFrameExchangeManager::CalculateAcknowledgmentTime(WifiAcknowledgment* acknowle
     if (acknowledgment->method == WifiAcknowledgment::BLOCK_ACK)
     {
         auto blockAcknowledgment = static_cast<WifiBlockAck*>(acknowledgment);
-        auto baTxDuration =
-            WifiPhy::CalculateTxDuration(GetBlockAckSize(blockAcknowledgment->baType),
-                                         blockAcknowledgment->blockAckTxVector,
-                                         m_phy->GetPhyBand());
+        auto baTxDuration = m_phy->GetTxDuration(GetBlockAckSize(blockAcknowledgment->baType),
+                                                 blockAcknowledgment->blockAckTxVector);
         blockAcknowledgment->acknowledgmentTime = m_phy->GetSifs() + baTxDuration;
     }
     else if (acknowledgment->method == WifiAcknowledgment::BAR_BLOCK_ACK)
     {
         auto barBlockAcknowledgment = static_cast<WifiBarBlockAck*>(acknowledgment);
         auto barTxDuration =
-            WifiPhy::CalculateTxDuration(GetBlockAckRequestSize(barBlockAcknowledgment->barType),
-                                         barBlockAcknowledgment->blockAckReqTxVector,
-                                         m_phy->GetPhyBand());
-        auto baTxDuration =
-            WifiPhy::CalculateTxDuration(GetBlockAckSize(barBlockAcknowledgment->baType),
-                                         barBlockAcknowledgment->blockAckTxVector,
-                                         m_phy->GetPhyBand());
+            m_phy->GetTxDuration(GetBlockAckRequestSize(barBlockAcknowledgment->barType),
+                                 barBlockAcknowledgment->blockAckReqTxVector);
+        auto baTxDuration = m_phy->GetTxDuration(GetBlockAckSize(barBlockAcknowledgment->baType),
+                                                 barBlockAcknowledgment->blockAckTxVector);
         barBlockAcknowledgment->acknowledgmentTime =
             2 * m_phy->GetSifs() + barTxDuration + baTxDuration;
     }
@@ -1207,8 +1202,7 @@ HtFrameExchangeManager::SendPsdu()
 {
     NS_LOG_FUNCTION(this);
 
-    Time txDuration =
-        WifiPhy::CalculateTxDuration(m_psdu->GetSize(), m_txParams.m_txVector, m_phy->GetPhyBand());
+    Time txDuration = m_phy->GetTxDuration(m_psdu->GetSize(), m_txParams.m_txVector);
 
     NS_ASSERT(m_txParams.m_acknowledgment);
 
@@ -1435,7 +1429,7 @@ HtFrameExchangeManager::ForwardPsduDown(Ptr<const WifiPsdu> psdu, WifiTxVector&
         txVector.SetAggregation(true);
     }
 
-    const auto txDuration = WifiPhy::CalculateTxDuration(psdu, txVector, m_phy->GetPhyBand());
+    const auto txDuration = m_phy->GetTxDuration(psdu, txVector);
     SetTxNav(*psdu->begin(), txDuration);
 
     const auto& hdr = psdu->GetHeader(0);
@@ -1805,7 +1799,7 @@ HtFrameExchangeManager::SendBlockAck(const RecipientBlockAckAgreement& agreement
     // time, in microseconds between the end of the PPDU carrying the frame that
     // elicited the response and the end of the PPDU carrying the BlockAck frame.
     Time baDurationId = durationId - m_phy->GetSifs() -
-                        WifiPhy::CalculateTxDuration(psdu, blockAckTxVector, m_phy->GetPhyBand());
+                        m_phy->GetTxDuration(psdu, blockAckTxVector);
     // The TXOP holder may exceed the TXOP limit in some situations (Sec. 10.22.2.8 of 802.11-2016)
     if (baDurationId.IsStrictlyNegative())
     {
@@ -2051,8 +2045,7 @@ HtFrameExchangeManager::ReceiveMgtAction(Ptr<const WifiMpdu> mpdu, const WifiTxV
     // compute the time to transmit the Ack
     const auto ackTxVector =
         GetWifiRemoteStationManager()->GetAckTxVector(mpdu->GetHeader().GetAddr2(), txVector);
-    const auto ackTxTime =
-        WifiPhy::CalculateTxDuration(GetAckSize(), ackTxVector, m_phy->GetPhyBand());
+    const auto ackTxTime = m_phy->GetTxDuration(GetAckSize(), ackTxVector);
 
     switch (actionHdr.GetCategory())
     {
@@ -129,12 +129,19 @@ operator<<(std::ostream& os, const Event& event)
  *       short period of time.
  ****************************************************************/
 
-InterferenceHelper::NiChange::NiChange(Watt_u power, Ptr<Event> event)
-    : m_power(power),
+InterferenceHelper::NiChange::NiChange(Time moment, Watt_u power, Ptr<Event> event)
+    : m_time(moment),
+      m_power(power),
       m_event(event)
 {
 }
 
+Time
+InterferenceHelper::NiChange::GetTime() const
+{
+    return m_time;
+}
+
 Watt_u
 InterferenceHelper::NiChange::GetPower() const
 {
@@ -183,10 +190,6 @@ void
 InterferenceHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto it : m_niChanges)
-    {
-        it.second.clear();
-    }
     m_niChanges.clear();
     m_firstPowers.clear();
     m_errorRateModel = nullptr;
@@ -242,7 +245,7 @@ InterferenceHelper::AddBand(const WifiSpectrumBandInfo& band)
     auto result = m_niChanges.insert({band, niChanges});
     NS_ASSERT(result.second);
     // Always have a zero power noise event in the list
-    AddNiChangeEvent(Time(0), NiChange(Watt_u{0}, nullptr), result.first);
+    AddNiChangeEvent(NiChange(Time(0), Watt_u{0}, nullptr), result.first);
     m_firstPowers.insert({band, Watt_u{0}});
 }
 
@@ -254,7 +257,6 @@ InterferenceHelper::RemoveBand(const WifiSpectrumBandInfo& band)
     m_firstPowers.erase(band);
     auto it = m_niChanges.find(band);
     NS_ASSERT(it != std::end(m_niChanges));
-    it->second.clear();
     m_niChanges.erase(it);
 }
 
@@ -327,11 +329,11 @@ InterferenceHelper::GetEnergyDuration(Watt_u energy, const WifiSpectrumBandInfo&
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
     auto i = GetPreviousPosition(now, niIt);
-    Time end = i->first;
+    Time end = i->GetTime();
     for (; i != niIt->second.end(); ++i)
     {
-        const auto noiseInterference = i->second.GetPower();
-        end = i->first;
+        const auto noiseInterference = i->GetPower();
+        end = i->GetTime();
         if (noiseInterference < energy)
         {
             break;
@@ -353,13 +355,15 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
         Watt_u previousPowerStart{0.0};
         Watt_u previousPowerEnd{0.0};
         auto previousPowerPosition = GetPreviousPosition(event->GetStartTime(), niIt);
-        previousPowerStart = previousPowerPosition->second.GetPower();
-        previousPowerEnd = GetPreviousPosition(event->GetEndTime(), niIt)->second.GetPower();
+        previousPowerStart = previousPowerPosition->GetPower();
+        previousPowerEnd = GetPreviousPosition(event->GetEndTime(), niIt)->GetPower();
         if (const auto rxing = (m_rxing.contains(freqRange) && m_rxing.at(freqRange)); !rxing)
         {
             m_firstPowers.find(band)->second = previousPowerStart;
-            // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            // Compact the list by removing the changes that are no longer needed, since
+            // the power they carry is accounted for by the first power of the band.
+            // Always leave the first zero power noise event in the list.
+            niIt->second.erase(std::next(niIt->second.begin()), std::next(previousPowerPosition));
         }
         else if (isStartHePortionRxing)
         {
@@ -368,12 +372,13 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
             // HE TB PPDU transmission and the start of HE TB payload.
             m_firstPowers.find(band)->second = previousPowerStart;
         }
-        auto first =
-            AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
-        auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
+        const auto first =
+            AddNiChangeEvent(NiChange(event->GetStartTime(), previousPowerStart, event), niIt);
+        const auto last =
+            AddNiChangeEvent(NiChange(event->GetEndTime(), previousPowerEnd, event), niIt);
         for (auto i = first; i != last; ++i)
         {
-            i->second.AddPower(power);
+            niIt->second[i].AddPower(power);
         }
     }
 }
@@ -391,7 +396,7 @@ InterferenceHelper::UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBan
         auto last = GetPreviousPosition(event->GetEndTime(), niIt);
         for (auto i = first; i != last; ++i)
         {
-            i->second.AddPower(power);
+            i->AddPower(power);
         }
     }
     event->UpdateRxPowerW(rxPower);
@@ -431,7 +436,7 @@ InterferenceHelper::CalculateSnr(Watt_u signal,
 
 Watt_u
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
+                                                NiChanges& nis,
                                                 const WifiSpectrumBandInfo& band) const
 {
     NS_LOG_FUNCTION(this << band);
@@ -441,39 +446,54 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
     const auto now = Simulator::Now();
-    auto it = niIt->second.lower_bound(event->GetStartTime());
-    const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
-                                 ? CalculateMuMimoPowerW(event, band)
-                                 : Watt_u{0.0};
-    for (; it != niIt->second.end() && it->first < now; ++it)
+    const auto start = GetFirstPosition(event->GetStartTime(), niIt);
+    const auto stop = GetFirstPosition(now, niIt);
+    if (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
     {
-        if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
-            (event != it->second.GetEvent()))
+        const auto muMimoPower = CalculateMuMimoPowerW(event, band);
+        for (auto it = start; it < stop; ++it)
         {
-            // Do not calculate noiseInterferenceW if events belong to the same MU-MIMO transmission
-            // unless this is the same event
-            continue;
+            if (IsSameMuMimoTransmission(event, it->GetEvent()) && (event != it->GetEvent()))
+            {
+                // Do not calculate noiseInterferenceW if events belong to the same MU-MIMO
+                // transmission unless this is the same event
+                continue;
+            }
+            noiseInterference = it->GetPower() - event->GetRxPower(band) - muMimoPower;
+            if (std::abs(noiseInterference) < std::numeric_limits<double>::epsilon())
+            {
+                // fix some possible rounding issues with double values
+                noiseInterference = Watt_u{0.0};
+            }
         }
-        noiseInterference = it->second.GetPower() - event->GetRxPower(band) - muMimoPower;
+    }
+    else if (start < stop)
+    {
+        // The power of the last change before now is the total power at this time
+        noiseInterference = std::prev(stop)->GetPower() - event->GetRxPower(band);
         if (std::abs(noiseInterference) < std::numeric_limits<double>::epsilon())
         {
             // fix some possible rounding issues with double values
             noiseInterference = Watt_u{0.0};
         }
     }
-    it = niIt->second.lower_bound(event->GetStartTime());
+    auto it = start;
     NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    for (; it != niIt->second.end() && it->GetEvent() != event; ++it)
     {
         ;
     }
-    auto& ni = nis[band];
-    ni.emplace(event->GetStartTime(), NiChange(Watt_u{0}, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    NS_ABORT_IF(it == niIt->second.end());
+    auto last = std::next(it);
+    for (; last != niIt->second.end() && last->GetEvent() != event; ++last)
     {
-        ni.insert(*it);
+        ;
     }
-    ni.emplace(event->GetEndTime(), NiChange(Watt_u{0}, event));
+    nis.clear();
+    nis.reserve(std::distance(it, last) + 1);
+    nis.emplace_back(event->GetStartTime(), Watt_u{0}, event);
+    nis.insert(nis.end(), std::next(it), last);
+    nis.emplace_back(event->GetEndTime(), Watt_u{0}, event);
     NS_ASSERT_MSG(noiseInterference >= Watt_u{0.0},
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
@@ -488,18 +508,18 @@ InterferenceHelper::CalculateMuMimoPowerW(Ptr<const Event> event,
     auto it = niIt->second.begin();
     ++it;
     Watt_u muMimoPower{0.0};
-    for (; it != niIt->second.end() && it->first < Simulator::Now(); ++it)
+    for (; it != niIt->second.end() && it->GetTime() < Simulator::Now(); ++it)
     {
-        if (IsSameMuMimoTransmission(event, it->second.GetEvent()))
+        if (IsSameMuMimoTransmission(event, it->GetEvent()))
         {
-            auto hePpdu = DynamicCast<HePpdu>(it->second.GetEvent()->GetPpdu()->Copy());
+            auto hePpdu = DynamicCast<HePpdu>(it->GetEvent()->GetPpdu()->Copy());
             NS_ASSERT(hePpdu);
             HePpdu::TxPsdFlag psdFlag = hePpdu->GetTxPsdFlag();
             if (psdFlag == HePpdu::PSD_HE_PORTION)
             {
                 const auto staId =
                     event->GetPpdu()->GetTxVector().GetHeMuUserInfoMap().cbegin()->first;
-                const auto otherStaId = it->second.GetEvent()
+                const auto otherStaId = it->GetEvent()
                                             ->GetPpdu()
                                             ->GetTxVector()
                                             .GetHeMuUserInfoMap()
@@ -509,7 +529,7 @@ InterferenceHelper::CalculateMuMimoPowerW(Ptr<const Event> event,
                 {
                     break;
                 }
-                muMimoPower += it->second.GetEvent()->GetRxPower(band);
+                muMimoPower += it->GetEvent()->GetRxPower(band);
             }
         }
     }
@@ -562,24 +582,23 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         MHz_u channelWidth,
-                                        NiChangesPerBand* nis,
+                                        const NiChanges& nis,
                                         const WifiSpectrumBandInfo& band,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
     double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
-    auto previous = j->first;
+    auto j = nis.cbegin();
+    auto previous = j->GetTime();
     Watt_u muMimoPower{0.0};
     const auto payloadMode = event->GetPpdu()->GetTxVector().GetMode(staId);
-    auto phyPayloadStart = j->first;
+    auto phyPayloadStart = j->GetTime();
     if (event->GetPpdu()->GetType() != WIFI_PPDU_TYPE_UL_MU &&
         event->GetPpdu()->GetType() !=
-            WIFI_PPDU_TYPE_DL_MU) // j->first corresponds to the start of the MU payload
+            WIFI_PPDU_TYPE_DL_MU) // j->GetTime() corresponds to the start of the MU payload
     {
-        phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration(
+        phyPayloadStart = j->GetTime() + WifiPhy::CalculatePhyPreambleAndHeaderDuration(
                                          event->GetPpdu()->GetTxVector());
     }
     else
@@ -591,9 +610,9 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     auto power = event->GetRxPower(band);
-    while (++j != niIt.cend())
+    while (++j != nis.cend())
     {
-        Time current = j->first;
+        Time current = j->GetTime();
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
         const auto snr = CalculateSnr(power,
@@ -621,14 +640,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                 "previous is before windowed payload and current is in the windowed payload: mode="
                 << payloadMode << ", psr=" << psr);
         }
-        noiseInterference = j->second.GetPower() - power;
-        if (IsSameMuMimoTransmission(event, j->second.GetEvent()))
+        noiseInterference = j->GetPower() - power;
+        if (IsSameMuMimoTransmission(event, j->GetEvent()))
         {
-            muMimoPower += j->second.GetEvent()->GetRxPower(band);
+            muMimoPower += j->GetEvent()->GetRxPower(band);
             NS_LOG_DEBUG("PPDU belongs to same MU-MIMO transmission: muMimoPowerW=" << muMimoPower);
         }
         noiseInterference -= muMimoPower;
-        previous = j->first;
+        previous = j->GetTime();
         if (previous > windowEnd)
         {
             NS_LOG_DEBUG("Stop: new previous=" << previous
@@ -642,15 +661,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                                 NiChangesPerBand* nis,
+                                                 const NiChanges& nis,
                                                  MHz_u channelWidth,
                                                  const WifiSpectrumBandInfo& band,
                                                  PhyHeaderSections phyHeaderSections) const
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    auto j = nis.cbegin();
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection;
@@ -659,13 +677,13 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
         stopLastSection = Max(stopLastSection, section.second.first.second);
     }
 
-    auto previous = j->first;
+    auto previous = j->GetTime();
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     const auto power = event->GetRxPower(band);
-    while (++j != niIt.end())
+    while (++j != nis.cend())
     {
-        auto current = j->first;
+        auto current = j->GetTime();
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
         const auto snr = CalculateSnr(power, noiseInterference, channelWidth, 1);
@@ -691,8 +709,8 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
                 }
             }
         }
-        noiseInterference = j->second.GetPower() - power;
-        previous = j->first;
+        noiseInterference = j->GetPower() - power;
+        previous = j->GetTime();
         if (previous > stopLastSection)
         {
             NS_LOG_DEBUG("Stop: new previous=" << previous << " after stop of last section="
@@ -705,19 +723,18 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
 
 double
 InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+                                          const NiChanges& nis,
                                           MHz_u channelWidth,
                                           const WifiSpectrumBandInfo& band,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
     PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), nis.cbegin()->GetTime()))
     {
         if (section.first == header)
         {
@@ -742,7 +759,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
+    NiChanges ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPower(band),
                                   noiseInterference,
@@ -753,7 +770,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
      * all SNIR changes in the SNIR vector.
      */
     const auto per =
-        CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+        CalculatePayloadPer(event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
     return SnrPer{snr, per};
 }
@@ -764,7 +781,7 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
+    NiChanges ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     return CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, nss);
 }
@@ -776,14 +793,14 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    NiChangesPerBand ni;
+    NiChanges ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPower(band), noiseInterference, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    const auto per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    const auto per = CalculatePhyHeaderPer(event, ni, channelWidth, band, header);
 
     return SnrPer{snr, per};
 }
@@ -791,7 +808,19 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt) const
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](Time t, const NiChange& change) { return t < change.GetTime(); });
+}
+
+InterferenceHelper::NiChanges::const_iterator
+InterferenceHelper::GetFirstPosition(Time moment, NiChangesPerBand::const_iterator niIt) const
+{
+    return std::lower_bound(niIt->second.cbegin(),
+                            niIt->second.cend(),
+                            moment,
+                            [](const NiChange& change, Time t) { return change.GetTime() < t; });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -801,10 +830,11 @@ InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator
     return std::prev(GetNextPosition(moment, niIt));
 }
 
-InterferenceHelper::NiChanges::iterator
-InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
+std::size_t
+InterferenceHelper::AddNiChangeEvent(NiChange change, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.insert(GetNextPosition(moment, niIt), {moment, change});
+    auto it = niIt->second.insert(GetNextPosition(change.GetTime(), niIt), std::move(change));
+    return std::distance(niIt->second.begin(), it);
 }
 
 void
@@ -828,7 +858,7 @@ InterferenceHelper::NotifyRxEnd(Time endTime, const FrequencyRange& freqRange)
         }
         NS_ASSERT(niIt->second.size() > 1);
         auto it = std::prev(GetPreviousPosition(endTime, niIt));
-        m_firstPowers.find(niIt->first)->second = it->second.GetPower();
+        m_firstPowers.find(niIt->first)->second = it->GetPower();
     }
 }
 
@@ -16,6 +16,7 @@
 #include "ns3/object.h"
 
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -365,11 +366,18 @@ class InterferenceHelper : public Object
         /**
          * Create a NiChange at the given time and the amount of NI change.
          *
+         * @param moment the time of the change
          * @param power the power
          * @param event causes this NI change
          */
-        NiChange(Watt_u power, Ptr<Event> event);
+        NiChange(Time moment, Watt_u power, Ptr<Event> event);
 
+        /**
+         * Return the time of the change
+         *
+         * @return the time of the change
+         */
+        Time GetTime() const;
         /**
          * Return the power
          *
@@ -390,14 +398,18 @@ class InterferenceHelper : public Object
         Ptr<Event> GetEvent() const;
 
       private:
+        Time m_time;        ///< time of the change
         Watt_u m_power;     ///< power
         Ptr<Event> m_event; ///< event
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * typedef for a contiguous array of NiChange sorted by time. Changes with the same time
+     * are kept in insertion order. The power of each change is the running sum of the power
+     * of all the events started and not yet ended at the time of the change, hence the total
+     * power at any time is found by a binary search.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<NiChange>;
 
     /**
      * Map of NiChanges per band
@@ -444,13 +456,13 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power.
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param nis the NiChanges from the start to the end of the event, filled by this function
      * @param band the band
      *
      * @return noise and interference power
      */
     Watt_u CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
+                                       NiChanges& nis,
                                        const WifiSpectrumBandInfo& band) const;
 
     /**
@@ -472,7 +484,7 @@ class InterferenceHelper : public Object
      *
      * @param event the event
      * @param channelWidth the channel width used to transmit the PSDU
-     * @param nis the NiChanges
+     * @param nis the NiChanges from the start to the end of the event
      * @param band identify the band used by the PSDU
      * @param staId the station ID of the PSDU (only used for MU)
      * @param window time window (pair of start and end times) of PHY payload to focus on
@@ -481,7 +493,7 @@ class InterferenceHelper : public Object
      */
     double CalculatePayloadPer(Ptr<const Event> event,
                                MHz_u channelWidth,
-                               NiChangesPerBand* nis,
+                               const NiChanges& nis,
                                const WifiSpectrumBandInfo& band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
@@ -490,7 +502,7 @@ class InterferenceHelper : public Object
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param nis the NiChanges from the start to the end of the event
      * @param channelWidth the channel width for header measurement
      * @param band the band
      * @param header the PHY header to consider
@@ -498,7 +510,7 @@ class InterferenceHelper : public Object
      * @return the error rate of the HT PHY header
      */
     double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+                                 const NiChanges& nis,
                                  MHz_u channelWidth,
                                  const WifiSpectrumBandInfo& band,
                                  WifiPpduField header) const;
@@ -506,7 +518,7 @@ class InterferenceHelper : public Object
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * @param event the event
-     * @param nis the NiChanges
+     * @param nis the NiChanges from the start to the end of the event
      * @param channelWidth the channel width for header measurement
      * @param band the band
      * @param phyHeaderSections the map of PHY header sections (\see PhyHeaderSections)
@@ -514,7 +526,7 @@ class InterferenceHelper : public Object
      * @return the success rate of the PHY header sections
      */
     double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+                                        const NiChanges& nis,
                                         MHz_u channelWidth,
                                         const WifiSpectrumBandInfo& band,
                                         PhyHeaderSections phyHeaderSections) const;
@@ -540,19 +552,26 @@ class InterferenceHelper : public Object
      * @returns an iterator to the list of NiChanges
      */
     NiChanges::iterator GetPreviousPosition(Time moment, NiChangesPerBand::iterator niIt) const;
-
     /**
-     * Add NiChange to the list at the appropriate position and
-     * return the iterator of the new event.
+     * Returns an iterator to the first NiChange that is not earlier than moment
      *
      * @param moment time to check from
+     * @param niIt iterator of the band to check
+     * @returns an iterator to the list of NiChanges
+     */
+    NiChanges::const_iterator GetFirstPosition(Time moment,
+                                               NiChangesPerBand::const_iterator niIt) const;
+
+    /**
+     * Add NiChange to the list at the appropriate position, i.e., after all the
+     * NiChanges at the same time, and return the index of the new event. Unlike an
+     * iterator, the index of a NiChange remains valid when a later NiChange is added.
+     *
      * @param change the NiChange to add
      * @param niIt iterator of the band to check
-     * @returns the iterator of the new event
+     * @returns the index of the new event in the list
      */
-    NiChanges::iterator AddNiChangeEvent(Time moment,
-                                         NiChange change,
-                                         NiChangesPerBand::iterator niIt);
+    std::size_t AddNiChangeEvent(NiChange change, NiChangesPerBand::iterator niIt);
 
     /**
      * Return whether another event is a MU-MIMO event that belongs to the same transmission and to
@@ -10,17 +10,24 @@
 #include "nist-error-rate-model.h"
 
 #include "wifi-tx-vector.h"
+#include "wifi-utils.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include <bitset>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("NistErrorRateModel");
 
+static const dB_u SNR_CACHE_MIN{-10};                   //!< lowest SNR of the cached tables
+static const dB_u SNR_CACHE_MAX{50};                    //!< highest SNR of the cached tables
+static const std::size_t SNR_CACHE_MAX_BINS = 1 << 16; //!< maximum number of bins of a table
+
 NS_OBJECT_ENSURE_REGISTERED(NistErrorRateModel);
 
 TypeId
@@ -29,11 +36,20 @@ NistErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::NistErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+                            .AddConstructor<NistErrorRateModel>()
+                            .AddAttribute("SnrCacheResolution",
+                                          "The resolution (in dB) to which the SNR of a chunk is "
+                                          "quantized to look up the coded bit error probability "
+                                          "in tables built lazily per WifiMode, or 0 to compute "
+                                          "the success rate from the exact SNR.",
+                                          DoubleValue(0),
+                                          MakeDoubleAccessor(&NistErrorRateModel::m_snrResolution),
+                                          MakeDoubleChecker<dB_u>(0));
     return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel()
+    : m_snrResolution(0)
 {
 }
 
@@ -200,6 +216,10 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
                                           uint16_t staId) const
 {
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
+    if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM && m_snrResolution > 0)
+    {
+        return std::pow(1 - GetCachedPe(mode, snr), nbits);
+    }
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
         if (mode.GetConstellationSize() == 2)
@@ -221,4 +241,46 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     return 0;
 }
 
+double
+NistErrorRateModel::GetCachedPe(WifiMode mode, double snr) const
+{
+    const auto binN =
+        std::min(SNR_CACHE_MAX_BINS,
+                 static_cast<std::size_t>((SNR_CACHE_MAX - SNR_CACHE_MIN) / m_snrResolution) + 1);
+    const auto bin = std::round((RatioToDb(snr) - SNR_CACHE_MIN) / m_snrResolution);
+    const auto bValue = GetBValue(mode.GetCodeRate());
+    auto calculatePe = [&](double quantizedSnr) {
+        double ber;
+        if (mode.GetConstellationSize() == 2)
+        {
+            ber = GetBpskBer(quantizedSnr);
+        }
+        else if (mode.GetConstellationSize() == 4)
+        {
+            ber = GetQpskBer(quantizedSnr);
+        }
+        else
+        {
+            ber = GetQamBer(mode.GetConstellationSize(), quantizedSnr);
+        }
+        return (ber == 0.0) ? 0.0 : std::min(CalculatePe(ber, bValue), 1.0);
+    };
+    if (!(bin >= 0 && bin < binN))
+    {
+        // out of the range of the tables (or not a number)
+        return calculatePe(snr);
+    }
+    auto& table = m_peTables[mode.GetUid()];
+    if (table.empty())
+    {
+        table.resize(binN, std::numeric_limits<double>::quiet_NaN());
+    }
+    auto& pe = table[static_cast<std::size_t>(bin)];
+    if (std::isnan(pe))
+    {
+        pe = calculatePe(DbToRatio(SNR_CACHE_MIN + bin * m_snrResolution));
+    }
+    return pe;
+}
+
 } // namespace ns3
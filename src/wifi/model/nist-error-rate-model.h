@@ -12,6 +12,9 @@
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
+#include <map>
+#include <vector>
+
 namespace ns3
 {
 
@@ -22,6 +25,12 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * When the SnrCacheResolution attribute is strictly positive, the SNR of a
+ * chunk is quantized to this resolution (in dB) and the coded bit error
+ * probability is looked up in a table built lazily for each WifiMode, hence
+ * the success rates are approximated. By default, they are computed from the
+ * exact SNR.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -117,6 +126,20 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+    /**
+     * Return the coded bit error probability of the given mode at the given SNR,
+     * quantized to the SNR cache resolution and looked up in the table of the mode.
+     *
+     * @param mode the Wi-Fi mode
+     * @param snr SNR ratio (in linear scale)
+     *
+     * @return the coded bit error probability, capped to 1
+     */
+    double GetCachedPe(WifiMode mode, double snr) const;
+
+    dB_u m_snrResolution; //!< resolution of the SNR bins of the tables, 0 to disable them
+    mutable std::map<uint32_t, std::vector<double>>
+        m_peTables; //!< coded bit error probability per SNR bin, indexed by mode UID
 };
 
 } // namespace ns3
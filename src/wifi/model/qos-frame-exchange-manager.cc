@@ -103,8 +103,7 @@ QosFrameExchangeManager::SendCfEndIfNeeded()
         GetWifiRemoteStationManager()->GetRtsTxVector(cfEnd.GetAddr1(), m_allowedWidth);
 
     auto mpdu = Create<WifiMpdu>(Create<Packet>(), cfEnd);
-    auto txDuration =
-        WifiPhy::CalculateTxDuration(mpdu->GetSize(), cfEndTxVector, m_phy->GetPhyBand());
+    auto txDuration = m_phy->GetTxDuration(mpdu->GetSize(), cfEndTxVector);
 
     // Send the CF-End frame if the remaining TXNAV is long enough to transmit this frame
     if (m_txNav > Simulator::Now() + txDuration)
@@ -508,7 +507,7 @@ QosFrameExchangeManager::GetFrameDurationId(const WifiMacHeader& header,
     // of 802.11-2016)
     auto duration =
         std::max(m_edca->GetRemainingTxop(m_linkId) -
-                     WifiPhy::CalculateTxDuration(size, txParams.m_txVector, m_phy->GetPhyBand()),
+                     m_phy->GetTxDuration(size, txParams.m_txVector),
                  *txParams.m_acknowledgment->acknowledgmentTime);
 
     // use single protection to transmit Association Request/Response or Probe Request/Response
@@ -548,7 +547,7 @@ QosFrameExchangeManager::GetRtsDurationId(const WifiTxVector& rtsTxVector,
     // of 802.11-2016)
     auto duration =
         std::max(m_edca->GetRemainingTxop(m_linkId) -
-                     WifiPhy::CalculateTxDuration(GetRtsSize(), rtsTxVector, m_phy->GetPhyBand()),
+                     m_phy->GetTxDuration(GetRtsSize(), rtsTxVector),
                  Seconds(0));
 
     if (m_protectSingleExchange)
@@ -586,7 +585,7 @@ QosFrameExchangeManager::GetCtsToSelfDurationId(const WifiTxVector& ctsTxVector,
     // of 802.11-2016)
     auto duration =
         std::max(m_edca->GetRemainingTxop(m_linkId) -
-                     WifiPhy::CalculateTxDuration(GetCtsSize(), ctsTxVector, m_phy->GetPhyBand()),
+                     m_phy->GetTxDuration(GetCtsSize(), ctsTxVector),
                  Seconds(0));
 
     if (m_protectSingleExchange)
@@ -13,6 +13,7 @@
 #include "wifi-utils.h"
 #include "yans-error-rate-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
@@ -21,6 +22,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -50,11 +52,19 @@ TableBasedErrorRateModel::GetTypeId()
                           "Threshold in bytes over which the table for large size frames is used",
                           UintegerValue(400),
                           MakeUintegerAccessor(&TableBasedErrorRateModel::m_threshold),
-                          MakeUintegerChecker<uint64_t>());
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("EnablePerCache",
+                          "Whether the PER interpolated from a table for a given MCS and SNR "
+                          "(rounded to the precision of the tables) is cached, so that it is "
+                          "computed only once.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&TableBasedErrorRateModel::m_perCacheEnabled),
+                          MakeBooleanChecker());
     return tid;
 }
 
 TableBasedErrorRateModel::TableBasedErrorRateModel()
+    : m_perCacheEnabled(true)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -175,69 +185,104 @@ TableBasedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
             ->GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
     }
 
-    auto errorTable = (ldpc ? AwgnErrorTableLdpc1458
-                            : (size < m_threshold ? AwgnErrorTableBcc32 : AwgnErrorTableBcc1458));
-    const auto& itVector = errorTable[mcs];
-    auto itTable =
-        std::find_if(itVector.cbegin(), itVector.cend(), [&roundedSnr](const auto& element) {
-            return element.first == roundedSnr;
-        });
+    const auto kind = (ldpc ? LDPC_1458 : (size < m_threshold ? BCC_32 : BCC_1458));
+    auto per = GetTablePer(kind, mcs, roundedSnr);
+
+    uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE
+                               : (size < m_threshold ? ERROR_TABLE_BCC_SMALL_FRAME_SIZE
+                                                     : ERROR_TABLE_BCC_LARGE_FRAME_SIZE));
+    if (size != tableSize)
+    {
+        // From IEEE document 11-14/0803r1 (Packet Length for Box 0 Calibration)
+        per = (1.0 - std::pow((1 - per), (static_cast<double>(size) / tableSize)));
+    }
+
+    if (per < TABLE_BASED_ERROR_MODEL_PRECISION)
+    {
+        per = 0.0;
+    }
+
+    return 1.0 - per;
+}
+
+double
+TableBasedErrorRateModel::GetTablePer(TableKind kind, uint8_t mcs, dB_u roundedSnr) const
+{
+    const auto& itVector = (kind == LDPC_1458 ? AwgnErrorTableLdpc1458
+                                              : (kind == BCC_32 ? AwgnErrorTableBcc32
+                                                                : AwgnErrorTableBcc1458))[mcs];
     const auto minSnr = itVector.cbegin()->first;
     const auto maxSnr = (--itVector.cend())->first;
-    double per;
-    if (itTable == itVector.cend())
+    if (roundedSnr < minSnr)
     {
-        if (roundedSnr < minSnr)
+        return 1.0;
+    }
+    if (roundedSnr > maxSnr)
+    {
+        return 0.0;
+    }
+
+    // the rounded SNRs between the first and the last entries of the table are all a
+    // multiple of the precision of the tables away from the first entry
+    double* cachedPer = nullptr;
+    if (m_perCacheEnabled)
+    {
+        auto& mcsCache = m_perCache[kind];
+        if (mcsCache.size() <= mcs)
+        {
+            mcsCache.resize(mcs + 1);
+        }
+        auto& snrCache = mcsCache[mcs];
+        if (snrCache.empty())
         {
-            per = 1.0;
+            snrCache.resize(std::llround((maxSnr - minSnr) * std::pow(10.0, SNR_PRECISION)) + 1,
+                            std::numeric_limits<double>::quiet_NaN());
         }
-        else if (roundedSnr > maxSnr)
+        const auto index = std::llround((roundedSnr - minSnr) * std::pow(10.0, SNR_PRECISION));
+        cachedPer = &snrCache[std::min<std::size_t>(index, snrCache.size() - 1)];
+        if (!std::isnan(*cachedPer))
         {
-            per = 0.0;
+            return *cachedPer;
         }
-        else
+    }
+
+    auto itTable =
+        std::find_if(itVector.cbegin(), itVector.cend(), [&roundedSnr](const auto& element) {
+            return element.first == roundedSnr;
+        });
+    double per;
+    if (itTable == itVector.cend())
+    {
+        double a = 0.0;
+        double b = 0.0;
+        dB_u previousSnr{0.0};
+        dB_u nextSnr{0.0};
+        for (auto i = itVector.cbegin(); i != itVector.cend(); ++i)
         {
-            double a = 0.0;
-            double b = 0.0;
-            dB_u previousSnr{0.0};
-            dB_u nextSnr{0.0};
-            for (auto i = itVector.cbegin(); i != itVector.cend(); ++i)
+            if (i->first < roundedSnr)
+            {
+                previousSnr = i->first;
+                a = i->second;
+            }
+            else
             {
-                if (i->first < roundedSnr)
-                {
-                    previousSnr = i->first;
-                    a = i->second;
-                }
-                else
-                {
-                    nextSnr = i->first;
-                    b = i->second;
-                    break;
-                }
+                nextSnr = i->first;
+                b = i->second;
+                break;
             }
-            per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
         }
+        per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
     }
     else
     {
         per = itTable->second;
     }
 
-    uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE
-                               : (size < m_threshold ? ERROR_TABLE_BCC_SMALL_FRAME_SIZE
-                                                     : ERROR_TABLE_BCC_LARGE_FRAME_SIZE));
-    if (size != tableSize)
-    {
-        // From IEEE document 11-14/0803r1 (Packet Length for Box 0 Calibration)
-        per = (1.0 - std::pow((1 - per), (static_cast<double>(size) / tableSize)));
-    }
-
-    if (per < TABLE_BASED_ERROR_MODEL_PRECISION)
+    if (cachedPer)
     {
-        per = 0.0;
+        *cachedPer = per;
     }
-
-    return 1.0 - per;
+    return per;
 }
 
 } // namespace ns3
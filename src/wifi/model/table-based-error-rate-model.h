@@ -15,7 +15,9 @@
 
 #include "ns3/error-rate-tables.h"
 
+#include <array>
 #include <optional>
+#include <vector>
 
 namespace ns3
 {
@@ -74,10 +76,34 @@ class TableBasedErrorRateModel : public ErrorRateModel
      */
     double FetchFsr(WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits) const;
 
+    /// The reference tables
+    enum TableKind : uint8_t
+    {
+        LDPC_1458 = 0,   //!< LDPC, 1458 bytes frames
+        BCC_32,          //!< BCC, 32 bytes frames
+        BCC_1458,        //!< BCC, 1458 bytes frames
+        TABLE_KIND_COUNT //!< number of reference tables
+    };
+
+    /**
+     * Get the PER for a given MCS and rounded SNR from a reference table, interpolating
+     * between its entries, and store it in the PER cache if enabled.
+     *
+     * @param kind the reference table
+     * @param mcs the MCS
+     * @param roundedSnr the SNR rounded to the precision of the tables
+     * @return the PER for the reference frame size of the table
+     */
+    double GetTablePer(TableKind kind, uint8_t mcs, dB_u roundedSnr) const;
+
     Ptr<ErrorRateModel>
         m_fallbackErrorModel; //!< Error rate model to fallback to if no value is found in the table
 
     uint64_t m_threshold; //!< Threshold in bytes over which the table for large size frames is used
+
+    bool m_perCacheEnabled; //!< Whether the PERs interpolated from the tables are cached
+    mutable std::array<std::vector<std::vector<double>>, TABLE_KIND_COUNT>
+        m_perCache; //!< PER per table, MCS and rounded SNR step from the first table entry
 };
 
 } // namespace ns3
@@ -292,6 +292,12 @@ WifiPhy::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&WifiPhy::m_notifyRxMacHeaderEnd),
                           MakeBooleanChecker())
+            .AddAttribute("TxDurationCacheSize",
+                          "The maximum number of TX durations of non-MU PPDUs memoized by this "
+                          "PHY, or 0 to compute every TX duration. The cache is emptied when full.",
+                          UintegerValue(256),
+                          MakeUintegerAccessor(&WifiPhy::m_txDurationCacheSize),
+                          MakeUintegerChecker<uint32_t>())
             .AddTraceSource(
                 "PhyTxBegin",
                 "Trace source indicating a packet has begun transmitting over the medium; "
@@ -468,6 +474,7 @@ WifiPhy::DoDispose()
         phyEntity.second = nullptr;
     }
     m_phyEntities.clear();
+    m_txDurationCache.clear();
 }
 
 std::map<WifiModulationClass, std::shared_ptr<PhyEntity>>&
@@ -1601,6 +1608,82 @@ WifiPhy::CalculateTxDuration(const WifiConstPsduMap& psduMap,
         ->CalculateTxDuration(psduMap, txVector, band);
 }
 
+std::size_t
+WifiPhy::TxDurationKeyHash::operator()(const TxDurationKey& key) const
+{
+    std::size_t hash = std::hash<uint32_t>{}(key.size);
+    auto combine = [&hash](std::size_t value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<uint32_t>{}(key.modeUid));
+    combine(std::hash<double>{}(key.channelWidth));
+    combine(std::hash<int64_t>{}(key.guardInterval.GetTimeStep()));
+    combine((key.staId << 16) | (key.band << 8) | key.preamble);
+    combine((key.nTx << 16) | (key.nss << 8) | key.ness);
+    combine((key.length << 16) | (key.ehtPpduType << 8) | (key.aggregation << 3) |
+            (key.stbc << 2) | (key.ldpc << 1) | key.triggerResponding);
+    return hash;
+}
+
+Time
+WifiPhy::GetTxDuration(uint32_t size, const WifiTxVector& txVector, uint16_t staId) const
+{
+    if (m_txDurationCacheSize == 0 || txVector.IsMu())
+    {
+        return CalculateTxDuration(size, txVector, m_band, staId);
+    }
+    TxDurationKey key{size,
+                      staId,
+                      m_band,
+                      txVector.GetMode().GetUid(),
+                      txVector.GetPreambleType(),
+                      txVector.GetChannelWidth(),
+                      txVector.GetGuardInterval(),
+                      txVector.GetNTx(),
+                      txVector.GetNss(),
+                      txVector.GetNess(),
+                      txVector.IsAggregation(),
+                      txVector.IsStbc(),
+                      txVector.IsLdpc(),
+                      txVector.GetLength(),
+                      txVector.IsTriggerResponding(),
+                      txVector.GetEhtPpduType(),
+                      txVector.GetInactiveSubchannels()};
+    if (auto it = m_txDurationCache.find(key); it != m_txDurationCache.end())
+    {
+        return it->second;
+    }
+    const auto duration = CalculateTxDuration(size, txVector, m_band, staId);
+    if (m_txDurationCache.size() >= m_txDurationCacheSize)
+    {
+        m_txDurationCache.clear();
+    }
+    m_txDurationCache.emplace(std::move(key), duration);
+    return duration;
+}
+
+Time
+WifiPhy::GetTxDuration(Ptr<const WifiPsdu> psdu, const WifiTxVector& txVector) const
+{
+    if (txVector.IsMu())
+    {
+        return CalculateTxDuration(psdu, txVector, m_band);
+    }
+    return GetTxDuration(GetWifiConstPsduMap(psdu, txVector), txVector);
+}
+
+Time
+WifiPhy::GetTxDuration(const WifiConstPsduMap& psduMap, const WifiTxVector& txVector) const
+{
+    if (txVector.IsMu() || psduMap.size() != 1)
+    {
+        return CalculateTxDuration(psduMap, txVector, m_band);
+    }
+    NS_ASSERT(txVector.IsValid(m_band));
+    const auto& [staId, psdu] = *psduMap.cbegin();
+    return GetTxDuration(psdu->GetSize(), txVector, staId);
+}
+
 uint32_t
 WifiPhy::GetMaxPsduSize(WifiModulationClass modulation)
 {
@@ -1876,7 +1959,7 @@ WifiPhy::Send(const WifiConstPsduMap& psdus, const WifiTxVector& txVector)
         return;
     }
 
-    const auto txDuration = CalculateTxDuration(psdus, txVector, GetPhyBand());
+    const auto txDuration = GetTxDuration(psdus, txVector);
 
     if (const auto timeToPreambleDetectionEnd = GetTimeToPreambleDetectionEnd();
         timeToPreambleDetectionEnd && !m_currentEvent)
@@ -28,6 +28,7 @@
 #include "ns3/wifi-export.h"
 
 #include <limits>
+#include <unordered_map>
 
 #define WIFI_PHY_NS_LOG_APPEND_CONTEXT(phy)                                                        \
     {                                                                                              \
@@ -290,6 +291,42 @@ class WIFI_EXPORT WifiPhy : public Object
                                     const WifiTxVector& txVector,
                                     WifiPhyBand band);
 
+    /**
+     * Return the TX duration in the current band of this PHY, as CalculateTxDuration() does.
+     * The durations of the non-MU PPDUs are memoized in a cache of this PHY, bounded by the
+     * TxDurationCacheSize attribute, whose entries are keyed by the PSDU size and the
+     * parameters of the TXVECTOR that determine the duration.
+     *
+     * @param size the number of bytes in the packet to send
+     * @param txVector the TXVECTOR used for the transmission of this packet
+     * @param staId the STA-ID of the recipient (only used for MU)
+     *
+     * @return the total amount of time this PHY will stay busy for the transmission of these bytes.
+     */
+    Time GetTxDuration(uint32_t size,
+                       const WifiTxVector& txVector,
+                       uint16_t staId = SU_STA_ID) const;
+    /**
+     * Return the TX duration in the current band of this PHY, as CalculateTxDuration() does,
+     * using the cache of this PHY for non-MU PPDUs.
+     *
+     * @param psdu the PSDU to transmit
+     * @param txVector the TXVECTOR used for the transmission of the PSDU
+     *
+     * @return the total amount of time this PHY will stay busy for the transmission of the PPDU
+     */
+    Time GetTxDuration(Ptr<const WifiPsdu> psdu, const WifiTxVector& txVector) const;
+    /**
+     * Return the TX duration in the current band of this PHY, as CalculateTxDuration() does,
+     * using the cache of this PHY for non-MU PPDUs.
+     *
+     * @param psduMap the PSDU(s) to transmit indexed by STA-ID
+     * @param txVector the TXVECTOR used for the transmission of the PPDU
+     *
+     * @return the total amount of time this PHY will stay busy for the transmission of the PPDU
+     */
+    Time GetTxDuration(const WifiConstPsduMap& psduMap, const WifiTxVector& txVector) const;
+
     /**
      * @param txVector the transmission parameters used for this packet
      *
@@ -1700,6 +1737,48 @@ class WIFI_EXPORT WifiPhy : public Object
     Time m_timeLastPreambleDetected; //!< Record the time the last preamble was detected
     bool m_notifyRxMacHeaderEnd;     //!< whether the PHY is capable of notifying MAC header RX end
 
+    /// The PSDU size, band and TXVECTOR parameters determining the duration of a non-MU PPDU
+    struct TxDurationKey
+    {
+        uint32_t size;                         //!< PSDU size
+        uint16_t staId;                        //!< STA-ID of the recipient
+        WifiPhyBand band;                      //!< band
+        uint32_t modeUid;                      //!< UID of the mode
+        WifiPreamble preamble;                 //!< preamble
+        MHz_u channelWidth;                    //!< channel width
+        Time guardInterval;                    //!< guard interval
+        uint8_t nTx;                           //!< number of TX antennas
+        uint8_t nss;                           //!< number of spatial streams
+        uint8_t ness;                          //!< number of extension spatial streams
+        bool aggregation;                      //!< whether the PSDU is an A-MPDU
+        bool stbc;                             //!< whether STBC is used
+        bool ldpc;                             //!< whether LDPC is used
+        uint16_t length;                       //!< LENGTH field of the L-SIG
+        bool triggerResponding;                //!< the TRIGGER_RESPONDING parameter
+        uint8_t ehtPpduType;                   //!< EHT_PPDU_TYPE
+        std::vector<bool> inactiveSubchannels; //!< bitmap of inactive subchannels
+
+        /**
+         * @param other another key
+         * @return true if both keys are equal
+         */
+        bool operator==(const TxDurationKey& other) const = default;
+    };
+
+    /// Hash function of a TxDurationKey
+    struct TxDurationKeyHash
+    {
+        /**
+         * @param key the key
+         * @return the hash of the key
+         */
+        std::size_t operator()(const TxDurationKey& key) const;
+    };
+
+    uint32_t m_txDurationCacheSize; //!< maximum number of TX durations in the cache
+    mutable std::unordered_map<TxDurationKey, Time, TxDurationKeyHash>
+        m_txDurationCache; //!< cache of the TX durations of the non-MU PPDUs
+
     Callback<void> m_capabilitiesChangedCallback; //!< Callback when PHY capabilities changed
 };
 
@@ -22,6 +22,7 @@
 #include <cmath>
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <sstream>
@@ -79,6 +80,116 @@ operator<(const WifiSpectrumModelId& lhs, const WifiSpectrumModelId& rhs)
 static std::map<WifiSpectrumModelId, Ptr<SpectrumModel>>
     g_wifiSpectrumModelMap; ///< static initializer for the class
 
+/// Kind of Wifi transmit PSD
+enum class WifiTxPsdKind : uint8_t
+{
+    OFDM = 0,         ///< CreateOfdmTxPowerSpectralDensity
+    DUPLICATED_20MHZ, ///< CreateDuplicated20MhzTxPowerSpectralDensity
+    HT_OFDM,          ///< CreateHtOfdmTxPowerSpectralDensity
+    HE_OFDM,          ///< CreateHeOfdmTxPowerSpectralDensity
+    HE_MU_OFDM        ///< CreateHeMuOfdmTxPowerSpectralDensity
+};
+
+///< Wifi transmit PSD structure
+struct WifiTxPsdId
+{
+    WifiTxPsdKind kind;                      ///< kind of PSD
+    std::vector<MHz_u> centerFrequencies;    ///< center frequency per segment
+    MHz_u channelWidth;                      ///< channel width
+    Watt_u txPower;                          ///< transmit power
+    MHz_u guardBandwidth;                    ///< guard band width
+    dBr_u minInnerBand;                      ///< minimum relative power in the inner band
+    dBr_u minOuterBand;                      ///< minimum relative power in the outer band
+    dBr_u lowestPoint;                       ///< maximum relative power in the outermost band
+    std::vector<bool> puncturedSubchannels;  ///< punctured 20 MHz subchannels
+    std::vector<WifiSpectrumBandIndices> ru; ///< RU bands used by the STA
+};
+
+/**
+ * Less than operator
+ * @param lhs the left hand side wifi transmit PSD to compare
+ * @param rhs the right hand side wifi transmit PSD to compare
+ * @returns true if the left hand side PSD is less than the right hand side PSD
+ */
+bool
+operator<(const WifiTxPsdId& lhs, const WifiTxPsdId& rhs)
+{
+    return std::tie(lhs.kind,
+                    lhs.centerFrequencies,
+                    lhs.channelWidth,
+                    lhs.txPower,
+                    lhs.guardBandwidth,
+                    lhs.minInnerBand,
+                    lhs.minOuterBand,
+                    lhs.lowestPoint,
+                    lhs.puncturedSubchannels,
+                    lhs.ru) < std::tie(rhs.kind,
+                                       rhs.centerFrequencies,
+                                       rhs.channelWidth,
+                                       rhs.txPower,
+                                       rhs.guardBandwidth,
+                                       rhs.minInnerBand,
+                                       rhs.minOuterBand,
+                                       rhs.lowestPoint,
+                                       rhs.puncturedSubchannels,
+                                       rhs.ru);
+}
+
+/**
+ * The transmit PSDs already created, which are not modified and shared by the
+ * transmissions with the same parameters: each of them gets its own copy, so that
+ * it may modify it.
+ */
+static std::map<WifiTxPsdId, Ptr<const SpectrumValue>> g_wifiTxPsdMap;
+
+static const std::size_t WIFI_TX_PSD_MAP_MAX_SIZE = 1024; ///< maximum number of stored PSDs
+
+#ifdef NS3_MTP
+/// Protects the stored transmit PSDs, which the PHYs of several partitions may look up at once
+static std::mutex g_wifiTxPsdMutex;
+#endif
+
+/**
+ * @param id the parameters of a transmit PSD
+ * @return a copy of the transmit PSD already created with these parameters, if any,
+ * or a null pointer otherwise
+ */
+static Ptr<SpectrumValue>
+FindTxPsd(const WifiTxPsdId& id)
+{
+#ifdef NS3_MTP
+    std::lock_guard lock(g_wifiTxPsdMutex);
+#endif
+    if (const auto it = g_wifiTxPsdMap.find(id); it != g_wifiTxPsdMap.cend())
+    {
+        return it->second->Copy();
+    }
+    return nullptr;
+}
+
+/**
+ * Store a copy of a transmit PSD just created, so that it is shared by the next
+ * transmissions with the same parameters.
+ *
+ * @param id the parameters of the transmit PSD
+ * @param psd the transmit PSD
+ * @return the transmit PSD
+ */
+static Ptr<SpectrumValue>
+StoreTxPsd(WifiTxPsdId&& id, Ptr<SpectrumValue> psd)
+{
+#ifdef NS3_MTP
+    std::lock_guard lock(g_wifiTxPsdMutex);
+#endif
+    if (g_wifiTxPsdMap.size() >= WIFI_TX_PSD_MAP_MAX_SIZE)
+    {
+        // power control may generate an unbounded number of PSDs
+        g_wifiTxPsdMap.clear();
+    }
+    g_wifiTxPsdMap.emplace(std::move(id), psd->Copy());
+    return psd;
+}
+
 Ptr<SpectrumModel>
 WifiSpectrumValueHelper::GetSpectrumModel(const std::vector<MHz_u>& centerFrequencies,
                                           MHz_u channelWidth,
@@ -196,6 +307,20 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPower << guardBandwidth << minInnerBand
                                     << minOuterBand << lowestPoint);
+    WifiTxPsdId id{WifiTxPsdKind::OFDM,
+                   {centerFrequency},
+                   channelWidth,
+                   txPower,
+                   guardBandwidth,
+                   minInnerBand,
+                   minOuterBand,
+                   lowestPoint,
+                   {},
+                   {}};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     Hz_u carrierSpacing{0};
     uint32_t innerSlopeWidth = 0;
     switch (static_cast<uint16_t>(channelWidth))
@@ -255,7 +380,7 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
                               lowestPoint);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(std::move(id), c);
 }
 
 Ptr<SpectrumValue>
@@ -276,6 +401,20 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    WifiTxPsdId id{WifiTxPsdKind::DUPLICATED_20MHZ,
+                   centerFrequencies,
+                   channelWidth,
+                   txPower,
+                   guardBandwidth,
+                   minInnerBand,
+                   minOuterBand,
+                   lowestPoint,
+                   puncturedSubchannels,
+                   {}};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     const auto carrierSpacing{SUBCARRIER_FREQUENCY_SPACING};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -361,7 +500,7 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(std::move(id), c);
 }
 
 Ptr<SpectrumValue>
@@ -381,6 +520,20 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    WifiTxPsdId id{WifiTxPsdKind::HT_OFDM,
+                   centerFrequencies,
+                   channelWidth,
+                   txPower,
+                   guardBandwidth,
+                   minInnerBand,
+                   minOuterBand,
+                   lowestPoint,
+                   {},
+                   {}};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     const auto carrierSpacing{SUBCARRIER_FREQUENCY_SPACING};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -451,7 +604,7 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
                               lowestPoint);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(std::move(id), c);
 }
 
 Ptr<SpectrumValue>
@@ -495,6 +648,20 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << minInnerBand << minOuterBand
                     << lowestPoint);
+    WifiTxPsdId id{WifiTxPsdKind::HE_OFDM,
+                   centerFrequencies,
+                   channelWidth,
+                   txPower,
+                   guardBandwidth,
+                   minInnerBand,
+                   minOuterBand,
+                   lowestPoint,
+                   puncturedSubchannels,
+                   {}};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     const auto carrierSpacing{SUBCARRIER_FREQUENCY_SPACING_HE};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -628,7 +795,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
                               puncturedSlopeWidth);
     NormalizeSpectrumMask(c, txPower);
     NS_ASSERT_MSG(std::abs(txPower - Integral(*c)) < 1e-6, "Power allocation failed");
-    return c;
+    return StoreTxPsd(std::move(id), c);
 }
 
 Ptr<SpectrumValue>
@@ -649,6 +816,20 @@ WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(
     };
     NS_LOG_FUNCTION(printFrequencies(centerFrequencies)
                     << channelWidth << txPower << guardBandwidth << printRuIndices(ru));
+    WifiTxPsdId id{WifiTxPsdKind::HE_MU_OFDM,
+                   centerFrequencies,
+                   channelWidth,
+                   txPower,
+                   guardBandwidth,
+                   dBr_u{0},
+                   dBr_u{0},
+                   dBr_u{0},
+                   {},
+                   ru};
+    if (auto psd = FindTxPsd(id))
+    {
+        return psd;
+    }
     const auto carrierSpacing{SUBCARRIER_FREQUENCY_SPACING_HE};
     Ptr<SpectrumValue> c = Create<SpectrumValue>(
         GetSpectrumModel(centerFrequencies, channelWidth, carrierSpacing, guardBandwidth));
@@ -671,7 +852,7 @@ WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(
         *vit = allocated ? psd : 0.0;
     }
 
-    return c;
+    return StoreTxPsd(std::move(id), c);
 }
 
 void
@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -21,6 +22,9 @@
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
+#include "ns3/spatial-grid.h"
+
+#include <vector>
 
 namespace ns3
 {
@@ -46,11 +50,24 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "If positive, the maximum distance (m) between the transmitter "
+                          "and the receivers of a transmission. The PHYs beyond this distance "
+                          "are not looked at: no propagation loss or delay is computed for "
+                          "them, and they do not receive the transmission. This reduces the "
+                          "computational load of large networks, provided that this distance "
+                          "is beyond the interference range. Zero means that all the PHYs "
+                          "receive the transmissions.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::SetMaxRange,
+                                             &YansWifiChannel::GetMaxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -59,6 +76,7 @@ YansWifiChannel::~YansWifiChannel()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_grid = nullptr;
 }
 
 void
@@ -75,13 +93,52 @@ YansWifiChannel::SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay
     m_delay = delay;
 }
 
+void
+YansWifiChannel::SetMaxRange(double range)
+{
+    NS_LOG_FUNCTION(this << range);
+    m_maxRange = range;
+    if (range <= 0)
+    {
+        m_grid = nullptr;
+        return;
+    }
+    if (m_grid)
+    {
+        m_grid->SetCellSize(range);
+        return;
+    }
+    m_grid = Create<SpatialGrid>(range);
+    for (uint32_t i = 0; i < m_phyList.size(); i++)
+    {
+        m_grid->Add(i, MakeCallback(&YansWifiPhy::GetMobility, m_phyList[i]));
+    }
+}
+
+double
+YansWifiChannel::GetMaxRange() const
+{
+    return m_maxRange;
+}
+
 void
 YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const
 {
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    // Only look at the PHYs within range, if the range is limited
+    PhyList inRange;
+    if (m_grid)
+    {
+        for (auto i : m_grid->GetWithin(senderMobility->GetPosition(), m_maxRange))
+        {
+            inRange.push_back(m_phyList[i]);
+        }
+    }
+    const PhyList& receivers = m_grid ? inRange : m_phyList;
+    std::vector<Simulator::ContextEvent> events;
+    for (auto i = receivers.begin(); i != receivers.end(); i++)
     {
         if (sender != (*i))
         {
@@ -109,14 +166,11 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
                 dstNode = dstNetDevice->GetNode()->GetId();
             }
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+            events.push_back(
+                {dstNode, delay, MakeEvent(&YansWifiChannel::Receive, (*i), ppdu, rxPower)});
         }
     }
+    Simulator::ScheduleWithContextBatch(events);
 }
 
 void
@@ -161,6 +215,12 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    if (m_grid)
+    {
+        // The PHY may not have a mobility model yet
+        m_grid->Add(static_cast<uint32_t>(m_phyList.size() - 1),
+                    MakeCallback(&YansWifiPhy::GetMobility, phy));
+    }
 }
 
 int64_t
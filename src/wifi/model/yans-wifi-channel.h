@@ -19,6 +19,7 @@ namespace ns3
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
+class SpatialGrid;
 class YansWifiPhy;
 class Packet;
 class Time;
@@ -32,6 +33,11 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, a transmission is passed to all the other PHYs.  If the
+ * MaxRange attribute is set, it is only passed to the PHYs within this
+ * distance of the transmitter, which are found with a SpatialGrid instead
+ * of computing the propagation loss to every PHY.
  */
 class YansWifiChannel : public Channel
 {
@@ -64,6 +70,17 @@ class YansWifiChannel : public Channel
      */
     void SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay);
 
+    /**
+     * Set the distance beyond which the PHYs do not receive the transmissions.
+     *
+     * @param range the distance (m), or zero for no limit
+     */
+    void SetMaxRange(double range);
+    /**
+     * @return the distance beyond which the PHYs do not receive the transmissions (m)
+     */
+    double GetMaxRange() const;
+
     /**
      * @param sender the PHY object from which the packet is originating.
      * @param ppdu the PPDU to send
@@ -107,6 +124,8 @@ class YansWifiChannel : public Channel
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Maximum distance of the receivers, or zero
+    Ptr<SpatialGrid> m_grid;            //!< Positions of the PHYs, if the range is limited
 };
 
 } // namespace ns3
@@ -16,6 +16,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/yans-wifi-phy.h"
 
@@ -2569,6 +2570,85 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief TX duration cache test: the TX durations memoized by a PHY are those computed
+ * by CalculateTxDuration(), including when the cache is emptied because it is full.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param cacheSize the maximum number of TX durations in the cache of the PHY
+     */
+    TxDurationCacheTest(uint32_t cacheSize);
+
+  private:
+    void DoRun() override;
+
+    uint32_t m_cacheSize; ///< the maximum number of TX durations in the cache of the PHY
+};
+
+TxDurationCacheTest::TxDurationCacheTest(uint32_t cacheSize)
+    : TestCase("Wifi TX duration cache of size " + std::to_string(cacheSize)),
+      m_cacheSize(cacheSize)
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    auto phy = CreateObject<YansWifiPhy>();
+    phy->SetAttribute("TxDurationCacheSize", UintegerValue(m_cacheSize));
+    phy->SetOperatingChannel(WifiPhy::ChannelTuple{42, 80, WIFI_PHY_BAND_5GHZ, 0});
+    phy->ConfigureStandard(WIFI_STANDARD_80211ax);
+
+    // every TX duration is computed twice, the second one being read from the cache
+    for (auto round = 0; round < 2; ++round)
+    {
+        for (uint8_t mcs = 0; mcs < 12; ++mcs)
+        {
+            for (const auto width : {MHz_u{20}, MHz_u{40}, MHz_u{80}})
+            {
+                for (const auto gi : {800, 1600, 3200})
+                {
+                    WifiTxVector txVector{HePhy::GetHeMcs(mcs),
+                                          0,
+                                          WIFI_PREAMBLE_HE_SU,
+                                          NanoSeconds(gi),
+                                          1,
+                                          1,
+                                          0,
+                                          width,
+                                          mcs % 2 == 0};
+                    for (const uint32_t size : {14, 100, 1500, 4000})
+                    {
+                        const auto expected =
+                            WifiPhy::CalculateTxDuration(size, txVector, WIFI_PHY_BAND_5GHZ);
+                        NS_TEST_ASSERT_MSG_EQ(phy->GetTxDuration(size, txVector),
+                                              expected,
+                                              "Incorrect TX duration for MCS "
+                                                  << +mcs << ", width " << width << ", GI " << gi
+                                                  << ", size " << size);
+                        WifiMacHeader hdr(WIFI_MAC_QOSDATA);
+                        auto psdu = Create<WifiPsdu>(Create<Packet>(size), hdr);
+                        NS_TEST_ASSERT_MSG_EQ(
+                            phy->GetTxDuration(psdu, txVector),
+                            WifiPhy::CalculateTxDuration(psdu, txVector, WIFI_PHY_BAND_5GHZ),
+                            "Incorrect TX duration of a PSDU of " << size << " bytes");
+                    }
+                }
+            }
+        }
+    }
+
+    phy->Dispose();
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -2585,6 +2665,9 @@ TxDurationTestSuite::TxDurationTestSuite()
     : TestSuite("wifi-devices-tx-duration", Type::UNIT)
 {
     AddTestCase(new TxDurationTest, TestCase::Duration::QUICK);
+    AddTestCase(new TxDurationCacheTest(0), TestCase::Duration::QUICK);
+    AddTestCase(new TxDurationCacheTest(16), TestCase::Duration::QUICK);
+    AddTestCase(new TxDurationCacheTest(1024), TestCase::Duration::QUICK);
 
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
@@ -14,6 +14,8 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
@@ -1110,6 +1112,80 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Wifi Error Rate Models Cache Test Case: the PERs cached by the table-based
+ * model are those it computes without cache, and the success rates computed by the
+ * NIST model from quantized SNRs are those of an SNR within half the resolution.
+ */
+class WifiErrorRateModelsTestCaseCache : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseCache();
+
+  private:
+    void DoRun() override;
+};
+
+WifiErrorRateModelsTestCaseCache::WifiErrorRateModelsTestCaseCache()
+    : TestCase("WifiErrorRateModel cached success rates")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseCache::DoRun()
+{
+    auto tableCached = CreateObject<TableBasedErrorRateModel>();
+    auto table = CreateObject<TableBasedErrorRateModel>();
+    table->SetAttribute("EnablePerCache", BooleanValue(false));
+    auto nistCached = CreateObject<NistErrorRateModel>();
+    nistCached->SetAttribute("SnrCacheResolution", DoubleValue(0.01));
+    auto nist = CreateObject<NistErrorRateModel>();
+
+    for (uint8_t mcs = 0; mcs < 10; ++mcs)
+    {
+        const auto mode = VhtPhy::GetVhtMcs(mcs);
+        for (const auto ldpc : {false, true})
+        {
+            WifiTxVector txVector;
+            txVector.SetMode(mode);
+            txVector.SetLdpc(ldpc);
+            // each SNR is used twice, the second time from the caches
+            for (auto round = 0; round < 2; ++round)
+            {
+                for (dB_u snr{-6}; snr <= dB_u{40}; snr += dB_u{0.0137})
+                {
+                    for (const uint64_t size : {32, 1000, 1458})
+                    {
+                        NS_TEST_ASSERT_MSG_EQ(
+                            tableCached->GetChunkSuccessRate(mode,
+                                                             txVector,
+                                                             DbToRatio(snr),
+                                                             size * 8),
+                            table->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), size * 8),
+                            "Cached PER differs for MCS " << +mcs << ", SNR " << snr << " dB");
+                    }
+                    // the SNR is quantized to the closest multiple of the resolution
+                    const auto cached =
+                        nistCached->GetChunkSuccessRate(mode, txVector, DbToRatio(snr), 800);
+                    NS_TEST_ASSERT_MSG_GT_OR_EQ(
+                        cached,
+                        nist->GetChunkSuccessRate(mode, txVector, DbToRatio(snr - 0.00501), 800),
+                        "Cached success rate too low for MCS " << +mcs << ", SNR " << snr
+                                                               << " dB");
+                    NS_TEST_ASSERT_MSG_LT_OR_EQ(
+                        cached,
+                        nist->GetChunkSuccessRate(mode, txVector, DbToRatio(snr + 0.00501), 800),
+                        "Cached success rate too high for MCS " << +mcs << ", SNR " << snr
+                                                                << " dB");
+                }
+            }
+        }
+    }
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -1128,6 +1204,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseCache, TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
@@ -14,6 +14,7 @@
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -24,10 +25,13 @@
 #include "ns3/mgt-headers.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/ofdm-ppdu.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
 #include "ns3/packet-socket-server.h"
 #include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/socket.h"
@@ -44,11 +48,14 @@
 #include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
+#include "ns3/wifi-spectrum-value-helper.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
+#include <cmath>
 #include <optional>
+#include <set>
 
 using namespace ns3;
 
@@ -420,6 +427,288 @@ InterferenceHelperSequenceTest::DoRun()
     Simulator::Destroy();
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the InterferenceHelper keeps track of the total power of many
+ * overlapping signals: the time during which the energy on the medium stays above
+ * a threshold must match the one computed from the signals themselves, both when
+ * the NI changes of the expired signals are compacted and when they are kept while
+ * a reception is ongoing.
+ */
+class InterferenceHelperEnergyDurationTest : public TestCase
+{
+  public:
+    InterferenceHelperEnergyDurationTest();
+
+    void DoRun() override;
+
+  private:
+    /// A signal added to the interference helper
+    struct Signal
+    {
+        Time start;   //!< the start time of the signal
+        Time end;     //!< the end time of the signal
+        Watt_u power; //!< the received power of the signal
+    };
+
+    /**
+     * Add a signal to the interference helper
+     * @param signal the signal
+     */
+    void AddSignal(Signal signal);
+    /**
+     * Check the energy duration returned by the interference helper
+     */
+    void CheckEnergyDuration();
+
+    Ptr<InterferenceHelper> m_interferenceHelper; ///< the interference helper
+    WifiSpectrumBandInfo m_band;                  ///< the band tracked by the interference helper
+    std::vector<Signal> m_signals;                ///< the signals added so far
+    Watt_u m_threshold;                           ///< the energy threshold
+};
+
+InterferenceHelperEnergyDurationTest::InterferenceHelperEnergyDurationTest()
+    : TestCase("InterferenceHelper energy duration with many overlapping signals"),
+      m_band{{{0, 0}}, {{Hz_u{5170e6}, Hz_u{5190e6}}}},
+      m_threshold{20.5 * std::ldexp(1.0, -30)}
+{
+}
+
+void
+InterferenceHelperEnergyDurationTest::AddSignal(Signal signal)
+{
+    RxPowerWattPerChannelBand rxPower{{m_band, signal.power}};
+    m_interferenceHelper->AddForeignSignal(signal.end - signal.start,
+                                           rxPower,
+                                           WHOLE_WIFI_SPECTRUM);
+    m_signals.push_back(signal);
+}
+
+void
+InterferenceHelperEnergyDurationTest::CheckEnergyDuration()
+{
+    const auto now = Simulator::Now();
+    auto powerAt = [this](Time t) {
+        Watt_u power{0};
+        for (const auto& signal : m_signals)
+        {
+            if (signal.start <= t && t < signal.end)
+            {
+                power += signal.power;
+            }
+        }
+        return power;
+    };
+    Time expected;
+    if (powerAt(now) >= m_threshold)
+    {
+        std::set<Time> ends;
+        for (const auto& signal : m_signals)
+        {
+            if (signal.end > now)
+            {
+                ends.insert(signal.end);
+            }
+        }
+        for (const auto& end : ends)
+        {
+            if (powerAt(end) < m_threshold)
+            {
+                expected = end - now;
+                break;
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_interferenceHelper->GetEnergyDuration(m_threshold, m_band),
+                          expected,
+                          "Unexpected energy duration at " << now.As(Time::US));
+}
+
+void
+InterferenceHelperEnergyDurationTest::DoRun()
+{
+    m_interferenceHelper = CreateObject<InterferenceHelper>();
+    m_interferenceHelper->AddBand(m_band);
+
+    // The powers are multiples of 2^-30 W, hence they are added and subtracted exactly,
+    // and the starts and ends of the signals never coincide
+    const uint32_t signalN = 400;
+    for (uint32_t i = 0; i < signalN; i++)
+    {
+        const auto start = MicroSeconds(10 * (i + 1));
+        const auto end = start + MicroSeconds(10 * (5 + (i * 7) % 40) + 5);
+        const Watt_u power{((i * 13) % 5 + 1) * std::ldexp(1.0, -30)};
+        Simulator::Schedule(start,
+                            &InterferenceHelperEnergyDurationTest::AddSignal,
+                            this,
+                            Signal{start, end, power});
+        Simulator::Schedule(start + MicroSeconds(3),
+                            &InterferenceHelperEnergyDurationTest::CheckEnergyDuration,
+                            this);
+    }
+    // Keep the NI changes of the expired signals during the second half of the test
+    Simulator::Schedule(MicroSeconds(10 * signalN / 2 + 1),
+                        &InterferenceHelper::NotifyRxStart,
+                        m_interferenceHelper,
+                        WHOLE_WIFI_SPECTRUM);
+
+    Simulator::Run();
+    m_interferenceHelper->Dispose();
+    m_interferenceHelper = nullptr;
+    Simulator::Destroy();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a YansWifiChannel whose MaxRange attribute is set only passes the
+ * signals to the PHYs within range, and keeps track of the PHYs which move.
+ *
+ * A PHY sends a PPDU before and after a PHY beyond the range moves within the
+ * range: the PHY within the range gets both signals, the PHY which stays beyond
+ * the range gets none, and the moving PHY gets the second one.  Without a range,
+ * all the PHYs get both signals.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param maxRange the MaxRange attribute of the channel, zero for no limit
+     */
+    YansWifiChannelMaxRangeTest(double maxRange);
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Create a PHY attached to the channel
+     * @param pos the position of the PHY
+     * @returns the PHY
+     */
+    Ptr<YansWifiPhy> CreatePhy(Vector pos);
+    /**
+     * Send a PPDU from the first PHY
+     */
+    void SendPpdu();
+    /**
+     * Notify the arrival of a signal at a PHY
+     * @param index the index of the PHY
+     * @param ppdu the PPDU
+     * @param rxPowerDbm the received power
+     * @param duration the duration of the signal
+     */
+    void SignalArrival(std::size_t index,
+                       Ptr<const WifiPpdu> ppdu,
+                       double rxPowerDbm,
+                       Time duration);
+
+    double m_maxRange;                    ///< the MaxRange attribute of the channel
+    Ptr<YansWifiChannel> m_channel;       ///< the channel
+    std::vector<Ptr<YansWifiPhy>> m_phys; ///< the PHYs, the first one sending
+    std::vector<uint32_t> m_arrivals;     ///< the number of signals arrived at each PHY
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest(double maxRange)
+    : TestCase(maxRange > 0 ? "YansWifiChannel with a maximum range"
+                            : "YansWifiChannel without maximum range"),
+      m_maxRange(maxRange)
+{
+}
+
+Ptr<YansWifiPhy>
+YansWifiChannelMaxRangeTest::CreatePhy(Vector pos)
+{
+    auto node = CreateObject<Node>();
+    auto dev = CreateObject<WifiNetDevice>();
+    auto mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(pos);
+    node->AggregateObject(mobility);
+
+    auto phy = CreateObject<YansWifiPhy>();
+    phy->SetDevice(dev);
+    phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    phy->SetErrorRateModel(CreateObject<YansErrorRateModel>());
+    phy->SetMobility(mobility);
+    phy->SetChannel(m_channel);
+    phy->ConfigureStandard(WIFI_STANDARD_80211a);
+    dev->SetPhy(phy);
+    node->AddDevice(dev);
+
+    phy->TraceConnectWithoutContext(
+        "SignalArrival",
+        MakeCallback(&YansWifiChannelMaxRangeTest::SignalArrival, this).Bind(m_phys.size()));
+    m_phys.push_back(phy);
+    m_arrivals.push_back(0);
+    return phy;
+}
+
+void
+YansWifiChannelMaxRangeTest::SendPpdu()
+{
+    WifiTxVector txVector{OfdmPhy::GetOfdmRate6Mbps(),
+                          WIFI_MIN_TX_PWR_LEVEL,
+                          WIFI_PREAMBLE_LONG,
+                          NanoSeconds(800),
+                          1,
+                          1,
+                          0,
+                          MHz_u{20},
+                          false};
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_DATA);
+    auto psdu = Create<WifiPsdu>(Create<Packet>(100), hdr);
+    auto ppdu = Create<OfdmPpdu>(psdu, txVector, m_phys.front()->GetOperatingChannel(), 0);
+    m_channel->Send(m_phys.front(), ppdu, dBm_u{20});
+}
+
+void
+YansWifiChannelMaxRangeTest::SignalArrival(std::size_t index,
+                                           Ptr<const WifiPpdu> ppdu,
+                                           double rxPowerDbm,
+                                           Time duration)
+{
+    m_arrivals[index]++;
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun()
+{
+    m_channel = CreateObject<YansWifiChannel>();
+    m_channel->SetAttribute("MaxRange", DoubleValue(m_maxRange));
+    m_channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    // the signals are too weak to be received, so that only their arrival is traced
+    m_channel->SetPropagationLossModel(CreateObject<FixedRssLossModel>());
+
+    CreatePhy(Vector(0, 0, 0));
+    auto near = CreatePhy(Vector(50, 0, 50));
+    auto far = CreatePhy(Vector(150, 0, 0));
+    auto moving = CreatePhy(Vector(-300, 20, 0));
+
+    Simulator::Schedule(Seconds(1), &YansWifiChannelMaxRangeTest::SendPpdu, this);
+    Simulator::Schedule(Seconds(2),
+                        &MobilityModel::SetPosition,
+                        moving->GetMobility(),
+                        Vector(-80, 20, 0));
+    Simulator::Schedule(Seconds(3), &YansWifiChannelMaxRangeTest::SendPpdu, this);
+    Simulator::Run();
+
+    const bool limited = m_maxRange > 0;
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals[0], 0, "The sender got its signals");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals[1], 2, "The PHY within range missed a signal");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals[2], (limited ? 0 : 2), "Wrong number of signals beyond range");
+    NS_TEST_EXPECT_MSG_EQ(m_arrivals[3],
+                          (limited ? 1 : 2),
+                          "Wrong number of signals arrived at the moving PHY");
+
+    for (auto& phy : m_phys)
+    {
+        phy->Dispose();
+    }
+    m_phys.clear();
+    m_channel = nullptr;
+    Simulator::Destroy();
+}
+
 //-----------------------------------------------------------------------------
 /**
  * Make sure that when multiple broadcast packets are queued on the same
@@ -3996,6 +4285,9 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new WifiTest, TestCase::Duration::QUICK);
     AddTestCase(new QosUtilsIsOldPacketTest, TestCase::Duration::QUICK);
     AddTestCase(new InterferenceHelperSequenceTest, TestCase::Duration::QUICK); // Bug 991
+    AddTestCase(new InterferenceHelperEnergyDurationTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelMaxRangeTest(0), TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelMaxRangeTest(100), TestCase::Duration::QUICK);
     AddTestCase(new DcfImmediateAccessBroadcastTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Bug730TestCase, TestCase::Duration::QUICK); // Bug 730
     AddTestCase(new QosFragmentationTestCase, TestCase::Duration::QUICK);
@@ -15,6 +15,7 @@
 #include "ns3/wifi-standards.h"
 
 #include <cmath>
+#include <functional>
 #include <vector>
 
 using namespace ns3;
@@ -301,6 +302,100 @@ WifiOfdmMaskSlopesTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test that the transmit PSDs created twice with the same parameters have the same
+ * values, and that each of them can be modified without modifying the other ones.
+ */
+class WifiTxPsdSharingTestCase : public TestCase
+{
+  public:
+    WifiTxPsdSharingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that two PSDs created with the same parameters are equal and independent.
+     *
+     * @param create the function creating the PSD
+     * @param name the name of the PSD
+     */
+    void CheckSharing(const std::function<Ptr<SpectrumValue>()>& create, const std::string& name);
+};
+
+WifiTxPsdSharingTestCase::WifiTxPsdSharingTestCase()
+    : TestCase("Sharing of the transmit PSDs created with the same parameters")
+{
+}
+
+void
+WifiTxPsdSharingTestCase::CheckSharing(const std::function<Ptr<SpectrumValue>()>& create,
+                                       const std::string& name)
+{
+    auto first = create();
+    const auto values = first->GetValues();
+    auto second = create();
+    NS_TEST_ASSERT_MSG_NE(first, second, name << ": each PSD should be a distinct object");
+    NS_TEST_ASSERT_MSG_EQ((second->GetValues() == values), true, name << ": different values");
+    *first *= 2;
+    auto third = create();
+    NS_TEST_ASSERT_MSG_EQ((second->GetValues() == values), true, name << ": PSD modified");
+    NS_TEST_ASSERT_MSG_EQ((third->GetValues() == values), true, name << ": stored PSD modified");
+}
+
+void
+WifiTxPsdSharingTestCase::DoRun()
+{
+    CheckSharing(
+        []() {
+            return WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u{5180},
+                                                                             MHz_u{20},
+                                                                             Watt_u{0.1},
+                                                                             MHz_u{10});
+        },
+        "OFDM");
+    CheckSharing(
+        []() {
+            return WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity({MHz_u{5190}},
+                                                                               MHz_u{40},
+                                                                               Watt_u{0.1},
+                                                                               MHz_u{20});
+        },
+        "HT OFDM");
+    CheckSharing(
+        []() {
+            return WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
+                MHz_u{5210},
+                MHz_u{80},
+                Watt_u{0.1},
+                MHz_u{40},
+                dBr_u{-20},
+                dBr_u{-28},
+                dBr_u{-40},
+                {false, true, false, false});
+        },
+        "HE OFDM");
+    CheckSharing(
+        []() {
+            return WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity({MHz_u{5210}},
+                                                                                 MHz_u{80},
+                                                                                 Watt_u{0.1},
+                                                                                 MHz_u{40},
+                                                                                 {{1000, 1105}});
+        },
+        "HE MU OFDM");
+
+    // a different power gives a different PSD
+    auto psd = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u{5180},
+                                                                         MHz_u{20},
+                                                                         Watt_u{0.2},
+                                                                         MHz_u{10});
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*psd), 0.2, 1e-6, "Unexpected power of the PSD");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -324,6 +419,8 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite()
 
     NS_LOG_INFO("Creating WifiTransmitMaskTestSuite");
 
+    AddTestCase(new WifiTxPsdSharingTestCase, TestCase::Duration::QUICK);
+
     WifiOfdmMaskSlopesTestCase::IndexPowerVect maskSlopes;
     dB_u tol{10e-2};
     double prec = 10; // in decimals
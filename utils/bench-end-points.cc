@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the end point demultiplexing of a
+// server holding many TCP connections on a single port: it accepts the
+// connections, looks up the end point of the packets they receive, and
+// closes them.
+// Sample usage:  ./ns3 run 'bench-end-points --connections=50000 --packets=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Get the address of a client of the server.
+ *
+ * @param [in] i The index of the connection.
+ * @returns The address of the client.
+ */
+static Ipv4Address
+GetPeerAddress(uint32_t i)
+{
+    return Ipv4Address(Ipv4Address("10.1.0.0").Get() + i / 16);
+}
+
+/**
+ * Get the port of a client of the server.
+ *
+ * @param [in] i The index of the connection.
+ * @returns The port of the client.
+ */
+static uint16_t
+GetPeerPort(uint32_t i)
+{
+    return 49152 + i % 16;
+}
+
+/**
+ * Print the rate of an operation.
+ *
+ * @param [in] n The number of operations.
+ * @param [in] ms The elapsed time (ms).
+ * @param [in] name The name of the operation.
+ */
+static void
+PrintRate(uint32_t n, int64_t ms, const char* name)
+{
+    std::cout << n * 1000.0 / std::max<int64_t>(ms, 1) << " ops/s"
+              << " (" << ms << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t connections = 0;
+    uint32_t packets = 1000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the IPv4 end point demultiplexer");
+    cmd.AddValue("connections", "number of connections of the server", connections);
+    cmd.AddValue("packets", "number of packets received by the server", packets);
+    cmd.Parse(argc, argv);
+
+    if (connections == 0)
+    {
+        std::cerr << "Error-- number of connections must be specified "
+                  << "by command-line argument --connections=(number of connections)"
+                  << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-end-points with connections=" << connections
+              << " packets=" << packets << std::endl;
+
+    const Ipv4Address local("10.0.0.1");
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    interface->AddAddress(Ipv4InterfaceAddress(local, Ipv4Mask("255.255.255.0")));
+    Ipv4EndPointDemux demux;
+    demux.Allocate(nullptr, 80);
+
+    SystemWallClockMs time;
+    time.Start();
+    std::vector<Ipv4EndPoint*> endPoints;
+    for (uint32_t i = 0; i < connections; i++)
+    {
+        endPoints.push_back(demux.Allocate(nullptr, local, 80, GetPeerAddress(i), GetPeerPort(i)));
+    }
+    PrintRate(connections, time.End(), "Accept connections");
+
+    time.Start();
+    uint32_t found = 0;
+    for (uint32_t p = 0; p < packets; p++)
+    {
+        // Spread the packets over the connections
+        uint32_t i = (p * 2654435761U) % connections;
+        found += demux.Lookup(local, 80, GetPeerAddress(i), GetPeerPort(i), interface).size();
+    }
+    PrintRate(packets, time.End(), "Receive packets on the connections");
+
+    time.Start();
+    for (uint32_t p = 0; p < packets; p++)
+    {
+        found += demux.Lookup(local, 80, GetPeerAddress(connections + p), 1000, interface).size();
+    }
+    PrintRate(packets, time.End(), "Receive packets of new connections");
+
+    time.Start();
+    for (auto endPoint : endPoints)
+    {
+        demux.DeAllocate(endPoint);
+    }
+    PrintRate(connections, time.End(), "Close connections");
+
+    if (found != 2 * packets)
+    {
+        std::cerr << "Error-- " << found << " end points found for " << 2 * packets << " packets"
+                  << std::endl;
+        exit(1);
+    }
+    return 0;
+}
@@ -339,6 +339,55 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchPacketTags(uint32_t n)
+{
+    BenchTag<4> flowId;
+    BenchTag<8> snr;
+    BenchTag<12> bearer;
+    BenchTag<1> priority;
+    BenchTag<16> absent;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddPacketTag(flowId);
+        p->AddPacketTag(snr);
+        p->AddPacketTag(bearer);
+        Ptr<Packet> o = p->Copy();
+        o->AddPacketTag(priority);
+        o->PeekPacketTag(flowId);
+        o->PeekPacketTag(snr);
+        o->PeekPacketTag(absent);
+        o->ReplacePacketTag(snr);
+        o->RemovePacketTag(bearer);
+        o->RemovePacketTag(absent);
+        p->RemovePacketTag(flowId);
+    }
+}
+
+static void
+benchPacketTagsOverflow(uint32_t n)
+{
+    BenchTag<20> tag1;
+    BenchTag<24> tag2;
+    BenchTag<28> tag3;
+    BenchTag<32> tag4;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddPacketTag(tag1);
+        p->AddPacketTag(tag2);
+        p->AddPacketTag(tag3);
+        Ptr<Packet> o = p->Copy();
+        o->AddPacketTag(tag4);
+        o->PeekPacketTag(tag1);
+        o->RemovePacketTag(tag2);
+        p->RemovePacketTag(tag3);
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -396,6 +445,11 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchPacketTags, n, minIterations, "Add, copy, peek and remove packet tags");
+    runBench(&benchPacketTagsOverflow,
+             n,
+             minIterations,
+             "Packet tags exceeding the inline tag storage");
 
     return 0;
 }
@@ -376,26 +376,65 @@ BenchSuite::Log() const
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
- *  If the \p filename parameter is empty a default exponential time
- *  distribution will be used, with mean delay of 100 ns.
+ *  If the \p filename parameter is empty the delays are drawn from
+ *  the \p dist distribution, all with a mean delay of about 100 ns:
+ *
+ *  - `exp`: an exponential distribution;
+ *  - `bimodal`: a mix of short exponential delays (mean 10 ns, 99%)
+ *    and long exponential delays (mean 9 us, 1%), like the timers of
+ *    a model scheduling both per-packet events and timeouts;
+ *  - `pareto`: a heavy-tailed Pareto distribution with shape 1.5.
  *
  *  If the \p filename is `-` standard input will be used.
  *
  *  @param [in] filename The delay interval source file name.
+ *  @param [in] dist The delay distribution, if \p filename is empty.
  *  @returns The RandomVariableStream.
  */
 Ptr<RandomVariableStream>
-GetRandomStream(std::string filename)
+GetRandomStream(std::string filename, std::string dist)
 {
     Ptr<RandomVariableStream> stream = nullptr;
 
-    if (filename.empty())
+    if (filename.empty() && dist == "exp")
     {
         LOG("  Event time distribution:      default exponential");
         auto erv = CreateObject<ExponentialRandomVariable>();
         erv->SetAttribute("Mean", DoubleValue(100));
         stream = erv;
     }
+    else if (filename.empty() && dist == "bimodal")
+    {
+        LOG("  Event time distribution:      bimodal exponential");
+        // Draw the samples beforehand, since the mixture is not a
+        // RandomVariableStream on its own
+        auto choice = CreateObject<UniformRandomVariable>();
+        auto shortDelay = CreateObject<ExponentialRandomVariable>();
+        shortDelay->SetAttribute("Mean", DoubleValue(10));
+        auto longDelay = CreateObject<ExponentialRandomVariable>();
+        longDelay->SetAttribute("Mean", DoubleValue(9000));
+
+        std::vector<double> nsValues(1 << 20);
+        for (auto& value : nsValues)
+        {
+            value = choice->GetValue() < 0.99 ? shortDelay->GetValue() : longDelay->GetValue();
+        }
+        auto drv = CreateObject<DeterministicRandomVariable>();
+        drv->SetValueArray(nsValues);
+        stream = drv;
+    }
+    else if (filename.empty() && dist == "pareto")
+    {
+        LOG("  Event time distribution:      pareto");
+        auto prv = CreateObject<ParetoRandomVariable>();
+        prv->SetAttribute("Shape", DoubleValue(1.5));
+        prv->SetAttribute("Scale", DoubleValue(100.0 / 3));
+        stream = prv;
+    }
+    else if (filename.empty())
+    {
+        NS_FATAL_ERROR("Unknown event time distribution: " << dist);
+    }
     else
     {
         std::istream* input;
@@ -446,18 +485,21 @@ main(int argc, char* argv[])
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
+    bool schedLadder = false;
 
     uint64_t pop = 100000;
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string dist = "exp";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
               "\n"
               "Event intervals are taken from one of:\n"
-              "  an exponential distribution, with mean 100 ns,\n"
+              "  a distribution with mean 100 ns, given by the\n"
+              "    --dist=\"exp|bimodal|pareto\" argument (default exponential),\n"
               "  an ascii file, given by the --file=\"<filename>\" argument,\n"
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
@@ -468,6 +510,7 @@ main(int argc, char* argv[])
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -476,6 +519,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("dist", "event time distribution: exp, bimodal or pareto", dist);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -491,15 +535,15 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = GetRandomStream(filename, dist);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -518,6 +562,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
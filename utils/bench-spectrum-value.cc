@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the arithmetic of SpectrumValue and the
+// conversion of a SpectrumValue between two SpectrumModels, over spectrum models
+// with a given number of bands, and over SpectrumModel300Khz300GhzLog.
+// Sample usage:  ./ns3 run 'bench-spectrum-value --iterations=10000 --bands=1000,4000'
+
+#include "ns3/command-line.h"
+#include "ns3/spectrum-converter.h"
+#include "ns3/spectrum-model-300kHz-300GHz-log.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cmath>
+#include <cstdlib> // for exit ()
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/** The sum of the values computed, so that the computations are not optimized out. */
+static double g_sum = 0;
+
+/**
+ * Run an operation repeatedly, and print the time per operation and per band.
+ *
+ * @param [in] op The operation.
+ * @param [in] iterations The number of operations.
+ * @param [in] bands The number of bands of the values.
+ * @param [in] name The name of the operation.
+ */
+static void
+Run(const std::function<void()>& op,
+    uint32_t iterations,
+    std::size_t bands,
+    const std::string& name)
+{
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        op();
+    }
+    int64_t ms = time.End();
+    double ns = ms * 1e6 / std::max<uint32_t>(iterations, 1);
+    std::cout << ns << " ns/op, " << ns / std::max<std::size_t>(bands, 1) << " ns/band"
+              << " (" << ms << " ms elapsed)\t" << name << " (" << bands << " bands)"
+              << std::endl;
+}
+
+/**
+ * Create a spectrum model of contiguous bands of the same width.
+ *
+ * @param [in] bands The number of bands.
+ * @param [in] start The center frequency of the first band, in Hz.
+ * @param [in] width The width of the bands, in Hz.
+ * @return The spectrum model.
+ */
+static Ptr<SpectrumModel>
+CreateModel(std::size_t bands, double start, double width)
+{
+    std::vector<double> freqs;
+    freqs.reserve(bands);
+    for (std::size_t i = 0; i < bands; i++)
+    {
+        freqs.push_back(start + i * width);
+    }
+    return Create<SpectrumModel>(freqs);
+}
+
+/**
+ * Benchmark the arithmetic of the values of a spectrum model.
+ *
+ * @param [in] model The spectrum model.
+ * @param [in] iterations The number of operations.
+ */
+static void
+BenchArithmetic(Ptr<const SpectrumModel> model, uint32_t iterations)
+{
+    const auto bands = model->GetNumBands();
+    SpectrumValue a(model);
+    SpectrumValue b(model);
+    for (std::size_t i = 0; i < bands; i++)
+    {
+        a[i] = 1e-12 * (1 + std::sin(i * 0.1));
+        b[i] = 1e-12 * (1 + std::cos(i * 0.1));
+    }
+
+    Run([&]() { a += b; }, iterations, bands, "operator+=");
+    Run([&]() { a -= b; }, iterations, bands, "operator-=");
+    Run([&]() { a *= 1.0000001; }, iterations, bands, "operator*= (scalar)");
+    Run([&]() { a /= 1.0000001; }, iterations, bands, "operator/= (scalar)");
+    Run([&]() { g_sum += Sum(a * b); }, iterations, bands, "Sum (a * b)");
+    Run([&]() { g_sum += Integral(a); }, iterations, bands, "Integral");
+}
+
+/**
+ * Benchmark the conversion of values from a spectrum model to another.
+ *
+ * @param [in] from The spectrum model converted from.
+ * @param [in] to The spectrum model converted to.
+ * @param [in] iterations The number of conversions.
+ * @param [in] name The name of the conversion.
+ */
+static void
+BenchConversion(Ptr<const SpectrumModel> from,
+                Ptr<const SpectrumModel> to,
+                uint32_t iterations,
+                const std::string& name)
+{
+    auto value = Create<SpectrumValue>(from);
+    *value = 1e-12;
+    SpectrumConverter converter(from, to);
+    Run([&]() { g_sum += (*converter.Convert(value))[0]; },
+        iterations,
+        from->GetNumBands(),
+        name);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t iterations = 10000;
+    std::string bandList = "1000,2000,4000";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the arithmetic and the conversion of SpectrumValue");
+    cmd.AddValue("iterations", "number of operations per benchmark", iterations);
+    cmd.AddValue("bands", "comma-separated numbers of bands of the spectrum models", bandList);
+    cmd.Parse(argc, argv);
+
+    std::vector<std::size_t> bandNumbers;
+    std::istringstream iss(bandList);
+    std::string token;
+    while (std::getline(iss, token, ','))
+    {
+        bandNumbers.push_back(std::stoul(token));
+    }
+    if (bandNumbers.empty())
+    {
+        std::cerr << "Error-- at least one number of bands is required" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-spectrum-value with iterations=" << iterations
+              << " bands=" << bandList << std::endl;
+
+    BenchArithmetic(SpectrumModel300Khz300GhzLog(), iterations);
+    for (auto bands : bandNumbers)
+    {
+        // 78.125 kHz subcarriers, and 312.5 kHz bands whose edges are in the middle of
+        // subcarriers, so that the models are not aligned
+        auto fine = CreateModel(bands, 5e9, 78125);
+        auto coarse = CreateModel(bands / 4, 5e9 + 156250, 312500);
+        BenchArithmetic(fine, iterations);
+        BenchConversion(fine, coarse, iterations, "Convert (fine to coarse)");
+        BenchConversion(coarse, fine, iterations, "Convert (coarse to fine)");
+    }
+
+    std::cout << "Sum of the values: " << g_sum << std::endl;
+    return 0;
+}
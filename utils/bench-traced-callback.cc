@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the overhead of a trace source, i.e.,
+// of invoking a TracedCallback with no sink, one sink or many sinks connected.
+// Sample usage:  ./ns3 run 'bench-traced-callback --calls=10000000 --sinks=8'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/traced-callback.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/** The sum of the values received by the sinks. */
+static uint64_t g_sum = 0;
+
+/**
+ * A trace sink.
+ *
+ * @param [in] value The value traced.
+ */
+static void
+Sink(uint32_t value)
+{
+    g_sum += value;
+}
+
+/**
+ * Invoke a trace source repeatedly, and print the time per invocation.
+ *
+ * @param [in] trace The trace source.
+ * @param [in] calls The number of invocations.
+ * @param [in] name The name of the configuration.
+ */
+static void
+Run(const TracedCallback<uint32_t>& trace, uint32_t calls, const std::string& name)
+{
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < calls; i++)
+    {
+        trace(i);
+    }
+    int64_t ms = time.End();
+    std::cout << ms * 1e6 / std::max<uint32_t>(calls, 1) << " ns/call"
+              << " (" << ms << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t calls = 10000000;
+    uint32_t sinks = 8;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the invocation of a trace source");
+    cmd.AddValue("calls", "number of invocations of the trace source", calls);
+    cmd.AddValue("sinks", "number of sinks connected in the last run", sinks);
+    cmd.Parse(argc, argv);
+
+    if (sinks < 2)
+    {
+        std::cerr << "Error-- number of sinks must be at least 2" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-traced-callback with calls=" << calls << " sinks=" << sinks
+              << std::endl;
+
+    TracedCallback<uint32_t> trace;
+    Run(trace, calls, "No sink");
+
+    trace.ConnectWithoutContext(MakeCallback(&Sink));
+    Run(trace, calls, "1 sink");
+
+    for (uint32_t i = 1; i < sinks; i++)
+    {
+        trace.ConnectWithoutContext(MakeCallback(&Sink));
+    }
+    Run(trace, calls, std::to_string(sinks) + " sinks");
+
+    if (!trace.IsEmpty() && g_sum == 0)
+    {
+        std::cerr << "Error-- the sinks were not invoked" << std::endl;
+        exit(1);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program prints the datasets of a file written by a
+// ColumnarAggregator as text, one row per line, e.g., to convert them to
+// a format of another tool.  Post-processing in C++ can read the file
+// with a ColumnarReader instead.
+// Sample usage:  ./ns3 run 'print-columnar --file=data.col --separator=,'
+
+#include "ns3/columnar-aggregator.h"
+#include "ns3/command-line.h"
+
+#include <cstdlib> // for exit ()
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Print a dataset.
+ *
+ * @param [in] reader The reader of the file.
+ * @param [in] context The context of the dataset.
+ * @param [in] separator The separator of the values of a row.
+ */
+static void
+PrintDataset(const ColumnarReader& reader, const std::string& context, const std::string& separator)
+{
+    std::size_t columnN = reader.GetColumnN(context);
+    std::vector<std::vector<double>> doubles(columnN);
+    std::vector<std::vector<int64_t>> signedIntegers(columnN);
+    std::vector<std::vector<uint64_t>> unsignedIntegers(columnN);
+
+    std::cout << "# " << context << std::endl << "# ";
+    for (std::size_t i = 0; i < columnN; i++)
+    {
+        std::cout << (i ? separator : "") << reader.GetColumnName(context, i);
+        switch (reader.GetColumnType(context, i))
+        {
+        case ColumnarAggregator::INT64:
+            signedIntegers[i] = reader.GetColumn<int64_t>(context, i);
+            break;
+        case ColumnarAggregator::UINT64:
+            unsignedIntegers[i] = reader.GetColumn<uint64_t>(context, i);
+            break;
+        default:
+            doubles[i] = reader.GetColumn<double>(context, i);
+            break;
+        }
+    }
+    std::cout << std::endl;
+
+    for (std::size_t row = 0; row < reader.GetRowN(context); row++)
+    {
+        for (std::size_t i = 0; i < columnN; i++)
+        {
+            std::cout << (i ? separator : "");
+            switch (reader.GetColumnType(context, i))
+            {
+            case ColumnarAggregator::INT64:
+                std::cout << signedIntegers[i][row];
+                break;
+            case ColumnarAggregator::UINT64:
+                std::cout << unsignedIntegers[i][row];
+                break;
+            default:
+                std::cout << doubles[i][row];
+                break;
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string file;
+    std::string dataset;
+    std::string separator = " ";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Print the datasets of a file written by a ColumnarAggregator");
+    cmd.AddValue("file", "name of the file to read", file);
+    cmd.AddValue("dataset", "context of the dataset to print, or all of them if empty", dataset);
+    cmd.AddValue("separator", "separator of the values of a row", separator);
+    cmd.Parse(argc, argv);
+
+    ColumnarReader reader;
+    if (!reader.Open(file))
+    {
+        std::cerr << "Error-- unable to read " << file << std::endl;
+        exit(1);
+    }
+
+    std::cout << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (const auto& context : reader.GetDatasets())
+    {
+        if (dataset.empty() || dataset == context)
+        {
+            PrintDataset(reader, context, separator);
+        }
+    }
+    return 0;
+}